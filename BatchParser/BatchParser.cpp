@@ -0,0 +1,473 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include "BatchParser.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+using namespace BatchParser;
+using EmbeddedStAX::XmlReader::XmlReader;
+
+/**
+ * Number of bytes that are written to the XML reader at once
+ */
+static const size_t ChunkSize = 4U * 1024U;
+
+/**
+ * Constructor
+ */
+FileResult::FileResult()
+    : path(),
+      status(Status_OpenFailed),
+      byteCount(0U),
+      eventCount(0U),
+      durationUs(0U),
+      workerIndex(0U),
+      errorOffset(0U),
+      errorLine(0U),
+      errorColumn(0U)
+{
+}
+
+/**
+ * Constructor
+ */
+Statistics::Statistics()
+    : fileCount(0U),
+      successCount(0U),
+      failureCount(0U),
+      stolenCount(0U),
+      byteCount(0U),
+      eventCount(0U),
+      parsingTimeUs(0U),
+      wallTimeUs(0U)
+{
+}
+
+/**
+ * Destructor
+ */
+AbstractResultHandler::~AbstractResultHandler()
+{
+}
+
+/**
+ * Constructor
+ */
+BatchParser::BatchParser::Worker::Worker()
+    : owner(NULL),
+      index(0U),
+      thread(),
+      queueMutex(),
+      queue(),
+      xmlReader(),
+      statistics()
+{
+    pthread_mutex_init(&queueMutex, NULL);
+    xmlReader.setLineTrackingEnabled(true);
+}
+
+/**
+ * Constructor
+ */
+BatchParser::BatchParser::BatchParser()
+    : m_pathList(NULL),
+      m_workerList(),
+      m_resultHandler(NULL),
+      m_resultMutex()
+{
+    pthread_mutex_init(&m_resultMutex, NULL);
+}
+
+/**
+ * Destructor
+ */
+BatchParser::BatchParser::~BatchParser()
+{
+    pthread_mutex_destroy(&m_resultMutex);
+}
+
+/**
+ * Parse all files from the list
+ *
+ * \param pathList      List of paths to XML files
+ * \param workerCount   Number of worker threads (at least one worker is always used)
+ * \param resultHandler Optional handler that receives the result of each file as soon as it is
+ *                      parsed
+ *
+ * \return Aggregate statistics of the run
+ */
+Statistics BatchParser::BatchParser::run(const std::vector<std::string> &pathList,
+                                         const size_t workerCount,
+                                         AbstractResultHandler *resultHandler)
+{
+    Statistics statistics;
+    const uint64_t startTime = monotonicTimeUs();
+    size_t count = workerCount;
+
+    if (count == 0U)
+    {
+        count = 1U;
+    }
+
+    if (count > pathList.size())
+    {
+        count = (pathList.empty() ? 1U : pathList.size());
+    }
+
+    m_pathList = &pathList;
+    m_resultHandler = resultHandler;
+
+    // Create the workers and split the files into contiguous blocks, one block per worker
+    for (size_t i = 0U; i < count; i++)
+    {
+        Worker *worker = new Worker();
+        worker->owner = this;
+        worker->index = i;
+
+        const size_t first = (pathList.size() * i) / count;
+        const size_t last = (pathList.size() * (i + 1U)) / count;
+
+        for (size_t fileIndex = first; fileIndex < last; fileIndex++)
+        {
+            worker->queue.push_back(fileIndex);
+        }
+
+        m_workerList.push_back(worker);
+    }
+
+    // Run the workers
+    for (size_t i = 0U; i < m_workerList.size(); i++)
+    {
+        pthread_create(&(m_workerList[i]->thread), NULL, &executeWorker, m_workerList[i]);
+    }
+
+    for (size_t i = 0U; i < m_workerList.size(); i++)
+    {
+        Worker *worker = m_workerList[i];
+        pthread_join(worker->thread, NULL);
+
+        statistics.fileCount += worker->statistics.fileCount;
+        statistics.successCount += worker->statistics.successCount;
+        statistics.failureCount += worker->statistics.failureCount;
+        statistics.stolenCount += worker->statistics.stolenCount;
+        statistics.byteCount += worker->statistics.byteCount;
+        statistics.eventCount += worker->statistics.eventCount;
+        statistics.parsingTimeUs += worker->statistics.parsingTimeUs;
+
+        pthread_mutex_destroy(&(worker->queueMutex));
+        delete worker;
+    }
+
+    m_workerList.clear();
+    m_pathList = NULL;
+    m_resultHandler = NULL;
+
+    statistics.wallTimeUs = monotonicTimeUs() - startTime;
+    return statistics;
+}
+
+/**
+ * Worker thread's main loop
+ *
+ * \param worker    Pointer to the worker
+ *
+ * \return NULL
+ */
+void *BatchParser::BatchParser::executeWorker(void *worker)
+{
+    Worker *self = static_cast<Worker *>(worker);
+    BatchParser *owner = self->owner;
+    size_t fileIndex = 0U;
+
+    while (owner->takeFile(self, &fileIndex) || owner->stealFile(self, &fileIndex))
+    {
+        const FileResult result = owner->parseFile(self, owner->m_pathList->at(fileIndex));
+
+        self->statistics.fileCount++;
+        self->statistics.byteCount += result.byteCount;
+        self->statistics.eventCount += result.eventCount;
+        self->statistics.parsingTimeUs += result.durationUs;
+
+        if (result.status == FileResult::Status_Success)
+        {
+            self->statistics.successCount++;
+        }
+        else
+        {
+            self->statistics.failureCount++;
+        }
+
+        owner->reportResult(result);
+    }
+
+    return NULL;
+}
+
+/**
+ * Take the next file from the worker's own queue
+ *
+ * \param worker    Worker
+ * \param fileIndex Output for the index of the file
+ *
+ * \retval true     File taken
+ * \retval false    Worker's queue is empty
+ */
+bool BatchParser::BatchParser::takeFile(Worker *worker, size_t *fileIndex)
+{
+    bool success = false;
+
+    pthread_mutex_lock(&(worker->queueMutex));
+
+    if (!worker->queue.empty())
+    {
+        *fileIndex = worker->queue.front();
+        worker->queue.pop_front();
+        success = true;
+    }
+
+    pthread_mutex_unlock(&(worker->queueMutex));
+
+    return success;
+}
+
+/**
+ * Steal a file from the back of another worker's queue
+ *
+ * \param worker    Worker that is stealing
+ * \param fileIndex Output for the index of the file
+ *
+ * \retval true     File stolen
+ * \retval false    All queues are empty
+ */
+bool BatchParser::BatchParser::stealFile(Worker *worker, size_t *fileIndex)
+{
+    bool success = false;
+
+    for (size_t i = 1U; (i < m_workerList.size()) && !success; i++)
+    {
+        Worker *victim = m_workerList[(worker->index + i) % m_workerList.size()];
+
+        pthread_mutex_lock(&(victim->queueMutex));
+
+        if (!victim->queue.empty())
+        {
+            *fileIndex = victim->queue.back();
+            victim->queue.pop_back();
+            success = true;
+        }
+
+        pthread_mutex_unlock(&(victim->queueMutex));
+    }
+
+    if (success)
+    {
+        worker->statistics.stolenCount++;
+    }
+
+    return success;
+}
+
+/**
+ * Parse a single file with the worker's XML reader
+ *
+ * \param worker    Worker
+ * \param path      Path to the file
+ *
+ * \return Result of parsing
+ */
+FileResult BatchParser::BatchParser::parseFile(Worker *worker, const std::string &path)
+{
+    FileResult result;
+    result.path = path;
+    result.workerIndex = worker->index;
+
+    const uint64_t startTime = monotonicTimeUs();
+    const int fd = open(path.c_str(), O_RDONLY);
+    struct stat fileStat;
+
+    if ((fd >= 0) && (fstat(fd, &fileStat) == 0))
+    {
+        const size_t size = static_cast<size_t>(fileStat.st_size);
+        void *data = NULL;
+
+        if (size > 0U)
+        {
+            data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (data == MAP_FAILED)
+            {
+                data = NULL;
+            }
+            else
+            {
+                madvise(data, size, MADV_SEQUENTIAL);
+            }
+        }
+
+        if ((size == 0U) || (data != NULL))
+        {
+            // The mapped file is fed to the reader in chunks so that the reader's buffer stays
+            // small, the parsed data is erased from the front of the buffer after each token
+            const char *chunk = static_cast<const char *>(data);
+            size_t remainingSize = size;
+            XmlReader &xmlReader = worker->xmlReader;
+            xmlReader.clear();
+            result.byteCount = size;
+            result.status = FileResult::Status_Incomplete;
+
+            bool finished = false;
+            bool rootElementClosed = false;
+            size_t depth = 0U;
+
+            while (!finished)
+            {
+                switch (xmlReader.parse())
+                {
+                    case XmlReader::ParsingResult_NeedMoreData:
+                    {
+                        if (remainingSize == 0U)
+                        {
+                            // End of file, the root element must be closed for success
+                            if (rootElementClosed)
+                            {
+                                result.status = FileResult::Status_Success;
+                            }
+
+                            finished = true;
+                        }
+                        else
+                        {
+                            size_t chunkSize = remainingSize;
+
+                            if (chunkSize > ChunkSize)
+                            {
+                                chunkSize = ChunkSize;
+                            }
+
+                            if (xmlReader.writeData(chunk, chunkSize) != chunkSize)
+                            {
+                                // Error
+                                result.status = FileResult::Status_InvalidEncoding;
+                                finished = true;
+                            }
+
+                            chunk += chunkSize;
+                            remainingSize -= chunkSize;
+                        }
+                        break;
+                    }
+
+                    case XmlReader::ParsingResult_StartOfElement:
+                    {
+                        depth++;
+                        result.eventCount++;
+                        break;
+                    }
+
+                    case XmlReader::ParsingResult_EndOfElement:
+                    {
+                        depth--;
+                        result.eventCount++;
+
+                        if (depth == 0U)
+                        {
+                            rootElementClosed = true;
+                        }
+                        break;
+                    }
+
+                    case XmlReader::ParsingResult_XmlDeclaration:
+                    case XmlReader::ParsingResult_ProcessingInstruction:
+                    case XmlReader::ParsingResult_DocumentType:
+                    case XmlReader::ParsingResult_Comment:
+                    case XmlReader::ParsingResult_TextNode:
+                    case XmlReader::ParsingResult_CData:
+                    {
+                        result.eventCount++;
+                        break;
+                    }
+
+                    default:
+                    {
+                        // Error
+                        result.status = FileResult::Status_ParsingError;
+                        result.errorOffset = xmlReader.byteOffset();
+                        xmlReader.location(&result.errorLine, &result.errorColumn);
+                        finished = true;
+                        break;
+                    }
+                }
+            }
+
+            if (data != NULL)
+            {
+                munmap(data, size);
+            }
+        }
+    }
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+
+    result.durationUs = monotonicTimeUs() - startTime;
+    return result;
+}
+
+/**
+ * Pass the result to the result handler
+ *
+ * \param result    Result of parsing a file
+ */
+void BatchParser::BatchParser::reportResult(const FileResult &result)
+{
+    if (m_resultHandler != NULL)
+    {
+        pthread_mutex_lock(&m_resultMutex);
+        m_resultHandler->fileParsed(result);
+        pthread_mutex_unlock(&m_resultMutex);
+    }
+}
+
+/**
+ * Get monotonic time
+ *
+ * \return Monotonic time in microseconds
+ */
+uint64_t BatchParser::monotonicTimeUs()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (static_cast<uint64_t>(time.tv_sec) * 1000000U) +
+           (static_cast<uint64_t>(time.tv_nsec) / 1000U);
+}
@@ -0,0 +1,153 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#ifndef EMBEDDEDSTAX_BATCHPARSER_BATCHPARSER_H
+#define EMBEDDEDSTAX_BATCHPARSER_BATCHPARSER_H
+
+#include <EmbeddedStAX/XmlReader/XmlReader.h>
+#include <deque>
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include <stdint.h>
+
+namespace BatchParser
+{
+/**
+ * Result of parsing a single file
+ */
+struct FileResult
+{
+    // Public types
+    enum Status
+    {
+        Status_Success,
+        Status_OpenFailed,
+        Status_InvalidEncoding,
+        Status_ParsingError,
+        Status_Incomplete
+    };
+
+    FileResult();
+
+    std::string path;
+    Status status;
+    uint64_t byteCount;
+    uint64_t eventCount;
+    uint64_t durationUs;
+    size_t workerIndex;
+    uint64_t errorOffset;
+    size_t errorLine;
+    size_t errorColumn;
+};
+
+/**
+ * Aggregate statistics of a batch run
+ */
+struct Statistics
+{
+    Statistics();
+
+    size_t fileCount;
+    size_t successCount;
+    size_t failureCount;
+    size_t stolenCount;
+    uint64_t byteCount;
+    uint64_t eventCount;
+    uint64_t parsingTimeUs;
+    uint64_t wallTimeUs;
+};
+
+/**
+ * Interface for receiving the per-file results while the batch is running
+ *
+ * \note Calls are serialized by the batch parser, but they are made from the worker threads.
+ */
+class AbstractResultHandler
+{
+public:
+    virtual ~AbstractResultHandler() = 0;
+    virtual void fileParsed(const FileResult &result) = 0;
+};
+
+/**
+ * Batch parser distributes a list of XML files over a pool of worker threads
+ *
+ * Every worker owns a queue of files and a XmlReader that is reused for all the files it parses.
+ * When a worker runs out of files it steals files from the back of the other workers' queues, so
+ * the load stays balanced even when file sizes differ a lot.
+ */
+class BatchParser
+{
+public:
+    // Public API
+    BatchParser();
+    ~BatchParser();
+
+    Statistics run(const std::vector<std::string> &pathList,
+                   const size_t workerCount,
+                   AbstractResultHandler *resultHandler = NULL);
+
+private:
+    // Private types
+    struct Worker
+    {
+        Worker();
+
+        BatchParser *owner;
+        size_t index;
+        pthread_t thread;
+        pthread_mutex_t queueMutex;
+        std::deque<size_t> queue;
+        EmbeddedStAX::XmlReader::XmlReader xmlReader;
+        Statistics statistics;
+    };
+
+private:
+    // Private API
+    static void *executeWorker(void *worker);
+    bool takeFile(Worker *worker, size_t *fileIndex);
+    bool stealFile(Worker *worker, size_t *fileIndex);
+    FileResult parseFile(Worker *worker, const std::string &path);
+    void reportResult(const FileResult &result);
+
+    // Disabled copying
+    BatchParser(const BatchParser &);
+    BatchParser &operator=(const BatchParser &);
+
+private:
+    // Private data
+    const std::vector<std::string> *m_pathList;
+    std::vector<Worker *> m_workerList;
+    AbstractResultHandler *m_resultHandler;
+    pthread_mutex_t m_resultMutex;
+};
+
+uint64_t monotonicTimeUs();
+}
+
+#endif // EMBEDDEDSTAX_BATCHPARSER_BATCHPARSER_H
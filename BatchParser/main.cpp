@@ -0,0 +1,288 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include "BatchParser.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * Result handler that prints the failed files (and optionally all files)
+ */
+class ConsoleResultHandler : public BatchParser::AbstractResultHandler
+{
+public:
+    explicit ConsoleResultHandler(const bool verbose)
+        : m_verbose(verbose)
+    {
+    }
+
+    void fileParsed(const BatchParser::FileResult &result)
+    {
+        if (m_verbose || (result.status != BatchParser::FileResult::Status_Success))
+        {
+            std::cout << statusToString(result.status) << ": " << result.path;
+
+            if (result.status == BatchParser::FileResult::Status_ParsingError)
+            {
+                std::cout << ":" << result.errorLine << ":" << result.errorColumn
+                          << " (byte " << result.errorOffset << ")";
+            }
+
+            std::cout << " (bytes: " << result.byteCount
+                      << ", events: " << result.eventCount
+                      << ", time: " << result.durationUs << " us"
+                      << ", worker: " << result.workerIndex << ")" << std::endl;
+        }
+    }
+
+private:
+    static const char *statusToString(const BatchParser::FileResult::Status status)
+    {
+        const char *text = "UNKNOWN";
+
+        switch (status)
+        {
+            case BatchParser::FileResult::Status_Success:
+            {
+                text = "OK";
+                break;
+            }
+
+            case BatchParser::FileResult::Status_OpenFailed:
+            {
+                text = "OPEN FAILED";
+                break;
+            }
+
+            case BatchParser::FileResult::Status_InvalidEncoding:
+            {
+                text = "INVALID ENCODING";
+                break;
+            }
+
+            case BatchParser::FileResult::Status_ParsingError:
+            {
+                text = "PARSING ERROR";
+                break;
+            }
+
+            case BatchParser::FileResult::Status_Incomplete:
+            {
+                text = "INCOMPLETE";
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
+        }
+
+        return text;
+    }
+
+    bool m_verbose;
+};
+
+/**
+ * Check if the path ends with the ".xml" extension
+ */
+static bool hasXmlExtension(const std::string &path)
+{
+    bool success = false;
+
+    if (path.size() >= 4U)
+    {
+        success = (path.compare(path.size() - 4U, 4U, ".xml") == 0);
+    }
+
+    return success;
+}
+
+/**
+ * Add the file or (recursively) all XML files in the directory to the path list
+ */
+static void collectPaths(const std::string &path, std::vector<std::string> *pathList)
+{
+    struct stat pathStat;
+
+    if (stat(path.c_str(), &pathStat) == 0)
+    {
+        if (S_ISDIR(pathStat.st_mode))
+        {
+            DIR *directory = opendir(path.c_str());
+
+            if (directory != NULL)
+            {
+                struct dirent *entry = readdir(directory);
+
+                while (entry != NULL)
+                {
+                    const std::string name(entry->d_name);
+
+                    if ((name != ".") && (name != ".."))
+                    {
+                        const std::string entryPath = path + "/" + name;
+                        struct stat entryStat;
+
+                        if (stat(entryPath.c_str(), &entryStat) == 0)
+                        {
+                            if (S_ISDIR(entryStat.st_mode))
+                            {
+                                collectPaths(entryPath, pathList);
+                            }
+                            else if (hasXmlExtension(name))
+                            {
+                                pathList->push_back(entryPath);
+                            }
+                            else
+                            {
+                                // Skip files that are not XML files
+                            }
+                        }
+                    }
+
+                    entry = readdir(directory);
+                }
+
+                closedir(directory);
+            }
+        }
+        else
+        {
+            // Files given explicitly are always parsed
+            pathList->push_back(path);
+        }
+    }
+    else
+    {
+        std::cerr << "Path not found: " << path << std::endl;
+    }
+}
+
+static void printUsage(const char *program)
+{
+    std::cerr << "Usage: " << program << " [-j <workers>] [-v] <file|directory>..." << std::endl
+              << std::endl
+              << "  -j <workers>  Number of worker threads (default: number of CPUs)" << std::endl
+              << "  -v            Print the result of every file, not only the failed ones"
+              << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    int exitCode = EXIT_SUCCESS;
+    long workerCount = sysconf(_SC_NPROCESSORS_ONLN);
+    bool verbose = false;
+    bool validArguments = true;
+    std::vector<std::string> pathList;
+
+    for (int i = 1; (i < argc) && validArguments; i++)
+    {
+        if (std::strcmp(argv[i], "-j") == 0)
+        {
+            if ((i + 1) < argc)
+            {
+                i++;
+                workerCount = std::strtol(argv[i], NULL, 10);
+
+                if (workerCount <= 0)
+                {
+                    // Error
+                    validArguments = false;
+                }
+            }
+            else
+            {
+                // Error
+                validArguments = false;
+            }
+        }
+        else if (std::strcmp(argv[i], "-v") == 0)
+        {
+            verbose = true;
+        }
+        else
+        {
+            collectPaths(argv[i], &pathList);
+        }
+    }
+
+    if (!validArguments || pathList.empty())
+    {
+        printUsage(argv[0]);
+        exitCode = EXIT_FAILURE;
+    }
+    else
+    {
+        // Sorted order keeps the contiguous blocks of the workers stable between the runs
+        std::sort(pathList.begin(), pathList.end());
+
+        if (workerCount <= 0)
+        {
+            workerCount = 1;
+        }
+
+        ConsoleResultHandler resultHandler(verbose);
+        BatchParser::BatchParser batchParser;
+        const BatchParser::Statistics statistics =
+                batchParser.run(pathList, static_cast<size_t>(workerCount), &resultHandler);
+
+        double wallTime = static_cast<double>(statistics.wallTimeUs) / 1000000.0;
+
+        if (wallTime <= 0.0)
+        {
+            wallTime = 0.000001;
+        }
+
+        std::cout << std::endl
+                  << "Files:      " << statistics.fileCount
+                  << " (OK: " << statistics.successCount
+                  << ", failed: " << statistics.failureCount
+                  << ", stolen: " << statistics.stolenCount << ")" << std::endl
+                  << "Bytes:      " << statistics.byteCount << std::endl
+                  << "Events:     " << statistics.eventCount << std::endl
+                  << "Wall time:  " << statistics.wallTimeUs << " us" << std::endl
+                  << "Throughput: "
+                  << (static_cast<double>(statistics.byteCount) / (1024.0 * 1024.0) / wallTime)
+                  << " MB/s, "
+                  << (static_cast<double>(statistics.fileCount) / wallTime) << " files/s"
+                  << std::endl;
+
+        if (statistics.failureCount > 0U)
+        {
+            exitCode = EXIT_FAILURE;
+        }
+    }
+
+    return exitCode;
+}
@@ -0,0 +1,286 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include "PerfCounters.h"
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace Benchmark;
+
+#ifdef __linux__
+/**
+ * Open a single counter
+ *
+ * \param type      Counter type
+ * \param config    Counter configuration
+ *
+ * \return File descriptor of the counter or -1 if the counter is not available
+ */
+static int openCounter(const uint32_t type, const uint64_t config)
+{
+    struct perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = type;
+    attributes.config = config;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+}
+
+/**
+ * Create the configuration of a hardware cache counter
+ */
+static uint64_t cacheConfig(const uint64_t cache, const uint64_t operation, const uint64_t result)
+{
+    return (cache | (operation << 8) | (result << 16));
+}
+#endif
+
+/**
+ * Constructor
+ */
+PerfCounters::PerfCounters()
+{
+    for (size_t i = 0U; i < Counter_Count; i++)
+    {
+        m_fileDescriptor[i] = -1;
+        m_value[i] = 0U;
+    }
+}
+
+/**
+ * Destructor
+ */
+PerfCounters::~PerfCounters()
+{
+    close();
+}
+
+/**
+ * Open the counters
+ *
+ * \retval true     At least one counter is available
+ * \retval false    No counter is available
+ */
+bool PerfCounters::open()
+{
+    close();
+
+#ifdef __linux__
+    m_fileDescriptor[Counter_Cycles] = openCounter(PERF_TYPE_HARDWARE,
+                                                   PERF_COUNT_HW_CPU_CYCLES);
+    m_fileDescriptor[Counter_Instructions] = openCounter(PERF_TYPE_HARDWARE,
+                                                         PERF_COUNT_HW_INSTRUCTIONS);
+    m_fileDescriptor[Counter_BranchMisses] = openCounter(PERF_TYPE_HARDWARE,
+                                                         PERF_COUNT_HW_BRANCH_MISSES);
+    m_fileDescriptor[Counter_L1DataMisses] =
+            openCounter(PERF_TYPE_HW_CACHE,
+                        cacheConfig(PERF_COUNT_HW_CACHE_L1D,
+                                    PERF_COUNT_HW_CACHE_OP_READ,
+                                    PERF_COUNT_HW_CACHE_RESULT_MISS));
+    m_fileDescriptor[Counter_LastLevelCacheMisses] = openCounter(PERF_TYPE_HARDWARE,
+                                                                 PERF_COUNT_HW_CACHE_MISSES);
+#endif
+
+    return isOpen();
+}
+
+/**
+ * Close the counters
+ */
+void PerfCounters::close()
+{
+    for (size_t i = 0U; i < Counter_Count; i++)
+    {
+#ifdef __linux__
+        if (m_fileDescriptor[i] >= 0)
+        {
+            ::close(m_fileDescriptor[i]);
+        }
+#endif
+
+        m_fileDescriptor[i] = -1;
+        m_value[i] = 0U;
+    }
+}
+
+/**
+ * Check if at least one counter is available
+ */
+bool PerfCounters::isOpen() const
+{
+    bool success = false;
+
+    for (size_t i = 0U; (i < Counter_Count) && !success; i++)
+    {
+        success = (m_fileDescriptor[i] >= 0);
+    }
+
+    return success;
+}
+
+/**
+ * Reset and start the counters
+ */
+void PerfCounters::start()
+{
+    for (size_t i = 0U; i < Counter_Count; i++)
+    {
+        m_value[i] = 0U;
+
+#ifdef __linux__
+        if (m_fileDescriptor[i] >= 0)
+        {
+            ioctl(m_fileDescriptor[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(m_fileDescriptor[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+}
+
+/**
+ * Stop the counters and read their values
+ *
+ * \note If the kernel had to multiplex the counters then the values are scaled to the full
+ *       measurement time.
+ */
+void PerfCounters::stop()
+{
+    for (size_t i = 0U; i < Counter_Count; i++)
+    {
+#ifdef __linux__
+        if (m_fileDescriptor[i] >= 0)
+        {
+            uint64_t data[3] = {0U, 0U, 0U};
+            ioctl(m_fileDescriptor[i], PERF_EVENT_IOC_DISABLE, 0);
+
+            if (read(m_fileDescriptor[i], data, sizeof(data)) == static_cast<ssize_t>(sizeof(data)))
+            {
+                if ((data[2] > 0U) && (data[2] < data[1]))
+                {
+                    // Counter was multiplexed
+                    m_value[i] = static_cast<uint64_t>(static_cast<double>(data[0]) *
+                                                       static_cast<double>(data[1]) /
+                                                       static_cast<double>(data[2]));
+                }
+                else
+                {
+                    m_value[i] = data[0];
+                }
+            }
+        }
+#endif
+    }
+}
+
+/**
+ * Check if the counter is available
+ */
+bool PerfCounters::isAvailable(const Counter counter) const
+{
+    bool available = false;
+
+    if (counter < Counter_Count)
+    {
+        available = (m_fileDescriptor[counter] >= 0);
+    }
+
+    return available;
+}
+
+/**
+ * Get value of the counter from the last measurement
+ */
+uint64_t PerfCounters::value(const Counter counter) const
+{
+    uint64_t value = 0U;
+
+    if (counter < Counter_Count)
+    {
+        value = m_value[counter];
+    }
+
+    return value;
+}
+
+/**
+ * Get name of the counter
+ */
+const char *PerfCounters::counterName(const Counter counter)
+{
+    const char *name = "unknown";
+
+    switch (counter)
+    {
+        case Counter_Cycles:
+        {
+            name = "cycles";
+            break;
+        }
+
+        case Counter_Instructions:
+        {
+            name = "instructions";
+            break;
+        }
+
+        case Counter_BranchMisses:
+        {
+            name = "branch-misses";
+            break;
+        }
+
+        case Counter_L1DataMisses:
+        {
+            name = "L1D-misses";
+            break;
+        }
+
+        case Counter_LastLevelCacheMisses:
+        {
+            name = "LLC-misses";
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+    return name;
+}
@@ -0,0 +1,86 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#ifndef EMBEDDEDSTAX_BENCHMARK_PERFCOUNTERS_H
+#define EMBEDDEDSTAX_BENCHMARK_PERFCOUNTERS_H
+
+#include <cstddef>
+#include <stdint.h>
+
+namespace Benchmark
+{
+/**
+ * Hardware performance counters of the calling thread
+ *
+ * On Linux the counters are read with perf_event_open() (user space only, so it also works with
+ * perf_event_paranoid set to 2). Counters that are not supported by the CPU, the kernel or the
+ * virtual machine are reported as unavailable. On other platforms all counters are unavailable.
+ */
+class PerfCounters
+{
+public:
+    // Public types
+    enum Counter
+    {
+        Counter_Cycles,
+        Counter_Instructions,
+        Counter_BranchMisses,
+        Counter_L1DataMisses,
+        Counter_LastLevelCacheMisses,
+        Counter_Count
+    };
+
+public:
+    // Public API
+    PerfCounters();
+    ~PerfCounters();
+
+    bool open();
+    void close();
+    bool isOpen() const;
+
+    void start();
+    void stop();
+
+    bool isAvailable(const Counter counter) const;
+    uint64_t value(const Counter counter) const;
+
+    static const char *counterName(const Counter counter);
+
+private:
+    // Disabled copying
+    PerfCounters(const PerfCounters &);
+    PerfCounters &operator=(const PerfCounters &);
+
+private:
+    // Private data
+    int m_fileDescriptor[Counter_Count];
+    uint64_t m_value[Counter_Count];
+};
+}
+
+#endif // EMBEDDEDSTAX_BENCHMARK_PERFCOUNTERS_H
@@ -0,0 +1,205 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include "Workload.h"
+#include <sstream>
+
+using namespace Benchmark;
+
+/**
+ * Generate a document with a root element and repeated content, up to the selected size
+ *
+ * \param content   Content that is repeated inside the root element
+ * \param size      Approximate size of the document (in bytes)
+ *
+ * \return Document
+ */
+static std::string repeatContent(const std::string &content, const size_t size)
+{
+    std::string document("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<root>\n");
+    document.reserve(size + content.size() + 16U);
+
+    while (document.size() < size)
+    {
+        document.append(content);
+    }
+
+    document.append("</root>\n");
+    return document;
+}
+
+static std::string generateText(const size_t size)
+{
+    return repeatContent("  <p>Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod "
+                         "tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim "
+                         "veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea "
+                         "commodo consequat.</p>\n",
+                         size);
+}
+
+static std::string generateNames(const size_t size)
+{
+    return repeatContent("  <transactionRecord><accountIdentifier/><transactionTimestamp/>"
+                         "<counterpartyReference/><settlementCurrency/><instructedAmount/>"
+                         "</transactionRecord>\n",
+                         size);
+}
+
+static std::string generateAttributes(const size_t size)
+{
+    return repeatContent("  <item id=\"12345\" type=\"product\" name=\"Widget\" price=\"19.99\" "
+                         "currency='EUR' available=\"true\" category=\"tools\"/>\n",
+                         size);
+}
+
+static std::string generateReferences(const size_t size)
+{
+    return repeatContent("  <r>a &lt; b &amp;&amp; c &gt; d &quot;e&quot; &apos;f&apos; "
+                         "&#65;&#66;&#x43;&#x44;</r>\n",
+                         size);
+}
+
+static std::string generateCData(const size_t size)
+{
+    return repeatContent("  <code><![CDATA[if (a < b && c > d) { return x[y[0]]; }]]></code>\n",
+                         size);
+}
+
+static std::string generateComments(const size_t size)
+{
+    return repeatContent("  <!-- This is a comment that describes the next element in detail -->"
+                         "<e/>\n",
+                         size);
+}
+
+static std::string generateUnicodeText(const size_t size)
+{
+    return repeatContent("  <p>Größenordnung, café, naïve, Ελληνικά, Русский текст, "
+                         "日本語のテキスト, 中文文本, emoji \xF0\x9F\x98\x80\xF0\x9F\x8E\x89</p>\n",
+                         size);
+}
+
+static std::string generateMixed(const size_t size)
+{
+    std::ostringstream content;
+    content << "  <order id=\"1001\" status='open'>\n"
+            << "    <!-- customer data -->\n"
+            << "    <customer name=\"Jane &amp; John Doe\" country=\"AT\"/>\n"
+            << "    <line sku=\"A-100\" quantity=\"2\">Ergonomic keyboard</line>\n"
+            << "    <line sku=\"B-200\" quantity=\"1\">Monitor 27&quot; &#x2013; IPS</line>\n"
+            << "    <note><![CDATA[Deliver between 8:00 & 12:00 <weekdays>]]></note>\n"
+            << "    <?audit checked?>\n"
+            << "  </order>\n";
+
+    return repeatContent(content.str(), size);
+}
+
+/**
+ * Generate a record with nested elements, indented with the selected indentation per level (or
+ * minified if the indentation is empty)
+ */
+static std::string generateRecord(const std::string &indentation)
+{
+    const std::string newLine(indentation.empty() ? "" : "\n");
+    std::string levels[5];
+
+    for (size_t i = 1U; i < 5U; i++)
+    {
+        levels[i] = levels[i - 1U] + indentation;
+    }
+
+    return levels[1] + "<record>" + newLine +
+           levels[2] + "<header>" + newLine +
+           levels[3] + "<id>42</id>" + newLine +
+           levels[3] + "<created>2024-01-01</created>" + newLine +
+           levels[2] + "</header>" + newLine +
+           levels[2] + "<items>" + newLine +
+           levels[3] + "<item>" + newLine +
+           levels[4] + "<sku>A-100</sku>" + newLine +
+           levels[4] + "<quantity>2</quantity>" + newLine +
+           levels[3] + "</item>" + newLine +
+           levels[3] + "<item>" + newLine +
+           levels[4] + "<sku>B-200</sku>" + newLine +
+           levels[4] + "<quantity>1</quantity>" + newLine +
+           levels[3] + "</item>" + newLine +
+           levels[2] + "</items>" + newLine +
+           levels[1] + "</record>" + newLine;
+}
+
+static std::string generateIndented(const size_t size)
+{
+    return repeatContent(generateRecord("    "), size);
+}
+
+static std::string generateMinified(const size_t size)
+{
+    return repeatContent(generateRecord(""), size);
+}
+
+static const Workload s_workloadList[] =
+{
+    {"text",        "Long text nodes (TextNodeParser)",             Workload::Kind_Parse,
+     &generateText},
+    {"names",       "Many elements with long names (NameParser)",   Workload::Kind_Parse,
+     &generateNames},
+    {"attributes",  "Elements with many attributes",                Workload::Kind_Parse,
+     &generateAttributes},
+    {"references",  "Entity and character references",             Workload::Kind_Parse,
+     &generateReferences},
+    {"cdata",       "CDATA sections",                               Workload::Kind_Parse,
+     &generateCData},
+    {"comments",    "Comments",                                     Workload::Kind_Parse,
+     &generateComments},
+    {"unicode",     "Text with multi-byte UTF-8 characters",        Workload::Kind_Parse,
+     &generateUnicodeText},
+    {"mixed",       "Typical document with all kinds of tokens",    Workload::Kind_Parse,
+     &generateMixed},
+    {"indented",    "Pretty-printed records (whitespace between tags)", Workload::Kind_Parse,
+     &generateIndented},
+    {"minified",    "Same records as \"indented\" without whitespace", Workload::Kind_Parse,
+     &generateMinified},
+    {"utf8-decode", "UTF-8 decoding only (Utf8, ParsingBuffer)",    Workload::Kind_Decode,
+     &generateUnicodeText}
+};
+
+/**
+ * Get the number of workloads
+ */
+size_t Benchmark::workloadCount()
+{
+    return (sizeof(s_workloadList) / sizeof(s_workloadList[0]));
+}
+
+/**
+ * Get the workload
+ *
+ * \param index Index of the workload (must be less than workloadCount())
+ */
+const Workload &Benchmark::workload(const size_t index)
+{
+    return s_workloadList[index];
+}
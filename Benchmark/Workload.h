@@ -0,0 +1,60 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#ifndef EMBEDDEDSTAX_BENCHMARK_WORKLOAD_H
+#define EMBEDDEDSTAX_BENCHMARK_WORKLOAD_H
+
+#include <cstddef>
+#include <string>
+
+namespace Benchmark
+{
+/**
+ * Benchmark workload: a generated document and the way it is processed
+ */
+struct Workload
+{
+    // Public types
+    enum Kind
+    {
+        Kind_Parse,     /**< Document is written to a XmlReader and parsed */
+        Kind_Decode     /**< Document is only decoded from UTF-8 (written to a ParsingBuffer) */
+    };
+
+    typedef std::string (*Generator)(const size_t size);
+
+    const char *name;
+    const char *description;
+    Kind kind;
+    Generator generator;
+};
+
+size_t workloadCount();
+const Workload &workload(const size_t index);
+}
+
+#endif // EMBEDDEDSTAX_BENCHMARK_WORKLOAD_H
@@ -0,0 +1,413 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include "PerfCounters.h"
+#include "Workload.h"
+#include <EmbeddedStAX/XmlReader/XmlReader.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+using namespace Benchmark;
+using namespace EmbeddedStAX;
+
+/**
+ * Result of a single run of a workload
+ */
+struct RunResult
+{
+    double time;
+    size_t eventCount;
+    bool success;
+};
+
+/**
+ * Settings of the XML reader used by the parse workloads
+ */
+struct ReaderSettings
+{
+    uint32_t eventMask;
+    XmlReader::XmlReader::ValidationMode validationMode;
+    size_t sampleInterval;
+    size_t attributeValueCacheCapacity;
+    size_t shapePredictorCapacity;
+    size_t parseBudget;
+    bool textCoalescing;
+};
+
+static double monotonicTime()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (static_cast<double>(time.tv_sec) + (static_cast<double>(time.tv_nsec) / 1.0e9));
+}
+
+/**
+ * Run the workload once
+ */
+static RunResult runWorkload(const Workload &workload,
+                             const std::string &document,
+                             const ReaderSettings &readerSettings,
+                             PerfCounters *perfCounters)
+{
+    RunResult result;
+    result.eventCount = 0U;
+    result.success = true;
+
+    if (workload.kind == Workload::Kind_Decode)
+    {
+        XmlReader::ParsingBuffer parsingBuffer;
+
+        const double startTime = monotonicTime();
+        perfCounters->start();
+
+        result.success = (parsingBuffer.writeData(document) == document.size());
+
+        perfCounters->stop();
+        result.time = monotonicTime() - startTime;
+    }
+    else
+    {
+        XmlReader::XmlReader xmlReader;
+        xmlReader.setEventMask(readerSettings.eventMask);
+        xmlReader.setValidationMode(readerSettings.validationMode, readerSettings.sampleInterval);
+        xmlReader.setAttributeValueCache(readerSettings.attributeValueCacheCapacity);
+        xmlReader.setShapePrediction(readerSettings.shapePredictorCapacity);
+        xmlReader.setTextCoalescingEnabled(readerSettings.textCoalescing);
+        bool finished = false;
+
+        const double startTime = monotonicTime();
+        perfCounters->start();
+
+        xmlReader.writeData(document);
+
+        while (!finished)
+        {
+            XmlReader::XmlReader::ParsingResult parsingResult =
+                    XmlReader::XmlReader::ParsingResult_None;
+
+            if (readerSettings.parseBudget == 0U)
+            {
+                parsingResult = xmlReader.parse();
+            }
+            else
+            {
+                parsingResult = xmlReader.parse(readerSettings.parseBudget);
+            }
+
+            switch (parsingResult)
+            {
+                case XmlReader::XmlReader::ParsingResult_Yield:
+                {
+                    // Budget was used up, continue parsing
+                    break;
+                }
+
+                case XmlReader::XmlReader::ParsingResult_NeedMoreData:
+                {
+                    finished = true;
+                    break;
+                }
+
+                case XmlReader::XmlReader::ParsingResult_Error:
+                {
+                    // Error
+                    result.success = false;
+                    finished = true;
+                    break;
+                }
+
+                default:
+                {
+                    result.eventCount++;
+                    break;
+                }
+            }
+        }
+
+        perfCounters->stop();
+        result.time = monotonicTime() - startTime;
+    }
+
+    return result;
+}
+
+/**
+ * Print a counter value per kilobyte of the document, or "n/a" if the counter is not available
+ */
+static void printPerKilobyte(const PerfCounters &perfCounters,
+                             const PerfCounters::Counter counter,
+                             const double kilobytes)
+{
+    if (perfCounters.isAvailable(counter))
+    {
+        std::printf(" %10.2f", static_cast<double>(perfCounters.value(counter)) / kilobytes);
+    }
+    else
+    {
+        std::printf(" %10s", "n/a");
+    }
+}
+
+static void printUsage(const char *program)
+{
+    std::fprintf(stderr,
+                 "Usage: %s [-s <size in KB>] [-r <runs>] [-c] [-m] [-t | -p <n>] [-i <n>] [-k <n>] [-b <n>] [-x] [-l] [workload...]\n"
+                 "\n"
+                 "  -s <size>  Size of the generated documents in KB (default: 1024)\n"
+                 "  -r <runs>  Number of runs per workload, the best run is reported (default: 5)\n"
+                 "  -c         Read hardware performance counters (Linux perf_event_open)\n"
+                 "  -m         Mask comments, processing instructions, XML declaration and\n"
+                 "             whitespace-only text\n"
+                 "  -t         Trusted input, skip character validation\n"
+                 "  -p <n>     Trusted input, but fully validate every n-th token\n"
+                 "  -i <n>     Intern attribute values in a cache with n entries\n"
+                 "  -k <n>     Predict element and attribute names with a shape predictor with n\n"
+                 "             entries\n"
+                 "  -b <n>     Parse with a budget of n characters per parse() call\n"
+                 "  -x         Coalesce text, references and CDATA into one text node\n"
+                 "  -l         List the workloads\n",
+                 program);
+}
+
+int main(int argc, char **argv)
+{
+    int exitCode = EXIT_SUCCESS;
+    size_t size = 1024U * 1024U;
+    size_t runCount = 5U;
+    bool useCounters = false;
+    ReaderSettings readerSettings = {XmlReader::XmlReader::EventMask_All,
+                                     XmlReader::XmlReader::ValidationMode_Full,
+                                     1U,
+                                     0U,
+                                     0U,
+                                     0U,
+                                     false};
+    bool listWorkloads = false;
+    bool validArguments = true;
+    std::vector<size_t> selectedWorkloads;
+
+    for (int i = 1; (i < argc) && validArguments; i++)
+    {
+        if ((std::strcmp(argv[i], "-s") == 0) && ((i + 1) < argc))
+        {
+            i++;
+            size = static_cast<size_t>(std::strtoul(argv[i], NULL, 10)) * 1024U;
+            validArguments = (size > 0U);
+        }
+        else if ((std::strcmp(argv[i], "-r") == 0) && ((i + 1) < argc))
+        {
+            i++;
+            runCount = static_cast<size_t>(std::strtoul(argv[i], NULL, 10));
+            validArguments = (runCount > 0U);
+        }
+        else if (std::strcmp(argv[i], "-c") == 0)
+        {
+            useCounters = true;
+        }
+        else if (std::strcmp(argv[i], "-m") == 0)
+        {
+            readerSettings.eventMask = XmlReader::XmlReader::EventMask_None;
+        }
+        else if (std::strcmp(argv[i], "-t") == 0)
+        {
+            readerSettings.validationMode = XmlReader::XmlReader::ValidationMode_Trusted;
+        }
+        else if ((std::strcmp(argv[i], "-p") == 0) && ((i + 1) < argc))
+        {
+            i++;
+            readerSettings.validationMode = XmlReader::XmlReader::ValidationMode_Sampled;
+            readerSettings.sampleInterval = static_cast<size_t>(std::strtoul(argv[i], NULL, 10));
+            validArguments = (readerSettings.sampleInterval > 0U);
+        }
+        else if ((std::strcmp(argv[i], "-i") == 0) && ((i + 1) < argc))
+        {
+            i++;
+            readerSettings.attributeValueCacheCapacity =
+                    static_cast<size_t>(std::strtoul(argv[i], NULL, 10));
+        }
+        else if ((std::strcmp(argv[i], "-k") == 0) && ((i + 1) < argc))
+        {
+            i++;
+            readerSettings.shapePredictorCapacity =
+                    static_cast<size_t>(std::strtoul(argv[i], NULL, 10));
+        }
+        else if ((std::strcmp(argv[i], "-b") == 0) && ((i + 1) < argc))
+        {
+            i++;
+            readerSettings.parseBudget = static_cast<size_t>(std::strtoul(argv[i], NULL, 10));
+            validArguments = (readerSettings.parseBudget > 0U);
+        }
+        else if (std::strcmp(argv[i], "-x") == 0)
+        {
+            readerSettings.textCoalescing = true;
+        }
+        else if (std::strcmp(argv[i], "-l") == 0)
+        {
+            listWorkloads = true;
+        }
+        else
+        {
+            bool found = false;
+
+            for (size_t j = 0U; (j < workloadCount()) && !found; j++)
+            {
+                if (std::strcmp(argv[i], workload(j).name) == 0)
+                {
+                    selectedWorkloads.push_back(j);
+                    found = true;
+                }
+            }
+
+            validArguments = found;
+        }
+    }
+
+    if (!validArguments)
+    {
+        printUsage(argv[0]);
+        exitCode = EXIT_FAILURE;
+    }
+    else if (listWorkloads)
+    {
+        for (size_t i = 0U; i < workloadCount(); i++)
+        {
+            std::printf("%-12s %s\n", workload(i).name, workload(i).description);
+        }
+    }
+    else
+    {
+        PerfCounters perfCounters;
+
+        if (selectedWorkloads.empty())
+        {
+            for (size_t i = 0U; i < workloadCount(); i++)
+            {
+                selectedWorkloads.push_back(i);
+            }
+        }
+
+        if (useCounters && !perfCounters.open())
+        {
+            std::fprintf(stderr, "Hardware performance counters are not available\n");
+        }
+
+        std::printf("%-12s %10s %10s %10s", "workload", "MB/s", "events", "time [ms]");
+
+        if (useCounters)
+        {
+            std::printf(" %10s %10s %10s %10s %10s",
+                        "cycles/B", "IPC", "brmiss/KB", "L1Dmiss/KB", "LLCmiss/KB");
+        }
+
+        std::printf("\n");
+
+        for (size_t i = 0U; i < selectedWorkloads.size(); i++)
+        {
+            const Workload &selectedWorkload = workload(selectedWorkloads.at(i));
+            const std::string document = selectedWorkload.generator(size);
+            const double kilobytes = static_cast<double>(document.size()) / 1024.0;
+            RunResult bestResult = {0.0, 0U, false};
+
+            for (size_t run = 0U; run < runCount; run++)
+            {
+                const RunResult result =
+                        runWorkload(selectedWorkload, document, readerSettings, &perfCounters);
+
+                if ((run == 0U) || (result.time < bestResult.time))
+                {
+                    bestResult = result;
+                }
+
+                if (!result.success)
+                {
+                    exitCode = EXIT_FAILURE;
+                }
+            }
+
+            // Counters are read in a separate run so that they do not affect the timing
+            if (perfCounters.isOpen())
+            {
+                runWorkload(selectedWorkload, document, readerSettings, &perfCounters);
+            }
+
+            std::printf("%-12s %10.2f %10lu %10.2f",
+                        selectedWorkload.name,
+                        kilobytes / 1024.0 / bestResult.time,
+                        static_cast<unsigned long>(bestResult.eventCount),
+                        bestResult.time * 1000.0);
+
+            if (useCounters)
+            {
+                if (perfCounters.isAvailable(PerfCounters::Counter_Cycles))
+                {
+                    std::printf(" %10.2f",
+                                static_cast<double>(
+                                    perfCounters.value(PerfCounters::Counter_Cycles)) /
+                                static_cast<double>(document.size()));
+                }
+                else
+                {
+                    std::printf(" %10s", "n/a");
+                }
+
+                if (perfCounters.isAvailable(PerfCounters::Counter_Cycles) &&
+                    perfCounters.isAvailable(PerfCounters::Counter_Instructions) &&
+                    (perfCounters.value(PerfCounters::Counter_Cycles) > 0U))
+                {
+                    std::printf(" %10.2f",
+                                static_cast<double>(
+                                    perfCounters.value(PerfCounters::Counter_Instructions)) /
+                                static_cast<double>(
+                                    perfCounters.value(PerfCounters::Counter_Cycles)));
+                }
+                else
+                {
+                    std::printf(" %10s", "n/a");
+                }
+
+                printPerKilobyte(perfCounters, PerfCounters::Counter_BranchMisses, kilobytes);
+                printPerKilobyte(perfCounters, PerfCounters::Counter_L1DataMisses, kilobytes);
+                printPerKilobyte(perfCounters,
+                                 PerfCounters::Counter_LastLevelCacheMisses,
+                                 kilobytes);
+            }
+
+            if (!bestResult.success)
+            {
+                std::printf("  (FAILED)");
+            }
+
+            std::printf("\n");
+        }
+    }
+
+    return exitCode;
+}
@@ -281,7 +281,7 @@ void executeXmlReader(const std::string &xmlString)
 
                 std::cout << "Start of element: name = " << name << std::endl;
 
-                const Common::AttributeList attributeList = xmlReader.attributeList();
+                const Common::AttributeList &attributeList = xmlReader.attributeList();
 
                 for (Common::AttributeList::ConstIterator it = attributeList.begin();
                      it != attributeList.end();
@@ -52,7 +52,7 @@ public:
     UnicodeString name() const;
     void setName(const UnicodeString &name);
 
-    UnicodeString value() const;
+    const UnicodeString &value() const;
     void setValue(const UnicodeString &value,
                   const QuotationMark quotationMark = QuotationMark_Quote);
 
@@ -81,6 +81,7 @@ public:
 
     void clear();
     size_t size() const;
+    void swap(AttributeList &other);
 
     void add(const Attribute &attribute);
     const Attribute *attribute(const UnicodeString &name);
@@ -30,6 +30,7 @@
 
 #include <EmbeddedStAX/Common/Utf.h>
 #include <stdint.h>
+#include <vector>
 
 namespace EmbeddedStAX
 {
@@ -50,9 +51,22 @@ public:
     UnicodeString name() const;
     void setName(const UnicodeString &name);
 
+    UnicodeString publicId() const;
+    UnicodeString systemId() const;
+    void setExternalId(const UnicodeString &publicId, const UnicodeString &systemId);
+
+    size_t elementDeclarationCount() const;
+    UnicodeString elementName(const size_t index) const;
+    UnicodeString elementContentSpec(const size_t index) const;
+    void addElementDeclaration(const UnicodeString &name, const UnicodeString &contentSpec);
+
 private:
     // Private data
     UnicodeString m_name;
+    UnicodeString m_publicId;
+    UnicodeString m_systemId;
+    std::vector<UnicodeString> m_elementNameList;
+    std::vector<UnicodeString> m_elementContentSpecList;
 };
 }
 }
@@ -0,0 +1,81 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#ifndef EMBEDDEDSTAX_COMMON_HASHINDEX_H
+#define EMBEDDEDSTAX_COMMON_HASHINDEX_H
+
+#include <EmbeddedStAX/Common/Utf.h>
+#include <vector>
+
+namespace EmbeddedStAX
+{
+namespace Common
+{
+/**
+ * Hash index maps the hashes of the items in a list to the indexes of the items
+ *
+ * The index is a hash table with open addressing and linear probing that is doubled when it becomes
+ * half full. The items themselves are stored and compared by the owner of the list, the index only
+ * narrows the comparisons down to the items with the same hash. Hashes are mixed before they select
+ * a slot, so hashes that differ only in their high bits do not end up in the same probe sequence.
+ *
+ * Hashes of strings are calculated with FNV-1a. When the strings come from an untrusted source, a
+ * seed can be used in place of the offset basis (initialHash()).
+ */
+class HashIndex
+{
+public:
+    // Public API
+    HashIndex();
+    ~HashIndex();
+
+    void clear();
+    size_t size() const;
+
+    size_t firstSlot(const uint32_t hash) const;
+    bool find(const uint32_t hash, size_t *slot, size_t *index) const;
+    void add(const uint32_t hash);
+
+    static uint32_t initialHash();
+    static uint32_t appendHash(const uint32_t hash, const uint32_t value);
+    static uint32_t appendHash(const uint32_t hash, const UnicodeString &value);
+    static uint32_t calculateHash(const UnicodeString &value);
+
+private:
+    // Private API
+    void insertIndex(const size_t index);
+    static uint32_t mixHash(const uint32_t hash);
+
+private:
+    // Private data
+    std::vector<uint32_t> m_hashList;
+    std::vector<size_t> m_table;
+};
+}
+}
+
+#endif // EMBEDDEDSTAX_COMMON_HASHINDEX_H
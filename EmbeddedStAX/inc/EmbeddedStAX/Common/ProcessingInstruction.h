@@ -47,6 +47,7 @@ public:
 
     bool isValid() const;
     void clear();
+    void swap(ProcessingInstruction &other);
 
     UnicodeString piTarget() const;
     void setPiTarget(const UnicodeString &piTarget);
@@ -64,6 +64,7 @@ public:
     void clear();
     Result write(const char data);
     uint32_t getChar() const;
+    size_t incompleteSize() const;
 
     static std::string toUtf8(const uint32_t unicodeChar);
     static std::string toUtf8(const UnicodeString &unicodeString);
@@ -0,0 +1,84 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#ifndef EMBEDDEDSTAX_XMLREADER_ATTRIBUTEVALUECACHE_H
+#define EMBEDDEDSTAX_XMLREADER_ATTRIBUTEVALUECACHE_H
+
+#include <EmbeddedStAX/Common/Utf.h>
+#include <vector>
+
+namespace EmbeddedStAX
+{
+namespace XmlReader
+{
+/**
+ * Bounded cache for interning short attribute values
+ *
+ * The cache is a fixed table of entries that is indexed with the hash of the value (a value can
+ * only be stored in a single entry, a new value replaces the old value in the entry). Values that
+ * are longer than the maximum value size are not cached.
+ */
+class AttributeValueCache
+{
+public:
+    // Public API
+    AttributeValueCache();
+    ~AttributeValueCache();
+
+    size_t capacity() const;
+    size_t maxValueSize() const;
+    void setCapacity(const size_t capacity, const size_t maxValueSize = 32U);
+    void clear();
+
+    const Common::UnicodeString &intern(const Common::UnicodeString &value);
+
+    size_t lookupCount() const;
+    size_t hitCount() const;
+    size_t replacementCount() const;
+    void resetStatistics();
+
+private:
+    // Private types
+    struct Entry
+    {
+        bool used;
+        uint32_t hash;
+        Common::UnicodeString value;
+    };
+
+private:
+    // Private data
+    std::vector<Entry> m_entryList;
+    size_t m_maxValueSize;
+    size_t m_lookupCount;
+    size_t m_hitCount;
+    size_t m_replacementCount;
+};
+}
+}
+
+#endif // EMBEDDEDSTAX_XMLREADER_ATTRIBUTEVALUECACHE_H
@@ -0,0 +1,142 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#ifndef EMBEDDEDSTAX_XMLREADER_COLUMNAREXTRACTOR_H
+#define EMBEDDEDSTAX_XMLREADER_COLUMNAREXTRACTOR_H
+
+#include <EmbeddedStAX/XmlReader/XmlReader.h>
+#include <vector>
+
+namespace EmbeddedStAX
+{
+namespace XmlReader
+{
+/**
+ * Columnar extractor flattens repeated records of a XML document into typed columns
+ *
+ * The extractor is configured with the path of the record element (for example "/export/row") and
+ * the paths of the fields relative to the record element: "price" is the text of the child element
+ * "price", "item/@sku" is the attribute "sku" of the child element "item", "@id" is the attribute
+ * "id" of the record element and an empty path is the text of the record element.
+ *
+ * The events of the XML reader are processed with processEvent() and the field values are written
+ * directly into the column buffers of the current batch (there is no per-record or per-field
+ * storage). Each column has a validity bitmap (bit i of byte i / 8 is set if the value of row i is
+ * valid): fields that are missing in a record or that can not be converted to the column type are
+ * null. Strings are stored in a single UTF-8 data buffer per column with the offsets of the values
+ * (row i is [offsets[i], offsets[i + 1])).
+ */
+class ColumnarExtractor
+{
+public:
+    // Public types
+    enum ColumnType
+    {
+        ColumnType_Int64,
+        ColumnType_Double,
+        ColumnType_String
+    };
+
+    /**
+     * Column buffer of a batch (only the values of the column type are used)
+     */
+    struct Column
+    {
+        ColumnType type;
+        std::vector<int64_t> int64Values;
+        std::vector<double> doubleValues;
+        std::vector<uint32_t> stringOffsets;
+        std::string stringData;
+        std::vector<uint8_t> validity;
+    };
+
+public:
+    // Public API
+    ColumnarExtractor();
+    ~ColumnarExtractor();
+
+    void clear();
+    bool setRecordPath(const Common::UnicodeString &recordPath);
+    size_t addField(const Common::UnicodeString &fieldPath, const ColumnType type);
+    size_t columnCount() const;
+
+    size_t batchSize() const;
+    void setBatchSize(const size_t batchSize);
+
+    void startNewDocument();
+    void processEvent(const XmlReader &xmlReader, const XmlReader::ParsingResult parsingResult);
+
+    size_t rowCount() const;
+    bool isBatchFull() const;
+    const Column &column(const size_t index) const;
+    bool isValid(const size_t index, const size_t row) const;
+    void clearBatch();
+
+    size_t conversionErrorCount() const;
+
+private:
+    // Private types
+    struct Field
+    {
+        uint32_t pathHash;
+        Common::UnicodeString path;
+        Common::UnicodeString attributeName;
+        bool assigned;
+    };
+
+private:
+    // Private API
+    void startRecord();
+    void discardRecord();
+    void processStartOfElement(const XmlReader &xmlReader);
+    void processEndOfElement(const XmlReader &xmlReader);
+    void assignValue(const size_t index, const std::string &value);
+    static void appendUtf8(const Common::UnicodeString &value, std::string *output);
+    static bool parseInt64(const std::string &value, int64_t *number);
+    bool parseDouble(const std::string &value, double *number);
+
+private:
+    // Private data
+    Common::UnicodeString m_recordPath;
+    uint32_t m_recordPathHash;
+    std::vector<Field> m_fieldList;
+    std::vector<Column> m_columnList;
+    size_t m_batchSize;
+
+    size_t m_depth;
+    size_t m_recordDepth;
+    std::vector<size_t> m_textDepthList;
+    std::vector<std::string> m_textList;
+    std::string m_attributeValue;
+    std::string m_number;
+    size_t m_rowCount;
+    size_t m_conversionErrorCount;
+};
+}
+}
+
+#endif // EMBEDDEDSTAX_XMLREADER_COLUMNAREXTRACTOR_H
@@ -0,0 +1,139 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#ifndef EMBEDDEDSTAX_XMLREADER_CONTENTMODEL_H
+#define EMBEDDEDSTAX_XMLREADER_CONTENTMODEL_H
+
+#include <EmbeddedStAX/XmlReader/NameTable.h>
+#include <EmbeddedStAX/Common/HashIndex.h>
+#include <vector>
+
+namespace EmbeddedStAX
+{
+namespace XmlReader
+{
+/**
+ * Content model of an element compiled to a deterministic finite automaton
+ *
+ * The content model is written in the DTD syntax (for example "(head, (p | list)*, foot?)"). The
+ * element names are interned in a name table and the automaton is built from the positions of the
+ * names (Glushkov automaton) with the subset construction. Only the transitions that exist are
+ * stored, sorted by the name for each state, so checking a child element is a binary search in the
+ * transitions of the current state. The start state of the automaton is 0.
+ */
+class ContentModel
+{
+public:
+    // Public types
+    enum Type
+    {
+        Type_Empty,
+        Type_Any,
+        Type_Mixed,
+        Type_Children
+    };
+
+public:
+    // Public API
+    ContentModel();
+    ~ContentModel();
+
+    void clear();
+    bool compile(const Common::UnicodeString &contentSpec, NameTable *nameTable);
+
+    Type type() const;
+    bool isTextAllowed() const;
+    size_t stateCount() const;
+    size_t symbolCount() const;
+    size_t nextState(const size_t state, const size_t nameId) const;
+    bool isAcceptingState(const size_t state) const;
+
+private:
+    // Private types
+    enum NodeType
+    {
+        NodeType_Name,
+        NodeType_Sequence,
+        NodeType_Choice
+    };
+
+    struct Node
+    {
+        NodeType type;
+        size_t position;
+        uint32_t occurrence;
+        std::vector<size_t> childList;
+        bool nullable;
+        std::vector<size_t> firstList;
+        std::vector<size_t> lastList;
+    };
+
+private:
+    // Private API
+    bool parseMixed(const Common::UnicodeString &contentSpec,
+                    size_t position,
+                    NameTable *nameTable);
+    bool parseChildren(const Common::UnicodeString &contentSpec,
+                       size_t position,
+                       NameTable *nameTable);
+    bool calculatePositionSets();
+    bool addFollowPositions(const std::vector<size_t> &positionList,
+                            const size_t position,
+                            size_t *followCount);
+    bool buildAutomaton();
+    static size_t maxTransitionCount(const size_t positionCount);
+    size_t findOrAddState(const std::vector<size_t> &positionSet);
+    static uint32_t calculatePositionSetHash(const std::vector<size_t> &positionSet);
+    size_t symbolIndex(const size_t nameId) const;
+    static size_t skipWhitespace(const Common::UnicodeString &contentSpec, size_t position);
+    static bool matchKeyword(const Common::UnicodeString &contentSpec,
+                             const size_t position,
+                             const char *keyword);
+    static size_t readName(const Common::UnicodeString &contentSpec,
+                           size_t position,
+                           Common::UnicodeString *name);
+    static void mergePositions(const std::vector<size_t> &positionList,
+                               std::vector<size_t> *positionSet);
+
+private:
+    // Private data
+    Type m_type;
+    std::vector<Node> m_nodeList;
+    std::vector<size_t> m_positionNameList;
+    std::vector<std::vector<size_t> > m_followList;
+    std::vector<std::vector<size_t> > m_stateList;
+    Common::HashIndex m_stateIndex;
+    std::vector<size_t> m_symbolList;
+    std::vector<size_t> m_transitionStartList;
+    std::vector<size_t> m_transitionSymbolList;
+    std::vector<size_t> m_transitionStateList;
+    std::vector<bool> m_acceptingList;
+};
+}
+}
+
+#endif // EMBEDDEDSTAX_XMLREADER_CONTENTMODEL_H
@@ -0,0 +1,67 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#ifndef EMBEDDEDSTAX_XMLREADER_NAMETABLE_H
+#define EMBEDDEDSTAX_XMLREADER_NAMETABLE_H
+
+#include <EmbeddedStAX/Common/HashIndex.h>
+#include <vector>
+
+namespace EmbeddedStAX
+{
+namespace XmlReader
+{
+/**
+ * Name table interns names and assigns them consecutive IDs (starting with 0)
+ *
+ * Names are stored in a hash table with open addressing, so a name is looked up with a single hash
+ * calculation and (usually) a single comparison. The IDs can be used to index tables instead of
+ * comparing the names.
+ */
+class NameTable
+{
+public:
+    // Public API
+    NameTable();
+    ~NameTable();
+
+    void clear();
+    size_t size() const;
+
+    size_t add(const Common::UnicodeString &name);
+    size_t find(const Common::UnicodeString &name) const;
+    const Common::UnicodeString &name(const size_t id) const;
+
+private:
+    // Private data
+    std::vector<Common::UnicodeString> m_nameList;
+    Common::HashIndex m_nameIndex;
+};
+}
+}
+
+#endif // EMBEDDEDSTAX_XMLREADER_NAMETABLE_H
@@ -38,6 +38,23 @@ namespace XmlReader
  * Parsing buffer
  *
  * Holds the parsing buffer
+ *
+ * Erasing from the front of the buffer only moves the start of the buffer forward, the erased
+ * characters are removed from the storage when new data is written and at least half of the
+ * storage is erased. This way the cost of erasing is amortized to a constant per character, even
+ * when a large document is written to the buffer at once.
+ *
+ * Reading can be limited to a number of characters after the current position (read limit). When
+ * the limit is reached the buffer behaves as if more data is needed, so the token parsers stop at
+ * the limit and can continue from the same place after the limit is removed or moved.
+ *
+ * Offsets of the characters from the start of the data stream are derived from the number of
+ * characters that were removed from the storage. The UTF-8 size of the erased characters is counted
+ * when they are erased, so a byte offset only measures the characters between the start of the
+ * buffer and the requested position. Line and column numbers are calculated only when they are
+ * requested. With line tracking enabled the newlines are counted
+ * when the erased characters are removed from the storage, so that the line numbers stay available
+ * for the characters that are still in the buffer.
  */
 class ParsingBuffer
 {
@@ -58,17 +75,45 @@ public:
     size_t currentPosition() const;
     bool setCurrentPosition(const size_t position);
     void incrementPosition();
+    size_t skipWhitespace();
+    size_t skipToCharacter(const uint32_t uchar);
+    bool matchesCurrentPosition(const Common::UnicodeString &value) const;
+
+    void setReadLimit(const size_t size);
+    void clearReadLimit();
+    bool isReadLimitReached() const;
+
+    size_t characterOffset(const size_t position) const;
+    size_t byteOffset(const size_t position) const;
+    bool isLineTrackingEnabled() const;
+    void setLineTrackingEnabled(const bool enabled);
+    bool calculateLineAndColumn(const size_t position, size_t *line, size_t *column) const;
 
     Common::UnicodeString substring(const size_t position,
                                     const size_t size = std::string::npos) const;
 
     size_t writeData(const std::string &data);
+    size_t writeData(const char *data, const size_t size);
+
+private:
+    // Private API
+    void compact();
+    void countErasedLines(const size_t size);
+    size_t readEnd() const;
 
 private:
     // Private data
     Common::Utf8 m_utf8;
     Common::UnicodeString m_buffer;
+    size_t m_start;
     size_t m_position;
+    size_t m_readLimit;
+    size_t m_erasedSize;
+    size_t m_erasedByteCount;
+    bool m_lineTracking;
+    bool m_erasedLinesCounted;
+    size_t m_erasedLineCount;
+    size_t m_erasedLineStart;
 };
 }
 }
@@ -0,0 +1,91 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#ifndef EMBEDDEDSTAX_XMLREADER_PATHROUTER_H
+#define EMBEDDEDSTAX_XMLREADER_PATHROUTER_H
+
+#include <EmbeddedStAX/XmlReader/XmlReader.h>
+#include <EmbeddedStAX/Common/HashIndex.h>
+#include <vector>
+
+namespace EmbeddedStAX
+{
+namespace XmlReader
+{
+/**
+ * Handler of the events of an element path
+ */
+class AbstractPathHandler
+{
+public:
+    // Public API
+    virtual ~AbstractPathHandler();
+
+    virtual void handleEvent(const XmlReader &xmlReader,
+                             const XmlReader::ParsingResult parsingResult) = 0;
+};
+
+/**
+ * Path router routes the events of the XML reader to the handlers of their element paths
+ *
+ * Routes are stored in a hash table indexed with the precompiled path hashes, so an event is routed
+ * with a lookup of the reader's path hash. The path of a route is compared with the reader's path
+ * only when the hashes match (to handle hash collisions).
+ */
+class PathRouter
+{
+public:
+    // Public API
+    PathRouter();
+    ~PathRouter();
+
+    void clear();
+    size_t size() const;
+
+    bool addRoute(const Common::UnicodeString &path, AbstractPathHandler *handler);
+    AbstractPathHandler *handler(const XmlReader &xmlReader) const;
+    bool route(const XmlReader &xmlReader, const XmlReader::ParsingResult parsingResult) const;
+
+    static bool validatePath(const Common::UnicodeString &path);
+
+private:
+    // Private types
+    struct Route
+    {
+        Common::UnicodeString path;
+        AbstractPathHandler *handler;
+    };
+
+private:
+    // Private data
+    std::vector<Route> m_routeList;
+    Common::HashIndex m_routeIndex;
+};
+}
+}
+
+#endif // EMBEDDEDSTAX_XMLREADER_PATHROUTER_H
@@ -0,0 +1,124 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#ifndef EMBEDDEDSTAX_XMLREADER_REWRITEENGINE_H
+#define EMBEDDEDSTAX_XMLREADER_REWRITEENGINE_H
+
+#include <EmbeddedStAX/XmlReader/XmlReader.h>
+#include <EmbeddedStAX/Common/HashIndex.h>
+#include <vector>
+
+namespace EmbeddedStAX
+{
+namespace XmlReader
+{
+/**
+ * Rewrite engine applies rewrite rules to a XML document while it is being read
+ *
+ * Rules are declared for element paths (for example "/order/card/number"): the element can be
+ * renamed or dropped (with its whole subtree), attributes can be injected or overridden and the
+ * text directly inside of the element can be masked. All rules of a path are compiled into a single
+ * entry of a hash table indexed with the precompiled path hash, so the rules of an event are found
+ * with a lookup of the reader's path hash.
+ *
+ * The input data is kept until it is written to the output. Events without a matching rule are not
+ * materialized: their data is copied to the output as a raw byte range (adjacent ranges are copied
+ * at once). Only the events with a matching rule are rewritten.
+ */
+class RewriteEngine
+{
+public:
+    // Public API
+    RewriteEngine();
+    ~RewriteEngine();
+
+    void clear();
+    size_t ruleCount() const;
+
+    bool addRenameRule(const Common::UnicodeString &path, const Common::UnicodeString &name);
+    bool addDropRule(const Common::UnicodeString &path);
+    bool addAttributeRule(const Common::UnicodeString &path, const Common::Attribute &attribute);
+    bool addTextMaskRule(const Common::UnicodeString &path, const Common::UnicodeString &mask);
+
+    void startNewStream();
+    size_t writeData(const std::string &data);
+    size_t writeData(const char *data, const size_t size);
+    XmlReader::ParsingResult process();
+    void finish();
+
+    const XmlReader &xmlReader() const;
+    const std::string &output() const;
+    void clearOutput();
+
+    size_t copiedSize() const;
+    size_t rewrittenEventCount() const;
+
+private:
+    // Private types
+    struct PathRules
+    {
+        Common::UnicodeString path;
+        Common::UnicodeString name;
+        bool drop;
+        bool maskText;
+        Common::UnicodeString mask;
+        std::vector<Common::Attribute> attributeList;
+    };
+
+private:
+    // Private API
+    PathRules *addPathRules(const Common::UnicodeString &path);
+    const PathRules *findPathRules() const;
+
+    void rewriteEvent(const XmlReader::ParsingResult result, const size_t eventEnd);
+    void writeStartOfElement(const PathRules &pathRules, const bool emptyElement);
+    size_t findTokenStart(const size_t eventStart, const size_t eventEnd) const;
+    void copyData(const size_t endOffset);
+    void skipData(const size_t endOffset);
+    void writeMarkup(const Common::UnicodeString &markup);
+
+private:
+    // Private data
+    std::vector<PathRules> m_pathRulesList;
+    Common::HashIndex m_pathRulesIndex;
+    size_t m_ruleCount;
+
+    XmlReader m_xmlReader;
+    std::string m_inputData;
+    size_t m_inputOffset;
+    size_t m_copiedOffset;
+    size_t m_eventEnd;
+    size_t m_dropDepth;
+    bool m_textMasked;
+    std::string m_output;
+    size_t m_copiedSize;
+    size_t m_rewrittenEventCount;
+};
+}
+}
+
+#endif // EMBEDDEDSTAX_XMLREADER_REWRITEENGINE_H
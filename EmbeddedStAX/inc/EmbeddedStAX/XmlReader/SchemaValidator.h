@@ -0,0 +1,125 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#ifndef EMBEDDEDSTAX_XMLREADER_SCHEMAVALIDATOR_H
+#define EMBEDDEDSTAX_XMLREADER_SCHEMAVALIDATOR_H
+
+#include <EmbeddedStAX/XmlReader/ContentModel.h>
+#include <EmbeddedStAX/XmlReader/NameTable.h>
+#include <EmbeddedStAX/XmlReader/SimpleType.h>
+#include <EmbeddedStAX/Common/DocumentType.h>
+#include <vector>
+
+namespace EmbeddedStAX
+{
+namespace XmlReader
+{
+/**
+ * Schema validator validates the structure of a document while it is being read
+ *
+ * The validator is fed with the element and text events of the XML reader. Each declared element
+ * has a content model that is compiled to a deterministic finite automaton, the validator only
+ * keeps the state of the automaton of each open element, so no document tree is built. The text
+ * content of an element can also be restricted with a simple type.
+ *
+ * Element names are interned in a name table, so an element is looked up with a single hash table
+ * lookup and a child element is checked with a single transition table lookup.
+ */
+class SchemaValidator
+{
+public:
+    // Public types
+    enum Error
+    {
+        Error_None,
+        Error_UndeclaredElement,
+        Error_InvalidRootElement,
+        Error_UnexpectedElement,
+        Error_UnexpectedText,
+        Error_IncompleteContent,
+        Error_InvalidValue,
+        Error_InvalidDeclaration
+    };
+
+public:
+    // Public API
+    SchemaValidator();
+    ~SchemaValidator();
+
+    void clear();
+    size_t elementCount() const;
+
+    bool declareElement(const Common::UnicodeString &name,
+                        const Common::UnicodeString &contentSpec);
+    bool isElementDeclared(const Common::UnicodeString &name) const;
+    bool setElementType(const Common::UnicodeString &name, const SimpleType &simpleType);
+    bool setRootElement(const Common::UnicodeString &name);
+    bool declareElements(const Common::DocumentType &documentType);
+
+    void startNewDocument();
+    bool validateStartOfElement(const Common::UnicodeString &name);
+    bool validateText(const Common::UnicodeString &text, const bool cData);
+    bool validateEndOfElement();
+    Error error() const;
+
+private:
+    // Private types
+    struct ElementDeclaration
+    {
+        ContentModel contentModel;
+        bool typed;
+        SimpleType simpleType;
+    };
+
+    struct OpenElement
+    {
+        size_t declarationIndex;
+        size_t state;
+    };
+
+private:
+    // Private API
+    size_t findDeclaration(const Common::UnicodeString &name) const;
+    Error checkStartOfElement(const Common::UnicodeString &name);
+    Error checkText(const Common::UnicodeString &text, const bool cData);
+    Error checkEndOfElement();
+    static bool isWhitespaceText(const Common::UnicodeString &text);
+
+private:
+    // Private data
+    NameTable m_nameTable;
+    std::vector<size_t> m_declarationIndexList;
+    std::vector<ElementDeclaration> m_declarationList;
+    size_t m_rootNameId;
+    std::vector<OpenElement> m_openElementList;
+    Common::UnicodeString m_text;
+    Error m_error;
+};
+}
+}
+
+#endif // EMBEDDEDSTAX_XMLREADER_SCHEMAVALIDATOR_H
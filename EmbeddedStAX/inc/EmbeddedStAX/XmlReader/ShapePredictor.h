@@ -0,0 +1,106 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#ifndef EMBEDDEDSTAX_XMLREADER_SHAPEPREDICTOR_H
+#define EMBEDDEDSTAX_XMLREADER_SHAPEPREDICTOR_H
+
+#include <EmbeddedStAX/Common/Utf.h>
+#include <vector>
+
+namespace EmbeddedStAX
+{
+namespace XmlReader
+{
+/**
+ * Shape predictor learns the sequence of names in the start of element tokens
+ *
+ * The predictor remembers which name followed the previous name (element and attribute names are
+ * handled as a single sequence). The next name is predicted from the hash of the previous name and
+ * the type of the next name, so for a stream of records with the same shape (same elements and
+ * attributes in the same order) every name after the first record is predicted.
+ *
+ * The learned names are stored in a fixed table of entries indexed with the prediction context (an
+ * entry holds a single name, a new name replaces the old name in the entry).
+ */
+class ShapePredictor
+{
+public:
+    // Public types
+    enum NameType
+    {
+        NameType_Element,
+        NameType_Attribute
+    };
+
+public:
+    // Public API
+    ShapePredictor();
+    ~ShapePredictor();
+
+    size_t capacity() const;
+    void setCapacity(const size_t capacity);
+    void clear();
+
+    const Common::UnicodeString *predictName(const NameType nameType,
+                                             const bool validationNeeded,
+                                             uint32_t *hash);
+    void addName(const Common::UnicodeString &name,
+                 const uint32_t hash,
+                 const bool validated,
+                 const bool predicted);
+
+    size_t lookupCount() const;
+    size_t predictionCount() const;
+    size_t hitCount() const;
+    size_t skippedCharacterCount() const;
+    void resetStatistics();
+
+private:
+    // Private types
+    struct Entry
+    {
+        bool used;
+        uint32_t context;
+        uint32_t hash;
+        bool validated;
+        Common::UnicodeString name;
+    };
+
+private:
+    // Private data
+    std::vector<Entry> m_entryList;
+    uint32_t m_previousHash;
+    uint32_t m_context;
+    size_t m_lookupCount;
+    size_t m_predictionCount;
+    size_t m_hitCount;
+    size_t m_skippedCharacterCount;
+};
+}
+}
+
+#endif // EMBEDDEDSTAX_XMLREADER_SHAPEPREDICTOR_H
@@ -0,0 +1,107 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#ifndef EMBEDDEDSTAX_XMLREADER_SIMPLETYPE_H
+#define EMBEDDEDSTAX_XMLREADER_SIMPLETYPE_H
+
+#include <EmbeddedStAX/Common/Utf.h>
+#include <vector>
+
+namespace EmbeddedStAX
+{
+namespace XmlReader
+{
+/**
+ * Simple type of the text content of an element
+ *
+ * A simple type is a base type (a subset of the XML Schema built-in types) restricted with facets:
+ * length range, value range (integer only) and enumeration. The facets are checked directly on the
+ * text, the value is not converted and stored.
+ *
+ * \note For all base types except string the leading and trailing whitespace of the text is
+ *       ignored (whitespace is collapsed).
+ */
+class SimpleType
+{
+public:
+    // Public types
+    enum BaseType
+    {
+        BaseType_String,
+        BaseType_Boolean,
+        BaseType_Integer,
+        BaseType_Decimal
+    };
+
+public:
+    // Public API
+    SimpleType(const BaseType baseType = BaseType_String);
+
+    BaseType baseType() const;
+
+    size_t minLength() const;
+    size_t maxLength() const;
+    void setLengthRange(const size_t minLength, const size_t maxLength);
+
+    int32_t minValue() const;
+    int32_t maxValue() const;
+    void setValueRange(const int32_t minValue, const int32_t maxValue);
+
+    void addEnumeration(const Common::UnicodeString &value);
+    void clearEnumeration();
+
+    bool validate(const Common::UnicodeString &text) const;
+
+private:
+    // Private API
+    static bool validateBoolean(const Common::UnicodeString &text,
+                                const size_t position,
+                                const size_t size);
+    bool validateInteger(const Common::UnicodeString &text,
+                         const size_t position,
+                         const size_t size) const;
+    static bool validateDecimal(const Common::UnicodeString &text,
+                                const size_t position,
+                                const size_t size);
+    static bool matchText(const Common::UnicodeString &text,
+                          const size_t position,
+                          const size_t size,
+                          const char *value);
+
+private:
+    // Private data
+    BaseType m_baseType;
+    size_t m_minLength;
+    size_t m_maxLength;
+    int32_t m_minValue;
+    int32_t m_maxValue;
+    std::vector<Common::UnicodeString> m_enumerationList;
+};
+}
+}
+
+#endif // EMBEDDEDSTAX_XMLREADER_SIMPLETYPE_H
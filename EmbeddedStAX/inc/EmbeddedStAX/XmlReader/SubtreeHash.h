@@ -0,0 +1,81 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#ifndef EMBEDDEDSTAX_XMLREADER_SUBTREEHASH_H
+#define EMBEDDEDSTAX_XMLREADER_SUBTREEHASH_H
+
+#include <EmbeddedStAX/Common/Utf.h>
+#include <vector>
+
+namespace EmbeddedStAX
+{
+namespace XmlReader
+{
+/**
+ * Subtree hash calculates the hash of a canonical byte stream incrementally
+ *
+ * The canonical stream is made of markers (byte 0xFF followed by a marker byte, byte 0xFF is never
+ * used in UTF-8) and UTF-8 encoded strings. The fast hash (64-bit FNV-1a) is always calculated and
+ * the SHA-256 digest is calculated only when it is enabled.
+ */
+class SubtreeHash
+{
+public:
+    // Public API
+    SubtreeHash();
+    ~SubtreeHash();
+
+    void start(const bool sha256Enabled);
+    void appendMarker(const uint8_t marker);
+    void appendString(const Common::UnicodeString &value);
+    void finish();
+
+    bool isFinished() const;
+    uint64_t fastHash() const;
+    std::vector<uint8_t> sha256() const;
+
+    static std::vector<uint8_t> calculateSha256(const std::string &data);
+
+private:
+    // Private API
+    void appendByte(const uint8_t value);
+    void processSha256Block();
+
+private:
+    // Private data
+    uint64_t m_fastHash;
+    bool m_sha256Enabled;
+    bool m_finished;
+    uint32_t m_sha256State[8];
+    uint8_t m_sha256Block[64];
+    size_t m_sha256BlockSize;
+    uint64_t m_size;
+};
+}
+}
+
+#endif // EMBEDDEDSTAX_XMLREADER_SUBTREEHASH_H
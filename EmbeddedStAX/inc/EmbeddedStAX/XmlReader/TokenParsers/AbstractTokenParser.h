@@ -52,7 +52,8 @@ public:
     {
         Option_None,
         Option_Synchronization,
-        Option_IgnoreLeadingWhitespace
+        Option_IgnoreLeadingWhitespace,
+        Option_SkipContent
     };
 
     enum ParserType
@@ -95,6 +96,9 @@ public:
     TokenType tokenType() const;
     uint32_t terminationChar() const;
 
+    bool isTrusted() const;
+    void setTrusted(const bool trusted);
+
     bool initialize(ParsingBuffer *parsingBuffer, const Option option = Option_None);
     virtual Result parse() = 0;
     void deinitialize();
@@ -116,6 +120,7 @@ private:
     Option m_option;
     TokenType m_tokenType;
     uint32_t m_terminationChar;
+    bool m_trusted;
     const ParserType m_parserType;
 };
 }
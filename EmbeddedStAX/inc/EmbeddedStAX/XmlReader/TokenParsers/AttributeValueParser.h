@@ -45,7 +45,7 @@ public:
     AttributeValueParser();
     ~AttributeValueParser();
 
-    Common::UnicodeString value() const;
+    const Common::UnicodeString &value() const;
 
     virtual Result parse();
 
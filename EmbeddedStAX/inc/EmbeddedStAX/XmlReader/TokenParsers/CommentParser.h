@@ -59,6 +59,7 @@ private:
 
 private:
     // Private API
+    virtual bool setOption(const Option option);
     virtual bool initializeAdditionalData();
     virtual void deinitializeAdditionalData();
 
@@ -38,6 +38,11 @@ namespace XmlReader
 {
 /**
  * Document type parser
+ *
+ * Besides the name of the root element the external ID and the internal subset are read. Element
+ * type declarations from the internal subset are stored in the document type, the other markup
+ * declarations (attribute list, entity and notation declarations, comments, processing
+ * instructions and parameter entity references) are only checked for their end and skipped.
  */
 class DocumentTypeParser: public AbstractTokenParser
 {
@@ -55,7 +60,9 @@ private:
     enum State
     {
         State_ReadingName,
-        // TODO: add support for reading the other parts of document type!
+        State_ReadingExternalId,
+        State_ReadingInternalSubset,
+        State_ReadingMarkupDeclaration,
         State_ReadingEnd,
         State_Finished,
         State_Error
@@ -67,14 +74,28 @@ private:
     virtual void deinitializeAdditionalData();
 
     State executeStateReadingName();
+    State executeStateReadingExternalId();
+    State executeStateReadingInternalSubset();
+    State executeStateReadingMarkupDeclaration();
     State executeStateReadingEnd();
 
+    bool parseExternalId();
+    bool parseMarkupDeclaration();
+    bool isMarkupDeclarationEnd(const uint32_t uchar);
+    static bool startsWith(const Common::UnicodeString &text, const char *prefix);
+    static size_t skipWhitespace(const Common::UnicodeString &text, size_t position);
+    static size_t readLiteral(const Common::UnicodeString &text,
+                              const size_t position,
+                              Common::UnicodeString *literal);
+
 private:
     // Private data
     State m_state;
     NameParser m_nameParser;
     Common::UnicodeString m_piTarget;
     Common::DocumentType m_documentType;
+    Common::UnicodeString m_text;
+    uint32_t m_quoteChar;
 };
 }
 }
@@ -45,6 +45,8 @@ public:
     ~EndOfElementParser();
 
     Common::UnicodeString name() const;
+    bool isExpectedName() const;
+    void setExpectedName(const Common::UnicodeString *expectedName);
 
     virtual Result parse();
 
@@ -52,6 +54,7 @@ private:
     // Private types
     enum State
     {
+        State_MatchingElementName,
         State_ReadingElementName,
         State_ReadingEndOfElement,
         State_Finished,
@@ -63,6 +66,7 @@ private:
     virtual bool initializeAdditionalData();
     virtual void deinitializeAdditionalData();
 
+    State executeStateMatchingElementName();
     State executeStateReadingElementName();
     State executeStateReadingEndOfElement();
 
@@ -71,6 +75,8 @@ private:
     State m_state;
     NameParser m_nameParser;
     Common::UnicodeString m_elementName;
+    const Common::UnicodeString *m_expectedName;
+    bool m_expectedNameMatched;
 };
 }
 }
@@ -29,6 +29,7 @@
 #define EMBEDDEDSTAX_XMLREADER_TOKENPARSERS_NAMEPARSER_H
 
 #include <EmbeddedStAX/XmlReader/TokenParsers/AbstractTokenParser.h>
+#include <EmbeddedStAX/XmlReader/ShapePredictor.h>
 
 namespace EmbeddedStAX
 {
@@ -45,6 +46,10 @@ public:
     ~NameParser();
 
     Common::UnicodeString value() const;
+    uint32_t hash() const;
+
+    void setHashSeed(const uint32_t hashSeed);
+    void setShapePredictor(ShapePredictor *shapePredictor, const ShapePredictor::NameType nameType);
 
     virtual Result parse();
 
@@ -66,11 +71,16 @@ private:
 
     State executeStateReadingNameStartChar();
     State executeStateReadingNameChars();
+    bool matchPredictedName();
 
 private:
     // Private data
     State m_state;
     Common::UnicodeString m_value;
+    uint32_t m_hash;
+    uint32_t m_hashSeed;
+    ShapePredictor *m_shapePredictor;
+    ShapePredictor::NameType m_nameType;
 };
 }
 }
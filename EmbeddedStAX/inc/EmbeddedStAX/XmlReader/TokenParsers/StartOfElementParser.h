@@ -30,7 +30,10 @@
 
 #include <EmbeddedStAX/XmlReader/TokenParsers/NameParser.h>
 #include <EmbeddedStAX/XmlReader/TokenParsers/AttributeValueParser.h>
+#include <EmbeddedStAX/XmlReader/AttributeValueCache.h>
 #include <EmbeddedStAX/Common/Attribute.h>
+#include <EmbeddedStAX/Common/HashIndex.h>
+#include <vector>
 
 namespace EmbeddedStAX
 {
@@ -49,6 +52,10 @@ public:
     Common::UnicodeString name() const;
     const Common::AttributeList &attributeList() const;
 
+    void setAttributeValueCache(AttributeValueCache *attributeValueCache);
+    void setShapePredictor(ShapePredictor *shapePredictor);
+    void setHashSeed(const uint32_t hashSeed);
+
     Result parse();
 
 private:
@@ -77,14 +84,23 @@ private:
     State executeStateReadingAttributeValue();
     State executeStateReadingEndOfEmptyElement();
 
+    void clearAttributeNames();
+    bool containsAttributeName(const Common::UnicodeString &name, const uint32_t hash) const;
+    void addAttributeName(const uint32_t hash);
+
 private:
     // Private data
     State m_state;
     NameParser m_nameParser;
     AttributeValueParser m_attributeValueParser;
+    AttributeValueCache *m_attributeValueCache;
+    ShapePredictor *m_shapePredictor;
     Common::UnicodeString m_elementName;
     Common::UnicodeString m_attributeName;
+    uint32_t m_attributeNameHash;
     Common::AttributeList m_attributeList;
+    std::vector<Common::UnicodeString> m_attributeNameList;
+    Common::HashIndex m_attributeNameIndex;
 };
 }
 }
@@ -28,7 +28,11 @@
 #ifndef EMBEDDEDSTAX_XMLREADER_XMLREADER_H
 #define EMBEDDEDSTAX_XMLREADER_XMLREADER_H
 
+#include <EmbeddedStAX/XmlReader/AttributeValueCache.h>
 #include <EmbeddedStAX/XmlReader/ParsingBuffer.h>
+#include <EmbeddedStAX/XmlReader/SchemaValidator.h>
+#include <EmbeddedStAX/XmlReader/ShapePredictor.h>
+#include <EmbeddedStAX/XmlReader/SubtreeHash.h>
 #include <EmbeddedStAX/XmlReader/TokenParsers/CDataParser.h>
 #include <EmbeddedStAX/XmlReader/TokenParsers/CommentParser.h>
 #include <EmbeddedStAX/XmlReader/TokenParsers/EndOfElementParser.h>
@@ -43,6 +47,7 @@
 #include <EmbeddedStAX/Common/Utf.h>
 #include <EmbeddedStAX/Common/XmlDeclaration.h>
 #include <list>
+#include <vector>
 
 namespace EmbeddedStAX
 {
@@ -67,7 +72,43 @@ public:
         ParsingResult_StartOfElement,
         ParsingResult_EndOfElement,
         ParsingResult_TextNode,
-        ParsingResult_CData
+        ParsingResult_CData,
+        ParsingResult_Yield,
+        ParsingResult_DataDiscarded
+    };
+
+    /**
+     * Events that can be suppressed with the event mask
+     *
+     * A masked processing instruction or comment is only scanned for its end, its content is not
+     * stored. The XML declaration is always parsed (it is needed to validate the document), but it
+     * is not reported when masked. Masked events are never returned by parse().
+     */
+    enum EventMask
+    {
+        EventMask_None                  = 0x00U,
+        EventMask_XmlDeclaration        = 0x01U,
+        EventMask_ProcessingInstruction = 0x02U,
+        EventMask_Comment               = 0x04U,
+        EventMask_WhitespaceTextNode    = 0x08U,
+        EventMask_All                   = 0x0FU
+    };
+
+    /**
+     * Validation of the characters in the tokens
+     *
+     * - Full: all characters are validated
+     * - Trusted: only the structural delimiters of the tokens are checked, names and character data
+     *   are not validated (the input has to be produced by a trusted producer, for example XmlWriter)
+     * - Sampled: like trusted, but every n-th token is fully validated
+     *
+     * \note UTF-8 decoding, references and the structure of the document are always validated.
+     */
+    enum ValidationMode
+    {
+        ValidationMode_Full,
+        ValidationMode_Trusted,
+        ValidationMode_Sampled
     };
 
 public:
@@ -79,8 +120,48 @@ public:
 
     // TODO: replace writting data to XmlReader with reading data from an "AbstractXmlInputStream" or externally supplied string input?
     size_t writeData(const std::string &data);
+    size_t writeData(const char *data, const size_t size);
+
+    uint32_t eventMask() const;
+    void setEventMask(const uint32_t eventMask);
+
+    ValidationMode validationMode() const;
+    size_t validationSampleInterval() const;
+    void setValidationMode(const ValidationMode validationMode, const size_t sampleInterval = 64U);
+
+    bool isTextCoalescingEnabled() const;
+    void setTextCoalescingEnabled(const bool enabled);
+
+    bool isLineTrackingEnabled() const;
+    void setLineTrackingEnabled(const bool enabled);
+
+    bool isErrorRecoveryEnabled() const;
+    void setErrorRecoveryEnabled(const bool enabled);
+
+    bool isDtdValidationEnabled() const;
+    void setDtdValidationEnabled(const bool enabled);
+    bool addExternalDtd(const Common::UnicodeString &systemId, const std::string &dtd);
+    void clearExternalDtds();
+    SchemaValidator::Error validationError() const;
+
+    bool addHashedSubtree(const Common::UnicodeString &path);
+    void clearHashedSubtrees();
+    bool isSubtreeSha256Enabled() const;
+    void setSubtreeSha256Enabled(const bool enabled);
+    bool isSubtreeHashAvailable() const;
+    uint64_t subtreeHash() const;
+    std::vector<uint8_t> subtreeSha256() const;
+
+    const AttributeValueCache &attributeValueCache() const;
+    void setAttributeValueCache(const size_t capacity, const size_t maxValueSize = 32U);
+
+    const ShapePredictor &shapePredictor() const;
+    void setShapePrediction(const size_t capacity);
 
     ParsingResult parse();
+    ParsingResult parse(const size_t budget);
+    ParsingResult peek();
+    Common::UnicodeString peekedName() const;
     ParsingResult lastParsingResult();
 
     Common::XmlDeclaration xmlDeclaration() const;
@@ -88,7 +169,17 @@ public:
     Common::DocumentType documentType() const;
     Common::UnicodeString text() const;
     Common::UnicodeString name() const;
-    Common::AttributeList attributeList() const;
+    const Common::AttributeList &attributeList() const;
+
+    size_t characterOffset() const;
+    size_t byteOffset() const;
+    bool location(size_t *line, size_t *column) const;
+    size_t discardedOffset() const;
+    size_t discardedSize() const;
+
+    uint32_t pathHash() const;
+    bool isCurrentPath(const Common::UnicodeString &path) const;
+    static uint32_t calculatePathHash(const Common::UnicodeString &path);
 
 private:
     // Private types
@@ -116,34 +207,113 @@ private:
         ParsingState_ReadingStartOfElement,
         ParsingState_StartOfElementRead,
         ParsingState_EmptyElementRead,
+        ParsingState_ReadingWhitespace,
         ParsingState_ReadingTextNode,
         ParsingState_TextNodeRead,
+        ParsingState_CoalescedTextRead,
         ParsingState_ReadingCData,
         ParsingState_CDataRead,
         ParsingState_ReadingEndOfElement,
         ParsingState_EndOfElementRead,
+        ParsingState_Resynchronizing,
         ParsingState_Error
     };
 
+    /**
+     * Data of an event that is kept aside while another event is peeked
+     */
+    struct EventData
+    {
+        Common::XmlDeclaration xmlDeclaration;
+        Common::ProcessingInstruction processingInstruction;
+        Common::DocumentType documentType;
+        Common::UnicodeString text;
+        Common::UnicodeString name;
+        Common::AttributeList attributeList;
+        uint32_t pathHash;
+        bool pathIncludesName;
+        SubtreeHash subtreeHash;
+        size_t discardedOffset;
+        size_t discardedSize;
+    };
+
+    /**
+     * Change of the open elements that is deferred until the peeked event is consumed
+     */
+    enum PeekedElementChange
+    {
+        PeekedElementChange_None,
+        PeekedElementChange_Opened,
+        PeekedElementChange_Closed
+    };
+
 private:
     // Private API
+    ParsingResult parseNextEvent();
     ParsingState executeParsingStateReadingTokenType();
     ParsingState executeParsingStateReadingProcessingInstruction();
     ParsingState executeParsingStateReadingComment();
     ParsingState executeParsingStateReadingDocumentType();
     ParsingState executeParsingStateReadingStartOfElement();
     ParsingState executeParsingStateReadingTextNode();
+    ParsingState executeParsingStateReadingWhitespace();
     ParsingState executeParsingStateReadingCData();
     ParsingState executeParsingStateReadingEndOfElement();
+    ParsingState executeParsingStateResynchronizing();
 
     bool setTokenParser(AbstractTokenParser *tokenParser);
+    ParsingState startReadingTextNode();
+    void selectTokenValidation();
+    bool isEventEnabled(const EventMask event) const;
+    bool isWhitespaceText() const;
+    bool isCoalescedTextPending() const;
+    ParsingState finishCoalescedText(const ParsingState markupState, ParsingResult *result);
+    ParsingResult validateEvent(const ParsingResult result);
+    bool declareDocumentTypeElements();
+    void hashEvent(const ParsingResult result);
+    void hashStartOfElement(const size_t depth);
+    void hashEndOfElement(const size_t depth);
+    void hashText();
+    void enterElementPath(const bool emptyElement);
+    void leaveElementPath();
+    void closeOpenElement();
+    void parkEventData(EventData *eventData);
+    void swapEventData(EventData *eventData);
+    void swapDocumentData(EventData *eventData, const ParsingResult result);
 
 private:
     // Private data
+    uint32_t m_eventMask;
+    ValidationMode m_validationMode;
+    size_t m_validationSampleInterval;
+    size_t m_validationSampleCounter;
+    bool m_textCoalescing;
+    ParsingState m_coalescedTextNextState;
+    bool m_errorRecovery;
+    size_t m_documentOffset;
+    size_t m_discardedOffset;
+    size_t m_discardedSize;
+    bool m_dtdValidation;
+    SchemaValidator m_schemaValidator;
+    std::vector<Common::DocumentType> m_externalDtdList;
+    std::vector<Common::UnicodeString> m_hashedSubtreePathList;
+    std::vector<uint32_t> m_hashedSubtreePathHashList;
+    bool m_subtreeSha256;
+    std::vector<SubtreeHash> m_openSubtreeHashList;
+    std::vector<size_t> m_openSubtreeDepthList;
+    SubtreeHash m_subtreeHash;
+    bool m_subtreeTextStarted;
+    Common::UnicodeString m_subtreeWhitespace;
     DocumentState m_documentState;
     ParsingState m_parsingState;
     ParsingBuffer m_parsingBuffer;
     ParsingResult m_lastParsingResult;
+    ParsingResult m_peekedResult;
+    EventData m_parkedEvent;
+    bool m_eventParked;
+    bool m_peeking;
+    PeekedElementChange m_peekedElementChange;
+    std::list<Common::UnicodeString> m_peekedElementList;
     Common::XmlDeclaration m_xmlDeclaration;
     Common::ProcessingInstruction m_processingInstruction;
     Common::DocumentType m_documentType;
@@ -151,6 +321,11 @@ private:
     Common::UnicodeString m_name;
     Common::AttributeList m_attributeList;
     std::list<Common::UnicodeString> m_openElementList;
+    std::vector<uint32_t> m_openElementPathHashList;
+    uint32_t m_pathHash;
+    bool m_pathIncludesName;
+    AttributeValueCache m_attributeValueCache;
+    ShapePredictor m_shapePredictor;
 
     CDataParser m_cDataParser;
     CommentParser m_commentParser;
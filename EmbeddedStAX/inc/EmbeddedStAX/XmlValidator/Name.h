@@ -36,6 +36,7 @@ namespace XmlValidator
 {
 bool isNameStartChar(const uint32_t character);
 bool isNameChar(const uint32_t character);
+bool isNameDelimiter(const uint32_t character);
 
 bool validateName(const Common::UnicodeString &name);
 }
@@ -0,0 +1,193 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#ifndef EMBEDDEDSTAX_XMLWRITER_JSONCONVERTER_H
+#define EMBEDDEDSTAX_XMLWRITER_JSONCONVERTER_H
+
+#include <EmbeddedStAX/XmlWriter/XmlWriter.h>
+#include <vector>
+
+namespace EmbeddedStAX
+{
+namespace XmlWriter
+{
+/**
+ * JSON Converter class can be used to convert a JSON document to a XML document
+ *
+ * The JSON document is tokenized while it is written to the converter and each token is written to
+ * the XML writer right away, so the memory usage does not depend on the size of the document (only
+ * on the nesting depth and the size of a single token):
+ *
+ * - the top level value is written as the root element (named "json" by default)
+ * - an object is written as an element and its members as child elements named after their keys
+ * - a member with a key that starts with the attribute prefix ('@' by default) is written as an
+ *   attribute of the object's element (it has to be before the other members of the object)
+ * - a member with the text key ("#text" by default) is written as a text node of the object's
+ *   element
+ * - an array that is a value of an object member is written as repeated elements named after the
+ *   member's key, other arrays are written as an element with a child element (named "item" by
+ *   default) for each array item
+ * - strings, numbers and booleans are written as text nodes and null is written as an empty element
+ *
+ * Element and attribute names are generated from the keys, so they are validated once per distinct
+ * key: the validation results are stored in a name cache.
+ */
+class JsonConverter
+{
+public:
+    // Public types
+    enum Result
+    {
+        Result_NeedMoreData,
+        Result_Finished,
+        Result_Error
+    };
+
+public:
+    // Public API
+    JsonConverter();
+    ~JsonConverter();
+
+    Common::UnicodeString rootName() const;
+    bool setRootName(const Common::UnicodeString &rootName);
+    Common::UnicodeString arrayItemName() const;
+    bool setArrayItemName(const Common::UnicodeString &arrayItemName);
+    uint32_t attributePrefix() const;
+    void setAttributePrefix(const uint32_t attributePrefix);
+    Common::UnicodeString textKey() const;
+    void setTextKey(const Common::UnicodeString &textKey);
+    void setNameCacheCapacity(const size_t capacity);
+
+    void startNewStream();
+    size_t writeData(const std::string &data);
+    size_t writeData(const char *data, const size_t size);
+    void finish();
+    Result process();
+
+    const std::string &output() const;
+    void clearOutput();
+
+    size_t nameValidationCount() const;
+
+private:
+    // Private types
+    enum State
+    {
+        State_Value,
+        State_ValueOrEndOfArray,
+        State_KeyOrEndOfObject,
+        State_Key,
+        State_Colon,
+        State_CommaOrEnd,
+        State_EndOfDocument,
+        State_Error
+    };
+
+    enum TokenType
+    {
+        TokenType_None,
+        TokenType_Error,
+        TokenType_BeginObject,
+        TokenType_EndObject,
+        TokenType_BeginArray,
+        TokenType_EndArray,
+        TokenType_Colon,
+        TokenType_Comma,
+        TokenType_String,
+        TokenType_Number,
+        TokenType_Boolean,
+        TokenType_Null
+    };
+
+    enum Target
+    {
+        Target_Element,
+        Target_Attribute,
+        Target_Text
+    };
+
+    struct Container
+    {
+        bool object;
+        bool wrapper;
+        Common::UnicodeString name;
+        bool startWritten;
+        Common::AttributeList attributeList;
+    };
+
+    struct NameCacheEntry
+    {
+        bool used;
+        bool valid;
+        Common::UnicodeString key;
+    };
+
+private:
+    // Private API
+    TokenType readToken();
+    TokenType readString();
+    TokenType readNumber();
+    TokenType readLiteral(const char *literal, const TokenType tokenType);
+    bool readHexValue(const size_t position, uint32_t *value) const;
+
+    bool processToken(const TokenType tokenType);
+    bool processKey();
+    bool processValue(const TokenType tokenType);
+    bool processEndOfContainer(const TokenType tokenType);
+    bool writePendingStartOfElement();
+    void finishValue();
+    bool isValidName(const Common::UnicodeString &key, const Common::UnicodeString &name);
+    void clearNameCache();
+    void moveOutput();
+
+private:
+    // Private data
+    Common::UnicodeString m_rootName;
+    Common::UnicodeString m_arrayItemName;
+    uint32_t m_attributePrefix;
+    Common::UnicodeString m_textKey;
+    std::vector<NameCacheEntry> m_nameCache;
+    size_t m_nameValidationCount;
+
+    std::string m_inputData;
+    size_t m_inputOffset;
+    bool m_inputFinished;
+    bool m_readingString;
+    Common::Utf8 m_utf8;
+    Common::UnicodeString m_token;
+
+    State m_state;
+    std::vector<Container> m_containerList;
+    Target m_target;
+    Common::UnicodeString m_name;
+    XmlWriter m_xmlWriter;
+    std::string m_output;
+};
+}
+}
+
+#endif // EMBEDDEDSTAX_XMLWRITER_JSONCONVERTER_H
@@ -0,0 +1,107 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#ifndef EMBEDDEDSTAX_XMLWRITER_XMLTEMPLATE_H
+#define EMBEDDEDSTAX_XMLWRITER_XMLTEMPLATE_H
+
+#include <EmbeddedStAX/Common/Common.h>
+#include <EmbeddedStAX/Common/Utf.h>
+#include <vector>
+
+namespace EmbeddedStAX
+{
+namespace XmlWriter
+{
+/**
+ * XML Template class can be used to generate many XML documents with the same structure
+ *
+ * The template is compiled from a skeleton: a XML document (UTF-8 encoded) with holes written as
+ * "${name}" in the text nodes and in the attribute values ("$${" is a literal "${"). The holes are
+ * found in the markup of the skeleton, so a '$' written as a reference is not a part of a hole.
+ * The skeleton is validated with the XML reader and its markup is copied to the static data only
+ * once, so a document is rendered by copying the static data to the output and writing the escaped
+ * values in the holes.
+ */
+class XmlTemplate
+{
+public:
+    // Public types
+    enum HoleType
+    {
+        HoleType_Text,
+        HoleType_AttributeValue
+    };
+
+public:
+    // Public API
+    XmlTemplate();
+    ~XmlTemplate();
+
+    void clear();
+    bool compile(const std::string &skeleton);
+    bool isCompiled() const;
+
+    size_t holeCount() const;
+    size_t findHole(const Common::UnicodeString &name) const;
+    Common::UnicodeString holeName(const size_t index) const;
+    HoleType holeType(const size_t index) const;
+    size_t staticSize() const;
+
+    bool render(const std::vector<Common::UnicodeString> &valueList, std::string *output) const;
+
+private:
+    // Private types
+    struct Segment
+    {
+        size_t size;
+        size_t holeIndex;
+        Common::QuotationMark quotationMark;
+    };
+
+private:
+    // Private API
+    bool compileMarkup(const std::string &markup, const HoleType holeType);
+    bool addHole(const Common::UnicodeString &name, const HoleType holeType,
+                 const Common::QuotationMark quotationMark);
+    static bool containsHole(const std::string &markup);
+    static bool appendValue(const Common::UnicodeString &value,
+                            const Common::QuotationMark quotationMark,
+                            std::string *output);
+
+private:
+    // Private data
+    bool m_compiled;
+    std::string m_staticData;
+    size_t m_segmentStart;
+    std::vector<Segment> m_segmentList;
+    std::vector<Common::UnicodeString> m_holeNameList;
+    std::vector<HoleType> m_holeTypeList;
+};
+}
+}
+
+#endif // EMBEDDEDSTAX_XMLWRITER_XMLTEMPLATE_H
@@ -39,6 +39,11 @@ namespace XmlWriter
 {
 /**
  * XML Writer class can be used to create a XML document
+ *
+ * A XML writer can also write a fragment: a sequence of nodes that is the content of an element at
+ * a known depth in the parent document. Each fragment writer has its own buffer, so fragments of a
+ * large document can be written in parallel (one writer per thread) and then spliced into the
+ * parent document in order with writeFragment().
  */
 class XmlWriter
 {
@@ -50,6 +55,16 @@ public:
 
     void clearDocument();
     Common::UnicodeString xmlString() const;
+    void clearXmlString();
+
+    bool isNameValidationEnabled() const;
+    void setNameValidationEnabled(const bool enabled);
+
+    bool startFragment(const size_t depth);
+    bool isFragment() const;
+    bool isFragmentComplete() const;
+    size_t fragmentDepth() const;
+    size_t depth() const;
 
     bool writeXmlDeclaration();
     bool writeDocumentType(const Common::UnicodeString &documentType);
@@ -62,13 +77,16 @@ public:
     bool writeTextNode(const Common::UnicodeString &text);
     bool writeCDataSection(const Common::UnicodeString &cdata);
     bool writeEndOfElement();
+    bool writeFragment(const XmlWriter &fragment);
+
+    static Common::UnicodeString escapeAttributeValue(const Common::UnicodeString &attributeValue,
+                                                      const Common::QuotationMark quotationMark);
+    static Common::UnicodeString escapeTextNode(const Common::UnicodeString &text);
 
 private:
     // Private API
     bool writeAttributeList(const Common::AttributeList &attributeList);
-    Common::UnicodeString escapeAttributeValue(const Common::UnicodeString &attributeValue,
-                                               const Common::QuotationMark quotationMark) const;
-    Common::UnicodeString escapeTextNode(const Common::UnicodeString &text) const;
+    bool validateName(const Common::UnicodeString &name) const;
 
 private:
     // Private types
@@ -78,12 +96,16 @@ private:
         State_DocumentStarted,
         State_Element,
         State_DocumentEnded,
+        State_Fragment,
         State_Error
     };
 
 private:
     // Private data
     State m_state;
+    bool m_fragment;
+    size_t m_fragmentDepth;
+    bool m_nameValidation;
     Common::UnicodeString m_documentType;
     std::list<Common::UnicodeString> m_openedElementList;
     Common::UnicodeString m_xmlString;
@@ -114,7 +114,7 @@ void Attribute::setName(const UnicodeString &name)
  *
  * \return Attribute value
  */
-UnicodeString Attribute::value() const
+const UnicodeString &Attribute::value() const
 {
     return m_value;
 }
@@ -195,6 +195,16 @@ void AttributeList::clear()
     m_attributeList.clear();
 }
 
+/**
+ * Swap the contents with another list
+ *
+ * \param other The other list
+ */
+void AttributeList::swap(AttributeList &other)
+{
+    m_attributeList.swap(other.m_attributeList);
+}
+
 /**
  * Get size of the list
  */
@@ -36,7 +36,11 @@ using namespace EmbeddedStAX::Common;
  * \param name  Name of the root element
  */
 DocumentType::DocumentType(const UnicodeString &name)
-    : m_name(name)
+    : m_name(name),
+      m_publicId(),
+      m_systemId(),
+      m_elementNameList(),
+      m_elementContentSpecList()
 {
 }
 
@@ -46,7 +50,11 @@ DocumentType::DocumentType(const UnicodeString &name)
  * \param other Document type
  */
 DocumentType::DocumentType(const DocumentType &other)
-    : m_name(other.m_name)
+    : m_name(other.m_name),
+      m_publicId(other.m_publicId),
+      m_systemId(other.m_systemId),
+      m_elementNameList(other.m_elementNameList),
+      m_elementContentSpecList(other.m_elementContentSpecList)
 {
 }
 
@@ -60,6 +68,10 @@ DocumentType &DocumentType::operator=(const DocumentType &other)
     if (this != &other)
     {
         m_name = other.m_name;
+        m_publicId = other.m_publicId;
+        m_systemId = other.m_systemId;
+        m_elementNameList = other.m_elementNameList;
+        m_elementContentSpecList = other.m_elementContentSpecList;
     }
 
     return *this;
@@ -82,6 +94,10 @@ bool DocumentType::isValid() const
 void DocumentType::clear()
 {
     m_name.clear();
+    m_publicId.clear();
+    m_systemId.clear();
+    m_elementNameList.clear();
+    m_elementContentSpecList.clear();
 }
 
 /**
@@ -103,3 +119,96 @@ void DocumentType::setName(const UnicodeString &name)
 {
     m_name = name;
 }
+
+/**
+ * Get public identifier of the external DTD
+ *
+ * \return Public identifier (empty if it is not set)
+ */
+UnicodeString DocumentType::publicId() const
+{
+    return m_publicId;
+}
+
+/**
+ * Get system identifier of the external DTD
+ *
+ * \return System identifier (empty if the document type has no external DTD)
+ */
+UnicodeString DocumentType::systemId() const
+{
+    return m_systemId;
+}
+
+/**
+ * Set external identifier of the external DTD
+ *
+ * \param publicId  Public identifier
+ * \param systemId  System identifier
+ */
+void DocumentType::setExternalId(const UnicodeString &publicId, const UnicodeString &systemId)
+{
+    m_publicId = publicId;
+    m_systemId = systemId;
+}
+
+/**
+ * Get number of element type declarations
+ *
+ * \return Number of element type declarations
+ */
+size_t DocumentType::elementDeclarationCount() const
+{
+    return m_elementNameList.size();
+}
+
+/**
+ * Get name of the declared element
+ *
+ * \param index Index of the element type declaration
+ *
+ * \return Element name (empty if the index is not valid)
+ */
+UnicodeString DocumentType::elementName(const size_t index) const
+{
+    UnicodeString name;
+
+    if (index < m_elementNameList.size())
+    {
+        name = m_elementNameList.at(index);
+    }
+
+    return name;
+}
+
+/**
+ * Get content specification of the declared element
+ *
+ * \param index Index of the element type declaration
+ *
+ * \return Content specification (empty if the index is not valid)
+ */
+UnicodeString DocumentType::elementContentSpec(const size_t index) const
+{
+    UnicodeString contentSpec;
+
+    if (index < m_elementContentSpecList.size())
+    {
+        contentSpec = m_elementContentSpecList.at(index);
+    }
+
+    return contentSpec;
+}
+
+/**
+ * Add element type declaration
+ *
+ * \param name          Element name
+ * \param contentSpec   Content specification (for example "(head, body)")
+ */
+void DocumentType::addElementDeclaration(const UnicodeString &name,
+                                         const UnicodeString &contentSpec)
+{
+    m_elementNameList.push_back(name);
+    m_elementContentSpecList.push_back(contentSpec);
+}
@@ -0,0 +1,251 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include <EmbeddedStAX/Common/HashIndex.h>
+
+using namespace EmbeddedStAX::Common;
+
+/**
+ * Constructor
+ */
+HashIndex::HashIndex()
+    : m_hashList(),
+      m_table(16U, 0U)
+{
+}
+
+/**
+ * Destructor
+ */
+HashIndex::~HashIndex()
+{
+}
+
+/**
+ * Remove all indexes
+ *
+ * \note The hash table is shrunk back to its initial size.
+ */
+void HashIndex::clear()
+{
+    m_hashList.clear();
+    m_table.assign(16U, 0U);
+}
+
+/**
+ * Get number of indexes
+ *
+ * \return Number of items that were added to the index
+ */
+size_t HashIndex::size() const
+{
+    return m_hashList.size();
+}
+
+/**
+ * Get the first slot of the probe sequence of a hash
+ *
+ * \param hash  Hash
+ *
+ * \return Slot where the search for the hash has to start
+ */
+size_t HashIndex::firstSlot(const uint32_t hash) const
+{
+    return static_cast<size_t>(mixHash(hash)) & (m_table.size() - 1U);
+}
+
+/**
+ * Find the next item with the selected hash
+ *
+ * \param hash      Hash
+ * \param slot      Slot where the search starts, it is updated to the slot where the search has
+ *                  to continue
+ * \param index     Output for the index of the item
+ *
+ * \retval true     Item with the same hash found
+ * \retval false    There are no more items with the same hash
+ *
+ * \note The search has to start at firstSlot(). The owner of the list compares the found item and
+ *       calls this method again if it is not the searched item.
+ */
+bool HashIndex::find(const uint32_t hash, size_t *slot, size_t *index) const
+{
+    const size_t mask = m_table.size() - 1U;
+    bool found = false;
+    bool finished = false;
+
+    while (!finished)
+    {
+        const size_t entry = m_table.at(*slot);
+
+        if (entry == 0U)
+        {
+            // Empty slot found, there are no more items with the same hash
+            finished = true;
+        }
+        else
+        {
+            // Check next slot
+            *slot = (*slot + 1U) & mask;
+
+            if (m_hashList.at(entry - 1U) == hash)
+            {
+                // Item with the same hash found
+                *index = entry - 1U;
+                found = true;
+                finished = true;
+            }
+        }
+    }
+
+    return found;
+}
+
+/**
+ * Add the next item to the index
+ *
+ * \param hash  Hash of the item
+ *
+ * \note Index of the item is the number of items that were added before it, so it has to be added
+ *       to the list at the same time. The hash table is doubled when it becomes half full so the
+ *       probe sequences stay short.
+ */
+void HashIndex::add(const uint32_t hash)
+{
+    m_hashList.push_back(hash);
+
+    if ((m_hashList.size() * 2U) > m_table.size())
+    {
+        // Grow the hash table and insert all of the indexes again
+        m_table.assign(m_table.size() * 2U, 0U);
+
+        for (size_t i = 0U; i < m_hashList.size(); i++)
+        {
+            insertIndex(i);
+        }
+    }
+    else
+    {
+        insertIndex(m_hashList.size() - 1U);
+    }
+}
+
+/**
+ * Get initial hash
+ *
+ * \return FNV-1a offset basis
+ */
+uint32_t HashIndex::initialHash()
+{
+    return 2166136261U;
+}
+
+/**
+ * Append a value to a hash
+ *
+ * \param hash  Hash
+ * \param value Value to append (for example a unicode character)
+ *
+ * \return New hash (FNV-1a)
+ */
+uint32_t HashIndex::appendHash(const uint32_t hash, const uint32_t value)
+{
+    return (hash ^ value) * 16777619U;
+}
+
+/**
+ * Append the characters of a string to a hash
+ *
+ * \param hash  Hash
+ * \param value Characters to append
+ *
+ * \return New hash (FNV-1a)
+ */
+uint32_t HashIndex::appendHash(const uint32_t hash, const UnicodeString &value)
+{
+    uint32_t newHash = hash;
+
+    for (size_t i = 0U; i < value.size(); i++)
+    {
+        newHash = appendHash(newHash, value[i]);
+    }
+
+    return newHash;
+}
+
+/**
+ * Calculate hash of a string
+ *
+ * \param value String
+ *
+ * \return FNV-1a hash of the string
+ */
+uint32_t HashIndex::calculateHash(const UnicodeString &value)
+{
+    return appendHash(initialHash(), value);
+}
+
+/**
+ * Insert an index into the hash table
+ *
+ * \param index Index of the item
+ */
+void HashIndex::insertIndex(const size_t index)
+{
+    const size_t mask = m_table.size() - 1U;
+    size_t slot = firstSlot(m_hashList.at(index));
+
+    while (m_table.at(slot) != 0U)
+    {
+        slot = (slot + 1U) & mask;
+    }
+
+    m_table.at(slot) = index + 1U;
+}
+
+/**
+ * Mix the bits of a hash
+ *
+ * \param hash  Hash
+ *
+ * \return Mixed hash
+ *
+ * \note FNV-1a propagates a difference of the input only to the higher bits, the mixing makes all
+ *       bits of the hash affect the low bits that select the slot.
+ */
+uint32_t HashIndex::mixHash(const uint32_t hash)
+{
+    uint32_t value = hash;
+
+    value = value ^ (value >> 16);
+    value = value * 0x85EBCA6BU;
+    value = value ^ (value >> 13);
+    value = value * 0xC2B2AE35U;
+    value = value ^ (value >> 16);
+
+    return value;
+}
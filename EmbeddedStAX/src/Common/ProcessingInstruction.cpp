@@ -97,6 +97,17 @@ void ProcessingInstruction::clear()
     m_piData.clear();
 }
 
+/**
+ * Swap the contents with another processing instruction
+ *
+ * \param other    The other processing instruction
+ */
+void ProcessingInstruction::swap(ProcessingInstruction &other)
+{
+    m_piTarget.swap(other.m_piTarget);
+    m_piData.swap(other.m_piData);
+}
+
 /**
  * Get processing instruction name ("PITarget")
  *
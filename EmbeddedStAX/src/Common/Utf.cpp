@@ -189,6 +189,16 @@ uint32_t Utf8::getChar() const
     return m_char;
 }
 
+/**
+ * Get the size of the incomplete unicode character
+ *
+ * \return Number of bytes of the incomplete unicode character that were already written
+ */
+size_t Utf8::incompleteSize() const
+{
+    return m_index;
+}
+
 /**
  * Convert unicode character to UTF-8 string
  *
@@ -236,7 +246,7 @@ std::string Utf8::toUtf8(const uint32_t unicodeChar)
             ucValue = ucValue >> 6;
         }
 
-        value = value | 0xE0U;
+        value = ucValue | 0xE0U;
         utf8[0] = static_cast<char>(value);
     }
     else if (unicodeChar <= 0x10FFFFU)
@@ -255,7 +265,7 @@ std::string Utf8::toUtf8(const uint32_t unicodeChar)
             ucValue = ucValue >> 6;
         }
 
-        value = value | 0xF0U;
+        value = ucValue | 0xF0U;
         utf8[0] = static_cast<char>(value);
     }
     else
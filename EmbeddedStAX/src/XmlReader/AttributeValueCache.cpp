@@ -0,0 +1,204 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include <EmbeddedStAX/XmlReader/AttributeValueCache.h>
+#include <EmbeddedStAX/Common/HashIndex.h>
+
+using namespace EmbeddedStAX::XmlReader;
+
+/**
+ * Constructor
+ *
+ * \note The cache is disabled (capacity is 0) until the capacity is set.
+ */
+AttributeValueCache::AttributeValueCache()
+    : m_entryList(),
+      m_maxValueSize(0U),
+      m_lookupCount(0U),
+      m_hitCount(0U),
+      m_replacementCount(0U)
+{
+}
+
+/**
+ * Destructor
+ */
+AttributeValueCache::~AttributeValueCache()
+{
+}
+
+/**
+ * Get capacity
+ *
+ * \return Number of entries in the cache
+ */
+size_t AttributeValueCache::capacity() const
+{
+    return m_entryList.size();
+}
+
+/**
+ * Get maximum value size
+ *
+ * \return Maximum number of characters of a cached value
+ */
+size_t AttributeValueCache::maxValueSize() const
+{
+    return m_maxValueSize;
+}
+
+/**
+ * Set capacity
+ *
+ * \param capacity      Number of entries in the cache (rounded up to a power of two, value 0
+ *                      disables the cache)
+ * \param maxValueSize  Maximum number of characters of a cached value
+ *
+ * \note All cached values are removed.
+ */
+void AttributeValueCache::setCapacity(const size_t capacity, const size_t maxValueSize)
+{
+    size_t entryCount = 0U;
+
+    if (capacity > 0U)
+    {
+        entryCount = 1U;
+
+        while (entryCount < capacity)
+        {
+            entryCount *= 2U;
+        }
+    }
+
+    m_entryList.clear();
+    m_entryList.resize(entryCount);
+    m_maxValueSize = maxValueSize;
+    clear();
+}
+
+/**
+ * Remove all cached values
+ *
+ * \note Statistics are not reset.
+ */
+void AttributeValueCache::clear()
+{
+    for (size_t i = 0U; i < m_entryList.size(); i++)
+    {
+        m_entryList[i].used = false;
+        m_entryList[i].hash = 0U;
+        m_entryList[i].value.clear();
+    }
+}
+
+/**
+ * Intern a value
+ *
+ * \param value Value
+ *
+ * \return Cached value equal to the input value or the input value itself if it can not be cached
+ *
+ * \note The returned reference is valid only until the next call to intern(), setCapacity() or
+ *       clear().
+ */
+const EmbeddedStAX::Common::UnicodeString &AttributeValueCache::intern(
+        const Common::UnicodeString &value)
+{
+    const Common::UnicodeString *internedValue = &value;
+
+    if ((!m_entryList.empty()) && (value.size() <= m_maxValueSize))
+    {
+        // Look up the value in its entry
+        const uint32_t hash = Common::HashIndex::calculateHash(value);
+        Entry &entry = m_entryList[static_cast<size_t>(hash) & (m_entryList.size() - 1U)];
+        m_lookupCount++;
+
+        if (entry.used && (entry.hash == hash) && (entry.value == value))
+        {
+            // Value found
+            m_hitCount++;
+        }
+        else
+        {
+            // Value not found, store it in the entry
+            if (entry.used)
+            {
+                m_replacementCount++;
+            }
+
+            entry.used = true;
+            entry.hash = hash;
+            entry.value = value;
+        }
+
+        internedValue = &(entry.value);
+    }
+
+    return *internedValue;
+}
+
+/**
+ * Get lookup count
+ *
+ * \return Number of values that were looked up in the cache
+ */
+size_t AttributeValueCache::lookupCount() const
+{
+    return m_lookupCount;
+}
+
+/**
+ * Get hit count
+ *
+ * \return Number of values that were found in the cache
+ *
+ * \note Hit rate of the cache is hitCount() / lookupCount().
+ */
+size_t AttributeValueCache::hitCount() const
+{
+    return m_hitCount;
+}
+
+/**
+ * Get replacement count
+ *
+ * \return Number of cached values that were replaced with a new value
+ */
+size_t AttributeValueCache::replacementCount() const
+{
+    return m_replacementCount;
+}
+
+/**
+ * Reset statistics
+ */
+void AttributeValueCache::resetStatistics()
+{
+    m_lookupCount = 0U;
+    m_hitCount = 0U;
+    m_replacementCount = 0U;
+}
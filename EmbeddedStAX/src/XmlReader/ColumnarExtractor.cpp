@@ -0,0 +1,813 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include <EmbeddedStAX/XmlReader/ColumnarExtractor.h>
+#include <EmbeddedStAX/XmlReader/PathRouter.h>
+#include <EmbeddedStAX/XmlValidator/Name.h>
+#include <cerrno>
+#include <clocale>
+#include <cstdlib>
+
+using namespace EmbeddedStAX::XmlReader;
+using namespace EmbeddedStAX;
+
+/**
+ * Constructor
+ */
+ColumnarExtractor::ColumnarExtractor()
+    : m_recordPath(),
+      m_recordPathHash(0U),
+      m_fieldList(),
+      m_columnList(),
+      m_batchSize(1024U),
+      m_depth(0U),
+      m_recordDepth(0U),
+      m_textDepthList(),
+      m_textList(),
+      m_attributeValue(),
+      m_number(),
+      m_rowCount(0U),
+      m_conversionErrorCount(0U)
+{
+}
+
+/**
+ * Destructor
+ */
+ColumnarExtractor::~ColumnarExtractor()
+{
+}
+
+/**
+ * Clear the record path, the fields and the current batch
+ */
+void ColumnarExtractor::clear()
+{
+    m_recordPath.clear();
+    m_recordPathHash = 0U;
+    m_fieldList.clear();
+    m_columnList.clear();
+    m_rowCount = 0U;
+    m_conversionErrorCount = 0U;
+    startNewDocument();
+}
+
+/**
+ * Set record path
+ *
+ * \param recordPath    Path of the record element (for example "/export/row")
+ *
+ * \retval true     Success
+ * \retval false    Error, invalid path
+ *
+ * \note The fields and the current batch are cleared.
+ */
+bool ColumnarExtractor::setRecordPath(const Common::UnicodeString &recordPath)
+{
+    bool success = false;
+    clear();
+
+    if ((!recordPath.empty()) && PathRouter::validatePath(recordPath))
+    {
+        m_recordPath = recordPath;
+        m_recordPathHash = XmlReader::calculatePathHash(recordPath);
+        success = true;
+    }
+
+    return success;
+}
+
+/**
+ * Add a field
+ *
+ * \param fieldPath Path of the field relative to the record element ("a/b" for the text of an
+ *                  element, "a/b/@c" for an attribute, "@c" for an attribute of the record element
+ *                  and an empty path for the text of the record element)
+ * \param type      Type of the field's column
+ *
+ * \return Index of the field's column or Common::UnicodeString::npos on error (invalid path, the
+ *         record path is not set or the current batch is not empty)
+ */
+size_t ColumnarExtractor::addField(const Common::UnicodeString &fieldPath, const ColumnType type)
+{
+    size_t index = Common::UnicodeString::npos;
+
+    if ((!m_recordPath.empty()) && (m_rowCount == 0U) && (m_recordDepth == 0U))
+    {
+        Field field;
+        field.path = m_recordPath;
+        field.assigned = false;
+        bool valid = true;
+
+        // Split the attribute name from the element path
+        size_t elementPathSize = fieldPath.size();
+        const size_t attributePosition = fieldPath.find(static_cast<uint32_t>('@'));
+
+        if (attributePosition != Common::UnicodeString::npos)
+        {
+            field.attributeName = fieldPath.substr(attributePosition + 1U);
+            valid = XmlValidator::validateName(field.attributeName);
+
+            if (attributePosition == 0U)
+            {
+                elementPathSize = 0U;
+            }
+            else if (fieldPath.at(attributePosition - 1U) == static_cast<uint32_t>('/'))
+            {
+                elementPathSize = attributePosition - 1U;
+            }
+            else
+            {
+                // Error, attribute has to be a separate path segment
+                valid = false;
+            }
+        }
+
+        if (valid && (elementPathSize > 0U))
+        {
+            field.path.push_back(static_cast<uint32_t>('/'));
+            field.path.append(fieldPath, 0U, elementPathSize);
+            valid = PathRouter::validatePath(field.path);
+        }
+
+        if (valid)
+        {
+            field.pathHash = XmlReader::calculatePathHash(field.path);
+            m_fieldList.push_back(field);
+
+            Column column;
+            column.type = type;
+            m_columnList.push_back(column);
+            clearBatch();
+
+            index = m_columnList.size() - 1U;
+        }
+    }
+
+    return index;
+}
+
+/**
+ * Get number of columns
+ *
+ * \return Number of columns (one for each field)
+ */
+size_t ColumnarExtractor::columnCount() const
+{
+    return m_columnList.size();
+}
+
+/**
+ * Get batch size
+ *
+ * \return Number of rows in a full batch
+ */
+size_t ColumnarExtractor::batchSize() const
+{
+    return m_batchSize;
+}
+
+/**
+ * Set batch size
+ *
+ * \param batchSize Number of rows in a full batch (the column buffers are reserved for it)
+ */
+void ColumnarExtractor::setBatchSize(const size_t batchSize)
+{
+    m_batchSize = batchSize;
+    clearBatch();
+}
+
+/**
+ * Start extracting from a new document
+ *
+ * \note An incomplete record of the previous document is discarded. The rows of the current batch
+ *       are kept.
+ */
+void ColumnarExtractor::startNewDocument()
+{
+    if (m_recordDepth != 0U)
+    {
+        discardRecord();
+    }
+
+    m_depth = 0U;
+    m_recordDepth = 0U;
+    m_textDepthList.clear();
+}
+
+/**
+ * Process an event of the XML reader
+ *
+ * \param xmlReader     XML reader
+ * \param parsingResult Event that was read by the XML reader
+ *
+ * \note Rows are added to the batch even if it is full, so the batch should be taken (and cleared)
+ *       as soon as it is full.
+ */
+void ColumnarExtractor::processEvent(const XmlReader &xmlReader,
+                                    const XmlReader::ParsingResult parsingResult)
+{
+    switch (parsingResult)
+    {
+        case XmlReader::ParsingResult_StartOfElement:
+        {
+            m_depth++;
+
+            if ((m_recordDepth == 0U) &&
+                (xmlReader.pathHash() == m_recordPathHash) &&
+                (!m_recordPath.empty()) &&
+                xmlReader.isCurrentPath(m_recordPath))
+            {
+                // Start of record
+                m_recordDepth = m_depth;
+                startRecord();
+            }
+
+            if (m_recordDepth != 0U)
+            {
+                processStartOfElement(xmlReader);
+            }
+            break;
+        }
+
+        case XmlReader::ParsingResult_EndOfElement:
+        {
+            if (m_recordDepth != 0U)
+            {
+                processEndOfElement(xmlReader);
+
+                if (m_depth == m_recordDepth)
+                {
+                    // End of record
+                    m_recordDepth = 0U;
+                    m_rowCount++;
+                }
+            }
+
+            if (m_depth > 0U)
+            {
+                m_depth--;
+            }
+            break;
+        }
+
+        case XmlReader::ParsingResult_TextNode:
+        case XmlReader::ParsingResult_CData:
+        {
+            if ((!m_textDepthList.empty()) && (m_textDepthList.back() == m_depth))
+            {
+                // Text of the element with a text field
+                appendUtf8(xmlReader.text(), &m_textList.at(m_textDepthList.size() - 1U));
+            }
+            break;
+        }
+
+        default:
+        {
+            // Other events are ignored
+            break;
+        }
+    }
+}
+
+/**
+ * Get number of rows in the current batch
+ *
+ * \return Number of rows
+ */
+size_t ColumnarExtractor::rowCount() const
+{
+    return m_rowCount;
+}
+
+/**
+ * Check if the current batch is full
+ *
+ * \retval true     Batch is full
+ * \retval false    Batch is not full
+ */
+bool ColumnarExtractor::isBatchFull() const
+{
+    return (m_rowCount >= m_batchSize);
+}
+
+/**
+ * Get column buffer of the current batch
+ *
+ * \param index Index of the column
+ *
+ * \return Column buffer
+ *
+ * \note Only the first rowCount() rows are complete, the values of a record that is still being
+ *       read follow them.
+ */
+const ColumnarExtractor::Column &ColumnarExtractor::column(const size_t index) const
+{
+    return m_columnList.at(index);
+}
+
+/**
+ * Check if a value is valid
+ *
+ * \param index Index of the column
+ * \param row   Row
+ *
+ * \retval true     Value is valid
+ * \retval false    Value is null (or the column or the row does not exist)
+ */
+bool ColumnarExtractor::isValid(const size_t index, const size_t row) const
+{
+    bool valid = false;
+
+    if ((index < m_columnList.size()) && (row < m_rowCount))
+    {
+        valid = ((m_columnList[index].validity[row / 8U] & (1U << (row % 8U))) != 0U);
+    }
+
+    return valid;
+}
+
+/**
+ * Clear the current batch
+ *
+ * \note The column buffers keep their capacity, so the next batch is filled without allocations.
+ *       If a record is being read, it is continued in the new batch (without the values that were
+ *       already read).
+ */
+void ColumnarExtractor::clearBatch()
+{
+    for (size_t i = 0U; i < m_columnList.size(); i++)
+    {
+        Column &column = m_columnList[i];
+        column.int64Values.clear();
+        column.doubleValues.clear();
+        column.stringOffsets.clear();
+        column.stringData.clear();
+        column.validity.clear();
+
+        switch (column.type)
+        {
+            case ColumnType_Int64:
+            {
+                column.int64Values.reserve(m_batchSize);
+                break;
+            }
+
+            case ColumnType_Double:
+            {
+                column.doubleValues.reserve(m_batchSize);
+                break;
+            }
+
+            default:
+            {
+                column.stringOffsets.reserve(m_batchSize + 1U);
+                column.stringOffsets.push_back(0U);
+                break;
+            }
+        }
+
+        column.validity.reserve((m_batchSize + 7U) / 8U);
+    }
+
+    m_rowCount = 0U;
+
+    if (m_recordDepth != 0U)
+    {
+        startRecord();
+    }
+}
+
+/**
+ * Get number of conversion errors
+ *
+ * \return Number of values that could not be converted to the column type (they are null)
+ */
+size_t ColumnarExtractor::conversionErrorCount() const
+{
+    return m_conversionErrorCount;
+}
+
+/**
+ * Add a null row for the record to all columns
+ */
+void ColumnarExtractor::startRecord()
+{
+    for (size_t i = 0U; i < m_columnList.size(); i++)
+    {
+        Column &column = m_columnList[i];
+
+        switch (column.type)
+        {
+            case ColumnType_Int64:
+            {
+                column.int64Values.push_back(0);
+                break;
+            }
+
+            case ColumnType_Double:
+            {
+                column.doubleValues.push_back(0.0);
+                break;
+            }
+
+            default:
+            {
+                column.stringOffsets.push_back(static_cast<uint32_t>(column.stringData.size()));
+                break;
+            }
+        }
+
+        if ((m_rowCount % 8U) == 0U)
+        {
+            column.validity.push_back(0U);
+        }
+
+        m_fieldList[i].assigned = false;
+    }
+}
+
+/**
+ * Remove the row of the incomplete record from all columns
+ */
+void ColumnarExtractor::discardRecord()
+{
+    for (size_t i = 0U; i < m_columnList.size(); i++)
+    {
+        Column &column = m_columnList[i];
+
+        switch (column.type)
+        {
+            case ColumnType_Int64:
+            {
+                column.int64Values.resize(m_rowCount);
+                break;
+            }
+
+            case ColumnType_Double:
+            {
+                column.doubleValues.resize(m_rowCount);
+                break;
+            }
+
+            default:
+            {
+                column.stringOffsets.resize(m_rowCount + 1U);
+                column.stringData.resize(column.stringOffsets.back());
+                break;
+            }
+        }
+
+        column.validity.resize((m_rowCount + 7U) / 8U);
+    }
+}
+
+/**
+ * Process start of element inside of a record
+ *
+ * \param xmlReader XML reader
+ */
+void ColumnarExtractor::processStartOfElement(const XmlReader &xmlReader)
+{
+    const uint32_t pathHash = xmlReader.pathHash();
+    const Common::UnicodeString *matchedPath = NULL;
+    bool textField = false;
+
+    for (size_t i = 0U; i < m_fieldList.size(); i++)
+    {
+        const Field &field = m_fieldList[i];
+
+        if ((field.pathHash == pathHash) && (!field.assigned))
+        {
+            // Compare the path with the reader only once for all fields of the element
+            bool pathMatched = ((matchedPath != NULL) && (*matchedPath == field.path));
+
+            if ((!pathMatched) && xmlReader.isCurrentPath(field.path))
+            {
+                matchedPath = &field.path;
+                pathMatched = true;
+            }
+
+            if (!pathMatched)
+            {
+                // Hash collision
+            }
+            else if (field.attributeName.empty())
+            {
+                textField = true;
+            }
+            else
+            {
+                const Common::AttributeList &attributeList = xmlReader.attributeList();
+
+                for (Common::AttributeList::ConstIterator it = attributeList.begin();
+                     it != attributeList.end();
+                     it++)
+                {
+                    if (it->name() == field.attributeName)
+                    {
+                        m_attributeValue.clear();
+                        appendUtf8(it->value(), &m_attributeValue);
+                        assignValue(i, m_attributeValue);
+                    }
+                }
+            }
+        }
+    }
+
+    if (textField)
+    {
+        // Start collecting the text of the element (buffers are reused)
+        m_textDepthList.push_back(m_depth);
+
+        if (m_textList.size() < m_textDepthList.size())
+        {
+            m_textList.push_back(std::string());
+        }
+
+        m_textList.at(m_textDepthList.size() - 1U).clear();
+    }
+}
+
+/**
+ * Process end of element inside of a record
+ *
+ * \param xmlReader XML reader
+ */
+void ColumnarExtractor::processEndOfElement(const XmlReader &xmlReader)
+{
+    if ((!m_textDepthList.empty()) && (m_textDepthList.back() == m_depth))
+    {
+        const uint32_t pathHash = xmlReader.pathHash();
+        const std::string &text = m_textList.at(m_textDepthList.size() - 1U);
+        const Common::UnicodeString *matchedPath = NULL;
+
+        for (size_t i = 0U; i < m_fieldList.size(); i++)
+        {
+            const Field &field = m_fieldList[i];
+
+            if ((field.pathHash == pathHash) &&
+                field.attributeName.empty() &&
+                (!field.assigned))
+            {
+                // Compare the path with the reader only once for all fields of the element
+                bool pathMatched = ((matchedPath != NULL) && (*matchedPath == field.path));
+
+                if ((!pathMatched) && xmlReader.isCurrentPath(field.path))
+                {
+                    matchedPath = &field.path;
+                    pathMatched = true;
+                }
+
+                if (pathMatched)
+                {
+                    assignValue(i, text);
+                }
+            }
+        }
+
+        m_textDepthList.pop_back();
+    }
+}
+
+/**
+ * Assign value to the field in the current row
+ *
+ * \param index Index of the field
+ * \param value Value (UTF-8 encoded)
+ *
+ * \note Only the first value of a field in a record is used.
+ */
+void ColumnarExtractor::assignValue(const size_t index, const std::string &value)
+{
+    Column &column = m_columnList[index];
+    bool valid = false;
+    m_fieldList[index].assigned = true;
+
+    switch (column.type)
+    {
+        case ColumnType_Int64:
+        {
+            valid = parseInt64(value, &column.int64Values.back());
+            break;
+        }
+
+        case ColumnType_Double:
+        {
+            valid = parseDouble(value, &column.doubleValues.back());
+            break;
+        }
+
+        default:
+        {
+            column.stringData.append(value);
+            column.stringOffsets.back() = static_cast<uint32_t>(column.stringData.size());
+            valid = true;
+            break;
+        }
+    }
+
+    if (valid)
+    {
+        column.validity.back() = static_cast<uint8_t>(column.validity.back() |
+                                                      (1U << (m_rowCount % 8U)));
+    }
+    else
+    {
+        m_conversionErrorCount++;
+    }
+}
+
+/**
+ * Append the value to the output (UTF-8 encoded)
+ *
+ * \param value     Value
+ * \param output    Output
+ */
+void ColumnarExtractor::appendUtf8(const Common::UnicodeString &value, std::string *output)
+{
+    for (size_t i = 0U; i < value.size(); i++)
+    {
+        const uint32_t uchar = value[i];
+
+        if (uchar < 0x80U)
+        {
+            output->push_back(static_cast<char>(uchar));
+        }
+        else
+        {
+            output->append(Common::Utf8::toUtf8(uchar));
+        }
+    }
+}
+
+/**
+ * Parse a 64-bit integer
+ *
+ * \param value     Value (optional sign and decimal digits, surrounding whitespace is ignored)
+ * \param number    Output for the number
+ *
+ * \retval true     Success
+ * \retval false    Error, invalid value or the number is out of range
+ */
+bool ColumnarExtractor::parseInt64(const std::string &value, int64_t *number)
+{
+    const size_t startPosition = value.find_first_not_of(" \t\r\n");
+    const size_t endPosition = value.find_last_not_of(" \t\r\n");
+    bool success = (startPosition != std::string::npos);
+    bool negative = false;
+    uint64_t magnitude = 0U;
+    size_t position = startPosition;
+
+    if (success && ((value[position] == '-') || (value[position] == '+')))
+    {
+        negative = (value[position] == '-');
+        position++;
+    }
+
+    if (success && (position > endPosition))
+    {
+        // Error, no digits
+        success = false;
+    }
+
+    // Maximum magnitude (one more for negative numbers)
+    const uint64_t maxMagnitude = (negative ? 9223372036854775808ULL : 9223372036854775807ULL);
+
+    while (success && (position <= endPosition))
+    {
+        const char data = value[position];
+
+        if ((data >= '0') && (data <= '9'))
+        {
+            const uint64_t digit = static_cast<uint64_t>(data - '0');
+
+            if (magnitude > ((maxMagnitude - digit) / 10U))
+            {
+                // Error, out of range
+                success = false;
+            }
+            else
+            {
+                magnitude = (magnitude * 10U) + digit;
+                position++;
+            }
+        }
+        else
+        {
+            // Error, invalid character
+            success = false;
+        }
+    }
+
+    if (success)
+    {
+        if (negative)
+        {
+            *number = static_cast<int64_t>(0U - magnitude);
+        }
+        else
+        {
+            *number = static_cast<int64_t>(magnitude);
+        }
+    }
+
+    return success;
+}
+
+/**
+ * Parse a floating point number
+ *
+ * \param value     Value (decimal floating point number, surrounding whitespace is ignored)
+ * \param number    Output for the number
+ *
+ * \retval true     Success
+ * \retval false    Error, invalid value or the number is out of range
+ *
+ * \note The decimal point is always '.' regardless of the current LC_NUMERIC locale
+ */
+bool ColumnarExtractor::parseDouble(const std::string &value, double *number)
+{
+    const size_t startPosition = value.find_first_not_of(" \t\r\n");
+    const size_t endPosition = value.find_last_not_of(" \t\r\n");
+    bool success = (startPosition != std::string::npos);
+
+    for (size_t i = startPosition; success && (i <= endPosition); i++)
+    {
+        // Only decimal notation is accepted (no hexadecimal numbers, infinity or NaN)
+        const char data = value[i];
+        success = (((data >= '0') && (data <= '9')) ||
+                   (data == '.') || (data == 'e') || (data == 'E') ||
+                   (data == '-') || (data == '+'));
+    }
+
+    if (success)
+    {
+        // The C library converts according to LC_NUMERIC, so the decimal point of the document is
+        // replaced with the one of the current locale (the buffer is reused between the values)
+        const struct lconv * const localeConventions = std::localeconv();
+        const char *decimalPoint = ".";
+
+        if ((localeConventions != NULL) && (localeConventions->decimal_point != NULL) &&
+            (localeConventions->decimal_point[0] != '\0'))
+        {
+            decimalPoint = localeConventions->decimal_point;
+        }
+
+        m_number.clear();
+
+        for (size_t i = startPosition; i <= endPosition; i++)
+        {
+            if (value[i] == '.')
+            {
+                m_number.append(decimalPoint);
+            }
+            else
+            {
+                m_number.push_back(value[i]);
+            }
+        }
+
+        const char *start = m_number.c_str();
+        char *end = NULL;
+        errno = 0;
+        const double result = std::strtod(start, &end);
+
+        if ((end == (start + m_number.size())) && (errno != ERANGE))
+        {
+            *number = result;
+        }
+        else
+        {
+            // Error, invalid number or out of range
+            success = false;
+        }
+    }
+
+    return success;
+}
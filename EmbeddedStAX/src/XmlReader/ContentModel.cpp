@@ -0,0 +1,892 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include <EmbeddedStAX/XmlReader/ContentModel.h>
+#include <EmbeddedStAX/XmlValidator/Common.h>
+#include <EmbeddedStAX/XmlValidator/Name.h>
+#include <algorithm>
+#include <utility>
+
+using namespace EmbeddedStAX::XmlReader;
+
+/**
+ * Constructor
+ */
+ContentModel::ContentModel()
+    : m_type(Type_Empty),
+      m_nodeList(),
+      m_positionNameList(),
+      m_followList(),
+      m_stateList(),
+      m_stateIndex(),
+      m_symbolList(),
+      m_transitionStartList(),
+      m_transitionSymbolList(),
+      m_transitionStateList(),
+      m_acceptingList()
+{
+    clear();
+}
+
+/**
+ * Destructor
+ */
+ContentModel::~ContentModel()
+{
+}
+
+/**
+ * Clear the content model
+ *
+ * \note A cleared content model is an EMPTY content model.
+ */
+void ContentModel::clear()
+{
+    m_type = Type_Empty;
+    m_nodeList.clear();
+    m_positionNameList.clear();
+    m_followList.clear();
+    m_stateList.clear();
+    m_stateIndex.clear();
+    m_symbolList.clear();
+    m_transitionStartList.assign(2U, 0U);
+    m_transitionSymbolList.clear();
+    m_transitionStateList.clear();
+    m_acceptingList.assign(1U, true);
+}
+
+/**
+ * Compile a content model
+ *
+ * \param contentSpec   Content specification in the DTD syntax
+ * \param nameTable     Name table for the element names
+ *
+ * \retval true     Content model compiled
+ * \retval false    Invalid content specification (content model is cleared)
+ *
+ * Format:
+ * \code{.unparsed}
+ * contentspec ::= 'EMPTY' | 'ANY' | Mixed | children
+ * Mixed       ::= '(' S? '#PCDATA' (S? '|' S? Name)* S? ')*' | '(' S? '#PCDATA' S? ')'
+ * children    ::= (choice | seq) ('?' | '*' | '+')?
+ * cp          ::= (Name | choice | seq) ('?' | '*' | '+')?
+ * choice      ::= '(' S? cp ( S? '|' S? cp )+ S? ')'
+ * seq         ::= '(' S? cp ( S? ',' S? cp )* S? ')'
+ * \endcode
+ *
+ * \note Leading and trailing whitespace is ignored. The automaton of a deterministic content model
+ *       has at most one state per name in the model plus the start state. The automaton of a
+ *       non-deterministic content model is also built, but the number of its states is limited to
+ *       the larger of 256 and the number of states of a deterministic model of the same size. The
+ *       number of transitions (and of the follow positions they are built from) is limited to the
+ *       larger of 65536 and 16 per state of a deterministic model of the same size.
+ */
+bool ContentModel::compile(const Common::UnicodeString &contentSpec, NameTable *nameTable)
+{
+    bool success = false;
+    clear();
+
+    if (nameTable != NULL)
+    {
+        const size_t position = skipWhitespace(contentSpec, 0U);
+
+        if (matchKeyword(contentSpec, position, "EMPTY"))
+        {
+            m_type = Type_Empty;
+            success = (skipWhitespace(contentSpec, position + 5U) == contentSpec.size());
+        }
+        else if (matchKeyword(contentSpec, position, "ANY"))
+        {
+            m_type = Type_Any;
+            success = (skipWhitespace(contentSpec, position + 3U) == contentSpec.size());
+        }
+        else if (matchKeyword(contentSpec, position, "("))
+        {
+            if (matchKeyword(contentSpec,
+                             skipWhitespace(contentSpec, position + 1U),
+                             "#PCDATA"))
+            {
+                m_type = Type_Mixed;
+                success = parseMixed(contentSpec, position, nameTable);
+            }
+            else
+            {
+                m_type = Type_Children;
+                success = parseChildren(contentSpec, position, nameTable);
+
+                if (success)
+                {
+                    success = calculatePositionSets();
+                }
+
+                if (success)
+                {
+                    success = buildAutomaton();
+                }
+            }
+        }
+        else
+        {
+            // Error, invalid content specification
+        }
+    }
+
+    // The parse tree and the position sets are only needed to build the automaton
+    m_nodeList.clear();
+    m_positionNameList.clear();
+    m_followList.clear();
+    m_stateList.clear();
+    m_stateIndex.clear();
+
+    if (!success)
+    {
+        clear();
+    }
+
+    return success;
+}
+
+/**
+ * Get type of the content model
+ *
+ * \return Type of the content model
+ */
+ContentModel::Type ContentModel::type() const
+{
+    return m_type;
+}
+
+/**
+ * Check if character data is allowed in the content
+ *
+ * \retval true     Character data is allowed (ANY and mixed content)
+ * \retval false    Only whitespace is allowed (element content) or no content at all (EMPTY)
+ */
+bool ContentModel::isTextAllowed() const
+{
+    return ((m_type == Type_Any) || (m_type == Type_Mixed));
+}
+
+/**
+ * Get number of states of the automaton
+ *
+ * \return Number of states
+ */
+size_t ContentModel::stateCount() const
+{
+    return m_acceptingList.size();
+}
+
+/**
+ * Get number of different child element names in the content model
+ *
+ * \return Number of names
+ */
+size_t ContentModel::symbolCount() const
+{
+    return m_symbolList.size();
+}
+
+/**
+ * Get the next state of the automaton
+ *
+ * \param state     Current state
+ * \param nameId    ID of the name of the child element (from the name table)
+ *
+ * \return Next state
+ * \retval Common::UnicodeString::npos  Child element is not allowed in the current state
+ */
+size_t ContentModel::nextState(const size_t state, const size_t nameId) const
+{
+    size_t next = Common::UnicodeString::npos;
+
+    if (m_type == Type_Any)
+    {
+        next = 0U;
+    }
+    else if (state < stateCount())
+    {
+        const size_t symbol = symbolIndex(nameId);
+
+        if (symbol != Common::UnicodeString::npos)
+        {
+            // Transitions of the state are sorted by the symbol
+            const std::vector<size_t>::const_iterator first =
+                    m_transitionSymbolList.begin() + m_transitionStartList.at(state);
+            const std::vector<size_t>::const_iterator last =
+                    m_transitionSymbolList.begin() + m_transitionStartList.at(state + 1U);
+            const std::vector<size_t>::const_iterator it = std::lower_bound(first, last, symbol);
+
+            if ((it != last) && (*it == symbol))
+            {
+                next = m_transitionStateList.at(
+                        static_cast<size_t>(it - m_transitionSymbolList.begin()));
+            }
+        }
+    }
+    else
+    {
+        // Error, invalid state
+    }
+
+    return next;
+}
+
+/**
+ * Check if the state is an accepting state (the content of the element can end in it)
+ *
+ * \param state     State
+ *
+ * \retval true     Accepting state
+ * \retval false    Not an accepting state or an invalid state
+ */
+bool ContentModel::isAcceptingState(const size_t state) const
+{
+    bool accepting = false;
+
+    if (state < stateCount())
+    {
+        accepting = m_acceptingList.at(state);
+    }
+
+    return accepting;
+}
+
+/**
+ * Parse mixed content specification
+ *
+ * \param contentSpec   Content specification
+ * \param position      Position of the opening parenthesis
+ * \param nameTable     Name table
+ *
+ * \retval true     Success
+ * \retval false    Error
+ */
+bool ContentModel::parseMixed(const Common::UnicodeString &contentSpec,
+                              size_t position,
+                              NameTable *nameTable)
+{
+    bool success = false;
+    bool finished = false;
+    position = skipWhitespace(contentSpec, position + 1U) + 7U;
+
+    while (!finished)
+    {
+        position = skipWhitespace(contentSpec, position);
+        finished = true;
+
+        if (matchKeyword(contentSpec, position, "|"))
+        {
+            Common::UnicodeString name;
+            position = readName(contentSpec, skipWhitespace(contentSpec, position + 1U), &name);
+
+            if (!name.empty())
+            {
+                const size_t nameId = nameTable->add(name);
+
+                if (std::find(m_symbolList.begin(), m_symbolList.end(), nameId) ==
+                    m_symbolList.end())
+                {
+                    m_symbolList.push_back(nameId);
+                    finished = false;
+                }
+                else
+                {
+                    // Error, duplicate name
+                }
+            }
+        }
+        else if (matchKeyword(contentSpec, position, ")*"))
+        {
+            success = (skipWhitespace(contentSpec, position + 2U) == contentSpec.size());
+        }
+        else if (matchKeyword(contentSpec, position, ")") && m_symbolList.empty())
+        {
+            success = (skipWhitespace(contentSpec, position + 1U) == contentSpec.size());
+        }
+        else
+        {
+            // Error, invalid character
+        }
+    }
+
+    if (success)
+    {
+        // Single state that accepts all of the names
+        std::sort(m_symbolList.begin(), m_symbolList.end());
+        m_transitionStartList.clear();
+        m_transitionStartList.push_back(0U);
+        m_transitionStartList.push_back(m_symbolList.size());
+        m_transitionSymbolList.clear();
+        m_transitionStateList.assign(m_symbolList.size(), 0U);
+
+        for (size_t symbol = 0U; symbol < m_symbolList.size(); symbol++)
+        {
+            m_transitionSymbolList.push_back(symbol);
+        }
+    }
+
+    return success;
+}
+
+/**
+ * Parse children content specification
+ *
+ * \param contentSpec   Content specification
+ * \param position      Position of the opening parenthesis
+ * \param nameTable     Name table
+ *
+ * \retval true     Success
+ * \retval false    Error
+ *
+ * \note The parse tree is built without recursion, a node is always added after its parent node.
+ */
+bool ContentModel::parseChildren(const Common::UnicodeString &contentSpec,
+                                 size_t position,
+                                 NameTable *nameTable)
+{
+    std::vector<size_t> groupStack;
+    std::vector<uint32_t> separatorStack;
+    bool expectParticle = true;
+    bool valid = true;
+    bool finished = false;
+
+    while (valid && (!finished))
+    {
+        position = skipWhitespace(contentSpec, position);
+
+        if (position >= contentSpec.size())
+        {
+            // Error, unexpected end of the content specification
+            valid = false;
+        }
+        else if (expectParticle)
+        {
+            Node node;
+            node.type = NodeType_Name;
+            node.position = 0U;
+            node.occurrence = 0U;
+            node.nullable = false;
+
+            if (contentSpec.at(position) == static_cast<uint32_t>('('))
+            {
+                // Start of a group
+                node.type = NodeType_Sequence;
+                position++;
+            }
+            else
+            {
+                Common::UnicodeString name;
+                position = readName(contentSpec, position, &name);
+
+                if (name.empty())
+                {
+                    // Error, name or group expected
+                    valid = false;
+                }
+                else
+                {
+                    node.position = m_positionNameList.size();
+                    m_positionNameList.push_back(nameTable->add(name));
+                    expectParticle = false;
+
+                    if ((position < contentSpec.size()) &&
+                        ((contentSpec.at(position) == static_cast<uint32_t>('?')) ||
+                         (contentSpec.at(position) == static_cast<uint32_t>('*')) ||
+                         (contentSpec.at(position) == static_cast<uint32_t>('+'))))
+                    {
+                        node.occurrence = contentSpec.at(position);
+                        position++;
+                    }
+                }
+            }
+
+            if (valid)
+            {
+                if (!groupStack.empty())
+                {
+                    m_nodeList.at(groupStack.back()).childList.push_back(m_nodeList.size());
+                }
+
+                if (node.type != NodeType_Name)
+                {
+                    groupStack.push_back(m_nodeList.size());
+                    separatorStack.push_back(0U);
+                }
+
+                m_nodeList.push_back(node);
+            }
+        }
+        else
+        {
+            const uint32_t uchar = contentSpec.at(position);
+            position++;
+
+            if ((uchar == static_cast<uint32_t>('|')) || (uchar == static_cast<uint32_t>(',')))
+            {
+                // All separators of a group must be the same
+                if (separatorStack.back() == 0U)
+                {
+                    separatorStack.back() = uchar;
+
+                    if (uchar == static_cast<uint32_t>('|'))
+                    {
+                        m_nodeList.at(groupStack.back()).type = NodeType_Choice;
+                    }
+                }
+
+                valid = (separatorStack.back() == uchar);
+                expectParticle = true;
+            }
+            else if (uchar == static_cast<uint32_t>(')'))
+            {
+                // End of a group
+                Node &group = m_nodeList.at(groupStack.back());
+                groupStack.pop_back();
+                separatorStack.pop_back();
+
+                if ((position < contentSpec.size()) &&
+                    ((contentSpec.at(position) == static_cast<uint32_t>('?')) ||
+                     (contentSpec.at(position) == static_cast<uint32_t>('*')) ||
+                     (contentSpec.at(position) == static_cast<uint32_t>('+'))))
+                {
+                    group.occurrence = contentSpec.at(position);
+                    position++;
+                }
+
+                finished = groupStack.empty();
+            }
+            else
+            {
+                // Error, invalid character
+                valid = false;
+            }
+        }
+    }
+
+    return (valid && (skipWhitespace(contentSpec, position) == contentSpec.size()));
+}
+
+/**
+ * Calculate the nullable flags, the first and last position sets of all nodes and the follow
+ * position sets of all positions
+ *
+ * \retval true     Success
+ * \retval false    Error, too many follow positions
+ *
+ * \note The nodes are processed in reverse order, so the children of a node are processed before
+ *       the node. The start of the content is an additional position after all name positions.
+ */
+bool ContentModel::calculatePositionSets()
+{
+    const size_t startPosition = m_positionNameList.size();
+    size_t followCount = 0U;
+    bool success = true;
+    m_followList.assign(startPosition + 1U, std::vector<size_t>());
+
+    for (size_t index = m_nodeList.size(); success && (index > 0U); index--)
+    {
+        Node &node = m_nodeList.at(index - 1U);
+
+        if (node.type == NodeType_Name)
+        {
+            node.nullable = false;
+            node.firstList.assign(1U, node.position);
+            node.lastList.assign(1U, node.position);
+        }
+        else if (node.type == NodeType_Choice)
+        {
+            node.nullable = false;
+
+            for (size_t i = 0U; i < node.childList.size(); i++)
+            {
+                const Node &child = m_nodeList.at(node.childList.at(i));
+                node.nullable = (node.nullable || child.nullable);
+                mergePositions(child.firstList, &node.firstList);
+                mergePositions(child.lastList, &node.lastList);
+            }
+        }
+        else
+        {
+            const size_t childCount = node.childList.size();
+            bool nullablePrefix = true;
+            bool nullableSuffix = true;
+
+            for (size_t i = 0U; i < childCount; i++)
+            {
+                const Node &child = m_nodeList.at(node.childList.at(i));
+                const Node &reverseChild = m_nodeList.at(node.childList.at(childCount - 1U - i));
+
+                if (nullablePrefix)
+                {
+                    mergePositions(child.firstList, &node.firstList);
+                    nullablePrefix = child.nullable;
+                }
+
+                if (nullableSuffix)
+                {
+                    mergePositions(reverseChild.lastList, &node.lastList);
+                    nullableSuffix = reverseChild.nullable;
+                }
+
+                // Positions that can follow the last positions of the child
+                bool nullableGap = true;
+
+                for (size_t j = i + 1U; success && nullableGap && (j < childCount); j++)
+                {
+                    const Node &nextChild = m_nodeList.at(node.childList.at(j));
+
+                    for (size_t k = 0U; success && (k < child.lastList.size()); k++)
+                    {
+                        success = addFollowPositions(nextChild.firstList,
+                                                     child.lastList.at(k),
+                                                     &followCount);
+                    }
+
+                    nullableGap = nextChild.nullable;
+                }
+            }
+
+            node.nullable = nullablePrefix;
+        }
+
+        // Apply the occurrence of the node
+        if ((node.occurrence == static_cast<uint32_t>('?')) ||
+            (node.occurrence == static_cast<uint32_t>('*')))
+        {
+            node.nullable = true;
+        }
+
+        if ((node.occurrence == static_cast<uint32_t>('*')) ||
+            (node.occurrence == static_cast<uint32_t>('+')))
+        {
+            for (size_t k = 0U; success && (k < node.lastList.size()); k++)
+            {
+                success = addFollowPositions(node.firstList, node.lastList.at(k), &followCount);
+            }
+        }
+    }
+
+    m_followList.at(startPosition) = m_nodeList.at(0U).firstList;
+    return success;
+}
+
+/**
+ * Add positions to the follow position set of a position
+ *
+ * \param positionList  Sorted positions to add
+ * \param position      Position
+ * \param followCount   Total number of follow positions (updated)
+ *
+ * \retval true     Success
+ * \retval false    Error, too many follow positions
+ */
+bool ContentModel::addFollowPositions(const std::vector<size_t> &positionList,
+                                      const size_t position,
+                                      size_t *followCount)
+{
+    std::vector<size_t> &followList = m_followList.at(position);
+    const size_t previousSize = followList.size();
+    mergePositions(positionList, &followList);
+    *followCount += followList.size() - previousSize;
+
+    return (*followCount <= maxTransitionCount(m_positionNameList.size()));
+}
+
+/**
+ * Build the automaton with the subset construction
+ *
+ * \retval true     Success
+ * \retval false    Error, too many states or transitions
+ *
+ * \note Only the transitions that exist are stored, so a long sequence of names does not need a
+ *       table of all states and names.
+ */
+bool ContentModel::buildAutomaton()
+{
+    const size_t startPosition = m_positionNameList.size();
+    const size_t maxStateCount = std::max(static_cast<size_t>(256U), startPosition + 1U);
+    const size_t maxTransitions = maxTransitionCount(startPosition);
+    const Node &root = m_nodeList.at(0U);
+    bool success = true;
+
+    m_symbolList = m_positionNameList;
+    std::sort(m_symbolList.begin(), m_symbolList.end());
+    m_symbolList.erase(std::unique(m_symbolList.begin(), m_symbolList.end()), m_symbolList.end());
+
+    m_acceptingList.clear();
+    m_transitionStartList.clear();
+    m_transitionSymbolList.clear();
+    m_transitionStateList.clear();
+    m_stateList.clear();
+    m_stateIndex.clear();
+    findOrAddState(std::vector<size_t>(1U, startPosition));
+
+    for (size_t state = 0U; success && (state < m_stateList.size()); state++)
+    {
+        const std::vector<size_t> positionSet = m_stateList.at(state);
+        std::vector<std::pair<size_t, size_t> > followList;
+        bool accepting = false;
+
+        for (size_t i = 0U; i < positionSet.size(); i++)
+        {
+            const size_t position = positionSet.at(i);
+
+            if (position == startPosition)
+            {
+                accepting = (accepting || root.nullable);
+            }
+            else if (std::binary_search(root.lastList.begin(), root.lastList.end(), position))
+            {
+                accepting = true;
+            }
+            else
+            {
+                // Not a last position
+            }
+
+            // Collect the following positions with their symbols
+            const std::vector<size_t> &positionFollowList = m_followList.at(position);
+
+            for (size_t j = 0U; j < positionFollowList.size(); j++)
+            {
+                const size_t followPosition = positionFollowList.at(j);
+                const size_t symbol = symbolIndex(m_positionNameList.at(followPosition));
+                followList.push_back(std::make_pair(symbol, followPosition));
+            }
+        }
+
+        m_acceptingList.push_back(accepting);
+        m_transitionStartList.push_back(m_transitionSymbolList.size());
+
+        // Following positions grouped by the symbol are the position sets of the next states
+        std::sort(followList.begin(), followList.end());
+        followList.erase(std::unique(followList.begin(), followList.end()), followList.end());
+        size_t index = 0U;
+
+        while (success && (index < followList.size()))
+        {
+            const size_t symbol = followList.at(index).first;
+            std::vector<size_t> nextSet;
+
+            while ((index < followList.size()) && (followList.at(index).first == symbol))
+            {
+                nextSet.push_back(followList.at(index).second);
+                index++;
+            }
+
+            const size_t nextState = findOrAddState(nextSet);
+            m_transitionSymbolList.push_back(symbol);
+            m_transitionStateList.push_back(nextState);
+            success = ((m_stateList.size() <= maxStateCount) &&
+                       (m_transitionSymbolList.size() <= maxTransitions));
+        }
+    }
+
+    m_transitionStartList.push_back(m_transitionSymbolList.size());
+    return success;
+}
+
+/**
+ * Get the maximum number of transitions of an automaton
+ *
+ * \param positionCount Number of name positions in the content model
+ *
+ * \return Maximum number of transitions (also used for the follow positions)
+ */
+size_t ContentModel::maxTransitionCount(const size_t positionCount)
+{
+    return std::max(static_cast<size_t>(65536U), (positionCount + 1U) * 16U);
+}
+
+/**
+ * Find the state of a position set or add a new state for it
+ *
+ * \param positionSet   Sorted set of positions
+ *
+ * \return State
+ */
+size_t ContentModel::findOrAddState(const std::vector<size_t> &positionSet)
+{
+    const uint32_t hash = calculatePositionSetHash(positionSet);
+    size_t slot = m_stateIndex.firstSlot(hash);
+    size_t index = 0U;
+    size_t state = Common::UnicodeString::npos;
+
+    while ((state == Common::UnicodeString::npos) && m_stateIndex.find(hash, &slot, &index))
+    {
+        if (m_stateList.at(index) == positionSet)
+        {
+            state = index;
+        }
+    }
+
+    if (state == Common::UnicodeString::npos)
+    {
+        state = m_stateList.size();
+        m_stateList.push_back(positionSet);
+        m_stateIndex.add(hash);
+    }
+
+    return state;
+}
+
+/**
+ * Calculate hash of a position set
+ *
+ * \param positionSet   Sorted set of positions
+ *
+ * \return Hash of the position set
+ */
+uint32_t ContentModel::calculatePositionSetHash(const std::vector<size_t> &positionSet)
+{
+    uint32_t hash = Common::HashIndex::initialHash();
+
+    for (size_t i = 0U; i < positionSet.size(); i++)
+    {
+        hash = Common::HashIndex::appendHash(hash, static_cast<uint32_t>(positionSet.at(i)));
+    }
+
+    return hash;
+}
+
+/**
+ * Get index of a name in the list of symbols of the automaton
+ *
+ * \param nameId    ID of the name
+ *
+ * \return Index of the symbol or Common::UnicodeString::npos if the name is not used
+ */
+size_t ContentModel::symbolIndex(const size_t nameId) const
+{
+    size_t index = Common::UnicodeString::npos;
+    const std::vector<size_t>::const_iterator it =
+            std::lower_bound(m_symbolList.begin(), m_symbolList.end(), nameId);
+
+    if ((it != m_symbolList.end()) && (*it == nameId))
+    {
+        index = static_cast<size_t>(it - m_symbolList.begin());
+    }
+
+    return index;
+}
+
+/**
+ * Skip whitespace
+ *
+ * \param contentSpec   Content specification
+ * \param position      Start position
+ *
+ * \return Position of the first non-whitespace character (or size of the content specification)
+ */
+size_t ContentModel::skipWhitespace(const Common::UnicodeString &contentSpec, size_t position)
+{
+    while ((position < contentSpec.size()) && XmlValidator::isWhitespace(contentSpec.at(position)))
+    {
+        position++;
+    }
+
+    return position;
+}
+
+/**
+ * Check if the keyword is at the selected position
+ *
+ * \param contentSpec   Content specification
+ * \param position      Position
+ * \param keyword       Keyword (ASCII)
+ *
+ * \retval true     Keyword matched
+ * \retval false    Keyword not matched
+ */
+bool ContentModel::matchKeyword(const Common::UnicodeString &contentSpec,
+                                const size_t position,
+                                const char *keyword)
+{
+    bool match = true;
+    size_t i = 0U;
+
+    while (match && (keyword[i] != '\0'))
+    {
+        match = (((position + i) < contentSpec.size()) &&
+                 (contentSpec.at(position + i) == static_cast<uint32_t>(keyword[i])));
+        i++;
+    }
+
+    return match;
+}
+
+/**
+ * Read a name
+ *
+ * \param contentSpec   Content specification
+ * \param position      Start position
+ * \param name          Output for the name (empty if there is no name at the position)
+ *
+ * \return Position after the name
+ */
+size_t ContentModel::readName(const Common::UnicodeString &contentSpec,
+                              size_t position,
+                              Common::UnicodeString *name)
+{
+    const size_t startPosition = position;
+
+    if ((position < contentSpec.size()) && XmlValidator::isNameStartChar(contentSpec.at(position)))
+    {
+        position++;
+
+        while ((position < contentSpec.size()) &&
+               XmlValidator::isNameChar(contentSpec.at(position)))
+        {
+            position++;
+        }
+    }
+
+    *name = contentSpec.substr(startPosition, position - startPosition);
+    return position;
+}
+
+/**
+ * Merge positions into a sorted set of positions
+ *
+ * \param positionList  Positions
+ * \param positionSet   Sorted set of positions
+ */
+void ContentModel::mergePositions(const std::vector<size_t> &positionList,
+                                  std::vector<size_t> *positionSet)
+{
+    for (size_t i = 0U; i < positionList.size(); i++)
+    {
+        const std::vector<size_t>::iterator it =
+                std::lower_bound(positionSet->begin(), positionSet->end(), positionList.at(i));
+
+        if ((it == positionSet->end()) || (*it != positionList.at(i)))
+        {
+            positionSet->insert(it, positionList.at(i));
+        }
+    }
+}
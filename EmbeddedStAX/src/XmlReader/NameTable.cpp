@@ -0,0 +1,126 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include <EmbeddedStAX/XmlReader/NameTable.h>
+
+using namespace EmbeddedStAX::XmlReader;
+
+/**
+ * Constructor
+ */
+NameTable::NameTable()
+    : m_nameList(),
+      m_nameIndex()
+{
+}
+
+/**
+ * Destructor
+ */
+NameTable::~NameTable()
+{
+}
+
+/**
+ * Remove all names
+ */
+void NameTable::clear()
+{
+    m_nameList.clear();
+    m_nameIndex.clear();
+}
+
+/**
+ * Get number of names
+ *
+ * \return Number of names
+ */
+size_t NameTable::size() const
+{
+    return m_nameList.size();
+}
+
+/**
+ * Add a name
+ *
+ * \param name  Name
+ *
+ * \return ID of the name (ID of the existing name if the name was already added)
+ */
+size_t NameTable::add(const Common::UnicodeString &name)
+{
+    size_t id = find(name);
+
+    if (id == Common::UnicodeString::npos)
+    {
+        id = m_nameList.size();
+        m_nameList.push_back(name);
+        m_nameIndex.add(Common::HashIndex::calculateHash(name));
+    }
+
+    return id;
+}
+
+/**
+ * Find a name
+ *
+ * \param name  Name
+ *
+ * \return ID of the name or Common::UnicodeString::npos if the name was not added
+ */
+size_t NameTable::find(const Common::UnicodeString &name) const
+{
+    const uint32_t hash = Common::HashIndex::calculateHash(name);
+    size_t slot = m_nameIndex.firstSlot(hash);
+    size_t index = 0U;
+    size_t id = Common::UnicodeString::npos;
+
+    while ((id == Common::UnicodeString::npos) && m_nameIndex.find(hash, &slot, &index))
+    {
+        if (m_nameList.at(index) == name)
+        {
+            // Name found
+            id = index;
+        }
+    }
+
+    return id;
+}
+
+/**
+ * Get name
+ *
+ * \param id    ID of the name
+ *
+ * \return Name
+ *
+ * \note ID must be valid!
+ */
+const EmbeddedStAX::Common::UnicodeString &NameTable::name(const size_t id) const
+{
+    return m_nameList.at(id);
+}
@@ -1,4 +1,5 @@
 #include <EmbeddedStAX/XmlReader/ParsingBuffer.h>
+#include <cstring>
 
 using namespace EmbeddedStAX::XmlReader;
 
@@ -8,7 +9,15 @@ using namespace EmbeddedStAX::XmlReader;
 ParsingBuffer::ParsingBuffer()
     : m_utf8(),
       m_buffer(),
-      m_position(0U)
+      m_start(0U),
+      m_position(0U),
+      m_readLimit(Common::UnicodeString::npos),
+      m_erasedSize(0U),
+      m_erasedByteCount(0U),
+      m_lineTracking(false),
+      m_erasedLinesCounted(true),
+      m_erasedLineCount(0U),
+      m_erasedLineStart(0U)
 {
 }
 
@@ -19,7 +28,7 @@ ParsingBuffer::ParsingBuffer()
  */
 size_t ParsingBuffer::size() const
 {
-    return m_buffer.size();
+    return (m_buffer.size() - m_start);
 }
 
 /**
@@ -31,7 +40,14 @@ void ParsingBuffer::clear()
 {
     m_utf8.clear();
     m_buffer.clear();
+    m_start = 0U;
     m_position = 0U;
+    m_readLimit = Common::UnicodeString::npos;
+    m_erasedSize = 0U;
+    m_erasedByteCount = 0U;
+    m_erasedLinesCounted = true;
+    m_erasedLineCount = 0U;
+    m_erasedLineStart = 0U;
 }
 
 /**
@@ -43,7 +59,15 @@ void ParsingBuffer::clear()
  */
 void ParsingBuffer::erase(const size_t size)
 {
-    m_buffer.erase(0U, size);
+    size_t end = m_buffer.size();
+
+    if (size < this->size())
+    {
+        end = m_start + size;
+    }
+
+    m_erasedByteCount += Common::Utf8::calculateSize(m_buffer, m_start, end);
+    m_start = end;
     m_position = 0U;
 }
 
@@ -54,7 +78,8 @@ void ParsingBuffer::erase(const size_t size)
  */
 void ParsingBuffer::eraseToCurrentPosition()
 {
-    m_buffer.erase(0U, m_position);
+    m_erasedByteCount += Common::Utf8::calculateSize(m_buffer, m_start, m_start + m_position);
+    m_start += m_position;
     m_position = 0U;
 }
 
@@ -70,9 +95,9 @@ uint32_t ParsingBuffer::at(const size_t position) const
 {
     uint32_t value = 0U;
 
-    if (position < m_buffer.size())
+    if (position < size())
     {
-        value = m_buffer.at(position);
+        value = m_buffer[m_start + position];
     }
 
     return value;
@@ -88,9 +113,9 @@ uint32_t ParsingBuffer::firstChar() const
 {
     uint32_t value = 0U;
 
-    if (!m_buffer.empty())
+    if (m_start < m_buffer.size())
     {
-        value = m_buffer.at(0U);
+        value = m_buffer[m_start];
     }
 
     return value;
@@ -107,9 +132,9 @@ uint32_t ParsingBuffer::currentChar() const
 {
     uint32_t value = 0U;
 
-    if (!m_buffer.empty() && !isMoreDataNeeded())
+    if (!isMoreDataNeeded())
     {
-        value = m_buffer.at(m_position);
+        value = m_buffer[m_start + m_position];
     }
 
     return value;
@@ -127,7 +152,7 @@ bool ParsingBuffer::isMoreDataNeeded() const
 {
     bool moreDataNeeded = true;
 
-    if (m_position < m_buffer.size())
+    if ((m_start + m_position) < readEnd())
     {
         moreDataNeeded = false;
     }
@@ -157,13 +182,13 @@ bool ParsingBuffer::setCurrentPosition(const size_t position)
 {
     bool success = false;
 
-    if (position <= m_buffer.size())
+    if (position <= size())
     {
         m_position = position;
         success = true;
     }
 
-    return position;
+    return success;
 }
 
 /**
@@ -171,12 +196,228 @@ bool ParsingBuffer::setCurrentPosition(const size_t position)
  */
 void ParsingBuffer::incrementPosition()
 {
-    if (m_position < m_buffer.size())
+    if ((m_start + m_position) < readEnd())
     {
         m_position++;
     }
 }
 
+/**
+ * Increment current position past all whitespace characters
+ *
+ * \return Number of whitespace characters that were skipped
+ *
+ * \note The scan stops at the first non-whitespace character or at the end of the buffer (or at the
+ *       read limit).
+ */
+size_t ParsingBuffer::skipWhitespace()
+{
+    const size_t startPosition = m_position;
+    const size_t endIndex = readEnd();
+    size_t index = m_start + m_position;
+    bool whitespace = true;
+
+    while (whitespace && (index < endIndex))
+    {
+        const uint32_t uchar = m_buffer[index];
+
+        if ((uchar == 0x20U) || (uchar == 0x0AU) || (uchar == 0x09U) || (uchar == 0x0DU))
+        {
+            index++;
+        }
+        else
+        {
+            whitespace = false;
+        }
+    }
+
+    m_position = index - m_start;
+    return (m_position - startPosition);
+}
+
+/**
+ * Increment current position to the next occurrence of the selected character
+ *
+ * \param uchar Character to search for
+ *
+ * \return Number of characters that were skipped
+ *
+ * \note The scan stops at the selected character or at the end of the buffer (or at the read
+ *       limit).
+ */
+size_t ParsingBuffer::skipToCharacter(const uint32_t uchar)
+{
+    const size_t startPosition = m_position;
+    const size_t endIndex = readEnd();
+    size_t index = m_start + m_position;
+
+    while ((index < endIndex) && (m_buffer[index] != uchar))
+    {
+        index++;
+    }
+
+    m_position = index - m_start;
+    return (m_position - startPosition);
+}
+
+/**
+ * Check if the characters at the current position match the value
+ *
+ * \param value Value to compare (it should not be empty)
+ *
+ * \retval true     Characters match and at least one more character can be read after them
+ * \retval false    Characters do not match or not enough characters can be read
+ *
+ * \note Characters are compared with a single memory comparison, the current position is not
+ *       changed.
+ */
+bool ParsingBuffer::matchesCurrentPosition(const Common::UnicodeString &value) const
+{
+    bool match = false;
+    const size_t index = m_start + m_position;
+
+    if ((!value.empty()) && ((index + value.size()) < readEnd()))
+    {
+        match = (std::memcmp(&m_buffer[index],
+                             value.data(),
+                             value.size() * sizeof(uint32_t)) == 0);
+    }
+
+    return match;
+}
+
+/**
+ * Set read limit
+ *
+ * \param size  Number of characters that can be read after the current position
+ *
+ * \note Characters past the read limit are handled as if they were not written to the buffer yet.
+ */
+void ParsingBuffer::setReadLimit(const size_t size)
+{
+    m_readLimit = m_start + m_position + size;
+}
+
+/**
+ * Remove read limit
+ */
+void ParsingBuffer::clearReadLimit()
+{
+    m_readLimit = Common::UnicodeString::npos;
+}
+
+/**
+ * Check if read limit was reached
+ *
+ * \retval true     Current position is at the read limit and there is more data in the buffer
+ * \retval false    Read limit was not reached or there is no data after the read limit
+ */
+bool ParsingBuffer::isReadLimitReached() const
+{
+    const size_t index = m_start + m_position;
+    return ((index >= m_readLimit) && (index < m_buffer.size()));
+}
+
+/**
+ * Get character offset
+ *
+ * \param position  Position in the buffer
+ *
+ * \return Number of characters in the data stream before the selected position
+ *
+ * \note The offset is counted from the last time the buffer was cleared.
+ */
+size_t ParsingBuffer::characterOffset(const size_t position) const
+{
+    return (m_erasedSize + m_start + position);
+}
+
+/**
+ * Get byte offset
+ *
+ * \param position  Position in the buffer
+ *
+ * \return Number of UTF-8 bytes in the data stream before the selected position
+ *
+ * \note The size of the erased characters is counted when they are erased, so only the characters
+ *       between the start of the buffer and the selected position have to be measured.
+ */
+size_t ParsingBuffer::byteOffset(const size_t position) const
+{
+    return (m_erasedByteCount + Common::Utf8::calculateSize(m_buffer, m_start, m_start + position));
+}
+
+/**
+ * Check if line tracking is enabled
+ *
+ * \retval true     Line tracking is enabled
+ * \retval false    Line tracking is disabled
+ */
+bool ParsingBuffer::isLineTrackingEnabled() const
+{
+    return m_lineTracking;
+}
+
+/**
+ * Enable or disable line tracking
+ *
+ * \param enabled   Enable line tracking
+ *
+ * \note Line tracking should be enabled before data is written to the buffer (or right after it is
+ *       cleared), otherwise the lines of the characters that were already removed from the storage
+ *       are not known.
+ */
+void ParsingBuffer::setLineTrackingEnabled(const bool enabled)
+{
+    m_lineTracking = enabled;
+}
+
+/**
+ * Calculate line and column number
+ *
+ * \param position  Position in the buffer
+ * \param line      Output for the line number (first line is 1)
+ * \param column    Output for the column number in characters (first column is 1)
+ *
+ * \retval true     Line and column number calculated
+ * \retval false    Lines of the removed characters are not known (line tracking is disabled)
+ *
+ * \note Only line feed characters are counted as newlines.
+ */
+bool ParsingBuffer::calculateLineAndColumn(const size_t position,
+                                           size_t *line,
+                                           size_t *column) const
+{
+    bool success = false;
+
+    if (m_erasedLinesCounted && (line != NULL) && (column != NULL))
+    {
+        size_t endIndex = m_start + position;
+        size_t lineCount = m_erasedLineCount;
+        size_t lineStart = m_erasedLineStart;
+
+        if (endIndex > m_buffer.size())
+        {
+            endIndex = m_buffer.size();
+        }
+
+        for (size_t i = 0U; i < endIndex; i++)
+        {
+            if (m_buffer[i] == 0x0AU)
+            {
+                lineCount++;
+                lineStart = m_erasedSize + i + 1U;
+            }
+        }
+
+        *line = lineCount + 1U;
+        *column = (m_erasedSize + endIndex) - lineStart + 1U;
+        success = true;
+    }
+
+    return success;
+}
+
 /**
  * Get substring from the buffer
  *
@@ -190,9 +431,9 @@ EmbeddedStAX::Common::UnicodeString ParsingBuffer::substring(const size_t positi
 {
     Common::UnicodeString data;
 
-    if (position < m_buffer.size())
+    if (position < this->size())
     {
-        data = m_buffer.substr(position, size);
+        data = m_buffer.substr(m_start + position, size);
     }
 
     return data;
@@ -206,12 +447,29 @@ EmbeddedStAX::Common::UnicodeString ParsingBuffer::substring(const size_t positi
  * \return Number of character written
  */
 size_t ParsingBuffer::writeData(const std::string &data)
+{
+    return writeData(data.data(), data.size());
+}
+
+/**
+ * Write data to buffer
+ *
+ * \param data  Pointer to UTF-8 encoded data
+ * \param size  Size of the data (in bytes)
+ *
+ * \return Number of character written
+ *
+ * \note This can be used to write data directly from an externally owned buffer (for example a
+ *       memory mapped file) without first copying it to a string.
+ */
+size_t ParsingBuffer::writeData(const char *data, const size_t size)
 {
     size_t charactersWritten = 0U;
+    compact();
 
-    for (size_t i = 0U; i < data.size(); i++)
+    for (size_t i = 0U; (data != NULL) && (i < size); i++)
     {
-        const Common::Utf8::Result result = m_utf8.write(data.at(i));
+        const Common::Utf8::Result result = m_utf8.write(data[i]);
 
         if (result == Common::Utf8::Result_Success)
         {
@@ -233,3 +491,97 @@ size_t ParsingBuffer::writeData(const std::string &data)
 
     return charactersWritten;
 }
+
+/**
+ * Remove the erased characters from the storage
+ *
+ * \note The storage is compacted only if at least half of it is erased, so that the cost of
+ *       moving the remaining characters is covered by the erased characters.
+ */
+void ParsingBuffer::compact()
+{
+    size_t erasedSize = 0U;
+
+    if (m_start == m_buffer.size())
+    {
+        countErasedLines(m_start);
+        m_buffer.clear();
+        erasedSize = m_start;
+        m_start = 0U;
+    }
+    else if ((m_start > 0U) && (m_start >= (m_buffer.size() - m_start)))
+    {
+        countErasedLines(m_start);
+        m_buffer.erase(0U, m_start);
+        erasedSize = m_start;
+        m_start = 0U;
+    }
+    else
+    {
+        // Nothing to do
+    }
+
+    // Move the read limit with the remaining characters
+    if (m_readLimit == Common::UnicodeString::npos)
+    {
+        // No read limit
+    }
+    else if (m_readLimit > erasedSize)
+    {
+        m_readLimit -= erasedSize;
+    }
+    else
+    {
+        m_readLimit = 0U;
+    }
+
+    m_erasedSize += erasedSize;
+}
+
+/**
+ * Count the newlines in the characters that are removed from the storage
+ *
+ * \param size  Number of characters that are removed from the start of the storage
+ *
+ * \note Newlines are counted only when line tracking is enabled, otherwise the line numbers are
+ *       not known anymore after the characters are removed.
+ */
+void ParsingBuffer::countErasedLines(const size_t size)
+{
+    if (size == 0U)
+    {
+        // Nothing to do
+    }
+    else if (m_lineTracking)
+    {
+        for (size_t i = 0U; i < size; i++)
+        {
+            if (m_buffer[i] == 0x0AU)
+            {
+                m_erasedLineCount++;
+                m_erasedLineStart = m_erasedSize + i + 1U;
+            }
+        }
+    }
+    else
+    {
+        m_erasedLinesCounted = false;
+    }
+}
+
+/**
+ * Get the end of the readable part of the storage
+ *
+ * \return Index in the storage of the first character that can not be read
+ */
+size_t ParsingBuffer::readEnd() const
+{
+    size_t end = m_buffer.size();
+
+    if (m_readLimit < end)
+    {
+        end = m_readLimit;
+    }
+
+    return end;
+}
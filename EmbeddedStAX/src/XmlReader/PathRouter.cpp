@@ -0,0 +1,211 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include <EmbeddedStAX/XmlReader/PathRouter.h>
+#include <EmbeddedStAX/XmlValidator/Name.h>
+
+using namespace EmbeddedStAX::XmlReader;
+
+/**
+ * Destructor
+ */
+AbstractPathHandler::~AbstractPathHandler()
+{
+}
+
+/**
+ * Constructor
+ */
+PathRouter::PathRouter()
+    : m_routeList(),
+      m_routeIndex()
+{
+}
+
+/**
+ * Destructor
+ */
+PathRouter::~PathRouter()
+{
+}
+
+/**
+ * Remove all routes
+ */
+void PathRouter::clear()
+{
+    m_routeList.clear();
+    m_routeIndex.clear();
+}
+
+/**
+ * Get number of routes
+ *
+ * \return Number of routes
+ */
+size_t PathRouter::size() const
+{
+    return m_routeList.size();
+}
+
+/**
+ * Add a route
+ *
+ * \param path      Element path (for example "/a/b/c")
+ * \param handler   Handler of the events of the path
+ *
+ * \retval true     Route added
+ * \retval false    Invalid path or handler, or a route for the path already exists
+ *
+ * \note The handler is not owned by the router.
+ */
+bool PathRouter::addRoute(const Common::UnicodeString &path, AbstractPathHandler *handler)
+{
+    bool success = false;
+
+    if ((handler != NULL) && validatePath(path))
+    {
+        const uint32_t pathHash = XmlReader::calculatePathHash(path);
+        size_t slot = m_routeIndex.firstSlot(pathHash);
+        size_t index = 0U;
+        success = true;
+
+        // Check for an existing route of the path
+        while (success && m_routeIndex.find(pathHash, &slot, &index))
+        {
+            if (m_routeList.at(index).path == path)
+            {
+                // Error, route already exists
+                success = false;
+            }
+        }
+
+        if (success)
+        {
+            Route route;
+            route.path = path;
+            route.handler = handler;
+            m_routeList.push_back(route);
+            m_routeIndex.add(pathHash);
+        }
+    }
+
+    return success;
+}
+
+/**
+ * Get the handler of the current element path of the XML reader
+ *
+ * \param xmlReader XML reader
+ *
+ * \return Handler of the path or NULL if there is no route for the path
+ */
+AbstractPathHandler *PathRouter::handler(const XmlReader &xmlReader) const
+{
+    AbstractPathHandler *pathHandler = NULL;
+    const uint32_t pathHash = xmlReader.pathHash();
+    size_t slot = m_routeIndex.firstSlot(pathHash);
+    size_t index = 0U;
+
+    while ((pathHandler == NULL) && m_routeIndex.find(pathHash, &slot, &index))
+    {
+        const Route &route = m_routeList.at(index);
+
+        if (xmlReader.isCurrentPath(route.path))
+        {
+            // Route found
+            pathHandler = route.handler;
+        }
+    }
+
+    return pathHandler;
+}
+
+/**
+ * Route the last event of the XML reader to the handler of the current element path
+ *
+ * \param xmlReader     XML reader
+ * \param parsingResult Parsing result of the event
+ *
+ * \retval true     Event was passed to a handler
+ * \retval false    There is no route for the path
+ */
+bool PathRouter::route(const XmlReader &xmlReader,
+                       const XmlReader::ParsingResult parsingResult) const
+{
+    bool success = false;
+    AbstractPathHandler *pathHandler = handler(xmlReader);
+
+    if (pathHandler != NULL)
+    {
+        pathHandler->handleEvent(xmlReader, parsingResult);
+        success = true;
+    }
+
+    return success;
+}
+
+/**
+ * Validate a path
+ *
+ * \param path  Element path
+ *
+ * \retval true     Valid path
+ * \retval false    Invalid path
+ *
+ * Format:
+ * \code{.unparsed}
+ * Path ::= ('/' Name)+
+ * \endcode
+ */
+bool PathRouter::validatePath(const Common::UnicodeString &path)
+{
+    bool valid = (!path.empty());
+    size_t position = 0U;
+
+    while (valid && (position < path.size()))
+    {
+        if (path.at(position) == static_cast<uint32_t>('/'))
+        {
+            // Validate the name of the path segment
+            position++;
+            const size_t endPosition = path.find(static_cast<uint32_t>('/'), position);
+            const size_t size = ((endPosition == Common::UnicodeString::npos) ?
+                                         (path.size() - position) :
+                                         (endPosition - position));
+
+            valid = XmlValidator::validateName(path.substr(position, size));
+            position += size;
+        }
+        else
+        {
+            valid = false;
+        }
+    }
+
+    return valid;
+}
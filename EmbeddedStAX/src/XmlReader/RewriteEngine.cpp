@@ -0,0 +1,680 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include <EmbeddedStAX/XmlReader/RewriteEngine.h>
+#include <EmbeddedStAX/XmlReader/PathRouter.h>
+#include <EmbeddedStAX/XmlValidator/Name.h>
+#include <EmbeddedStAX/XmlWriter/XmlWriter.h>
+
+using namespace EmbeddedStAX::XmlReader;
+
+/**
+ * Constructor
+ */
+RewriteEngine::RewriteEngine()
+    : m_pathRulesList(),
+      m_pathRulesIndex(),
+      m_ruleCount(0U),
+      m_xmlReader(),
+      m_inputData(),
+      m_inputOffset(0U),
+      m_copiedOffset(0U),
+      m_eventEnd(0U),
+      m_dropDepth(0U),
+      m_textMasked(false),
+      m_output(),
+      m_copiedSize(0U),
+      m_rewrittenEventCount(0U)
+{
+}
+
+/**
+ * Destructor
+ */
+RewriteEngine::~RewriteEngine()
+{
+}
+
+/**
+ * Remove all rules and start a new stream
+ */
+void RewriteEngine::clear()
+{
+    m_pathRulesList.clear();
+    m_pathRulesIndex.clear();
+    m_ruleCount = 0U;
+    startNewStream();
+}
+
+/**
+ * Get number of rules
+ *
+ * \return Number of rules
+ */
+size_t RewriteEngine::ruleCount() const
+{
+    return m_ruleCount;
+}
+
+/**
+ * Add a rule that renames the element
+ *
+ * \param path  Element path (for example "/a/b/c")
+ * \param name  New name of the element
+ *
+ * \retval true     Rule added
+ * \retval false    Invalid path or name, or the element is already renamed
+ */
+bool RewriteEngine::addRenameRule(const Common::UnicodeString &path,
+                                  const Common::UnicodeString &name)
+{
+    bool success = false;
+
+    if (XmlValidator::validateName(name))
+    {
+        PathRules *pathRules = addPathRules(path);
+
+        if ((pathRules != NULL) && pathRules->name.empty())
+        {
+            pathRules->name = name;
+            m_ruleCount++;
+            success = true;
+        }
+    }
+
+    return success;
+}
+
+/**
+ * Add a rule that drops the element with all of its content
+ *
+ * \param path  Element path (for example "/a/b/c")
+ *
+ * \retval true     Rule added
+ * \retval false    Invalid path or the element is already dropped
+ *
+ * \note The other rules of a dropped element are not applied.
+ */
+bool RewriteEngine::addDropRule(const Common::UnicodeString &path)
+{
+    bool success = false;
+    PathRules *pathRules = addPathRules(path);
+
+    if ((pathRules != NULL) && (!pathRules->drop))
+    {
+        pathRules->drop = true;
+        m_ruleCount++;
+        success = true;
+    }
+
+    return success;
+}
+
+/**
+ * Add a rule that injects an attribute into the element or overrides the value of the attribute
+ *
+ * \param path      Element path (for example "/a/b/c")
+ * \param attribute Attribute
+ *
+ * \retval true     Rule added
+ * \retval false    Invalid path or attribute name, or a rule for the attribute already exists
+ */
+bool RewriteEngine::addAttributeRule(const Common::UnicodeString &path,
+                                     const Common::Attribute &attribute)
+{
+    bool success = false;
+
+    if (XmlValidator::validateName(attribute.name()))
+    {
+        PathRules *pathRules = addPathRules(path);
+
+        if (pathRules != NULL)
+        {
+            success = true;
+
+            for (size_t i = 0U; success && (i < pathRules->attributeList.size()); i++)
+            {
+                if (pathRules->attributeList.at(i).name() == attribute.name())
+                {
+                    // Error, rule for the attribute already exists
+                    success = false;
+                }
+            }
+
+            if (success)
+            {
+                pathRules->attributeList.push_back(attribute);
+                m_ruleCount++;
+            }
+        }
+    }
+
+    return success;
+}
+
+/**
+ * Add a rule that masks the text of the element
+ *
+ * \param path  Element path (for example "/a/b/c")
+ * \param mask  Text that replaces the text of the element
+ *
+ * \retval true     Rule added
+ * \retval false    Invalid path or the text is already masked
+ *
+ * \note Each run of adjacent character data (text, references and CDATA sections) directly inside
+ *       of the element is replaced with the mask, the child elements are not changed.
+ */
+bool RewriteEngine::addTextMaskRule(const Common::UnicodeString &path,
+                                    const Common::UnicodeString &mask)
+{
+    bool success = false;
+    PathRules *pathRules = addPathRules(path);
+
+    if ((pathRules != NULL) && (!pathRules->maskText))
+    {
+        pathRules->maskText = true;
+        pathRules->mask = mask;
+        m_ruleCount++;
+        success = true;
+    }
+
+    return success;
+}
+
+/**
+ * Start a new stream (rules are kept)
+ */
+void RewriteEngine::startNewStream()
+{
+    m_xmlReader.clear();
+    m_inputData.clear();
+    m_inputOffset = 0U;
+    m_copiedOffset = 0U;
+    m_eventEnd = 0U;
+    m_dropDepth = 0U;
+    m_textMasked = false;
+    m_output.clear();
+    m_copiedSize = 0U;
+    m_rewrittenEventCount = 0U;
+}
+
+/**
+ * Write input data
+ *
+ * \param data  Data to write
+ *
+ * \return Number of bytes written
+ */
+size_t RewriteEngine::writeData(const std::string &data)
+{
+    return writeData(data.data(), data.size());
+}
+
+/**
+ * Write input data
+ *
+ * \param data  Pointer to data to write
+ * \param size  Size of the data (in bytes)
+ *
+ * \return Number of bytes written
+ */
+size_t RewriteEngine::writeData(const char *data, const size_t size)
+{
+    const size_t writtenSize = m_xmlReader.writeData(data, size);
+    m_inputData.append(data, writtenSize);
+    return writtenSize;
+}
+
+/**
+ * Process the input data until the next event
+ *
+ * \return Parsing result of the event
+ * \retval ParsingResult_NeedMoreData   All events were processed, more data is needed
+ *
+ * \note The rewritten data is appended to the output. When more data is needed the data of all
+ *       processed events is already in the output and the processed input data is released.
+ */
+XmlReader::ParsingResult RewriteEngine::process()
+{
+    const XmlReader::ParsingResult result = m_xmlReader.parse();
+
+    switch (result)
+    {
+        case XmlReader::ParsingResult_NeedMoreData:
+        {
+            // Copy the data of the processed events and release it
+            copyData(m_eventEnd);
+            m_inputData.erase(0U, m_copiedOffset - m_inputOffset);
+            m_inputOffset = m_copiedOffset;
+            break;
+        }
+
+        case XmlReader::ParsingResult_Error:
+        {
+            // Error, output ends with the last event before the error
+            break;
+        }
+
+        default:
+        {
+            const size_t eventEnd = m_xmlReader.byteOffset();
+            rewriteEvent(result, eventEnd);
+            m_eventEnd = eventEnd;
+            break;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Finish the stream: copy the remaining input data to the output
+ *
+ * \note It should be called after ParsingResult_NeedMoreData was returned at the end of the input,
+ *       so that the data after the last event (for example trailing whitespace) is not lost.
+ */
+void RewriteEngine::finish()
+{
+    if (m_dropDepth == 0U)
+    {
+        copyData(m_inputOffset + m_inputData.size());
+    }
+}
+
+/**
+ * Get XML reader (can be used to read the data of the last event)
+ *
+ * \return XML reader
+ */
+const XmlReader &RewriteEngine::xmlReader() const
+{
+    return m_xmlReader;
+}
+
+/**
+ * Get output
+ *
+ * \return Rewritten data (UTF-8 encoded)
+ */
+const std::string &RewriteEngine::output() const
+{
+    return m_output;
+}
+
+/**
+ * Clear output (for example after it was sent)
+ */
+void RewriteEngine::clearOutput()
+{
+    m_output.clear();
+}
+
+/**
+ * Get number of input bytes that were copied to the output without rewriting
+ *
+ * \return Number of bytes
+ */
+size_t RewriteEngine::copiedSize() const
+{
+    return m_copiedSize;
+}
+
+/**
+ * Get number of events that were rewritten
+ *
+ * \return Number of rewritten events
+ */
+size_t RewriteEngine::rewrittenEventCount() const
+{
+    return m_rewrittenEventCount;
+}
+
+/**
+ * Find the rules of the path or add them if they do not exist yet
+ *
+ * \param path  Element path
+ *
+ * \return Rules of the path or NULL if the path is not valid
+ */
+RewriteEngine::PathRules *RewriteEngine::addPathRules(const Common::UnicodeString &path)
+{
+    PathRules *pathRules = NULL;
+
+    if (PathRouter::validatePath(path))
+    {
+        const uint32_t pathHash = XmlReader::calculatePathHash(path);
+        size_t slot = m_pathRulesIndex.firstSlot(pathHash);
+        size_t index = 0U;
+
+        // Check for existing rules of the path
+        while ((pathRules == NULL) && m_pathRulesIndex.find(pathHash, &slot, &index))
+        {
+            if (m_pathRulesList.at(index).path == path)
+            {
+                pathRules = &m_pathRulesList.at(index);
+            }
+        }
+
+        if (pathRules == NULL)
+        {
+            PathRules newPathRules;
+            newPathRules.path = path;
+            newPathRules.drop = false;
+            newPathRules.maskText = false;
+            m_pathRulesList.push_back(newPathRules);
+            m_pathRulesIndex.add(pathHash);
+
+            pathRules = &m_pathRulesList.back();
+        }
+    }
+
+    return pathRules;
+}
+
+/**
+ * Find the rules of the current element path of the XML reader
+ *
+ * \return Rules of the path or NULL if there are no rules for the path
+ */
+const RewriteEngine::PathRules *RewriteEngine::findPathRules() const
+{
+    const PathRules *pathRules = NULL;
+    const uint32_t pathHash = m_xmlReader.pathHash();
+    size_t slot = m_pathRulesIndex.firstSlot(pathHash);
+    size_t index = 0U;
+
+    while ((pathRules == NULL) && m_pathRulesIndex.find(pathHash, &slot, &index))
+    {
+        const PathRules &candidate = m_pathRulesList.at(index);
+
+        if (m_xmlReader.isCurrentPath(candidate.path))
+        {
+            // Rules found
+            pathRules = &candidate;
+        }
+    }
+
+    return pathRules;
+}
+
+/**
+ * Rewrite the event
+ *
+ * \param result    Parsing result of the event
+ * \param eventEnd  Offset of the end of the event's data in the input
+ *
+ * \note The data of an event starts at the end of the previous event. Data of the events that are
+ *       not rewritten is left in the input, so that it can be copied later as a single range.
+ */
+void RewriteEngine::rewriteEvent(const XmlReader::ParsingResult result, const size_t eventEnd)
+{
+    const size_t eventStart = m_eventEnd;
+    const bool textMasked = m_textMasked;
+    m_textMasked = false;
+
+    if (m_dropDepth > 0U)
+    {
+        // Inside of a dropped element
+        if (result == XmlReader::ParsingResult_StartOfElement)
+        {
+            m_dropDepth++;
+        }
+        else if (result == XmlReader::ParsingResult_EndOfElement)
+        {
+            m_dropDepth--;
+        }
+        else
+        {
+            // Other events do not change the depth
+        }
+
+        skipData(eventEnd);
+    }
+    else
+    {
+        const PathRules *pathRules = findPathRules();
+
+        if (pathRules == NULL)
+        {
+            // Event is not rewritten
+        }
+        else if (result == XmlReader::ParsingResult_StartOfElement)
+        {
+            const size_t tokenStart = findTokenStart(eventStart, eventEnd);
+
+            if (pathRules->drop)
+            {
+                copyData(tokenStart);
+                skipData(eventEnd);
+                m_dropDepth = 1U;
+            }
+            else if ((!pathRules->name.empty()) || (!pathRules->attributeList.empty()))
+            {
+                // Empty element tag ends with "/>" (attribute values can not end the tag)
+                const bool emptyElement =
+                        ((eventEnd - m_inputOffset) >= 2U) &&
+                        (m_inputData.at(eventEnd - m_inputOffset - 1U) == '>') &&
+                        (m_inputData.at(eventEnd - m_inputOffset - 2U) == '/');
+
+                copyData(tokenStart);
+                writeStartOfElement(*pathRules, emptyElement);
+                skipData(eventEnd);
+            }
+            else
+            {
+                // Element is not rewritten
+            }
+        }
+        else if (result == XmlReader::ParsingResult_EndOfElement)
+        {
+            // End of an empty element has no data, it was rewritten with the start of element
+            if ((!pathRules->name.empty()) && (eventEnd > eventStart))
+            {
+                Common::UnicodeString markup = Common::Utf8::toUnicodeString("</");
+                markup.append(pathRules->name);
+                markup.push_back(static_cast<uint32_t>('>'));
+
+                copyData(findTokenStart(eventStart, eventEnd));
+                writeMarkup(markup);
+                skipData(eventEnd);
+            }
+        }
+        else if ((result == XmlReader::ParsingResult_TextNode) ||
+                 (result == XmlReader::ParsingResult_CData))
+        {
+            if (pathRules->maskText)
+            {
+                copyData(eventStart);
+
+                if (!textMasked)
+                {
+                    // Mask is written only once for adjacent character data
+                    writeMarkup(XmlWriter::XmlWriter::escapeTextNode(pathRules->mask));
+                }
+
+                skipData(eventEnd);
+                m_textMasked = true;
+            }
+        }
+        else
+        {
+            // Other events are not rewritten
+        }
+    }
+}
+
+/**
+ * Write the rewritten start of element
+ *
+ * \param pathRules     Rules of the element
+ * \param emptyElement  Element is an empty element
+ */
+void RewriteEngine::writeStartOfElement(const PathRules &pathRules, const bool emptyElement)
+{
+    const Common::AttributeList &attributeList = m_xmlReader.attributeList();
+    std::vector<bool> injectList(pathRules.attributeList.size(), true);
+    Common::UnicodeString markup;
+    markup.push_back(static_cast<uint32_t>('<'));
+
+    if (pathRules.name.empty())
+    {
+        markup.append(m_xmlReader.name());
+    }
+    else
+    {
+        markup.append(pathRules.name);
+    }
+
+    // Write the attributes of the element (overridden values are replaced) and then the injected
+    // attributes
+    Common::AttributeList::ConstIterator it = attributeList.begin();
+
+    for (size_t i = 0U; i < (attributeList.size() + pathRules.attributeList.size()); i++)
+    {
+        Common::Attribute attribute;
+
+        if (it != attributeList.end())
+        {
+            attribute = *it;
+            it++;
+
+            for (size_t j = 0U; j < pathRules.attributeList.size(); j++)
+            {
+                if (pathRules.attributeList.at(j).name() == attribute.name())
+                {
+                    attribute = pathRules.attributeList.at(j);
+                    injectList.at(j) = false;
+                }
+            }
+        }
+        else
+        {
+            const size_t index = i - attributeList.size();
+
+            if (injectList.at(index))
+            {
+                attribute = pathRules.attributeList.at(index);
+            }
+        }
+
+        if (!attribute.name().empty())
+        {
+            Common::QuotationMark quotationMark = Common::QuotationMark_Quote;
+            uint32_t quote = static_cast<uint32_t>('"');
+
+            if (attribute.valueQuotationMark() == Common::QuotationMark_Apostrophe)
+            {
+                quotationMark = Common::QuotationMark_Apostrophe;
+                quote = static_cast<uint32_t>('\'');
+            }
+
+            markup.push_back(static_cast<uint32_t>(' '));
+            markup.append(attribute.name());
+            markup.push_back(static_cast<uint32_t>('='));
+            markup.push_back(quote);
+            markup.append(XmlWriter::XmlWriter::escapeAttributeValue(attribute.value(),
+                                                                     quotationMark));
+            markup.push_back(quote);
+        }
+    }
+
+    if (emptyElement)
+    {
+        markup.push_back(static_cast<uint32_t>('/'));
+    }
+
+    markup.push_back(static_cast<uint32_t>('>'));
+    writeMarkup(markup);
+}
+
+/**
+ * Find the start of the markup token in the data of the event
+ *
+ * \param eventStart    Offset of the start of the event's data in the input
+ * \param eventEnd      Offset of the end of the event's data in the input
+ *
+ * \return Offset of the last '<' character in the data of the event
+ *
+ * \note Data of a tag can start with the whitespace in the prolog, but there is no '<' character in
+ *       a tag after its start.
+ */
+size_t RewriteEngine::findTokenStart(const size_t eventStart, const size_t eventEnd) const
+{
+    size_t tokenStart = eventStart;
+
+    if (eventEnd > eventStart)
+    {
+        const size_t position = m_inputData.rfind('<', eventEnd - m_inputOffset - 1U);
+
+        if ((position != std::string::npos) && ((position + m_inputOffset) > eventStart))
+        {
+            tokenStart = position + m_inputOffset;
+        }
+    }
+
+    return tokenStart;
+}
+
+/**
+ * Copy the input data up to the offset to the output
+ *
+ * \param endOffset Offset of the end of the data in the input
+ */
+void RewriteEngine::copyData(const size_t endOffset)
+{
+    if (endOffset > m_copiedOffset)
+    {
+        const size_t size = endOffset - m_copiedOffset;
+        m_output.append(m_inputData, m_copiedOffset - m_inputOffset, size);
+        m_copiedSize += size;
+        m_copiedOffset = endOffset;
+    }
+}
+
+/**
+ * Skip the input data up to the offset (it is not copied to the output)
+ *
+ * \param endOffset Offset of the end of the data in the input
+ */
+void RewriteEngine::skipData(const size_t endOffset)
+{
+    if (endOffset > m_copiedOffset)
+    {
+        m_copiedOffset = endOffset;
+    }
+}
+
+/**
+ * Write rewritten markup to the output
+ *
+ * \param markup    Markup
+ */
+void RewriteEngine::writeMarkup(const Common::UnicodeString &markup)
+{
+    m_output.append(Common::Utf8::toUtf8(markup));
+    m_rewrittenEventCount++;
+}
@@ -0,0 +1,471 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include <EmbeddedStAX/XmlReader/SchemaValidator.h>
+#include <EmbeddedStAX/XmlValidator/Common.h>
+#include <EmbeddedStAX/XmlValidator/Name.h>
+
+using namespace EmbeddedStAX::XmlReader;
+
+/**
+ * Constructor
+ */
+SchemaValidator::SchemaValidator()
+    : m_nameTable(),
+      m_declarationIndexList(),
+      m_declarationList(),
+      m_rootNameId(Common::UnicodeString::npos),
+      m_openElementList(),
+      m_text(),
+      m_error(Error_None)
+{
+}
+
+/**
+ * Destructor
+ */
+SchemaValidator::~SchemaValidator()
+{
+}
+
+/**
+ * Remove all declarations
+ */
+void SchemaValidator::clear()
+{
+    m_nameTable.clear();
+    m_declarationIndexList.clear();
+    m_declarationList.clear();
+    m_rootNameId = Common::UnicodeString::npos;
+    startNewDocument();
+}
+
+/**
+ * Get number of declared elements
+ *
+ * \return Number of declared elements
+ */
+size_t SchemaValidator::elementCount() const
+{
+    return m_declarationList.size();
+}
+
+/**
+ * Declare an element
+ *
+ * \param name          Element name
+ * \param contentSpec   Content model of the element in the DTD syntax (see ContentModel)
+ *
+ * \retval true     Element declared
+ * \retval false    Invalid name or content model, or the element is already declared
+ */
+bool SchemaValidator::declareElement(const Common::UnicodeString &name,
+                                     const Common::UnicodeString &contentSpec)
+{
+    bool success = false;
+
+    if (XmlValidator::validateName(name) && (findDeclaration(name) == Common::UnicodeString::npos))
+    {
+        ElementDeclaration declaration;
+        declaration.typed = false;
+
+        if (declaration.contentModel.compile(contentSpec, &m_nameTable))
+        {
+            const size_t nameId = m_nameTable.add(name);
+
+            if (m_declarationIndexList.size() <= nameId)
+            {
+                m_declarationIndexList.resize(nameId + 1U, Common::UnicodeString::npos);
+            }
+
+            m_declarationIndexList.at(nameId) = m_declarationList.size();
+            m_declarationList.push_back(declaration);
+            success = true;
+        }
+    }
+
+    return success;
+}
+
+/**
+ * Check if an element is declared
+ *
+ * \param name  Element name
+ *
+ * \retval true     Element is declared
+ * \retval false    Element is not declared
+ */
+bool SchemaValidator::isElementDeclared(const Common::UnicodeString &name) const
+{
+    return (findDeclaration(name) != Common::UnicodeString::npos);
+}
+
+/**
+ * Set simple type of the text content of an element
+ *
+ * \param name          Element name
+ * \param simpleType    Simple type
+ *
+ * \retval true     Simple type set
+ * \retval false    Element is not declared or its content model is not "(#PCDATA)"
+ */
+bool SchemaValidator::setElementType(const Common::UnicodeString &name,
+                                     const SimpleType &simpleType)
+{
+    bool success = false;
+    const size_t index = findDeclaration(name);
+
+    if (index != Common::UnicodeString::npos)
+    {
+        ElementDeclaration &declaration = m_declarationList.at(index);
+
+        // Only text content can have a simple type
+        if ((declaration.contentModel.type() == ContentModel::Type_Mixed) &&
+            (declaration.contentModel.symbolCount() == 0U))
+        {
+            declaration.typed = true;
+            declaration.simpleType = simpleType;
+            success = true;
+        }
+    }
+
+    return success;
+}
+
+/**
+ * Set the required root element
+ *
+ * \param name  Element name
+ *
+ * \retval true     Root element set
+ * \retval false    Element is not declared
+ *
+ * \note Without the root element any declared element can be the root element.
+ */
+bool SchemaValidator::setRootElement(const Common::UnicodeString &name)
+{
+    bool success = false;
+
+    if (findDeclaration(name) != Common::UnicodeString::npos)
+    {
+        m_rootNameId = m_nameTable.find(name);
+        success = true;
+    }
+
+    return success;
+}
+
+/**
+ * Declare the elements of the document type
+ *
+ * \param documentType  Document type with element type declarations
+ *
+ * \retval true     All elements declared
+ * \retval false    Invalid or duplicate element type declaration (error() returns
+ *                  Error_InvalidDeclaration)
+ *
+ * \note The name of the document type is set as the required root element, even if the root
+ *       element is not declared.
+ */
+bool SchemaValidator::declareElements(const Common::DocumentType &documentType)
+{
+    bool success = true;
+
+    for (size_t i = 0U; success && (i < documentType.elementDeclarationCount()); i++)
+    {
+        success = declareElement(documentType.elementName(i), documentType.elementContentSpec(i));
+    }
+
+    if (!success)
+    {
+        // Error, the document can not be validated with the declarations
+        m_error = Error_InvalidDeclaration;
+    }
+    else if (documentType.isValid())
+    {
+        m_rootNameId = m_nameTable.add(documentType.name());
+    }
+    else
+    {
+        // No root element
+    }
+
+    return success;
+}
+
+/**
+ * Start validation of a new document
+ */
+void SchemaValidator::startNewDocument()
+{
+    m_openElementList.clear();
+    m_text.clear();
+    m_error = Error_None;
+}
+
+/**
+ * Validate start of element
+ *
+ * \param name  Element name
+ *
+ * \retval true     Document is valid so far
+ * \retval false    Document is not valid (see error())
+ *
+ * \note After the first error the document stays invalid until startNewDocument() is called.
+ */
+bool SchemaValidator::validateStartOfElement(const Common::UnicodeString &name)
+{
+    if (m_error == Error_None)
+    {
+        m_error = checkStartOfElement(name);
+    }
+
+    return (m_error == Error_None);
+}
+
+/**
+ * Validate text
+ *
+ * \param text  Text
+ * \param cData Text is a CDATA section
+ *
+ * \retval true     Document is valid so far
+ * \retval false    Document is not valid (see error())
+ *
+ * \note Text of an element can be split into multiple calls, the text of an element with a simple
+ *       type is validated at the end of the element.
+ */
+bool SchemaValidator::validateText(const Common::UnicodeString &text, const bool cData)
+{
+    if (m_error == Error_None)
+    {
+        m_error = checkText(text, cData);
+    }
+
+    return (m_error == Error_None);
+}
+
+/**
+ * Validate end of element
+ *
+ * \retval true     Document is valid so far
+ * \retval false    Document is not valid (see error())
+ */
+bool SchemaValidator::validateEndOfElement()
+{
+    if (m_error == Error_None)
+    {
+        m_error = checkEndOfElement();
+    }
+
+    return (m_error == Error_None);
+}
+
+/**
+ * Get validation error
+ *
+ * \return Validation error
+ */
+SchemaValidator::Error SchemaValidator::error() const
+{
+    return m_error;
+}
+
+/**
+ * Find the declaration of an element
+ *
+ * \param name  Element name
+ *
+ * \return Index of the declaration or Common::UnicodeString::npos if the element is not declared
+ */
+size_t SchemaValidator::findDeclaration(const Common::UnicodeString &name) const
+{
+    const size_t nameId = m_nameTable.find(name);
+    size_t index = Common::UnicodeString::npos;
+
+    if (nameId < m_declarationIndexList.size())
+    {
+        index = m_declarationIndexList.at(nameId);
+    }
+
+    return index;
+}
+
+/**
+ * Check start of element
+ *
+ * \param name  Element name
+ *
+ * \return Validation error
+ */
+SchemaValidator::Error SchemaValidator::checkStartOfElement(const Common::UnicodeString &name)
+{
+    Error error = Error_None;
+    const size_t nameId = m_nameTable.find(name);
+    size_t index = Common::UnicodeString::npos;
+
+    if (nameId < m_declarationIndexList.size())
+    {
+        index = m_declarationIndexList.at(nameId);
+    }
+
+    if (index == Common::UnicodeString::npos)
+    {
+        // Error, element is not declared
+        error = Error_UndeclaredElement;
+    }
+    else if (m_openElementList.empty())
+    {
+        if ((m_rootNameId != Common::UnicodeString::npos) && (m_rootNameId != nameId))
+        {
+            // Error, invalid root element
+            error = Error_InvalidRootElement;
+        }
+    }
+    else
+    {
+        // Move the automaton of the parent element to the next state
+        OpenElement &parent = m_openElementList.back();
+        const ContentModel &contentModel =
+                m_declarationList.at(parent.declarationIndex).contentModel;
+        parent.state = contentModel.nextState(parent.state, nameId);
+
+        if (parent.state == Common::UnicodeString::npos)
+        {
+            // Error, element is not allowed at this place in the content of the parent
+            error = Error_UnexpectedElement;
+        }
+    }
+
+    if (error == Error_None)
+    {
+        OpenElement element;
+        element.declarationIndex = index;
+        element.state = 0U;
+        m_openElementList.push_back(element);
+        m_text.clear();
+    }
+
+    return error;
+}
+
+/**
+ * Check text
+ *
+ * \param text  Text
+ * \param cData Text is a CDATA section
+ *
+ * \return Validation error
+ */
+SchemaValidator::Error SchemaValidator::checkText(const Common::UnicodeString &text,
+                                                  const bool cData)
+{
+    Error error = Error_None;
+
+    if (!m_openElementList.empty())
+    {
+        const ElementDeclaration &declaration =
+                m_declarationList.at(m_openElementList.back().declarationIndex);
+
+        if (declaration.contentModel.isTextAllowed())
+        {
+            if (declaration.typed)
+            {
+                // Collect the text of the simple type
+                m_text.append(text);
+            }
+        }
+        else if ((declaration.contentModel.type() == ContentModel::Type_Children) &&
+                 (!cData) &&
+                 isWhitespaceText(text))
+        {
+            // Whitespace is allowed between child elements
+        }
+        else
+        {
+            // Error, text is not allowed in the element
+            error = Error_UnexpectedText;
+        }
+    }
+
+    return error;
+}
+
+/**
+ * Check end of element
+ *
+ * \return Validation error
+ */
+SchemaValidator::Error SchemaValidator::checkEndOfElement()
+{
+    Error error = Error_None;
+
+    if (!m_openElementList.empty())
+    {
+        const OpenElement &element = m_openElementList.back();
+        const ElementDeclaration &declaration =
+                m_declarationList.at(element.declarationIndex);
+
+        if (!declaration.contentModel.isAcceptingState(element.state))
+        {
+            // Error, required child elements are missing
+            error = Error_IncompleteContent;
+        }
+        else if (declaration.typed && (!declaration.simpleType.validate(m_text)))
+        {
+            // Error, invalid value
+            error = Error_InvalidValue;
+        }
+        else
+        {
+            m_openElementList.pop_back();
+            m_text.clear();
+        }
+    }
+
+    return error;
+}
+
+/**
+ * Check if the text contains only whitespace
+ *
+ * \param text  Text
+ *
+ * \retval true     Text contains only whitespace
+ * \retval false    Text contains other characters
+ */
+bool SchemaValidator::isWhitespaceText(const Common::UnicodeString &text)
+{
+    bool whitespace = true;
+
+    for (size_t i = 0U; whitespace && (i < text.size()); i++)
+    {
+        whitespace = XmlValidator::isWhitespace(text.at(i));
+    }
+
+    return whitespace;
+}
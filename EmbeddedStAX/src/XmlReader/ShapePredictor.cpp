@@ -0,0 +1,241 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include <EmbeddedStAX/XmlReader/ShapePredictor.h>
+#include <EmbeddedStAX/Common/HashIndex.h>
+
+using namespace EmbeddedStAX::XmlReader;
+
+/**
+ * Constructor
+ *
+ * \note The predictor is disabled (capacity is 0) until the capacity is set.
+ */
+ShapePredictor::ShapePredictor()
+    : m_entryList(),
+      m_previousHash(0U),
+      m_context(0U),
+      m_lookupCount(0U),
+      m_predictionCount(0U),
+      m_hitCount(0U),
+      m_skippedCharacterCount(0U)
+{
+}
+
+/**
+ * Destructor
+ */
+ShapePredictor::~ShapePredictor()
+{
+}
+
+/**
+ * Get capacity
+ *
+ * \return Number of entries in the predictor
+ */
+size_t ShapePredictor::capacity() const
+{
+    return m_entryList.size();
+}
+
+/**
+ * Set capacity
+ *
+ * \param capacity  Number of entries in the predictor (rounded up to a power of two, value 0
+ *                  disables the predictor)
+ *
+ * \note All learned names are removed.
+ */
+void ShapePredictor::setCapacity(const size_t capacity)
+{
+    size_t entryCount = 0U;
+
+    if (capacity > 0U)
+    {
+        entryCount = 1U;
+
+        while (entryCount < capacity)
+        {
+            entryCount *= 2U;
+        }
+    }
+
+    m_entryList.clear();
+    m_entryList.resize(entryCount);
+    clear();
+}
+
+/**
+ * Remove all learned names
+ *
+ * \note Statistics are not reset.
+ */
+void ShapePredictor::clear()
+{
+    for (size_t i = 0U; i < m_entryList.size(); i++)
+    {
+        m_entryList[i].used = false;
+        m_entryList[i].context = 0U;
+        m_entryList[i].hash = 0U;
+        m_entryList[i].validated = false;
+        m_entryList[i].name.clear();
+    }
+
+    m_previousHash = 0U;
+    m_context = 0U;
+}
+
+/**
+ * Predict the next name
+ *
+ * \param nameType          Type of the next name
+ * \param validationNeeded  Only a validated name can be predicted
+ * \param hash              Output for the hash of the predicted name
+ *
+ * \return Predicted name or NULL if there is no prediction
+ *
+ * \note The name that is read next has to be added with addName() (also when it was predicted),
+ *       the returned pointer is valid only until then.
+ */
+const EmbeddedStAX::Common::UnicodeString *ShapePredictor::predictName(const NameType nameType,
+                                                                       const bool validationNeeded,
+                                                                       uint32_t *hash)
+{
+    const Common::UnicodeString *name = NULL;
+
+    if (!m_entryList.empty())
+    {
+        // Context of the prediction: previous name and the type of the next name
+        m_context = Common::HashIndex::appendHash(Common::HashIndex::initialHash(), m_previousHash);
+        m_context = Common::HashIndex::appendHash(m_context, static_cast<uint32_t>(nameType));
+        const size_t index = static_cast<size_t>(m_context) & (m_entryList.size() - 1U);
+        const Entry &entry = m_entryList[index];
+        m_lookupCount++;
+
+        if (entry.used && (entry.context == m_context) && (entry.validated || !validationNeeded))
+        {
+            // Name predicted
+            m_predictionCount++;
+            *hash = entry.hash;
+            name = &(entry.name);
+        }
+    }
+
+    return name;
+}
+
+/**
+ * Add the name that was read after the last prediction
+ *
+ * \param name      Name
+ * \param hash      Hash of the name
+ * \param validated Name was validated
+ * \param predicted Name was predicted (it matched the input)
+ */
+void ShapePredictor::addName(const Common::UnicodeString &name,
+                             const uint32_t hash,
+                             const bool validated,
+                             const bool predicted)
+{
+    if (!m_entryList.empty())
+    {
+        if (predicted)
+        {
+            m_hitCount++;
+            m_skippedCharacterCount += name.size();
+        }
+        else
+        {
+            // Learn the name
+            const size_t index = static_cast<size_t>(m_context) & (m_entryList.size() - 1U);
+            Entry &entry = m_entryList[index];
+            entry.used = true;
+            entry.context = m_context;
+            entry.hash = hash;
+            entry.validated = validated;
+            entry.name = name;
+        }
+
+        m_previousHash = hash;
+    }
+}
+
+/**
+ * Get lookup count
+ *
+ * \return Number of names that were predicted or could have been predicted
+ */
+size_t ShapePredictor::lookupCount() const
+{
+    return m_lookupCount;
+}
+
+/**
+ * Get prediction count
+ *
+ * \return Number of names that were predicted
+ */
+size_t ShapePredictor::predictionCount() const
+{
+    return m_predictionCount;
+}
+
+/**
+ * Get hit count
+ *
+ * \return Number of predicted names that matched the input
+ *
+ * \note Hit rate of the predictor is hitCount() / lookupCount(), the misses are
+ *       predictionCount() - hitCount().
+ */
+size_t ShapePredictor::hitCount() const
+{
+    return m_hitCount;
+}
+
+/**
+ * Get skipped character count
+ *
+ * \return Number of name characters that were matched with the predicted names instead of being
+ *         scanned and validated one by one
+ */
+size_t ShapePredictor::skippedCharacterCount() const
+{
+    return m_skippedCharacterCount;
+}
+
+/**
+ * Reset statistics
+ */
+void ShapePredictor::resetStatistics()
+{
+    m_lookupCount = 0U;
+    m_predictionCount = 0U;
+    m_hitCount = 0U;
+    m_skippedCharacterCount = 0U;
+}
@@ -0,0 +1,399 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include <EmbeddedStAX/XmlReader/SimpleType.h>
+#include <EmbeddedStAX/XmlValidator/Common.h>
+
+using namespace EmbeddedStAX::XmlReader;
+
+/**
+ * Constructor
+ *
+ * \param baseType  Base type
+ *
+ * \note By default there are no restrictions of the base type.
+ */
+SimpleType::SimpleType(const BaseType baseType)
+    : m_baseType(baseType),
+      m_minLength(0U),
+      m_maxLength(Common::UnicodeString::npos),
+      m_minValue(-2147483647 - 1),
+      m_maxValue(2147483647),
+      m_enumerationList()
+{
+}
+
+/**
+ * Get base type
+ *
+ * \return Base type
+ */
+SimpleType::BaseType SimpleType::baseType() const
+{
+    return m_baseType;
+}
+
+/**
+ * Get minimal length of the value
+ *
+ * \return Minimal length (in characters)
+ */
+size_t SimpleType::minLength() const
+{
+    return m_minLength;
+}
+
+/**
+ * Get maximal length of the value
+ *
+ * \return Maximal length (in characters)
+ */
+size_t SimpleType::maxLength() const
+{
+    return m_maxLength;
+}
+
+/**
+ * Set length range of the value
+ *
+ * \param minLength     Minimal length (in characters)
+ * \param maxLength     Maximal length (in characters)
+ */
+void SimpleType::setLengthRange(const size_t minLength, const size_t maxLength)
+{
+    m_minLength = minLength;
+    m_maxLength = maxLength;
+}
+
+/**
+ * Get minimal value
+ *
+ * \return Minimal value
+ */
+int32_t SimpleType::minValue() const
+{
+    return m_minValue;
+}
+
+/**
+ * Get maximal value
+ *
+ * \return Maximal value
+ */
+int32_t SimpleType::maxValue() const
+{
+    return m_maxValue;
+}
+
+/**
+ * Set value range (inclusive)
+ *
+ * \param minValue  Minimal value
+ * \param maxValue  Maximal value
+ *
+ * \note Value range is checked only for the integer base type.
+ */
+void SimpleType::setValueRange(const int32_t minValue, const int32_t maxValue)
+{
+    m_minValue = minValue;
+    m_maxValue = maxValue;
+}
+
+/**
+ * Add a value to the enumeration of allowed values
+ *
+ * \param value     Allowed value
+ */
+void SimpleType::addEnumeration(const Common::UnicodeString &value)
+{
+    m_enumerationList.push_back(value);
+}
+
+/**
+ * Clear the enumeration of allowed values (all values of the base type are allowed)
+ */
+void SimpleType::clearEnumeration()
+{
+    m_enumerationList.clear();
+}
+
+/**
+ * Validate text
+ *
+ * \param text  Text content of an element
+ *
+ * \retval true     Text is a valid value of the simple type
+ * \retval false    Text is not a valid value of the simple type
+ */
+bool SimpleType::validate(const Common::UnicodeString &text) const
+{
+    size_t position = 0U;
+    size_t endPosition = text.size();
+
+    if (m_baseType != BaseType_String)
+    {
+        // Ignore leading and trailing whitespace
+        while ((position < endPosition) && XmlValidator::isWhitespace(text.at(position)))
+        {
+            position++;
+        }
+
+        while ((endPosition > position) && XmlValidator::isWhitespace(text.at(endPosition - 1U)))
+        {
+            endPosition--;
+        }
+    }
+
+    const size_t size = endPosition - position;
+    bool valid = ((size >= m_minLength) && (size <= m_maxLength));
+
+    if (valid)
+    {
+        switch (m_baseType)
+        {
+            case BaseType_Boolean:
+            {
+                valid = validateBoolean(text, position, size);
+                break;
+            }
+
+            case BaseType_Integer:
+            {
+                valid = validateInteger(text, position, size);
+                break;
+            }
+
+            case BaseType_Decimal:
+            {
+                valid = validateDecimal(text, position, size);
+                break;
+            }
+
+            default:
+            {
+                // String, all characters are allowed
+                break;
+            }
+        }
+    }
+
+    if (valid && (!m_enumerationList.empty()))
+    {
+        valid = false;
+
+        for (size_t i = 0U; (!valid) && (i < m_enumerationList.size()); i++)
+        {
+            valid = (text.compare(position, size, m_enumerationList.at(i)) == 0);
+        }
+    }
+
+    return valid;
+}
+
+/**
+ * Validate boolean value
+ *
+ * \param text      Text
+ * \param position  Start position of the value
+ * \param size      Size of the value
+ *
+ * \retval true     Valid value
+ * \retval false    Invalid value
+ *
+ * Format:
+ * \code{.unparsed}
+ * boolean ::= 'true' | 'false' | '1' | '0'
+ * \endcode
+ */
+bool SimpleType::validateBoolean(const Common::UnicodeString &text,
+                                 const size_t position,
+                                 const size_t size)
+{
+    return (matchText(text, position, size, "true") ||
+            matchText(text, position, size, "false") ||
+            matchText(text, position, size, "1") ||
+            matchText(text, position, size, "0"));
+}
+
+/**
+ * Validate integer value
+ *
+ * \param text      Text
+ * \param position  Start position of the value
+ * \param size      Size of the value
+ *
+ * \retval true     Valid value in the value range
+ * \retval false    Invalid value or value out of the value range
+ *
+ * Format:
+ * \code{.unparsed}
+ * integer ::= ('+' | '-')? [0-9]+
+ * \endcode
+ */
+bool SimpleType::validateInteger(const Common::UnicodeString &text,
+                                 const size_t position,
+                                 const size_t size) const
+{
+    const size_t endPosition = position + size;
+    size_t i = position;
+    bool negative = false;
+
+    if ((i < endPosition) &&
+        ((text.at(i) == static_cast<uint32_t>('+')) || (text.at(i) == static_cast<uint32_t>('-'))))
+    {
+        negative = (text.at(i) == static_cast<uint32_t>('-'));
+        i++;
+    }
+
+    bool valid = (i < endPosition);
+    uint32_t magnitude = 0U;
+
+    while (valid && (i < endPosition))
+    {
+        const uint32_t uchar = text.at(i);
+
+        if ((uchar >= static_cast<uint32_t>('0')) &&
+            (uchar <= static_cast<uint32_t>('9')) &&
+            (magnitude <= 214748364U))
+        {
+            magnitude = (magnitude * 10U) + (uchar - static_cast<uint32_t>('0'));
+            valid = (magnitude <= 2147483648U);
+            i++;
+        }
+        else
+        {
+            // Error, invalid character or value out of range
+            valid = false;
+        }
+    }
+
+    if (valid)
+    {
+        int32_t value = 0;
+
+        if (!negative)
+        {
+            valid = (magnitude <= 2147483647U);
+            value = static_cast<int32_t>(magnitude & 0x7FFFFFFFU);
+        }
+        else if (magnitude == 2147483648U)
+        {
+            value = -2147483647 - 1;
+        }
+        else
+        {
+            value = -static_cast<int32_t>(magnitude);
+        }
+
+        valid = (valid && (value >= m_minValue) && (value <= m_maxValue));
+    }
+
+    return valid;
+}
+
+/**
+ * Validate decimal value
+ *
+ * \param text      Text
+ * \param position  Start position of the value
+ * \param size      Size of the value
+ *
+ * \retval true     Valid value
+ * \retval false    Invalid value
+ *
+ * Format:
+ * \code{.unparsed}
+ * decimal ::= ('+' | '-')? ([0-9]+ ('.' [0-9]*)? | '.' [0-9]+)
+ * \endcode
+ */
+bool SimpleType::validateDecimal(const Common::UnicodeString &text,
+                                 const size_t position,
+                                 const size_t size)
+{
+    const size_t endPosition = position + size;
+    size_t i = position;
+    size_t digitCount = 0U;
+    bool decimalPoint = false;
+    bool valid = true;
+
+    if ((i < endPosition) &&
+        ((text.at(i) == static_cast<uint32_t>('+')) || (text.at(i) == static_cast<uint32_t>('-'))))
+    {
+        i++;
+    }
+
+    while (valid && (i < endPosition))
+    {
+        const uint32_t uchar = text.at(i);
+
+        if ((uchar >= static_cast<uint32_t>('0')) && (uchar <= static_cast<uint32_t>('9')))
+        {
+            digitCount++;
+        }
+        else if ((uchar == static_cast<uint32_t>('.')) && (!decimalPoint))
+        {
+            decimalPoint = true;
+        }
+        else
+        {
+            // Error, invalid character
+            valid = false;
+        }
+
+        i++;
+    }
+
+    return (valid && (digitCount > 0U));
+}
+
+/**
+ * Check if the text matches the value
+ *
+ * \param text      Text
+ * \param position  Start position in the text
+ * \param size      Size of the text
+ * \param value     Value (ASCII)
+ *
+ * \retval true     Text matches the value
+ * \retval false    Text does not match the value
+ */
+bool SimpleType::matchText(const Common::UnicodeString &text,
+                           const size_t position,
+                           const size_t size,
+                           const char *value)
+{
+    size_t i = 0U;
+    bool match = true;
+
+    while (match && (i < size))
+    {
+        match = ((value[i] != '\0') && (text.at(position + i) == static_cast<uint32_t>(value[i])));
+        i++;
+    }
+
+    return (match && (value[i] == '\0'));
+}
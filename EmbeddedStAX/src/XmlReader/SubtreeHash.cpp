@@ -0,0 +1,321 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include <EmbeddedStAX/XmlReader/SubtreeHash.h>
+
+using namespace EmbeddedStAX::XmlReader;
+
+/**
+ * Constructor
+ */
+SubtreeHash::SubtreeHash()
+    : m_fastHash(0U),
+      m_sha256Enabled(false),
+      m_finished(false),
+      m_sha256BlockSize(0U),
+      m_size(0U)
+{
+    start(false);
+}
+
+/**
+ * Destructor
+ */
+SubtreeHash::~SubtreeHash()
+{
+}
+
+/**
+ * Start a new hash
+ *
+ * \param sha256Enabled Calculate also the SHA-256 digest
+ */
+void SubtreeHash::start(const bool sha256Enabled)
+{
+    static const uint32_t s_initialState[8] =
+    {
+        0x6A09E667U, 0xBB67AE85U, 0x3C6EF372U, 0xA54FF53AU,
+        0x510E527FU, 0x9B05688CU, 0x1F83D9ABU, 0x5BE0CD19U
+    };
+
+    m_fastHash = 14695981039346656037ULL;
+    m_sha256Enabled = sha256Enabled;
+    m_finished = false;
+    m_sha256BlockSize = 0U;
+    m_size = 0U;
+
+    for (size_t i = 0U; i < 8U; i++)
+    {
+        m_sha256State[i] = s_initialState[i];
+    }
+}
+
+/**
+ * Append a marker to the hash
+ *
+ * \param marker    Marker byte
+ */
+void SubtreeHash::appendMarker(const uint8_t marker)
+{
+    appendByte(0xFFU);
+    appendByte(marker);
+}
+
+/**
+ * Append a string to the hash (UTF-8 encoded)
+ *
+ * \param value String
+ */
+void SubtreeHash::appendString(const Common::UnicodeString &value)
+{
+    for (size_t i = 0U; i < value.size(); i++)
+    {
+        const std::string utf8 = Common::Utf8::toUtf8(value.at(i));
+
+        for (size_t j = 0U; j < utf8.size(); j++)
+        {
+            appendByte(static_cast<uint8_t>(utf8.at(j)));
+        }
+    }
+}
+
+/**
+ * Finish the hash
+ *
+ * \note Nothing can be appended to a finished hash.
+ */
+void SubtreeHash::finish()
+{
+    if ((!m_finished) && m_sha256Enabled)
+    {
+        // Pad the message: bit '1', zeros and the message length in bits
+        const uint64_t sizeInBits = m_size * 8U;
+        m_sha256Block[m_sha256BlockSize] = 0x80U;
+        m_sha256BlockSize++;
+
+        if (m_sha256BlockSize > 56U)
+        {
+            while (m_sha256BlockSize < 64U)
+            {
+                m_sha256Block[m_sha256BlockSize] = 0U;
+                m_sha256BlockSize++;
+            }
+
+            processSha256Block();
+        }
+
+        while (m_sha256BlockSize < 56U)
+        {
+            m_sha256Block[m_sha256BlockSize] = 0U;
+            m_sha256BlockSize++;
+        }
+
+        for (size_t i = 0U; i < 8U; i++)
+        {
+            m_sha256Block[56U + i] = static_cast<uint8_t>(sizeInBits >> (56U - (i * 8U)));
+        }
+
+        m_sha256BlockSize = 64U;
+        processSha256Block();
+    }
+
+    m_finished = true;
+}
+
+/**
+ * Check if the hash is finished
+ *
+ * \retval true     Hash is finished
+ * \retval false    Hash is not finished
+ */
+bool SubtreeHash::isFinished() const
+{
+    return m_finished;
+}
+
+/**
+ * Get fast hash
+ *
+ * \return 64-bit FNV-1a hash of the appended data
+ */
+uint64_t SubtreeHash::fastHash() const
+{
+    return m_fastHash;
+}
+
+/**
+ * Get SHA-256 digest
+ *
+ * \return SHA-256 digest (32 bytes) or an empty digest if SHA-256 is not enabled or the hash is not
+ *         finished
+ */
+std::vector<uint8_t> SubtreeHash::sha256() const
+{
+    std::vector<uint8_t> digest;
+
+    if (m_finished && m_sha256Enabled)
+    {
+        for (size_t i = 0U; i < 32U; i++)
+        {
+            const uint32_t word = m_sha256State[i / 4U];
+            digest.push_back(static_cast<uint8_t>(word >> (24U - ((i % 4U) * 8U))));
+        }
+    }
+
+    return digest;
+}
+
+/**
+ * Calculate SHA-256 digest of the data
+ *
+ * \param data  Data
+ *
+ * \return SHA-256 digest (32 bytes)
+ */
+std::vector<uint8_t> SubtreeHash::calculateSha256(const std::string &data)
+{
+    SubtreeHash subtreeHash;
+    subtreeHash.start(true);
+
+    for (size_t i = 0U; i < data.size(); i++)
+    {
+        subtreeHash.appendByte(static_cast<uint8_t>(data.at(i)));
+    }
+
+    subtreeHash.finish();
+    return subtreeHash.sha256();
+}
+
+/**
+ * Append a byte to the hash
+ *
+ * \param value Byte
+ */
+void SubtreeHash::appendByte(const uint8_t value)
+{
+    if (!m_finished)
+    {
+        m_fastHash = (m_fastHash ^ static_cast<uint64_t>(value)) * 1099511628211ULL;
+        m_size++;
+
+        if (m_sha256Enabled)
+        {
+            m_sha256Block[m_sha256BlockSize] = value;
+            m_sha256BlockSize++;
+
+            if (m_sha256BlockSize == 64U)
+            {
+                processSha256Block();
+            }
+        }
+    }
+}
+
+/**
+ * Process a full SHA-256 block
+ */
+void SubtreeHash::processSha256Block()
+{
+    static const uint32_t s_roundConstants[64] =
+    {
+        0x428A2F98U, 0x71374491U, 0xB5C0FBCFU, 0xE9B5DBA5U, 0x3956C25BU, 0x59F111F1U, 0x923F82A4U,
+        0xAB1C5ED5U, 0xD807AA98U, 0x12835B01U, 0x243185BEU, 0x550C7DC3U, 0x72BE5D74U, 0x80DEB1FEU,
+        0x9BDC06A7U, 0xC19BF174U, 0xE49B69C1U, 0xEFBE4786U, 0x0FC19DC6U, 0x240CA1CCU, 0x2DE92C6FU,
+        0x4A7484AAU, 0x5CB0A9DCU, 0x76F988DAU, 0x983E5152U, 0xA831C66DU, 0xB00327C8U, 0xBF597FC7U,
+        0xC6E00BF3U, 0xD5A79147U, 0x06CA6351U, 0x14292967U, 0x27B70A85U, 0x2E1B2138U, 0x4D2C6DFCU,
+        0x53380D13U, 0x650A7354U, 0x766A0ABBU, 0x81C2C92EU, 0x92722C85U, 0xA2BFE8A1U, 0xA81A664BU,
+        0xC24B8B70U, 0xC76C51A3U, 0xD192E819U, 0xD6990624U, 0xF40E3585U, 0x106AA070U, 0x19A4C116U,
+        0x1E376C08U, 0x2748774CU, 0x34B0BCB5U, 0x391C0CB3U, 0x4ED8AA4AU, 0x5B9CCA4FU, 0x682E6FF3U,
+        0x748F82EEU, 0x78A5636FU, 0x84C87814U, 0x8CC70208U, 0x90BEFFFAU, 0xA4506CEBU, 0xBEF9A3F7U,
+        0xC67178F2U
+    };
+
+    uint32_t w[64];
+
+    for (size_t i = 0U; i < 16U; i++)
+    {
+        w[i] = (static_cast<uint32_t>(m_sha256Block[i * 4U]) << 24U) |
+               (static_cast<uint32_t>(m_sha256Block[(i * 4U) + 1U]) << 16U) |
+               (static_cast<uint32_t>(m_sha256Block[(i * 4U) + 2U]) << 8U) |
+               static_cast<uint32_t>(m_sha256Block[(i * 4U) + 3U]);
+    }
+
+    for (size_t i = 16U; i < 64U; i++)
+    {
+        const uint32_t w15 = w[i - 15U];
+        const uint32_t w2 = w[i - 2U];
+        const uint32_t s0 = ((w15 >> 7U) | (w15 << 25U)) ^
+                            ((w15 >> 18U) | (w15 << 14U)) ^
+                            (w15 >> 3U);
+        const uint32_t s1 = ((w2 >> 17U) | (w2 << 15U)) ^
+                            ((w2 >> 19U) | (w2 << 13U)) ^
+                            (w2 >> 10U);
+        w[i] = w[i - 16U] + s0 + w[i - 7U] + s1;
+    }
+
+    uint32_t a = m_sha256State[0];
+    uint32_t b = m_sha256State[1];
+    uint32_t c = m_sha256State[2];
+    uint32_t d = m_sha256State[3];
+    uint32_t e = m_sha256State[4];
+    uint32_t f = m_sha256State[5];
+    uint32_t g = m_sha256State[6];
+    uint32_t h = m_sha256State[7];
+
+    for (size_t i = 0U; i < 64U; i++)
+    {
+        const uint32_t s1 = ((e >> 6U) | (e << 26U)) ^
+                            ((e >> 11U) | (e << 21U)) ^
+                            ((e >> 25U) | (e << 7U));
+        const uint32_t ch = (e & f) ^ ((~e) & g);
+        const uint32_t temp1 = h + s1 + ch + s_roundConstants[i] + w[i];
+        const uint32_t s0 = ((a >> 2U) | (a << 30U)) ^
+                            ((a >> 13U) | (a << 19U)) ^
+                            ((a >> 22U) | (a << 10U));
+        const uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        const uint32_t temp2 = s0 + maj;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
+    }
+
+    m_sha256State[0] += a;
+    m_sha256State[1] += b;
+    m_sha256State[2] += c;
+    m_sha256State[3] += d;
+    m_sha256State[4] += e;
+    m_sha256State[5] += f;
+    m_sha256State[6] += g;
+    m_sha256State[7] += h;
+    m_sha256BlockSize = 0U;
+}
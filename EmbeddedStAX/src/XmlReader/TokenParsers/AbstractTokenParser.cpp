@@ -40,6 +40,7 @@ AbstractTokenParser::AbstractTokenParser(const ParserType parserType)
       m_option(Option_None),
       m_tokenType(TokenType_None),
       m_terminationChar(0U),
+      m_trusted(false),
       m_parserType(parserType)
 {
 }
@@ -92,6 +93,33 @@ uint32_t AbstractTokenParser::terminationChar() const
     return m_terminationChar;
 }
 
+/**
+ * Check if the input is trusted
+ *
+ * \retval true     Input is trusted, character level validation is skipped
+ * \retval false    Input is fully validated
+ */
+bool AbstractTokenParser::isTrusted() const
+{
+    return m_trusted;
+}
+
+/**
+ * Set trusted input
+ *
+ * \param trusted   Trusted input flag
+ *
+ * For trusted input the parser only looks for the structural delimiters of the token, characters
+ * are not validated (for example names are not checked for valid name characters).
+ *
+ * \note The flag is kept until it is changed, it is not reset when the parser is initialized or
+ *       deinitialized. Composite parsers pass it on to the parsers they use.
+ */
+void AbstractTokenParser::setTrusted(const bool trusted)
+{
+    m_trusted = trusted;
+}
+
 /**
  * Initialize parser
  *
@@ -55,7 +55,7 @@ AttributeValueParser::~AttributeValueParser()
  *
  * \return Value string
  */
-EmbeddedStAX::Common::UnicodeString AttributeValueParser::value() const
+const EmbeddedStAX::Common::UnicodeString &AttributeValueParser::value() const
 {
     return m_value;
 }
@@ -294,7 +294,7 @@ AttributeValueParser::State AttributeValueParser::executeStateReadingQuotationMa
         if (parsingBuffer()->isMoreDataNeeded())
         {
             // More data is needed
-            nextState = State_ReadingAttributeValue;
+            nextState = State_ReadingQuotationMark;
         }
         else
         {
@@ -322,8 +322,14 @@ AttributeValueParser::State AttributeValueParser::executeStateReadingQuotationMa
                 if (option() == Option_IgnoreLeadingWhitespace)
                 {
                     // Ignore leading whitespace
+                    parsingBuffer()->incrementPosition();
                     finishParsing = false;
                 }
+                else
+                {
+                    // Error, leading whitespace is not allowed
+                    setTerminationChar(uchar);
+                }
             }
             else
             {
@@ -380,6 +386,8 @@ AttributeValueParser::State AttributeValueParser::executeStateReadingAttributeVa
                 // Possible start of Reference found, parse it
                 parsingBuffer()->eraseToCurrentPosition();
 
+                m_referenceParser.setTrusted(isTrusted());
+
                 if (m_referenceParser.initialize(parsingBuffer()))
                 {
                     nextState = State_ReadingReference;
@@ -200,14 +200,13 @@ CDataParser::State CDataParser::executeStateReadingCData()
                 if (position < 2U)
                 {
                     // Valid text character, continue
+                    parsingBuffer()->incrementPosition();
                     finishParsing = false;
                 }
                 else
                 {
-                    const Common::UnicodeString sequence =
-                            parsingBuffer()->substring(position - 2U, position - 1U);
-
-                    if (Common::compareUnicodeString(0U, sequence, std::string("]]")))
+                    if ((parsingBuffer()->at(position - 2U) == static_cast<uint32_t>(']')) &&
+                        (parsingBuffer()->at(position - 1U) == static_cast<uint32_t>(']')))
                     {
                         // End of CDATA found
                         m_text.append(parsingBuffer()->substring(0U, position - 2U));
@@ -224,7 +223,7 @@ CDataParser::State CDataParser::executeStateReadingCData()
                     }
                 }
             }
-            else if (XmlValidator::isChar(uchar))
+            else if (isTrusted() || XmlValidator::isChar(uchar))
             {
                 // Check next character
                 parsingBuffer()->incrementPosition();
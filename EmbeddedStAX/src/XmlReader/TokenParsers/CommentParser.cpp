@@ -137,6 +137,42 @@ AbstractTokenParser::Result CommentParser::parse()
     return result;
 }
 
+/**
+ * Set parsing option
+ *
+ * \param option    New parsing option
+ *
+ * \retval true     Parsing option set
+ * \retval false    Parsing option not set
+ *
+ * \note With option Option_SkipContent the comment is only scanned for its end, the comment text
+ *       is not stored and the parsing buffer is trimmed while scanning.
+ */
+bool CommentParser::setOption(const Option option)
+{
+    bool success = false;
+
+    switch (option)
+    {
+        case Option_None:
+        case Option_SkipContent:
+        {
+            // Valid option
+            AbstractTokenParser::setOption(option);
+            success = true;
+            break;
+        }
+
+        default:
+        {
+            // Invalid option
+            break;
+        }
+    }
+
+    return success;
+}
+
 /**
  * Initialize parser's additional data
  *
@@ -186,6 +222,19 @@ CommentParser::State CommentParser::executeStateReadingComment()
         {
             // More data is needed
             nextState = State_ReadingComment;
+
+            if (option() == Option_SkipContent)
+            {
+                // Comment text is not needed, keep only the last two characters (they can be the
+                // start of the "-->" sequence)
+                const size_t position = parsingBuffer()->currentPosition();
+
+                if (position > 2U)
+                {
+                    parsingBuffer()->erase(position - 2U);
+                    parsingBuffer()->setCurrentPosition(2U);
+                }
+            }
         }
         else
         {
@@ -203,7 +252,11 @@ CommentParser::State CommentParser::executeStateReadingComment()
                     if (parsingBuffer()->currentChar() == static_cast<uint32_t>('>'))
                     {
                         // End of comment found
-                        m_text = parsingBuffer()->substring(0U, position - 2U);
+                        if (option() != Option_SkipContent)
+                        {
+                            m_text = parsingBuffer()->substring(0U, position - 2U);
+                        }
+
                         parsingBuffer()->incrementPosition();
                         nextState = State_Finished;
                     }
@@ -38,7 +38,9 @@ DocumentTypeParser::DocumentTypeParser()
     : AbstractTokenParser(ParserType_DocumentType),
       m_state(State_ReadingName),
       m_nameParser(),
-      m_documentType()
+      m_documentType(),
+      m_text(),
+      m_quoteChar(0U)
 {
 }
 
@@ -95,6 +97,70 @@ AbstractTokenParser::Result DocumentTypeParser::parse()
                             break;
                         }
 
+                        case State_ReadingExternalId:
+                        {
+                            // Execute another cycle
+                            finishParsing = false;
+                            break;
+                        }
+
+                        default:
+                        {
+                            // Error
+                            nextState = State_Error;
+                            break;
+                        }
+                    }
+                    break;
+                }
+
+                case State_ReadingExternalId:
+                {
+                    // Reading external ID
+                    nextState = executeStateReadingExternalId();
+
+                    // Check transitions
+                    switch (nextState)
+                    {
+                        case State_ReadingExternalId:
+                        {
+                            result = Result_NeedMoreData;
+                            break;
+                        }
+
+                        case State_ReadingInternalSubset:
+                        case State_ReadingEnd:
+                        {
+                            // Execute another cycle
+                            finishParsing = false;
+                            break;
+                        }
+
+                        default:
+                        {
+                            // Error
+                            nextState = State_Error;
+                            break;
+                        }
+                    }
+                    break;
+                }
+
+                case State_ReadingInternalSubset:
+                {
+                    // Reading internal subset
+                    nextState = executeStateReadingInternalSubset();
+
+                    // Check transitions
+                    switch (nextState)
+                    {
+                        case State_ReadingInternalSubset:
+                        {
+                            result = Result_NeedMoreData;
+                            break;
+                        }
+
+                        case State_ReadingMarkupDeclaration:
                         case State_ReadingEnd:
                         {
                             // Execute another cycle
@@ -112,6 +178,37 @@ AbstractTokenParser::Result DocumentTypeParser::parse()
                     break;
                 }
 
+                case State_ReadingMarkupDeclaration:
+                {
+                    // Reading markup declaration in the internal subset
+                    nextState = executeStateReadingMarkupDeclaration();
+
+                    // Check transitions
+                    switch (nextState)
+                    {
+                        case State_ReadingMarkupDeclaration:
+                        {
+                            result = Result_NeedMoreData;
+                            break;
+                        }
+
+                        case State_ReadingInternalSubset:
+                        {
+                            // Execute another cycle
+                            finishParsing = false;
+                            break;
+                        }
+
+                        default:
+                        {
+                            // Error
+                            nextState = State_Error;
+                            break;
+                        }
+                    }
+                    break;
+                }
+
                 case State_ReadingEnd:
                 {
                     // Reading end of document type
@@ -180,8 +277,12 @@ bool DocumentTypeParser::initializeAdditionalData()
 {
     m_state = State_ReadingName;
     m_documentType.clear();
+    m_text.clear();
+    m_quoteChar = 0U;
     parsingBuffer()->eraseToCurrentPosition();
 
+    m_nameParser.setTrusted(isTrusted());
+
     return m_nameParser.initialize(parsingBuffer(), Option_IgnoreLeadingWhitespace);
 }
 
@@ -192,15 +293,17 @@ void DocumentTypeParser::deinitializeAdditionalData()
 {
     m_state = State_ReadingName;
     m_documentType.clear();
+    m_text.clear();
+    m_quoteChar = 0U;
     m_nameParser.deinitialize();
 }
 
 /**
  * Execute state: Reading name of the root element
  *
- * \retval State_ReadingName    Wait for more data
- * \retval State_ReadingEnd     Document type read
- * \retval State_Error          Error
+ * \retval State_ReadingName        Wait for more data
+ * \retval State_ReadingExternalId  Name read
+ * \retval State_Error              Error
  */
 DocumentTypeParser::State DocumentTypeParser::executeStateReadingName()
 {
@@ -228,8 +331,10 @@ DocumentTypeParser::State DocumentTypeParser::executeStateReadingName()
                 m_documentType.setName(m_nameParser.value());
                 m_nameParser.deinitialize();
 
-                // Read end of document type
-                nextState = State_ReadingEnd;
+                // Read external ID
+                m_text.clear();
+                m_quoteChar = 0U;
+                nextState = State_ReadingExternalId;
                 break;
             }
 
@@ -245,6 +350,213 @@ DocumentTypeParser::State DocumentTypeParser::executeStateReadingName()
     return nextState;
 }
 
+/**
+ * Execute state: Reading external ID
+ *
+ * \retval State_ReadingExternalId      Wait for more data
+ * \retval State_ReadingInternalSubset  External ID read, internal subset follows
+ * \retval State_ReadingEnd             External ID read
+ * \retval State_Error                  Error
+ *
+ * Format:
+ * \code{.unparsed}
+ * doctypedecl ::= '<!DOCTYPE' S Name (S ExternalID)? S? ('[' intSubset ']' S?)? '>'
+ * ExternalID  ::= 'SYSTEM' S SystemLiteral | 'PUBLIC' S PubidLiteral S SystemLiteral
+ * \endcode
+ */
+DocumentTypeParser::State DocumentTypeParser::executeStateReadingExternalId()
+{
+    State nextState = State_Error;
+    bool finishParsing = false;
+
+    while (!finishParsing)
+    {
+        finishParsing = true;
+
+        // Check if more data is needed
+        if (parsingBuffer()->isMoreDataNeeded())
+        {
+            // More data is needed
+            nextState = State_ReadingExternalId;
+        }
+        else
+        {
+            // Check character
+            const uint32_t uchar = parsingBuffer()->currentChar();
+
+            if ((m_quoteChar == 0U) &&
+                ((uchar == static_cast<uint32_t>('[')) || (uchar == static_cast<uint32_t>('>'))))
+            {
+                // End of external ID found
+                if (parseExternalId())
+                {
+                    m_text.clear();
+
+                    if (uchar == static_cast<uint32_t>('['))
+                    {
+                        parsingBuffer()->incrementPosition();
+                        parsingBuffer()->eraseToCurrentPosition();
+                        nextState = State_ReadingInternalSubset;
+                    }
+                    else
+                    {
+                        nextState = State_ReadingEnd;
+                    }
+                }
+                else
+                {
+                    // Error, invalid external ID
+                }
+            }
+            else
+            {
+                // Literals can contain any character
+                if (m_quoteChar == uchar)
+                {
+                    m_quoteChar = 0U;
+                }
+                else if ((m_quoteChar == 0U) &&
+                         ((uchar == static_cast<uint32_t>('"')) ||
+                          (uchar == static_cast<uint32_t>('\''))))
+                {
+                    m_quoteChar = uchar;
+                }
+                else
+                {
+                    // Other character
+                }
+
+                m_text.push_back(uchar);
+                parsingBuffer()->incrementPosition();
+                parsingBuffer()->eraseToCurrentPosition();
+                finishParsing = false;
+            }
+        }
+    }
+
+    return nextState;
+}
+
+/**
+ * Execute state: Reading internal subset
+ *
+ * \retval State_ReadingInternalSubset      Wait for more data
+ * \retval State_ReadingMarkupDeclaration   Start of markup declaration found
+ * \retval State_ReadingEnd                 End of internal subset read
+ * \retval State_Error                      Error
+ *
+ * Format:
+ * \code{.unparsed}
+ * intSubset ::= (markupdecl | PEReference | S)*
+ * \endcode
+ */
+DocumentTypeParser::State DocumentTypeParser::executeStateReadingInternalSubset()
+{
+    State nextState = State_Error;
+    bool finishParsing = false;
+
+    while (!finishParsing)
+    {
+        finishParsing = true;
+
+        // Check if more data is needed
+        if (parsingBuffer()->isMoreDataNeeded())
+        {
+            // More data is needed
+            nextState = State_ReadingInternalSubset;
+        }
+        else
+        {
+            // Check character
+            const uint32_t uchar = parsingBuffer()->currentChar();
+
+            if (XmlValidator::isWhitespace(uchar))
+            {
+                // We are allowed to ignore whitespace characters
+                parsingBuffer()->incrementPosition();
+                parsingBuffer()->eraseToCurrentPosition();
+                finishParsing = false;
+            }
+            else if (uchar == static_cast<uint32_t>(']'))
+            {
+                // End of internal subset found
+                parsingBuffer()->incrementPosition();
+                parsingBuffer()->eraseToCurrentPosition();
+                nextState = State_ReadingEnd;
+            }
+            else if ((uchar == static_cast<uint32_t>('<')) ||
+                     (uchar == static_cast<uint32_t>('%')))
+            {
+                // Start of markup declaration or parameter entity reference found
+                m_text.clear();
+                m_quoteChar = 0U;
+                nextState = State_ReadingMarkupDeclaration;
+            }
+            else
+            {
+                // Error, invalid character read
+            }
+        }
+    }
+
+    return nextState;
+}
+
+/**
+ * Execute state: Reading markup declaration in the internal subset
+ *
+ * \retval State_ReadingMarkupDeclaration   Wait for more data
+ * \retval State_ReadingInternalSubset      Markup declaration read
+ * \retval State_Error                      Error
+ *
+ * \note The characters of the markup declaration are collected until its end, element type
+ *       declarations are then stored in the document type and the other declarations are
+ *       skipped.
+ */
+DocumentTypeParser::State DocumentTypeParser::executeStateReadingMarkupDeclaration()
+{
+    State nextState = State_Error;
+    bool finishParsing = false;
+
+    while (!finishParsing)
+    {
+        finishParsing = true;
+
+        // Check if more data is needed
+        if (parsingBuffer()->isMoreDataNeeded())
+        {
+            // More data is needed
+            nextState = State_ReadingMarkupDeclaration;
+        }
+        else
+        {
+            // Read character
+            const uint32_t uchar = parsingBuffer()->currentChar();
+            m_text.push_back(uchar);
+            parsingBuffer()->incrementPosition();
+            parsingBuffer()->eraseToCurrentPosition();
+
+            if (!isMarkupDeclarationEnd(uchar))
+            {
+                // Read next character
+                finishParsing = false;
+            }
+            else if (parseMarkupDeclaration())
+            {
+                // Markup declaration read
+                m_text.clear();
+                nextState = State_ReadingInternalSubset;
+            }
+            else
+            {
+                // Error, invalid markup declaration
+            }
+        }
+    }
+
+    return nextState;
+}
+
 /**
  * Execute state: Reading end of document type
  *
@@ -303,3 +615,286 @@ DocumentTypeParser::State DocumentTypeParser::executeStateReadingEnd()
 
     return nextState;
 }
+
+/**
+ * Parse external ID
+ *
+ * \retval true     Success (external ID is optional)
+ * \retval false    Error
+ */
+bool DocumentTypeParser::parseExternalId()
+{
+    bool success = false;
+    Common::UnicodeString publicId;
+    Common::UnicodeString systemId;
+    size_t position = skipWhitespace(m_text, 0U);
+
+    if (position == m_text.size())
+    {
+        // No external ID
+        success = true;
+    }
+    else if (startsWith(m_text.substr(position, 6U), "SYSTEM"))
+    {
+        position += 6U;
+
+        if (skipWhitespace(m_text, position) != position)
+        {
+            position = readLiteral(m_text, skipWhitespace(m_text, position), &systemId);
+            success = (position != Common::UnicodeString::npos);
+        }
+    }
+    else if (startsWith(m_text.substr(position, 6U), "PUBLIC"))
+    {
+        position += 6U;
+
+        if (skipWhitespace(m_text, position) != position)
+        {
+            position = readLiteral(m_text, skipWhitespace(m_text, position), &publicId);
+
+            if ((position != Common::UnicodeString::npos) &&
+                (skipWhitespace(m_text, position) != position))
+            {
+                position = readLiteral(m_text, skipWhitespace(m_text, position), &systemId);
+                success = (position != Common::UnicodeString::npos);
+            }
+        }
+    }
+    else
+    {
+        // Error, invalid external ID
+    }
+
+    if (success && (position != m_text.size()))
+    {
+        // Only whitespace is allowed after the external ID
+        success = (skipWhitespace(m_text, position) == m_text.size());
+    }
+
+    if (success)
+    {
+        m_documentType.setExternalId(publicId, systemId);
+    }
+
+    return success;
+}
+
+/**
+ * Parse the markup declaration
+ *
+ * \retval true     Success
+ * \retval false    Error
+ *
+ * Format:
+ * \code{.unparsed}
+ * markupdecl  ::= elementdecl | AttlistDecl | EntityDecl | NotationDecl | PI | Comment
+ * elementdecl ::= '<!ELEMENT' S Name S contentspec S? '>'
+ * \endcode
+ *
+ * \note The content specification is not parsed here, it is compiled by the schema validator.
+ */
+bool DocumentTypeParser::parseMarkupDeclaration()
+{
+    bool success = false;
+    size_t keywordSize = 0U;
+
+    if (startsWith(m_text, "<!ELEMENT"))
+    {
+        // Element type declaration: read the name and the content specification
+        const size_t nameStart = skipWhitespace(m_text, 9U);
+        size_t nameEnd = nameStart;
+
+        while ((nameEnd < m_text.size()) && XmlValidator::isNameChar(m_text.at(nameEnd)))
+        {
+            nameEnd++;
+        }
+
+        const size_t contentSpecStart = skipWhitespace(m_text, nameEnd);
+        size_t contentSpecEnd = m_text.size() - 1U;
+
+        while ((contentSpecEnd > contentSpecStart) &&
+               XmlValidator::isWhitespace(m_text.at(contentSpecEnd - 1U)))
+        {
+            contentSpecEnd--;
+        }
+
+        const Common::UnicodeString name = m_text.substr(nameStart, nameEnd - nameStart);
+
+        if ((nameStart > 9U) &&
+            (contentSpecStart > nameEnd) &&
+            (contentSpecEnd > contentSpecStart) &&
+            XmlValidator::validateName(name))
+        {
+            m_documentType.addElementDeclaration(
+                        name,
+                        m_text.substr(contentSpecStart, contentSpecEnd - contentSpecStart));
+            success = true;
+        }
+    }
+    else if (startsWith(m_text, "<!ATTLIST"))
+    {
+        keywordSize = 9U;
+    }
+    else if (startsWith(m_text, "<!ENTITY"))
+    {
+        keywordSize = 8U;
+    }
+    else if (startsWith(m_text, "<!NOTATION"))
+    {
+        keywordSize = 10U;
+    }
+    else if ((m_text.at(0U) == static_cast<uint32_t>('%')) ||
+             startsWith(m_text, "<!--") ||
+             startsWith(m_text, "<?"))
+    {
+        // Parameter entity reference, comment or processing instruction is skipped
+        success = true;
+    }
+    else
+    {
+        // Error, invalid markup declaration
+    }
+
+    if (keywordSize > 0U)
+    {
+        // Other declarations are skipped, the keyword has to be followed by whitespace
+        success = (skipWhitespace(m_text, keywordSize) > keywordSize);
+    }
+
+    return success;
+}
+
+/**
+ * Check if the character ends the markup declaration that is being read
+ *
+ * \param uchar Last character of the markup declaration
+ *
+ * \retval true     End of the markup declaration
+ * \retval false    Not the end of the markup declaration
+ *
+ * \note Literals in the declarations are tracked, they can contain the '>' character.
+ */
+bool DocumentTypeParser::isMarkupDeclarationEnd(const uint32_t uchar)
+{
+    bool end = false;
+    const size_t size = m_text.size();
+
+    if (m_text.at(0U) == static_cast<uint32_t>('%'))
+    {
+        // Parameter entity reference
+        end = (uchar == static_cast<uint32_t>(';'));
+    }
+    else if (startsWith(m_text, "<!--"))
+    {
+        // Comment
+        end = ((size >= 7U) &&
+               (uchar == static_cast<uint32_t>('>')) &&
+               (m_text.at(size - 2U) == static_cast<uint32_t>('-')) &&
+               (m_text.at(size - 3U) == static_cast<uint32_t>('-')));
+    }
+    else if (startsWith(m_text, "<?"))
+    {
+        // Processing instruction
+        end = ((size >= 4U) &&
+               (uchar == static_cast<uint32_t>('>')) &&
+               (m_text.at(size - 2U) == static_cast<uint32_t>('?')));
+    }
+    else if (m_quoteChar != 0U)
+    {
+        // Literal
+        if (uchar == m_quoteChar)
+        {
+            m_quoteChar = 0U;
+        }
+    }
+    else if ((uchar == static_cast<uint32_t>('"')) || (uchar == static_cast<uint32_t>('\'')))
+    {
+        // Start of literal
+        m_quoteChar = uchar;
+    }
+    else
+    {
+        end = (uchar == static_cast<uint32_t>('>'));
+    }
+
+    return end;
+}
+
+/**
+ * Check if the text starts with the prefix
+ *
+ * \param text      Text
+ * \param prefix    Prefix (ASCII characters)
+ *
+ * \retval true     Text starts with the prefix
+ * \retval false    Text does not start with the prefix
+ */
+bool DocumentTypeParser::startsWith(const Common::UnicodeString &text, const char *prefix)
+{
+    bool match = true;
+    size_t i = 0U;
+
+    while (match && (prefix[i] != '\0'))
+    {
+        if ((i >= text.size()) || (text.at(i) != static_cast<uint32_t>(prefix[i])))
+        {
+            match = false;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    return match;
+}
+
+/**
+ * Skip whitespace characters
+ *
+ * \param text      Text
+ * \param position  Start position
+ *
+ * \return Position of the first non-whitespace character (or size of the text)
+ */
+size_t DocumentTypeParser::skipWhitespace(const Common::UnicodeString &text, size_t position)
+{
+    while ((position < text.size()) && XmlValidator::isWhitespace(text.at(position)))
+    {
+        position++;
+    }
+
+    return position;
+}
+
+/**
+ * Read a quoted literal
+ *
+ * \param text      Text
+ * \param position  Position of the opening quote
+ * \param literal   Output for the value of the literal (without the quotes)
+ *
+ * \return Position after the closing quote
+ * \retval Common::UnicodeString::npos  Invalid literal
+ */
+size_t DocumentTypeParser::readLiteral(const Common::UnicodeString &text,
+                                       const size_t position,
+                                       Common::UnicodeString *literal)
+{
+    size_t end = Common::UnicodeString::npos;
+
+    if ((position < text.size()) &&
+        ((text.at(position) == static_cast<uint32_t>('"')) ||
+         (text.at(position) == static_cast<uint32_t>('\''))))
+    {
+        const size_t closingQuote = text.find(text.at(position), position + 1U);
+
+        if (closingQuote != Common::UnicodeString::npos)
+        {
+            *literal = text.substr(position + 1U, closingQuote - position - 1U);
+            end = closingQuote + 1U;
+        }
+    }
+
+    return end;
+}
@@ -37,7 +37,9 @@ EndOfElementParser::EndOfElementParser()
     : AbstractTokenParser(ParserType_Reference),
       m_state(State_ReadingElementName),
       m_nameParser(),
-      m_elementName()
+      m_elementName(),
+      m_expectedName(NULL),
+      m_expectedNameMatched(false)
 {
 }
 
@@ -52,12 +54,42 @@ EndOfElementParser::~EndOfElementParser()
  * Get element name
  *
  * \return Element name
+ *
+ * \note The name is not copied when the end tag matched the expected name (see isExpectedName()),
+ *       in that case the expected name has to be used instead and an empty string is returned.
  */
 EmbeddedStAX::Common::UnicodeString EndOfElementParser::name() const
 {
     return m_elementName;
 }
 
+/**
+ * Check if the element name matched the expected name
+ *
+ * \retval true     Element name was matched directly against the expected name
+ * \retval false    Element name was read with the name parser
+ */
+bool EndOfElementParser::isExpectedName() const
+{
+    return m_expectedNameMatched;
+}
+
+/**
+ * Set expected element name
+ *
+ * \param expectedName  Pointer to the name of the innermost open element (NULL if not known)
+ *
+ * When an expected name is set the end tag is first compared directly against it, the full name
+ * parsing is only done if the end tag does not match it.
+ *
+ * \note It has to be set before the parser is initialized and the name must not change until the
+ *       end of element is parsed.
+ */
+void EndOfElementParser::setExpectedName(const Common::UnicodeString *expectedName)
+{
+    m_expectedName = expectedName;
+}
+
 /**
  * Parse
  *
@@ -80,6 +112,44 @@ AbstractTokenParser::Result EndOfElementParser::parse()
 
             switch (m_state)
             {
+                case State_MatchingElementName:
+                {
+                    // Matching element name
+                    nextState = executeStateMatchingElementName();
+
+                    // Check transitions
+                    switch (nextState)
+                    {
+                        case State_MatchingElementName:
+                        {
+                            result = Result_NeedMoreData;
+                            break;
+                        }
+
+                        case State_ReadingElementName:
+                        case State_ReadingEndOfElement:
+                        {
+                            // Execute another cycle
+                            finishParsing = false;
+                            break;
+                        }
+
+                        case State_Finished:
+                        {
+                            result = Result_Success;
+                            break;
+                        }
+
+                        default:
+                        {
+                            // Error
+                            nextState = State_Error;
+                            break;
+                        }
+                    }
+                    break;
+                }
+
                 case State_ReadingElementName:
                 {
                     // Reading element name
@@ -183,11 +253,23 @@ AbstractTokenParser::Result EndOfElementParser::parse()
  */
 bool EndOfElementParser::initializeAdditionalData()
 {
-    m_state = State_ReadingElementName;
+    bool success = true;
     m_elementName.clear();
+    m_expectedNameMatched = false;
     parsingBuffer()->eraseToCurrentPosition();
 
-    return m_nameParser.initialize(parsingBuffer());
+    if ((m_expectedName != NULL) && (!m_expectedName->empty()))
+    {
+        m_state = State_MatchingElementName;
+    }
+    else
+    {
+        m_state = State_ReadingElementName;
+        m_nameParser.setTrusted(isTrusted());
+        success = m_nameParser.initialize(parsingBuffer());
+    }
+
+    return success;
 }
 
 /**
@@ -197,9 +279,100 @@ void EndOfElementParser::deinitializeAdditionalData()
 {
     m_state = State_ReadingElementName;
     m_elementName.clear();
+    m_expectedName = NULL;
+    m_expectedNameMatched = false;
     m_nameParser.deinitialize();
 }
 
+/**
+ * Execute state: Matching element name
+ *
+ * \retval State_MatchingElementName    Wait for more data
+ * \retval State_ReadingElementName     Element name does not match the expected name, it has to be
+ *                                      parsed
+ * \retval State_ReadingEndOfElement    Expected element name found
+ * \retval State_Finished               End of element with the expected element name found
+ * \retval State_Error                  Error
+ *
+ * \note The current position in the parsing buffer is the number of already matched characters.
+ */
+EndOfElementParser::State EndOfElementParser::executeStateMatchingElementName()
+{
+    State nextState = State_Error;
+    bool finishParsing = false;
+
+    while (!finishParsing)
+    {
+        finishParsing = true;
+
+        // Check if more data is needed
+        if (parsingBuffer()->isMoreDataNeeded())
+        {
+            // More data is needed
+            nextState = State_MatchingElementName;
+        }
+        else
+        {
+            const size_t position = parsingBuffer()->currentPosition();
+            const uint32_t uchar = parsingBuffer()->currentChar();
+            bool match = false;
+
+            if (position < m_expectedName->size())
+            {
+                if (uchar == m_expectedName->at(position))
+                {
+                    // Check next character
+                    parsingBuffer()->incrementPosition();
+                    finishParsing = false;
+                    match = true;
+                }
+            }
+            else if (uchar == static_cast<uint32_t>('>'))
+            {
+                // End of element with the expected name found
+                m_expectedNameMatched = true;
+                parsingBuffer()->incrementPosition();
+                parsingBuffer()->eraseToCurrentPosition();
+                setTokenType(TokenType_EndOfElement);
+                nextState = State_Finished;
+                match = true;
+            }
+            else if (XmlValidator::isWhitespace(uchar))
+            {
+                // Expected element name found, try to read end of element
+                m_expectedNameMatched = true;
+                parsingBuffer()->incrementPosition();
+                parsingBuffer()->eraseToCurrentPosition();
+                nextState = State_ReadingEndOfElement;
+                match = true;
+            }
+            else
+            {
+                // Element name is longer than the expected name
+            }
+
+            if (!match)
+            {
+                // Element name does not match the expected name, parse it from the start
+                parsingBuffer()->setCurrentPosition(0U);
+
+                m_nameParser.setTrusted(isTrusted());
+
+                if (m_nameParser.initialize(parsingBuffer()))
+                {
+                    nextState = State_ReadingElementName;
+                }
+                else
+                {
+                    // Error, failed to initialize parser
+                }
+            }
+        }
+    }
+
+    return nextState;
+}
+
 /**
  * Execute state: Reading element name
  *
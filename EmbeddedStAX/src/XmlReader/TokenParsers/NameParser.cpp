@@ -26,6 +26,7 @@
  */
 
 #include <EmbeddedStAX/XmlReader/TokenParsers/NameParser.h>
+#include <EmbeddedStAX/Common/HashIndex.h>
 #include <EmbeddedStAX/XmlValidator/Common.h>
 #include <EmbeddedStAX/XmlValidator/Name.h>
 
@@ -37,7 +38,11 @@ using namespace EmbeddedStAX::XmlReader;
 NameParser::NameParser()
     : AbstractTokenParser(ParserType_Name),
       m_state(State_ReadingNameStartChar),
-      m_value()
+      m_value(),
+      m_hash(Common::HashIndex::initialHash()),
+      m_hashSeed(Common::HashIndex::initialHash()),
+      m_shapePredictor(NULL),
+      m_nameType(ShapePredictor::NameType_Element)
 {
 }
 
@@ -58,6 +63,48 @@ EmbeddedStAX::Common::UnicodeString NameParser::value() const
     return m_value;
 }
 
+/**
+ * Get hash of the value string
+ *
+ * \return Hash of the value string
+ *
+ * \note The hash (FNV-1a, starting with the hash seed) is calculated while the name is scanned so
+ *       it is available without another pass over the value string.
+ */
+uint32_t NameParser::hash() const
+{
+    return m_hash;
+}
+
+/**
+ * Set hash seed
+ *
+ * \param hashSeed  Seed that is used in place of the FNV-1a offset basis
+ *
+ * \note Hashes of names read with different seeds must not be compared.
+ */
+void NameParser::setHashSeed(const uint32_t hashSeed)
+{
+    m_hashSeed = hashSeed;
+}
+
+/**
+ * Set shape predictor
+ *
+ * \param shapePredictor    Predictor of the names (NULL to disable prediction)
+ * \param nameType          Type of the name that is parsed next
+ *
+ * \note With a predictor the input is first compared with the predicted name. If it matches, the
+ *       name is not scanned and validated character by character. Otherwise the name is parsed as
+ *       usual and the predictor learns it.
+ */
+void NameParser::setShapePredictor(ShapePredictor *shapePredictor,
+                                   const ShapePredictor::NameType nameType)
+{
+    m_shapePredictor = shapePredictor;
+    m_nameType = nameType;
+}
+
 /**
  * Parse
  *
@@ -101,6 +148,13 @@ AbstractTokenParser::Result NameParser::parse()
                             break;
                         }
 
+                        case State_Finished:
+                        {
+                            // Predicted name found
+                            result = Result_Success;
+                            break;
+                        }
+
                         default:
                         {
                             // Error
@@ -212,6 +266,7 @@ bool NameParser::initializeAdditionalData()
 {
     m_state = State_ReadingNameStartChar;
     m_value.clear();
+    m_hash = m_hashSeed;
     parsingBuffer()->eraseToCurrentPosition();
     return true;
 }
@@ -223,6 +278,7 @@ void NameParser::deinitializeAdditionalData()
 {
     m_state = State_ReadingNameStartChar;
     m_value.clear();
+    m_hash = m_hashSeed;
 }
 
 /**
@@ -251,13 +307,32 @@ NameParser::State NameParser::executeStateReadingNameStartChar()
         {
             // Check character
             const uint32_t uchar = parsingBuffer()->currentChar();
+            bool nameStartChar = false;
+
+            if (isTrusted())
+            {
+                nameStartChar = !XmlValidator::isNameDelimiter(uchar);
+            }
+            else
+            {
+                nameStartChar = XmlValidator::isNameStartChar(uchar);
+            }
 
-            if (XmlValidator::isNameStartChar(uchar))
+            if (nameStartChar)
             {
                 // Name start character found, now start reading the token type
                 parsingBuffer()->eraseToCurrentPosition();
-                parsingBuffer()->incrementPosition();
-                nextState = State_ReadingNameChars;
+
+                if (matchPredictedName())
+                {
+                    nextState = State_Finished;
+                }
+                else
+                {
+                    parsingBuffer()->incrementPosition();
+                    m_hash = Common::HashIndex::appendHash(m_hash, uchar);
+                    nextState = State_ReadingNameChars;
+                }
             }
             else
             {
@@ -314,11 +389,22 @@ NameParser::State NameParser::executeStateReadingNameChars()
         {
             // Check character
             const uint32_t uchar = parsingBuffer()->currentChar();
+            bool nameChar = false;
+
+            if (isTrusted())
+            {
+                nameChar = !XmlValidator::isNameDelimiter(uchar);
+            }
+            else
+            {
+                nameChar = XmlValidator::isNameChar(uchar);
+            }
 
-            if (XmlValidator::isNameChar(uchar))
+            if (nameChar)
             {
                 // Name character found, check for next one
                 parsingBuffer()->incrementPosition();
+                m_hash = Common::HashIndex::appendHash(m_hash, uchar);
                 finishParsing = false;
             }
             else
@@ -327,6 +413,11 @@ NameParser::State NameParser::executeStateReadingNameChars()
                 const size_t size = parsingBuffer()->currentPosition();
                 m_value = parsingBuffer()->substring(0U, size);
 
+                if (m_shapePredictor != NULL)
+                {
+                    m_shapePredictor->addName(m_value, m_hash, !isTrusted(), false);
+                }
+
                 parsingBuffer()->eraseToCurrentPosition();
                 nextState = State_Finished;
             }
@@ -335,3 +426,52 @@ NameParser::State NameParser::executeStateReadingNameChars()
 
     return nextState;
 }
+
+/**
+ * Match the predicted name with the input
+ *
+ * \retval true     Predicted name found, the name is read
+ * \retval false    No prediction or the input does not match it
+ *
+ * \note A name that was not validated is never predicted when validation is needed.
+ */
+bool NameParser::matchPredictedName()
+{
+    bool match = false;
+
+    if (m_shapePredictor != NULL)
+    {
+        uint32_t hash = 0U;
+        const Common::UnicodeString *name = m_shapePredictor->predictName(m_nameType,
+                                                                          !isTrusted(),
+                                                                          &hash);
+
+        if ((name != NULL) && parsingBuffer()->matchesCurrentPosition(*name))
+        {
+            // Name in the input has to end right after the predicted name
+            const size_t endPosition = parsingBuffer()->currentPosition() + name->size();
+            const uint32_t uchar = parsingBuffer()->at(endPosition);
+
+            if (isTrusted())
+            {
+                match = XmlValidator::isNameDelimiter(uchar);
+            }
+            else
+            {
+                match = !XmlValidator::isNameChar(uchar);
+            }
+
+            if (match)
+            {
+                m_value = *name;
+                m_hash = hash;
+                m_shapePredictor->addName(m_value, m_hash, !isTrusted(), true);
+
+                parsingBuffer()->setCurrentPosition(endPosition);
+                parsingBuffer()->eraseToCurrentPosition();
+            }
+        }
+    }
+
+    return match;
+}
@@ -182,6 +182,43 @@ AbstractTokenParser::Result ProcessingInstructionParser::parse()
     return result;
 }
 
+/**
+ * Set parsing option
+ *
+ * \param option    New parsing option
+ *
+ * \retval true     Parsing option set
+ * \retval false    Parsing option not set
+ *
+ * \note With option Option_SkipContent the PI data of a processing instruction is only scanned for
+ *       the end of the processing instruction, it is not stored and the parsing buffer is trimmed
+ *       while scanning. A XML declaration is always fully parsed.
+ */
+bool ProcessingInstructionParser::setOption(const Option option)
+{
+    bool success = false;
+
+    switch (option)
+    {
+        case Option_None:
+        case Option_SkipContent:
+        {
+            // Valid option
+            AbstractTokenParser::setOption(option);
+            success = true;
+            break;
+        }
+
+        default:
+        {
+            // Invalid option
+            break;
+        }
+    }
+
+    return success;
+}
+
 /**
  * Initialize parser's additional data
  *
@@ -195,6 +232,8 @@ bool ProcessingInstructionParser::initializeAdditionalData()
     m_xmlDeclaration.clear();
     parsingBuffer()->eraseToCurrentPosition();
 
+    m_nameParser.setTrusted(isTrusted());
+
     return m_nameParser.initialize(parsingBuffer());
 }
 
@@ -273,6 +312,8 @@ ProcessingInstructionParser::State ProcessingInstructionParser::executeStateRead
 {
     State nextState = State_Error;
     bool finishParsing = false;
+    const bool skipPiData =
+            (option() == Option_SkipContent) && (!XmlValidator::isXmlDeclaration(m_piTarget));
 
     while (!finishParsing)
     {
@@ -283,13 +324,26 @@ ProcessingInstructionParser::State ProcessingInstructionParser::executeStateRead
         {
             // More data is needed
             nextState = State_ReadingPiData;
+
+            if (skipPiData)
+            {
+                // PI data is not needed, keep only the last character (it can be the start of the
+                // "?>" sequence)
+                const size_t position = parsingBuffer()->currentPosition();
+
+                if (position > 1U)
+                {
+                    parsingBuffer()->erase(position - 1U);
+                    parsingBuffer()->setCurrentPosition(1U);
+                }
+            }
         }
         else
         {
             // Check character
             const uint32_t uchar = parsingBuffer()->currentChar();
 
-            if (XmlValidator::isChar(uchar))
+            if (isTrusted() || XmlValidator::isChar(uchar))
             {
                 // Check for "?>" sequence
                 const size_t currentPosition = parsingBuffer()->currentPosition();
@@ -306,13 +360,31 @@ ProcessingInstructionParser::State ProcessingInstructionParser::executeStateRead
                         (parsingBuffer()->at(currentPosition - 1U) == static_cast<uint32_t>('?')))
                     {
                         // End of PI Data found
-                        const Common::UnicodeString piData =
-                                parsingBuffer()->substring(0U, currentPosition - 1U);
+                        Common::UnicodeString piData;
+
+                        if (!skipPiData)
+                        {
+                            piData = parsingBuffer()->substring(0U, currentPosition - 1U);
+                        }
+
                         parsingBuffer()->incrementPosition();
                         parsingBuffer()->eraseToCurrentPosition();
 
                         // Check for XML declaration
-                        if (XmlValidator::isXmlDeclaration(m_piTarget))
+                        if (skipPiData)
+                        {
+                            if (XmlValidator::validatePiTarget(m_piTarget))
+                            {
+                                // Processing instruction skipped
+                                setTokenType(TokenType_ProcessingInstruction);
+                                nextState = State_Finished;
+                            }
+                            else
+                            {
+                                // Error, invalid PI target
+                            }
+                        }
+                        else if (XmlValidator::isXmlDeclaration(m_piTarget))
                         {
                             // Parse XML declaration
                             m_xmlDeclaration = Common::XmlDeclaration::fromPiData(piData);
@@ -329,7 +401,7 @@ ProcessingInstructionParser::State ProcessingInstructionParser::executeStateRead
                             m_processingInstruction.setPiTarget(m_piTarget);
                             m_processingInstruction.setPiData(piData);
 
-                            if (m_processingInstruction.isValid())
+                            if (isTrusted() || m_processingInstruction.isValid())
                             {
                                 // Processing instruction read
                                 setTokenType(TokenType_ProcessingInstruction);
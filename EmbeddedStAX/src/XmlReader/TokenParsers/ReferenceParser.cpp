@@ -383,7 +383,7 @@ ReferenceParser::State ReferenceParser::executeStateReadingReferenceType()
     if (parsingBuffer()->isMoreDataNeeded())
     {
         // More data is needed
-        nextState = State_ReadingStartOfReference;
+        nextState = State_ReadingReferenceType;
     }
     else
     {
@@ -400,6 +400,8 @@ ReferenceParser::State ReferenceParser::executeStateReadingReferenceType()
         else if (XmlValidator::isNameStartChar(uchar))
         {
             // Entity reference found, now start reading the entity reference name
+            m_nameParser.setTrusted(isTrusted());
+
             if (m_nameParser.initialize(parsingBuffer()))
             {
                 nextState = State_ReadingEntityReferenceName;
@@ -498,7 +500,7 @@ ReferenceParser::State ReferenceParser::executeStateReadingCharacterReferenceTyp
     if (parsingBuffer()->isMoreDataNeeded())
     {
         // More data is needed
-        nextState = State_ReadingStartOfReference;
+        nextState = State_ReadingCharacterReferenceType;
     }
     else
     {
@@ -566,7 +568,7 @@ ReferenceParser::State ReferenceParser::executeStateReadingCharacterReferenceDec
             {
                 // End of character reference (in decimal format) found
                 m_value.clear();
-                m_value.push_back(uchar);
+                m_value.push_back(m_charRefValue);
 
                 parsingBuffer()->incrementPosition();
                 parsingBuffer()->eraseToCurrentPosition();
@@ -576,7 +578,7 @@ ReferenceParser::State ReferenceParser::executeStateReadingCharacterReferenceDec
             else if (Common::parseDigit(uchar, 10U, &digitValue))
             {
                 // Digit found
-                m_charRefValue = (m_charRefValue * 10U) + uchar;
+                m_charRefValue = (m_charRefValue * 10U) + digitValue;
 
                 if (Common::isUnicodeChar(m_charRefValue))
                 {
@@ -637,7 +639,7 @@ ReferenceParser::State ReferenceParser::executeStateReadingCharacterReferenceHex
             {
                 // End of character reference (in hexadecimal format) found
                 m_value.clear();
-                m_value.push_back(uchar);
+                m_value.push_back(m_charRefValue);
 
                 parsingBuffer()->incrementPosition();
                 parsingBuffer()->eraseToCurrentPosition();
@@ -647,7 +649,7 @@ ReferenceParser::State ReferenceParser::executeStateReadingCharacterReferenceHex
             else if (Common::parseDigit(uchar, 16U, &digitValue))
             {
                 // Digit found
-                m_charRefValue = (m_charRefValue * 16U) + uchar;
+                m_charRefValue = (m_charRefValue * 16U) + digitValue;
 
                 if (Common::isUnicodeChar(m_charRefValue))
                 {
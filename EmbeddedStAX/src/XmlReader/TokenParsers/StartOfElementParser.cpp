@@ -39,9 +39,14 @@ StartOfElementParser::StartOfElementParser()
       m_state(State_ReadingElementName),
       m_nameParser(),
       m_attributeValueParser(),
+      m_attributeValueCache(NULL),
+      m_shapePredictor(NULL),
       m_elementName(),
       m_attributeName(),
-      m_attributeList()
+      m_attributeNameHash(0U),
+      m_attributeList(),
+      m_attributeNameList(),
+      m_attributeNameIndex()
 {
 }
 
@@ -72,6 +77,40 @@ const EmbeddedStAX::Common::AttributeList &StartOfElementParser::attributeList()
     return m_attributeList;
 }
 
+/**
+ * Set attribute value cache
+ *
+ * \param attributeValueCache   Cache used to intern attribute values (NULL to disable interning)
+ */
+void StartOfElementParser::setAttributeValueCache(AttributeValueCache *attributeValueCache)
+{
+    m_attributeValueCache = attributeValueCache;
+}
+
+/**
+ * Set shape predictor
+ *
+ * \param shapePredictor    Predictor of the element and attribute names (NULL to disable
+ *                          prediction)
+ */
+void StartOfElementParser::setShapePredictor(ShapePredictor *shapePredictor)
+{
+    m_shapePredictor = shapePredictor;
+}
+
+/**
+ * Set hash seed of the element and attribute names
+ *
+ * \param hashSeed  Hash seed
+ *
+ * \note Attribute names are checked for duplicates in a hash table. With a seed that is not known
+ *       in advance the input can not be prepared so that all of the attribute names collide.
+ */
+void StartOfElementParser::setHashSeed(const uint32_t hashSeed)
+{
+    m_nameParser.setHashSeed(hashSeed);
+}
+
 /**
  * Parse
  *
@@ -341,9 +380,13 @@ bool StartOfElementParser::initializeAdditionalData()
     m_elementName.clear();
     m_attributeName.clear();
     m_attributeList.clear();
+    clearAttributeNames();
     parsingBuffer()->eraseToCurrentPosition();
     m_attributeValueParser.deinitialize();
 
+    m_nameParser.setTrusted(isTrusted());
+    m_nameParser.setShapePredictor(m_shapePredictor, ShapePredictor::NameType_Element);
+
     return m_nameParser.initialize(parsingBuffer());
 }
 
@@ -356,6 +399,7 @@ void StartOfElementParser::deinitializeAdditionalData()
     m_elementName.clear();
     m_attributeName.clear();
     m_attributeList.clear();
+    clearAttributeNames();
     m_nameParser.deinitialize();
     m_attributeValueParser.deinitialize();
 }
@@ -400,6 +444,7 @@ StartOfElementParser::State StartOfElementParser::executeStateReadingElementName
                 // End of start of element found
                 m_elementName = m_nameParser.value();
                 m_attributeList.clear();
+                clearAttributeNames();
                 parsingBuffer()->incrementPosition();
                 parsingBuffer()->eraseToCurrentPosition();
                 setTokenType(TokenType_StartOfElement);
@@ -410,6 +455,7 @@ StartOfElementParser::State StartOfElementParser::executeStateReadingElementName
                 // End of empty element found
                 m_elementName = m_nameParser.value();
                 m_attributeList.clear();
+                clearAttributeNames();
                 parsingBuffer()->incrementPosition();
                 parsingBuffer()->eraseToCurrentPosition();
                 nextState = State_ReadingEndOfEmptyElement;
@@ -419,6 +465,7 @@ StartOfElementParser::State StartOfElementParser::executeStateReadingElementName
                 // End of element name, start reading next item
                 m_elementName = m_nameParser.value();
                 m_attributeList.clear();
+                clearAttributeNames();
                 parsingBuffer()->incrementPosition();
                 parsingBuffer()->eraseToCurrentPosition();
                 nextState = State_ReadingNextItem;
@@ -492,6 +539,9 @@ StartOfElementParser::State StartOfElementParser::executeStateReadingNextItem()
             {
                 // Start of attribute name found, start reading the next attribute
                 parsingBuffer()->eraseToCurrentPosition();
+                m_nameParser.setTrusted(isTrusted());
+                m_nameParser.setShapePredictor(m_shapePredictor,
+                                               ShapePredictor::NameType_Attribute);
                 m_nameParser.initialize(parsingBuffer());
                 nextState = State_ReadingAttributeName;
             }
@@ -542,8 +592,17 @@ StartOfElementParser::State StartOfElementParser::executeStateReadingAttributeNa
         {
             // End of attribute name found
             m_attributeName = m_nameParser.value();
+            m_attributeNameHash = m_nameParser.hash();
             m_nameParser.deinitialize();
-            nextState = State_ReadingEqualSign;
+
+            if (containsAttributeName(m_attributeName, m_attributeNameHash))
+            {
+                // Error, duplicate attribute name
+            }
+            else
+            {
+                nextState = State_ReadingEqualSign;
+            }
             break;
         }
 
@@ -623,6 +682,7 @@ StartOfElementParser::State StartOfElementParser::executeStateReadingEqualSign()
                 // Equal sign found
                 parsingBuffer()->incrementPosition();
                 parsingBuffer()->eraseToCurrentPosition();
+                m_attributeValueParser.setTrusted(isTrusted());
                 m_attributeValueParser.initialize(parsingBuffer(), Option_IgnoreLeadingWhitespace);
                 nextState = State_ReadingAttributeValue;
             }
@@ -669,9 +729,21 @@ StartOfElementParser::State StartOfElementParser::executeStateReadingAttributeVa
         case Result_Success:
         {
             // Add attribute to the attribute list
-            const Common::Attribute attribute(m_attributeName, m_attributeValueParser.value());
-            m_attributeList.add(attribute);
-            m_attributeName.clear();
+            if (m_attributeValueCache == NULL)
+            {
+                const Common::Attribute attribute(m_attributeName, m_attributeValueParser.value());
+                m_attributeList.add(attribute);
+            }
+            else
+            {
+                // Use the interned value
+                const Common::Attribute attribute(
+                            m_attributeName,
+                            m_attributeValueCache->intern(m_attributeValueParser.value()));
+                m_attributeList.add(attribute);
+            }
+
+            addAttributeName(m_attributeNameHash);
             m_attributeValueParser.deinitialize();
             nextState = State_ReadingNextItem;
             break;
@@ -727,3 +799,55 @@ StartOfElementParser::State StartOfElementParser::executeStateReadingEndOfEmptyE
 
     return nextState;
 }
+
+/**
+ * Clear the names of the element's attributes
+ *
+ * \note The hash index is shrunk back to its initial size so that an element with a lot of
+ *       attributes does not make clearing more expensive for all of the following elements.
+ */
+void StartOfElementParser::clearAttributeNames()
+{
+    m_attributeNameList.clear();
+    m_attributeNameIndex.clear();
+}
+
+/**
+ * Check if the element already contains an attribute with the selected name
+ *
+ * \param name  Attribute name
+ * \param hash  Hash of the attribute name
+ *
+ * \retval true     Attribute name found
+ * \retval false    Attribute name not found
+ *
+ * \note Attribute names are compared only when their hashes match.
+ */
+bool StartOfElementParser::containsAttributeName(const Common::UnicodeString &name,
+                                                 const uint32_t hash) const
+{
+    bool found = false;
+    size_t slot = m_attributeNameIndex.firstSlot(hash);
+    size_t index = 0U;
+
+    while ((!found) && m_attributeNameIndex.find(hash, &slot, &index))
+    {
+        found = (m_attributeNameList.at(index) == name);
+    }
+
+    return found;
+}
+
+/**
+ * Add the current attribute name to the names of the element's attributes
+ *
+ * \param hash  Hash of the attribute name
+ *
+ * \note The attribute name is moved to the list of attribute names.
+ */
+void StartOfElementParser::addAttributeName(const uint32_t hash)
+{
+    m_attributeNameList.push_back(Common::UnicodeString());
+    m_attributeNameList.back().swap(m_attributeName);
+    m_attributeNameIndex.add(hash);
+}
@@ -258,6 +258,7 @@ TextNodeParser::State TextNodeParser::executeStateReadingText()
 
                 // Possible start of Reference found, parse it
                 parsingBuffer()->eraseToCurrentPosition();
+                m_referenceParser.setTrusted(isTrusted());
                 m_referenceParser.initialize(parsingBuffer());
                 nextState = State_ReadingReference;
             }
@@ -267,12 +268,10 @@ TextNodeParser::State TextNodeParser::executeStateReadingText()
                 const size_t position = parsingBuffer()->currentPosition();
                 bool validChar = true;
 
-                if (position > 2U)
+                if (position >= 2U)
                 {
-                    const Common::UnicodeString sequence =
-                            parsingBuffer()->substring(position - 2U, position - 1U);
-
-                    if (Common::compareUnicodeString(0U, sequence, std::string("]]")))
+                    if ((parsingBuffer()->at(position - 2U) == static_cast<uint32_t>(']')) &&
+                        (parsingBuffer()->at(position - 1U) == static_cast<uint32_t>(']')))
                     {
                         // Error, invalid sequence
                         validChar = false;
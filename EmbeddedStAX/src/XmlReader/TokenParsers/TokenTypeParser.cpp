@@ -394,6 +394,7 @@ TokenTypeParser::State TokenTypeParser::executeStateWaitingForStartOfToken()
                 {
                     // On synchronization option ignore all other characters
                     parsingBuffer()->incrementPosition();
+                    parsingBuffer()->skipToCharacter(static_cast<uint32_t>('<'));
                     parsingBuffer()->eraseToCurrentPosition();
                     finishParsing = false;
                 }
@@ -404,7 +405,7 @@ TokenTypeParser::State TokenTypeParser::executeStateWaitingForStartOfToken()
                         if (option() == Option_IgnoreLeadingWhitespace)
                         {
                             // We are allowed to ignore whitespace characters
-                            parsingBuffer()->incrementPosition();
+                            parsingBuffer()->skipWhitespace();
                             parsingBuffer()->eraseToCurrentPosition();
                             finishParsing = false;
                         }
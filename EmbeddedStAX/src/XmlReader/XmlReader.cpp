@@ -26,6 +26,12 @@
  */
 
 #include <EmbeddedStAX/XmlReader/XmlReader.h>
+#include <EmbeddedStAX/XmlReader/PathRouter.h>
+#include <EmbeddedStAX/XmlValidator/Common.h>
+#include <EmbeddedStAX/XmlValidator/Name.h>
+#include <EmbeddedStAX/Common/HashIndex.h>
+#include <algorithm>
+#include <ctime>
 
 using namespace EmbeddedStAX::XmlReader;
 
@@ -33,7 +39,33 @@ using namespace EmbeddedStAX::XmlReader;
  * Constructor
  */
 XmlReader::XmlReader()
-    : m_cDataParser(),
+    : m_eventMask(EventMask_All),
+      m_validationMode(ValidationMode_Full),
+      m_validationSampleInterval(1U),
+      m_validationSampleCounter(0U),
+      m_textCoalescing(false),
+      m_coalescedTextNextState(ParsingState_Error),
+      m_errorRecovery(false),
+      m_documentOffset(0U),
+      m_discardedOffset(0U),
+      m_discardedSize(0U),
+      m_dtdValidation(false),
+      m_schemaValidator(),
+      m_externalDtdList(),
+      m_hashedSubtreePathList(),
+      m_hashedSubtreePathHashList(),
+      m_subtreeSha256(false),
+      m_openSubtreeHashList(),
+      m_openSubtreeDepthList(),
+      m_subtreeHash(),
+      m_subtreeTextStarted(false),
+      m_subtreeWhitespace(),
+      m_openElementPathHashList(),
+      m_pathHash(0U),
+      m_pathIncludesName(false),
+      m_attributeValueCache(),
+      m_shapePredictor(),
+      m_cDataParser(),
       m_commentParser(),
       m_documentTypeParser(),
       m_endOfElementParser(),
@@ -42,6 +74,17 @@ XmlReader::XmlReader()
       m_textNodeParser(),
       m_tokenTypeParser()
 {
+    // Seed the hashes of the attribute names with the address of the reader and the current time,
+    // so that a document can not be prepared in advance to make all of its attribute names collide
+    const size_t address = reinterpret_cast<size_t>(this);
+    const uint32_t addressLow = static_cast<uint32_t>(address);
+    const uint32_t addressHigh = static_cast<uint32_t>((address >> 16) >> 16);
+    uint32_t hashSeed = Common::HashIndex::initialHash();
+    hashSeed = Common::HashIndex::appendHash(hashSeed, addressLow);
+    hashSeed = Common::HashIndex::appendHash(hashSeed, addressHigh);
+    hashSeed = Common::HashIndex::appendHash(hashSeed, static_cast<uint32_t>(std::time(NULL)));
+    m_startOfElementParser.setHashSeed(hashSeed);
+
     clear();
 }
 
@@ -59,6 +102,9 @@ XmlReader::~XmlReader()
 void XmlReader::clear()
 {
     m_parsingBuffer.clear();
+    m_documentOffset = 0U;
+    m_discardedOffset = 0U;
+    m_discardedSize = 0U;
 
     startNewDocument();
 }
@@ -71,6 +117,9 @@ void XmlReader::startNewDocument()
     m_documentState = DocumentState_PrologWaitForXmlDeclaration;
     m_parsingState = ParsingState_Idle;
     m_lastParsingResult = ParsingResult_None;
+    m_peekedResult = ParsingResult_None;
+    m_validationSampleCounter = 0U;
+    m_coalescedTextNextState = ParsingState_Error;
     m_parsingBuffer.eraseToCurrentPosition();
     m_xmlDeclaration.clear();
     m_processingInstruction.clear();
@@ -79,6 +128,25 @@ void XmlReader::startNewDocument()
     m_name.clear();
     m_attributeList.clear();
     m_openElementList.clear();
+    m_openElementPathHashList.clear();
+    m_pathHash = calculatePathHash(Common::UnicodeString());
+    m_pathIncludesName = false;
+    m_schemaValidator.clear();
+    m_openSubtreeHashList.clear();
+    m_openSubtreeDepthList.clear();
+    m_subtreeHash.start(false);
+    m_subtreeTextStarted = false;
+    m_subtreeWhitespace.clear();
+    m_eventParked = false;
+    m_peeking = false;
+    m_peekedElementChange = PeekedElementChange_None;
+    m_peekedElementList.clear();
+    m_parkedEvent.xmlDeclaration.clear();
+    m_parkedEvent.processingInstruction.clear();
+    m_parkedEvent.documentType.clear();
+    m_parkedEvent.text.clear();
+    m_parkedEvent.name.clear();
+    m_parkedEvent.attributeList.clear();
 
     m_cDataParser.deinitialize();
     m_commentParser.deinitialize();
@@ -103,246 +171,685 @@ size_t XmlReader::writeData(const std::string &data)
 }
 
 /**
- * Parse data in the data buffer
+ * Write data
  *
- * \return Parsing result
+ * \param data  Pointer to data to write
+ * \param size  Size of the data (in bytes)
+ *
+ * \return Number of character written
  */
-XmlReader::ParsingResult XmlReader::parse()
+size_t XmlReader::writeData(const char *data, const size_t size)
 {
-    ParsingResult result = ParsingResult_Error;
-    bool finishParsing = false;
+    return m_parsingBuffer.writeData(data, size);
+}
 
-    while (!finishParsing)
-    {
-        finishParsing = true;
-        ParsingState nextState = ParsingState_Error;
+/**
+ * Get event mask
+ *
+ * \return Event mask (combination of EventMask flags for the events that are reported)
+ */
+uint32_t XmlReader::eventMask() const
+{
+    return m_eventMask;
+}
 
-        switch (m_parsingState)
-        {
-            case ParsingState_Idle:
-            {
-                // Start reading a XML document
-                if (m_tokenTypeParser.initialize(&m_parsingBuffer))
-                {
-                    m_documentState = DocumentState_PrologWaitForXmlDeclaration;
-                    nextState = ParsingState_ReadingTokenType;
-                    finishParsing = false;
-                }
-                else
-                {
-                    // Error, failed to initialize parser
-                }
-                break;
-            }
+/**
+ * Set event mask
+ *
+ * \param eventMask Combination of EventMask flags for the events that shall be reported
+ *
+ * \note The event mask is not changed by clear() and startNewDocument(). A change of the event mask
+ *       takes effect with the next token.
+ */
+void XmlReader::setEventMask(const uint32_t eventMask)
+{
+    m_eventMask = eventMask & static_cast<uint32_t>(EventMask_All);
+}
 
-            case ParsingState_ReadingTokenType:
-            {
-                // Reading token type
-                nextState = executeParsingStateReadingTokenType();
+/**
+ * Get validation mode
+ *
+ * \return Validation mode
+ */
+XmlReader::ValidationMode XmlReader::validationMode() const
+{
+    return m_validationMode;
+}
 
-                // Check transitions
-                switch (nextState)
-                {
-                    case ParsingState_ReadingTokenType:
-                    {
-                        // More data is needed
-                        result = ParsingResult_NeedMoreData;
-                        break;
-                    }
+/**
+ * Get validation sample interval
+ *
+ * \return Every n-th token is fully validated in ValidationMode_Sampled
+ */
+size_t XmlReader::validationSampleInterval() const
+{
+    return m_validationSampleInterval;
+}
 
-                    case ParsingState_ReadingProcessingInstruction:
-                    case ParsingState_ReadingDocumentType:
-                    case ParsingState_ReadingComment:
-                    case ParsingState_ReadingCData:
-                    case ParsingState_ReadingStartOfElement:
-                    case ParsingState_ReadingEndOfElement:
-                    {
-                        // Execute another cycle
-                        finishParsing = false;
-                        break;
-                    }
+/**
+ * Set validation mode
+ *
+ * \param validationMode    Validation mode
+ * \param sampleInterval    Every n-th token is fully validated in ValidationMode_Sampled (value 0
+ *                          is handled as 1)
+ *
+ * \note The validation mode is not changed by clear() and startNewDocument(). In sampled mode the
+ *       first token of each document is fully validated.
+ */
+void XmlReader::setValidationMode(const ValidationMode validationMode, const size_t sampleInterval)
+{
+    m_validationMode = validationMode;
+    m_validationSampleInterval = sampleInterval;
 
-                    default:
-                    {
-                        // Error
-                        nextState = ParsingState_Error;
-                        break;
-                    }
-                }
-                break;
-            }
+    if (m_validationSampleInterval == 0U)
+    {
+        m_validationSampleInterval = 1U;
+    }
 
-            case ParsingState_ReadingProcessingInstruction:
-            {
-                // Reading processing instruction
-                nextState = executeParsingStateReadingProcessingInstruction();
+    m_validationSampleCounter = 0U;
+}
 
-                // Check transitions
-                switch (nextState)
-                {
-                    case ParsingState_ReadingProcessingInstruction:
-                    {
-                        // More data is needed
-                        result = ParsingResult_NeedMoreData;
-                        break;
-                    }
+/**
+ * Check if text coalescing is enabled
+ *
+ * \retval true     Text coalescing is enabled
+ * \retval false    Text coalescing is disabled
+ */
+bool XmlReader::isTextCoalescingEnabled() const
+{
+    return m_textCoalescing;
+}
 
-                    case ParsingState_XmlDeclarationRead:
-                    {
-                        result = ParsingResult_XmlDeclaration;
-                        break;
-                    }
+/**
+ * Enable or disable text coalescing
+ *
+ * \param enabled   Enable text coalescing
+ *
+ * \note When text coalescing is enabled all adjacent character data (text, references and CDATA
+ *       sections) is read into a single text buffer and it is reported as one ParsingResult_TextNode
+ *       event, ParsingResult_CData is not reported. The coalesced text ends at any other markup
+ *       (also at a masked comment or processing instruction), so the text is reported just before
+ *       the markup is read. Whitespace text node mask is applied to the coalesced text.
+ *
+ * \note Text coalescing should be changed only between documents.
+ */
+void XmlReader::setTextCoalescingEnabled(const bool enabled)
+{
+    m_textCoalescing = enabled;
+}
 
-                    case ParsingState_ProcessingInstructionRead:
-                    {
-                        result = ParsingResult_ProcessingInstruction;
-                        break;
-                    }
+/**
+ * Check if line tracking is enabled
+ *
+ * \retval true     Line tracking is enabled
+ * \retval false    Line tracking is disabled
+ */
+bool XmlReader::isLineTrackingEnabled() const
+{
+    return m_parsingBuffer.isLineTrackingEnabled();
+}
 
-                    default:
-                    {
-                        // Error
-                        nextState = ParsingState_Error;
-                        break;
-                    }
-                }
-                break;
-            }
+/**
+ * Enable or disable line tracking
+ *
+ * \param enabled   Enable line tracking
+ *
+ * \note With line tracking enabled the newlines are counted when the parsed data is removed from
+ *       the parsing buffer, so location() is available for the whole data stream. Without it the
+ *       location is available only until the parsed data is removed from the buffer.
+ *
+ * \note Line tracking should be changed only before data is written to the reader (or right after
+ *       the reader is cleared).
+ */
+void XmlReader::setLineTrackingEnabled(const bool enabled)
+{
+    m_parsingBuffer.setLineTrackingEnabled(enabled);
+}
 
-            case ParsingState_ReadingComment:
-            {
-                // Reading comment
-                nextState = executeParsingStateReadingComment();
+/**
+ * Check if error recovery is enabled
+ *
+ * \retval true     Error recovery is enabled
+ * \retval false    Error recovery is disabled
+ */
+bool XmlReader::isErrorRecoveryEnabled() const
+{
+    return m_errorRecovery;
+}
 
-                // Check transitions
-                switch (nextState)
-                {
-                    case ParsingState_ReadingComment:
-                    {
-                        // More data is needed
-                        result = ParsingResult_NeedMoreData;
-                        break;
-                    }
+/**
+ * Enable or disable error recovery
+ *
+ * \param enabled   Enable error recovery
+ *
+ * \note Without error recovery the reader stays in the error state after ParsingResult_Error until
+ *       it is cleared or a new document is started. With error recovery the next parse() call
+ *       discards the data up to the next plausible start of a document ('<' followed by '?', '!'
+ *       or a name start character), reports ParsingResult_DataDiscarded (see discardedOffset() and
+ *       discardedSize(), the range starts at the start of the broken document) and continues with
+ *       a new document. The remaining content of the broken document can also look like the
+ *       start of a document, so a few short documents or errors can follow before the reader is
+ *       synchronized with the stream again.
+ */
+void XmlReader::setErrorRecoveryEnabled(const bool enabled)
+{
+    m_errorRecovery = enabled;
+}
 
-                    case ParsingState_CommentRead:
-                    {
-                        result = ParsingResult_Comment;
-                        break;
-                    }
+/**
+ * Check if DTD validation is enabled
+ *
+ * \retval true     DTD validation is enabled
+ * \retval false    DTD validation is disabled
+ */
+bool XmlReader::isDtdValidationEnabled() const
+{
+    return m_dtdValidation;
+}
 
-                    default:
-                    {
-                        // Error
-                        nextState = ParsingState_Error;
-                        break;
-                    }
-                }
-                break;
-            }
+/**
+ * Enable or disable DTD validation
+ *
+ * \param enabled   Enable DTD validation
+ *
+ * \note With DTD validation the element type declarations of the document type (from the internal
+ *       subset and from the external DTD registered with addExternalDtd() for its system ID) are
+ *       compiled when the document type is read. The elements and the text are then validated as
+ *       they are read, only the state of the content model of each open element is kept. An
+ *       invalid document is reported with ParsingResult_Error (see validationError()), a document
+ *       without a document type is not valid. An element type declaration that can not be compiled
+ *       (for example a parameter entity reference in its content model) is reported with
+ *       ParsingResult_Error for the document type and SchemaValidator::Error_InvalidDeclaration.
+ *
+ * \note Masked whitespace text nodes are not validated.
+ *
+ * \note DTD validation should be changed only between documents.
+ */
+void XmlReader::setDtdValidationEnabled(const bool enabled)
+{
+    m_dtdValidation = enabled;
+}
 
-            case ParsingState_ReadingDocumentType:
-            {
-                // Reading document type
-                nextState = executeParsingStateReadingDocumentType();
+/**
+ * Register an external DTD
+ *
+ * \param systemId  System ID of the external DTD (as it is written in the document type)
+ * \param dtd       Content of the external DTD (UTF-8 encoded markup declarations)
+ *
+ * \retval true     External DTD registered
+ * \retval false    Empty system ID or invalid markup declarations
+ *
+ * \note Only markup declarations are supported in the external DTD (no conditional sections and no
+ *       text declaration).
+ */
+bool XmlReader::addExternalDtd(const Common::UnicodeString &systemId, const std::string &dtd)
+{
+    bool success = false;
 
-                // Check transitions
-                switch (nextState)
-                {
-                    case ParsingState_ReadingDocumentType:
-                    {
-                        // More data is needed
-                        result = ParsingResult_NeedMoreData;
-                        break;
-                    }
+    if (!systemId.empty())
+    {
+        // The external DTD is read as the internal subset of a document type declaration
+        const std::string prefix(" dtd [");
+        const std::string suffix("]>");
+        ParsingBuffer parsingBuffer;
+        DocumentTypeParser documentTypeParser;
+
+        if ((parsingBuffer.writeData(prefix) == prefix.size()) &&
+            (parsingBuffer.writeData(dtd) == dtd.size()) &&
+            (parsingBuffer.writeData(suffix) == suffix.size()) &&
+            documentTypeParser.initialize(&parsingBuffer) &&
+            (documentTypeParser.parse() == DocumentTypeParser::Result_Success))
+        {
+            Common::DocumentType externalDtd = documentTypeParser.documentType();
+            externalDtd.setName(Common::UnicodeString());
+            externalDtd.setExternalId(Common::UnicodeString(), systemId);
+            m_externalDtdList.push_back(externalDtd);
+            success = true;
+        }
+    }
 
-                    case ParsingState_DocumentTypeRead:
-                    {
-                        result = ParsingResult_DocumentType;
-                        break;
-                    }
+    return success;
+}
 
-                    default:
-                    {
-                        // Error
-                        nextState = ParsingState_Error;
-                        break;
-                    }
-                }
-                break;
-            }
+/**
+ * Remove all registered external DTDs
+ */
+void XmlReader::clearExternalDtds()
+{
+    m_externalDtdList.clear();
+}
 
-            case ParsingState_ReadingStartOfElement:
-            {
-                // Reading element type
-                nextState = executeParsingStateReadingStartOfElement();
+/**
+ * Get DTD validation error
+ *
+ * \return Validation error of the current document
+ */
+SchemaValidator::Error XmlReader::validationError() const
+{
+    return m_schemaValidator.error();
+}
 
-                // Check transitions
-                switch (nextState)
-                {
-                    case ParsingState_ReadingStartOfElement:
-                    {
-                        // More data is needed
-                        result = ParsingResult_NeedMoreData;
-                        break;
-                    }
+/**
+ * Select the subtrees of the elements with the path for hashing
+ *
+ * \param path  Element path (for example "/a/b/c")
+ *
+ * \retval true     Path selected
+ * \retval false    Invalid path or the path is already selected
+ *
+ * \note The hash of a selected subtree is calculated over its canonical event stream while it is
+ *       read and it is available with the end of element event of the subtree (see subtreeHash()
+ *       and subtreeSha256()). The canonical stream contains the element names, the attributes
+ *       sorted by name (their values as they are reported, so the quotation mark and references do
+ *       not change the hash) and the character data (CDATA sections are handled as text). Comments,
+ *       processing instructions and whitespace-only runs of character data between the elements
+ *       are left out, so the hash does not depend on formatting.
+ *
+ * \note Selected paths should be changed only between documents.
+ */
+bool XmlReader::addHashedSubtree(const Common::UnicodeString &path)
+{
+    bool success = false;
 
-                    case ParsingState_StartOfElementRead:
-                    {
-                        if (m_openElementList.size() >= 1U)
-                        {
-                            result = ParsingResult_StartOfElement;
-                        }
-                        else
-                        {
-                            // Error, there should be at least 1 open element
-                            nextState = ParsingState_Error;
-                        }
-                        break;
-                    }
+    if (PathRouter::validatePath(path))
+    {
+        const uint32_t pathHash = calculatePathHash(path);
+        success = true;
 
-                    case ParsingState_EmptyElementRead:
-                    {
-                        result = ParsingResult_StartOfElement;
-                        break;
-                    }
+        for (size_t i = 0U; success && (i < m_hashedSubtreePathList.size()); i++)
+        {
+            if ((m_hashedSubtreePathHashList.at(i) == pathHash) &&
+                (m_hashedSubtreePathList.at(i) == path))
+            {
+                // Error, path is already selected
+                success = false;
+            }
+        }
 
-                    default:
+        if (success)
+        {
+            m_hashedSubtreePathList.push_back(path);
+            m_hashedSubtreePathHashList.push_back(pathHash);
+        }
+    }
+
+    return success;
+}
+
+/**
+ * Remove all paths selected for subtree hashing
+ */
+void XmlReader::clearHashedSubtrees()
+{
+    m_hashedSubtreePathList.clear();
+    m_hashedSubtreePathHashList.clear();
+}
+
+/**
+ * Check if SHA-256 digest of the selected subtrees is enabled
+ *
+ * \retval true     SHA-256 digest is enabled
+ * \retval false    SHA-256 digest is disabled
+ */
+bool XmlReader::isSubtreeSha256Enabled() const
+{
+    return m_subtreeSha256;
+}
+
+/**
+ * Enable or disable SHA-256 digest of the selected subtrees
+ *
+ * \param enabled   Enable SHA-256 digest
+ *
+ * \note The fast hash is always calculated, the SHA-256 digest is calculated in addition to it
+ *       only when it is enabled.
+ */
+void XmlReader::setSubtreeSha256Enabled(const bool enabled)
+{
+    m_subtreeSha256 = enabled;
+}
+
+/**
+ * Check if the hash of a selected subtree is available
+ *
+ * \retval true     Last event is the end of element of a selected subtree
+ * \retval false    Hash is not available
+ */
+bool XmlReader::isSubtreeHashAvailable() const
+{
+    return m_subtreeHash.isFinished();
+}
+
+/**
+ * Get the fast hash of the selected subtree
+ *
+ * \return 64-bit hash of the canonical event stream of the subtree (valid only when
+ *         isSubtreeHashAvailable() returns true)
+ */
+uint64_t XmlReader::subtreeHash() const
+{
+    return m_subtreeHash.fastHash();
+}
+
+/**
+ * Get the SHA-256 digest of the selected subtree
+ *
+ * \return SHA-256 digest (32 bytes) of the canonical event stream of the subtree or an empty
+ *         digest if it is not available or SHA-256 is disabled
+ */
+std::vector<uint8_t> XmlReader::subtreeSha256() const
+{
+    return m_subtreeHash.sha256();
+}
+
+/**
+ * Get attribute value cache
+ *
+ * \return Attribute value cache (can be used to read the statistics of the cache)
+ */
+const AttributeValueCache &XmlReader::attributeValueCache() const
+{
+    return m_attributeValueCache;
+}
+
+/**
+ * Set attribute value cache
+ *
+ * \param capacity      Number of entries in the cache (value 0 disables the cache)
+ * \param maxValueSize  Maximum number of characters of a cached value
+ *
+ * \note Short attribute values that repeat in the document (for example enumerations) are interned
+ *       in the cache so their attributes are created from the cached value. The cache and its
+ *       statistics are not cleared by clear() and startNewDocument().
+ */
+void XmlReader::setAttributeValueCache(const size_t capacity, const size_t maxValueSize)
+{
+    m_attributeValueCache.setCapacity(capacity, maxValueSize);
+    m_attributeValueCache.resetStatistics();
+
+    if (m_attributeValueCache.capacity() == 0U)
+    {
+        m_startOfElementParser.setAttributeValueCache(NULL);
+    }
+    else
+    {
+        m_startOfElementParser.setAttributeValueCache(&m_attributeValueCache);
+    }
+}
+
+/**
+ * Get shape predictor
+ *
+ * \return Shape predictor (can be used to read the statistics of the predictor)
+ */
+const ShapePredictor &XmlReader::shapePredictor() const
+{
+    return m_shapePredictor;
+}
+
+/**
+ * Set shape prediction
+ *
+ * \param capacity  Number of entries in the shape predictor (value 0 disables shape prediction)
+ *
+ * \note The shape predictor learns the sequence of element and attribute names in the start of
+ *       element tokens. When the input repeats the sequence (for example a stream of records with
+ *       the same shape) each name is matched with the predicted name at once, instead of being
+ *       scanned and validated character by character. On a miss the name is parsed as usual.
+ *       Learned names and the statistics are not cleared by clear() and startNewDocument().
+ */
+void XmlReader::setShapePrediction(const size_t capacity)
+{
+    m_shapePredictor.setCapacity(capacity);
+    m_shapePredictor.resetStatistics();
+
+    if (m_shapePredictor.capacity() == 0U)
+    {
+        m_startOfElementParser.setShapePredictor(NULL);
+    }
+    else
+    {
+        m_startOfElementParser.setShapePredictor(&m_shapePredictor);
+    }
+}
+
+/**
+ * Parse data in the data buffer
+ *
+ * \return Parsing result
+ *
+ * \note If the next event was already read with peek() it is returned without parsing.
+ */
+XmlReader::ParsingResult XmlReader::parse()
+{
+    ParsingResult result = m_peekedResult;
+
+    if (m_eventParked)
+    {
+        // Continue with the data that was read by peek()
+        swapEventData(&m_parkedEvent);
+        swapDocumentData(&m_parkedEvent, result);
+        m_eventParked = false;
+
+        // Apply the change of the open elements that was deferred by peek()
+        if (m_peekedElementChange == PeekedElementChange_Opened)
+        {
+            m_openElementList.splice(m_openElementList.end(), m_peekedElementList);
+        }
+        else if (m_peekedElementChange == PeekedElementChange_Closed)
+        {
+            m_openElementList.pop_back();
+        }
+        else
+        {
+            // Open elements were not changed
+        }
+
+        m_peekedElementChange = PeekedElementChange_None;
+    }
+
+    if (result == ParsingResult_None)
+    {
+        result = parseNextEvent();
+    }
+    else
+    {
+        // Consume the peeked event
+        m_peekedResult = ParsingResult_None;
+    }
+
+    // Save last parsing result
+    m_lastParsingResult = result;
+    return result;
+}
+
+/**
+ * Peek at the next event without consuming it
+ *
+ * \return Parsing result of the next event
+ * \retval ParsingResult_NeedMoreData   More data is needed to read the next event
+ *
+ * \note The event is read only once: the same result is returned by all peek() calls until it is
+ *       consumed by the next parse() call. The data of the peeked event is kept aside until then,
+ *       so name(), text(), attributeList(), pathHash() and the subtree hash still return the data
+ *       of the current event. Only the name of the peeked element is available with peekedName().
+ *
+ * \note Last parsing result is not changed by peek(). The offsets, location and validation error
+ *       already refer to the position after the peeked event.
+ *
+ * \note Only the data that the peeked event overwrites is kept aside and it is swapped instead of
+ *       copied. The element opened or closed by the peeked event is moved between the lists of
+ *       open elements when the event is consumed.
+ */
+XmlReader::ParsingResult XmlReader::peek()
+{
+    ParsingResult result = m_peekedResult;
+
+    if (result == ParsingResult_None)
+    {
+        // Keep the data of the current event aside while the next event is read (there is nothing
+        // to keep if no event was read yet)
+        if (m_eventParked)
+        {
+            swapEventData(&m_parkedEvent);
+        }
+        else if ((m_lastParsingResult != ParsingResult_None) &&
+                 (m_lastParsingResult != ParsingResult_NeedMoreData))
+        {
+            parkEventData(&m_parkedEvent);
+            m_eventParked = true;
+        }
+        else
+        {
+            // No event to keep
+        }
+
+        m_peeking = m_eventParked;
+        result = parseNextEvent();
+        m_peeking = false;
+
+        if (m_eventParked)
+        {
+            swapEventData(&m_parkedEvent);
+
+            if (result != ParsingResult_NeedMoreData)
+            {
+                swapDocumentData(&m_parkedEvent, result);
+            }
+
+            if (m_peekedElementChange == PeekedElementChange_Opened)
+            {
+                // Element opened by the peeked event is not open yet for the current event
+                std::list<Common::UnicodeString>::iterator it = m_openElementList.end();
+                it--;
+                m_peekedElementList.splice(m_peekedElementList.end(), m_openElementList, it);
+            }
+            else if (m_peekedElementChange == PeekedElementChange_Closed)
+            {
+                // Element closed by the peeked event is still open for the current event
+                m_openElementList.splice(m_openElementList.end(), m_peekedElementList);
+            }
+            else
+            {
+                // Open elements were not changed
+            }
+        }
+
+        if (result != ParsingResult_NeedMoreData)
+        {
+            // Keep the event for the next parse() call
+            m_peekedResult = result;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Get name of the peeked element
+ *
+ * \return Element name if peek() returned a start or end of element event, otherwise an empty
+ *         string
+ */
+EmbeddedStAX::Common::UnicodeString XmlReader::peekedName() const
+{
+    Common::UnicodeString name;
+
+    if ((m_peekedResult == ParsingResult_StartOfElement) ||
+        (m_peekedResult == ParsingResult_EndOfElement))
+    {
+        if (m_eventParked)
+        {
+            name = m_parkedEvent.name;
+        }
+        else
+        {
+            // There was no current event to keep aside, the peeked data is already in place
+            name = m_name;
+        }
+    }
+
+    return name;
+}
+
+/**
+ * Parse data in the data buffer until the next event
+ *
+ * \return Parsing result
+ */
+XmlReader::ParsingResult XmlReader::parseNextEvent()
+{
+    ParsingResult result = ParsingResult_Error;
+    bool finishParsing = false;
+
+    while (!finishParsing)
+    {
+        finishParsing = true;
+        ParsingState nextState = ParsingState_Error;
+
+        switch (m_parsingState)
+        {
+            case ParsingState_Idle:
+            {
+                // Start reading a XML document
+                if (m_tokenTypeParser.initialize(&m_parsingBuffer))
+                {
+                    if (m_errorRecovery)
                     {
-                        // Error
-                        nextState = ParsingState_Error;
-                        break;
+                        // Remember the start of the document in case it has to be discarded
+                        m_documentOffset =
+                                m_parsingBuffer.byteOffset(m_parsingBuffer.currentPosition());
                     }
+
+                    m_documentState = DocumentState_PrologWaitForXmlDeclaration;
+                    nextState = ParsingState_ReadingTokenType;
+                    finishParsing = false;
+                }
+                else
+                {
+                    // Error, failed to initialize parser
                 }
                 break;
             }
 
-            case ParsingState_ReadingTextNode:
+            case ParsingState_ReadingTokenType:
             {
-                // Reading text node
-                nextState = executeParsingStateReadingTextNode();
+                // Reading token type
+                nextState = executeParsingStateReadingTokenType();
 
                 // Check transitions
                 switch (nextState)
                 {
-                    case ParsingState_ReadingTextNode:
+                    case ParsingState_ReadingTokenType:
                     {
                         // More data is needed
                         result = ParsingResult_NeedMoreData;
                         break;
                     }
 
-                    case ParsingState_TextNodeRead:
+                    case ParsingState_ReadingCData:
                     {
-                        // Check if any text was read
-                        if (m_text.empty())
+                        // Execute another cycle
+                        finishParsing = false;
+                        break;
+                    }
+
+                    case ParsingState_ReadingProcessingInstruction:
+                    case ParsingState_ReadingDocumentType:
+                    case ParsingState_ReadingComment:
+                    case ParsingState_ReadingStartOfElement:
+                    case ParsingState_ReadingEndOfElement:
+                    {
+                        if (isCoalescedTextPending())
                         {
-                            // No text was read, continue parsing
-                            finishParsing = false;
+                            // Markup ends the coalesced text
+                            nextState = finishCoalescedText(nextState, &result);
                         }
-                        else
+
+                        if (nextState != ParsingState_CoalescedTextRead)
                         {
-                            // Text was read
-                            result = ParsingResult_TextNode;
+                            // Execute another cycle
+                            finishParsing = false;
                         }
                         break;
                     }
@@ -357,9 +864,262 @@ XmlReader::ParsingResult XmlReader::parse()
                 break;
             }
 
-            case ParsingState_ReadingCData:
+            case ParsingState_ReadingProcessingInstruction:
             {
-                // Reading CDATA
+                // Reading processing instruction
+                nextState = executeParsingStateReadingProcessingInstruction();
+
+                // Check transitions
+                switch (nextState)
+                {
+                    case ParsingState_ReadingProcessingInstruction:
+                    {
+                        // More data is needed
+                        result = ParsingResult_NeedMoreData;
+                        break;
+                    }
+
+                    case ParsingState_XmlDeclarationRead:
+                    {
+                        if (isEventEnabled(EventMask_XmlDeclaration))
+                        {
+                            result = ParsingResult_XmlDeclaration;
+                        }
+                        else
+                        {
+                            // Event is masked, continue parsing
+                            finishParsing = false;
+                        }
+                        break;
+                    }
+
+                    case ParsingState_ProcessingInstructionRead:
+                    {
+                        if (isEventEnabled(EventMask_ProcessingInstruction))
+                        {
+                            result = ParsingResult_ProcessingInstruction;
+                        }
+                        else
+                        {
+                            // Event is masked, continue parsing
+                            finishParsing = false;
+                        }
+                        break;
+                    }
+
+                    default:
+                    {
+                        // Error
+                        nextState = ParsingState_Error;
+                        break;
+                    }
+                }
+                break;
+            }
+
+            case ParsingState_ReadingComment:
+            {
+                // Reading comment
+                nextState = executeParsingStateReadingComment();
+
+                // Check transitions
+                switch (nextState)
+                {
+                    case ParsingState_ReadingComment:
+                    {
+                        // More data is needed
+                        result = ParsingResult_NeedMoreData;
+                        break;
+                    }
+
+                    case ParsingState_CommentRead:
+                    {
+                        if (isEventEnabled(EventMask_Comment))
+                        {
+                            result = ParsingResult_Comment;
+                        }
+                        else
+                        {
+                            // Event is masked, continue parsing
+                            finishParsing = false;
+                        }
+                        break;
+                    }
+
+                    default:
+                    {
+                        // Error
+                        nextState = ParsingState_Error;
+                        break;
+                    }
+                }
+                break;
+            }
+
+            case ParsingState_ReadingDocumentType:
+            {
+                // Reading document type
+                nextState = executeParsingStateReadingDocumentType();
+
+                // Check transitions
+                switch (nextState)
+                {
+                    case ParsingState_ReadingDocumentType:
+                    {
+                        // More data is needed
+                        result = ParsingResult_NeedMoreData;
+                        break;
+                    }
+
+                    case ParsingState_DocumentTypeRead:
+                    {
+                        result = ParsingResult_DocumentType;
+                        break;
+                    }
+
+                    default:
+                    {
+                        // Error
+                        nextState = ParsingState_Error;
+                        break;
+                    }
+                }
+                break;
+            }
+
+            case ParsingState_ReadingStartOfElement:
+            {
+                // Reading element type
+                nextState = executeParsingStateReadingStartOfElement();
+
+                // Check transitions
+                switch (nextState)
+                {
+                    case ParsingState_ReadingStartOfElement:
+                    {
+                        // More data is needed
+                        result = ParsingResult_NeedMoreData;
+                        break;
+                    }
+
+                    case ParsingState_StartOfElementRead:
+                    {
+                        if (m_openElementList.size() >= 1U)
+                        {
+                            result = ParsingResult_StartOfElement;
+                        }
+                        else
+                        {
+                            // Error, there should be at least 1 open element
+                            nextState = ParsingState_Error;
+                        }
+                        break;
+                    }
+
+                    case ParsingState_EmptyElementRead:
+                    {
+                        result = ParsingResult_StartOfElement;
+                        break;
+                    }
+
+                    default:
+                    {
+                        // Error
+                        nextState = ParsingState_Error;
+                        break;
+                    }
+                }
+                break;
+            }
+
+            case ParsingState_ReadingTextNode:
+            {
+                // Reading text node
+                nextState = executeParsingStateReadingTextNode();
+
+                // Check transitions
+                switch (nextState)
+                {
+                    case ParsingState_ReadingTextNode:
+                    {
+                        // More data is needed
+                        result = ParsingResult_NeedMoreData;
+                        break;
+                    }
+
+                    case ParsingState_TextNodeRead:
+                    {
+                        // Check if any text was read
+                        if (m_textCoalescing)
+                        {
+                            // Text is reported at the end of the coalesced text, continue parsing
+                            finishParsing = false;
+                        }
+                        else if (m_text.empty())
+                        {
+                            // No text was read, continue parsing
+                            finishParsing = false;
+                        }
+                        else if ((!isEventEnabled(EventMask_WhitespaceTextNode)) &&
+                                 isWhitespaceText())
+                        {
+                            // Whitespace text node is masked, continue parsing
+                            finishParsing = false;
+                        }
+                        else
+                        {
+                            // Text was read
+                            result = ParsingResult_TextNode;
+                        }
+                        break;
+                    }
+
+                    default:
+                    {
+                        // Error
+                        nextState = ParsingState_Error;
+                        break;
+                    }
+                }
+                break;
+            }
+
+            case ParsingState_ReadingWhitespace:
+            {
+                // Skipping whitespace between markup
+                nextState = executeParsingStateReadingWhitespace();
+
+                // Check transitions
+                switch (nextState)
+                {
+                    case ParsingState_ReadingWhitespace:
+                    {
+                        // More data is needed
+                        result = ParsingResult_NeedMoreData;
+                        break;
+                    }
+
+                    case ParsingState_ReadingTokenType:
+                    case ParsingState_ReadingTextNode:
+                    {
+                        // Execute another cycle
+                        finishParsing = false;
+                        break;
+                    }
+
+                    default:
+                    {
+                        // Error
+                        nextState = ParsingState_Error;
+                        break;
+                    }
+                }
+                break;
+            }
+
+            case ParsingState_ReadingCData:
+            {
+                // Reading CDATA
                 nextState = executeParsingStateReadingCData();
 
                 // Check transitions
@@ -374,8 +1134,16 @@ XmlReader::ParsingResult XmlReader::parse()
 
                     case ParsingState_CDataRead:
                     {
-                        // CDATA was read
-                        result = ParsingResult_CData;
+                        if (m_textCoalescing)
+                        {
+                            // CDATA is a part of the coalesced text, continue parsing
+                            finishParsing = false;
+                        }
+                        else
+                        {
+                            // CDATA was read
+                            result = ParsingResult_CData;
+                        }
                         break;
                     }
 
@@ -450,18 +1218,18 @@ XmlReader::ParsingResult XmlReader::parse()
 
             case ParsingState_CDataRead:
             {
-                m_text.clear();
-
-                // Start reading next token
-                if (m_textNodeParser.initialize(&m_parsingBuffer))
+                if (!m_textCoalescing)
                 {
-                    // Read token type
-                    nextState = ParsingState_ReadingTextNode;
-                    finishParsing = false;
+                    m_text.clear();
                 }
-                else
+
+                // Start reading text node
+                nextState = startReadingTextNode();
+
+                if (nextState != ParsingState_Error)
                 {
-                    // Error, failed to initialize parser
+                    // Execute another cycle
+                    finishParsing = false;
                 }
                 break;
             }
@@ -471,23 +1239,23 @@ XmlReader::ParsingResult XmlReader::parse()
                 m_name.clear();
                 m_attributeList.clear();
 
-                // Start reading next token
-                if (m_textNodeParser.initialize(&m_parsingBuffer))
+                // Start reading text node
+                nextState = startReadingTextNode();
+
+                if (nextState != ParsingState_Error)
                 {
-                    // Read token type
-                    nextState = ParsingState_ReadingTextNode;
+                    // Execute another cycle
                     finishParsing = false;
                 }
-                else
-                {
-                    // Error, failed to initialize parser
-                }
                 break;
             }
 
             case ParsingState_TextNodeRead:
             {
-                m_text.clear();
+                if (!m_textCoalescing)
+                {
+                    m_text.clear();
+                }
 
                 // Start reading next token
                 if (m_tokenTypeParser.initialize(&m_parsingBuffer,
@@ -504,6 +1272,17 @@ XmlReader::ParsingResult XmlReader::parse()
                 break;
             }
 
+            case ParsingState_CoalescedTextRead:
+            {
+                m_text.clear();
+
+                // Continue with the markup that ended the coalesced text
+                nextState = m_coalescedTextNextState;
+                m_coalescedTextNextState = ParsingState_Error;
+                finishParsing = false;
+                break;
+            }
+
             case ParsingState_DocumentTypeRead:
             case ParsingState_XmlDeclarationRead:
             {
@@ -528,17 +1307,14 @@ XmlReader::ParsingResult XmlReader::parse()
 
                 if (m_documentState == DocumentState_Element)
                 {
-                    // Start reading next token
-                    if (m_textNodeParser.initialize(&m_parsingBuffer))
+                    // Start reading text node
+                    nextState = startReadingTextNode();
+
+                    if (nextState != ParsingState_Error)
                     {
-                        // Read token type
-                        nextState = ParsingState_ReadingTextNode;
+                        // Execute another cycle
                         finishParsing = false;
                     }
-                    else
-                    {
-                        // Error, failed to initialize parser
-                    }
                 }
                 else
                 {
@@ -564,19 +1340,28 @@ XmlReader::ParsingResult XmlReader::parse()
             {
                 m_name.clear();
 
+                // Return to the path of the parent element
+                if (m_openElementPathHashList.empty())
+                {
+                    m_pathHash = calculatePathHash(Common::UnicodeString());
+                }
+                else
+                {
+                    m_pathHash = m_openElementPathHashList.back();
+                }
+
+                m_pathIncludesName = false;
+
                 if (m_documentState == DocumentState_Element)
                 {
-                    // Start reading next token
-                    if (m_textNodeParser.initialize(&m_parsingBuffer))
+                    // Start reading text node
+                    nextState = startReadingTextNode();
+
+                    if (nextState != ParsingState_Error)
                     {
-                        // Read token type
-                        nextState = ParsingState_ReadingTextNode;
+                        // Execute another cycle
                         finishParsing = false;
                     }
-                    else
-                    {
-                        // Error, failed to initialize parser
-                    }
                 }
                 else
                 {
@@ -604,17 +1389,14 @@ XmlReader::ParsingResult XmlReader::parse()
 
                 if (m_documentState == DocumentState_Element)
                 {
-                    // Start reading next token
-                    if (m_textNodeParser.initialize(&m_parsingBuffer))
+                    // Start reading text node
+                    nextState = startReadingTextNode();
+
+                    if (nextState != ParsingState_Error)
                     {
-                        // Read token type
-                        nextState = ParsingState_ReadingTextNode;
+                        // Execute another cycle
                         finishParsing = false;
                     }
-                    else
-                    {
-                        // Error, failed to initialize parser
-                    }
                 }
                 else
                 {
@@ -636,6 +1418,56 @@ XmlReader::ParsingResult XmlReader::parse()
                 break;
             }
 
+            case ParsingState_Error:
+            {
+                if (m_errorRecovery)
+                {
+                    // Discard the data from the start of the broken document to the start of the
+                    // next document (the data up to the error was already read)
+                    m_discardedOffset = m_documentOffset;
+                    m_discardedSize = 0U;
+                    nextState = ParsingState_Resynchronizing;
+                    finishParsing = false;
+                }
+                else
+                {
+                    // Error, reader stays in the error state
+                }
+                break;
+            }
+
+            case ParsingState_Resynchronizing:
+            {
+                // Searching for the start of the next document
+                nextState = executeParsingStateResynchronizing();
+
+                // Check transitions
+                switch (nextState)
+                {
+                    case ParsingState_Resynchronizing:
+                    {
+                        // More data is needed
+                        result = ParsingResult_NeedMoreData;
+                        break;
+                    }
+
+                    case ParsingState_Idle:
+                    {
+                        // Start of the next document was found
+                        result = ParsingResult_DataDiscarded;
+                        break;
+                    }
+
+                    default:
+                    {
+                        // Error
+                        nextState = ParsingState_Error;
+                        break;
+                    }
+                }
+                break;
+            }
+
             default:
             {
                 // Error
@@ -649,12 +1481,57 @@ XmlReader::ParsingResult XmlReader::parse()
 
         if (m_parsingState == ParsingState_Error)
         {
-            m_documentState == DocumentState_Error;
+            m_documentState = DocumentState_Error;
         }
     }
 
-    // Save last parsing result
-    m_lastParsingResult = result;
+    if (m_dtdValidation)
+    {
+        result = validateEvent(result);
+    }
+
+    if (!m_hashedSubtreePathList.empty())
+    {
+        hashEvent(result);
+    }
+
+    return result;
+}
+
+/**
+ * Parse data in the data buffer with a work budget
+ *
+ * \param budget    Maximum number of characters that can be read from the buffer (value 0 is
+ *                  handled as 1)
+ *
+ * \return Parsing result
+ * \retval ParsingResult_Yield  Budget was used up before the next event, call parse() again to
+ *                              continue
+ *
+ * \note Parsing stops when the budget is used up, even inside of a token, and it continues exactly
+ *       where it stopped on the next call. This bounds the time spent in a single call when a large
+ *       amount of data is written to the reader at once.
+ */
+XmlReader::ParsingResult XmlReader::parse(const size_t budget)
+{
+    size_t readLimit = budget;
+
+    if (readLimit == 0U)
+    {
+        readLimit = 1U;
+    }
+
+    m_parsingBuffer.setReadLimit(readLimit);
+    ParsingResult result = parse();
+
+    if ((result == ParsingResult_NeedMoreData) && m_parsingBuffer.isReadLimitReached())
+    {
+        // Budget was used up, there is more data in the buffer
+        result = ParsingResult_Yield;
+        m_lastParsingResult = result;
+    }
+
+    m_parsingBuffer.clearReadLimit();
     return result;
 }
 
@@ -726,11 +1603,170 @@ EmbeddedStAX::Common::UnicodeString XmlReader::name() const
  *
  * \return Attribute list
  */
-EmbeddedStAX::Common::AttributeList XmlReader::attributeList() const
+const EmbeddedStAX::Common::AttributeList &XmlReader::attributeList() const
 {
     return m_attributeList;
 }
 
+/**
+ * Get character offset of the current parsing position
+ *
+ * \return Number of characters in the data stream before the current parsing position
+ *
+ * \note After ParsingResult_Error this is the position where the error was detected. Offsets are
+ *       counted from the last time the reader was cleared (they span multiple documents).
+ */
+size_t XmlReader::characterOffset() const
+{
+    return m_parsingBuffer.characterOffset(m_parsingBuffer.currentPosition());
+}
+
+/**
+ * Get byte offset of the current parsing position
+ *
+ * \return Number of UTF-8 bytes in the data stream before the current parsing position
+ *
+ * \note The offset is calculated on request from the amount of buffered data.
+ */
+size_t XmlReader::byteOffset() const
+{
+    return m_parsingBuffer.byteOffset(m_parsingBuffer.currentPosition());
+}
+
+/**
+ * Get line and column number of the current parsing position
+ *
+ * \param line      Output for the line number (first line is 1)
+ * \param column    Output for the column number in characters (first column is 1)
+ *
+ * \retval true     Location calculated
+ * \retval false    Location is not known (line tracking is disabled and the parsed data was
+ *                  already removed from the parsing buffer)
+ *
+ * \note The location is calculated on request by counting the newlines in the parsing buffer, it
+ *       is intended for error reports.
+ */
+bool XmlReader::location(size_t *line, size_t *column) const
+{
+    return m_parsingBuffer.calculateLineAndColumn(m_parsingBuffer.currentPosition(),
+                                                  line,
+                                                  column);
+}
+
+/**
+ * Get offset of the last discarded data
+ *
+ * \return Byte offset in the data stream of the start of the document that was discarded after
+ *         the last error
+ *
+ * \note Value is valid after ParsingResult_DataDiscarded.
+ */
+size_t XmlReader::discardedOffset() const
+{
+    return m_discardedOffset;
+}
+
+/**
+ * Get size of the last discarded data
+ *
+ * \return Number of bytes of the document that was discarded after the last error (from the
+ *         start of the document to the start of the next document)
+ *
+ * \note Value is valid after ParsingResult_DataDiscarded.
+ */
+size_t XmlReader::discardedSize() const
+{
+    return m_discardedSize;
+}
+
+/**
+ * Get path hash
+ *
+ * \return Hash of the path of the current element
+ *
+ * \note The path of the current element is the path of the element for the start and end of element
+ *       events and the path of the parent element for all other events inside of the root element.
+ *       The hash is updated incrementally when elements are opened and closed. It is equal to
+ *       calculatePathHash() of the path string (for example "/a/b/c") so it can be compared with
+ *       precompiled path hashes.
+ */
+uint32_t XmlReader::pathHash() const
+{
+    return m_pathHash;
+}
+
+/**
+ * Check if the path of the current element matches the selected path
+ *
+ * \param path  Path string (for example "/a/b/c", empty string for the path outside of the root
+ *              element)
+ *
+ * \retval true     Path matches
+ * \retval false    Path does not match
+ *
+ * \note The path is compared with the names of the open elements directly, the path string of the
+ *       current element is not built.
+ */
+bool XmlReader::isCurrentPath(const Common::UnicodeString &path) const
+{
+    bool match = true;
+    size_t position = 0U;
+    std::list<Common::UnicodeString>::const_iterator it = m_openElementList.begin();
+    bool finished = false;
+
+    while (match && !finished)
+    {
+        const Common::UnicodeString *name = NULL;
+
+        if (it != m_openElementList.end())
+        {
+            name = &(*it);
+            it++;
+        }
+        else if (m_pathIncludesName)
+        {
+            name = &m_name;
+            finished = true;
+        }
+        else
+        {
+            finished = true;
+        }
+
+        if (name != NULL)
+        {
+            // Compare the path segment with the element name
+            if ((position < path.size()) && (path.at(position) == static_cast<uint32_t>('/')))
+            {
+                position++;
+                match = (path.compare(position, name->size(), *name) == 0);
+                position += name->size();
+            }
+            else
+            {
+                match = false;
+            }
+        }
+    }
+
+    return (match && (position == path.size()));
+}
+
+/**
+ * Calculate path hash
+ *
+ * \param path  Path string (for example "/a/b/c", empty string for the path outside of the root
+ *              element)
+ *
+ * \return Hash of the path
+ *
+ * \note Path hash is calculated with FNV-1a over the characters of the path string.
+ */
+uint32_t XmlReader::calculatePathHash(const Common::UnicodeString &path)
+{
+    return Common::HashIndex::calculateHash(path);
+}
+
 /**
  * Execute parsing state: Reading token type
  *
@@ -766,6 +1802,9 @@ XmlReader::ParsingState XmlReader::executeParsingStateReadingTokenType()
 
             case TokenTypeParser::Result_Success:
             {
+                // Select validation of the token
+                selectTokenValidation();
+
                 // Check token type
                 const TokenTypeParser::TokenType tokenType = m_tokenTypeParser.tokenType();
 
@@ -800,7 +1839,16 @@ XmlReader::ParsingState XmlReader::executeParsingStateReadingTokenType()
                     case TokenTypeParser::TokenType_ProcessingInstruction:
                     {
                         // Set procesing instruction parser
-                        if (m_processingInstructionParser.initialize(&m_parsingBuffer))
+                        ProcessingInstructionParser::Option option =
+                                ProcessingInstructionParser::Option_None;
+
+                        if (!isEventEnabled(EventMask_ProcessingInstruction))
+                        {
+                            // Processing instruction is masked, its content is not needed
+                            option = ProcessingInstructionParser::Option_SkipContent;
+                        }
+
+                        if (m_processingInstructionParser.initialize(&m_parsingBuffer, option))
                         {
                             // Processing instruction token found
                             nextState = ParsingState_ReadingProcessingInstruction;
@@ -847,7 +1895,15 @@ XmlReader::ParsingState XmlReader::executeParsingStateReadingTokenType()
                     case TokenTypeParser::TokenType_Comment:
                     {
                         // Set comment parser
-                        if (m_commentParser.initialize(&m_parsingBuffer))
+                        CommentParser::Option option = CommentParser::Option_None;
+
+                        if (!isEventEnabled(EventMask_Comment))
+                        {
+                            // Comment is masked, its content is not needed
+                            option = CommentParser::Option_SkipContent;
+                        }
+
+                        if (m_commentParser.initialize(&m_parsingBuffer, option))
                         {
                             // Check document state
                             if (m_documentState == DocumentState_PrologWaitForXmlDeclaration)
@@ -923,6 +1979,16 @@ XmlReader::ParsingState XmlReader::executeParsingStateReadingTokenType()
 
                     case TokenTypeParser::TokenType_EndOfElement:
                     {
+                        // The end tag is expected to close the innermost open element
+                        if (m_openElementList.empty())
+                        {
+                            m_endOfElementParser.setExpectedName(NULL);
+                        }
+                        else
+                        {
+                            m_endOfElementParser.setExpectedName(&(m_openElementList.back()));
+                        }
+
                         if (m_endOfElementParser.initialize(&m_parsingBuffer))
                         {
                             m_name.clear();
@@ -955,11 +2021,422 @@ XmlReader::ParsingState XmlReader::executeParsingStateReadingTokenType()
                 break;
             }
 
-            default:
-            {
-                // Error
-                break;
-            }
+            default:
+            {
+                // Error
+                break;
+            }
+        }
+    }
+
+    return nextState;
+}
+
+/**
+ * Execute parsing state: Reading processing instruction
+ *
+ * \retval ParsingState_ReadingProcessingInstruction    Wait for more data
+ * \retval ParsingState_ProcessingInstructionRead       Processing instruction was read
+ * \retval ParsingState_XmlDeclarationRead              XML declaration was read
+ * \retval ParsingState_Error                           Error
+ */
+XmlReader::ParsingState XmlReader::executeParsingStateReadingProcessingInstruction()
+{
+    ParsingState nextState = ParsingState_Error;
+
+    // Parse
+    const ProcessingInstructionParser::Result result = m_processingInstructionParser.parse();
+
+    switch (result)
+    {
+        case ProcessingInstructionParser::Result_NeedMoreData:
+        {
+            // More data is needed
+            nextState = ParsingState_ReadingProcessingInstruction;
+            break;
+        }
+
+        case ProcessingInstructionParser::Result_Success:
+        {
+            // Check token type
+            const ProcessingInstructionParser::TokenType tokenType =
+                    m_processingInstructionParser.tokenType();
+
+            switch (tokenType)
+            {
+                case ProcessingInstructionParser::TokenType_ProcessingInstruction:
+                {
+                    // Processing instruction read
+                    m_processingInstruction = m_processingInstructionParser.processingInstruction();
+
+                    // Check document state
+                    if (m_documentState == DocumentState_PrologWaitForXmlDeclaration)
+                    {
+                        // A processing instruction was fround instead of a XML
+                        // declaration at the start of the document. Now start waiting
+                        // for document type.
+                        m_documentState = DocumentState_PrologWaitForDocumentType;
+                    }
+
+                    nextState = ParsingState_ProcessingInstructionRead;
+                    break;
+                }
+
+                case ProcessingInstructionParser::TokenType_XmlDeclaration:
+                {
+                    // Check document state
+                    if (m_documentState == DocumentState_PrologWaitForXmlDeclaration)
+                    {
+                        // XML declaration read
+                        m_xmlDeclaration = m_processingInstructionParser.xmlDeclaration();
+
+                        // A XML declaration is at the start of the document. Now start
+                        // waiting for document typel.
+                        m_documentState = DocumentState_PrologWaitForDocumentType;
+                        nextState = ParsingState_XmlDeclarationRead;
+                    }
+                    else
+                    {
+                        // Error, XML declaration was read at the unexpected time
+                    }
+                    break;
+                }
+
+                default:
+                {
+                    // Error
+                    break;
+                }
+            }
+            break;
+        }
+
+        default:
+        {
+            // Error
+            break;
+        }
+    }
+
+    return nextState;
+}
+
+/**
+ * Execute parsing state: Reading comment
+ *
+ * \retval ParsingState_ReadingComment  Wait for more data
+ * \retval ParsingState_CommentRead     Processing instruction was read
+ * \retval ParsingState_Error           Error
+ */
+XmlReader::ParsingState XmlReader::executeParsingStateReadingComment()
+{
+    ParsingState nextState = ParsingState_Error;
+
+    // Parse
+    const CommentParser::Result result = m_commentParser.parse();
+
+    switch (result)
+    {
+        case CommentParser::Result_NeedMoreData:
+        {
+            // More data is needed
+            nextState = ParsingState_ReadingComment;
+            break;
+        }
+
+        case CommentParser::Result_Success:
+        {
+            // Save comment text
+            m_text = m_commentParser.text();
+
+            // Check document state
+            if (m_documentState == DocumentState_PrologWaitForXmlDeclaration)
+            {
+                // A comment was fround instead of a XML declaration at the start of the
+                // document. Now start waiting for document type.
+                m_documentState = DocumentState_PrologWaitForDocumentType;
+            }
+
+            nextState = ParsingState_CommentRead;
+            break;
+        }
+
+        default:
+        {
+            // Error
+            break;
+        }
+    }
+
+    return nextState;
+}
+
+/**
+ * Execute parsing state: Reading document type
+ *
+ * \retval ParsingState_ReadingDocumentType Wait for more data
+ * \retval ParsingState_DocumentTypeRead    Document type was read
+ * \retval ParsingState_Error               Error
+ */
+XmlReader::ParsingState XmlReader::executeParsingStateReadingDocumentType()
+{
+    ParsingState nextState = ParsingState_Error;
+
+    // Parse
+    const DocumentTypeParser::Result result = m_documentTypeParser.parse();
+
+    switch (result)
+    {
+        case DocumentTypeParser::Result_NeedMoreData:
+        {
+            // More data is needed
+            nextState = ParsingState_ReadingDocumentType;
+            break;
+        }
+
+        case DocumentTypeParser::Result_Success:
+        {
+            // Document type read
+            m_documentType = m_documentTypeParser.documentType();
+
+            // Check document state
+            if (m_documentState == DocumentState_PrologWaitForDocumentType)
+            {
+                // A document type was fround. Now start waiting for Misc
+                m_documentState = DocumentState_PrologWaitForMisc;
+                nextState = ParsingState_DocumentTypeRead;
+            }
+            else
+            {
+                // Error, invalid document state
+            }
+            break;
+        }
+
+        default:
+        {
+            // Error
+            break;
+        }
+    }
+
+    return nextState;
+}
+
+/**
+ * Execute parsing state: Reading start of element
+ *
+ * \retval ParsingState_ReadingStartOfElement   Wait for more data
+ * \retval ParsingState_StartOfElementRead      Start of element was read
+ * \retval ParsingState_EmptyElementRead        Empty element was read
+ * \retval ParsingState_Error                   Error
+ */
+XmlReader::ParsingState XmlReader::executeParsingStateReadingStartOfElement()
+{
+    ParsingState nextState = ParsingState_Error;
+
+    // Parse
+    const StartOfElementParser::Result result = m_startOfElementParser.parse();
+
+    switch (result)
+    {
+        case StartOfElementParser::Result_NeedMoreData:
+        {
+            // More data is needed
+            nextState = ParsingState_ReadingStartOfElement;
+            break;
+        }
+
+        case StartOfElementParser::Result_Success:
+        {
+            // Check document state
+            switch (m_documentState)
+            {
+                case DocumentState_PrologWaitForXmlDeclaration:
+                case DocumentState_PrologWaitForDocumentType:
+                case DocumentState_PrologWaitForMisc:
+                case DocumentState_Element:
+                {
+                    // Start of element read
+                    m_name = m_startOfElementParser.name();
+                    m_attributeList = m_startOfElementParser.attributeList();
+
+                    if (m_documentState != DocumentState_Element)
+                    {
+                        m_documentState = DocumentState_Element;
+                    }
+
+                    const StartOfElementParser::TokenType tokenType =
+                            m_startOfElementParser.tokenType();
+
+                    switch (tokenType)
+                    {
+                        case StartOfElementParser::TokenType_StartOfElement:
+                        {
+                            // Check for start of root element
+                            bool success = true;
+
+                            if (m_openElementList.empty())
+                            {
+                                const Common::UnicodeString rootName = m_documentType.name();
+
+                                if (!rootName.empty())
+                                {
+                                    // Root element name was set in the document type, make sure
+                                    // that the root element name matches
+                                    if (m_name != rootName)
+                                    {
+                                        // Error, root element name does not match the root
+                                        // element name from the document type
+                                        success = false;
+                                    }
+                                }
+                            }
+
+                            enterElementPath(false);
+                            m_openElementList.push_back(m_name);
+
+                            if (m_peeking)
+                            {
+                                m_peekedElementChange = PeekedElementChange_Opened;
+                            }
+                            nextState = ParsingState_StartOfElementRead;
+                            break;
+                        }
+
+                        case StartOfElementParser::TokenType_EmptyElement:
+                        {
+                            enterElementPath(true);
+                            nextState = ParsingState_EmptyElementRead;
+                            break;
+                        }
+
+                        default:
+                        {
+                            // Error
+                            break;
+                        }
+                    }
+                    break;
+                }
+
+                default:
+                {
+                    // Error, invalid state
+                    break;
+                }
+            }
+            break;
+        }
+
+        default:
+        {
+            // Error
+            break;
+        }
+    }
+
+    return nextState;
+}
+
+/**
+ * Execute parsing state: Reading text node
+ *
+ * \retval ParsingState_ReadingTextNode Wait for more data
+ * \retval ParsingState_TextNodeRead    Text node was read
+ * \retval ParsingState_Error           Error
+ */
+XmlReader::ParsingState XmlReader::executeParsingStateReadingTextNode()
+{
+    ParsingState nextState = ParsingState_Error;
+
+    // Parse
+    const TextNodeParser::Result result = m_textNodeParser.parse();
+
+    switch (result)
+    {
+        case TextNodeParser::Result_NeedMoreData:
+        {
+            // More data is needed
+            nextState = ParsingState_ReadingTextNode;
+            break;
+        }
+
+        case TextNodeParser::Result_Success:
+        {
+            // Save text node
+            if (m_textCoalescing)
+            {
+                m_text.append(m_textNodeParser.text());
+            }
+            else
+            {
+                m_text = m_textNodeParser.text();
+            }
+
+            nextState = ParsingState_TextNodeRead;
+            break;
+        }
+
+        default:
+        {
+            // Error
+            break;
+        }
+    }
+
+    return nextState;
+}
+
+/**
+ * Execute parsing state: Reading whitespace
+ *
+ * \retval ParsingState_ReadingWhitespace   Wait for more data
+ * \retval ParsingState_ReadingTokenType    Whitespace was followed by markup and it was skipped
+ * \retval ParsingState_ReadingTextNode     Whitespace is the start of a text node
+ * \retval ParsingState_Error               Error
+ *
+ * \note Whitespace is kept in the parsing buffer until the first non-whitespace character is
+ *       found, so that it can still be read as a part of a text node.
+ */
+XmlReader::ParsingState XmlReader::executeParsingStateReadingWhitespace()
+{
+    ParsingState nextState = ParsingState_Error;
+
+    // Skip all available whitespace characters
+    m_parsingBuffer.skipWhitespace();
+
+    if (m_parsingBuffer.isMoreDataNeeded())
+    {
+        // More data is needed
+        nextState = ParsingState_ReadingWhitespace;
+    }
+    else if (m_parsingBuffer.currentChar() == static_cast<uint32_t>('<'))
+    {
+        // Whitespace is followed by markup, discard it and read the token type
+        m_parsingBuffer.eraseToCurrentPosition();
+
+        if (m_tokenTypeParser.initialize(&m_parsingBuffer))
+        {
+            nextState = ParsingState_ReadingTokenType;
+        }
+        else
+        {
+            // Error, failed to initialize parser
+        }
+    }
+    else
+    {
+        // Other text follows the whitespace, read all of it as a text node
+        m_parsingBuffer.setCurrentPosition(0U);
+
+        if (m_textNodeParser.initialize(&m_parsingBuffer))
+        {
+            nextState = ParsingState_ReadingTextNode;
+        }
+        else
+        {
+            // Error, failed to initialize parser
         }
     }
 
@@ -967,81 +2444,42 @@ XmlReader::ParsingState XmlReader::executeParsingStateReadingTokenType()
 }
 
 /**
- * Execute parsing state: Reading processing instruction
+ * Execute parsing state: Reading CDATA
  *
- * \retval ParsingState_ReadingProcessingInstruction    Wait for more data
- * \retval ParsingState_ProcessingInstructionRead       Processing instruction was read
- * \retval ParsingState_XmlDeclarationRead              XML declaration was read
- * \retval ParsingState_Error                           Error
+ * \retval ParsingState_ReadingCData    Wait for more data
+ * \retval ParsingState_CDataRead       CDATA was read
+ * \retval ParsingState_Error           Error
  */
-XmlReader::ParsingState XmlReader::executeParsingStateReadingProcessingInstruction()
+XmlReader::ParsingState XmlReader::executeParsingStateReadingCData()
 {
     ParsingState nextState = ParsingState_Error;
 
     // Parse
-    const ProcessingInstructionParser::Result result = m_processingInstructionParser.parse();
+    const CDataParser::Result result = m_cDataParser.parse();
 
     switch (result)
     {
-        case ProcessingInstructionParser::Result_NeedMoreData:
+        case CDataParser::Result_NeedMoreData:
         {
             // More data is needed
-            nextState = ParsingState_ReadingProcessingInstruction;
+            nextState = ParsingState_ReadingCData;
             break;
         }
 
-        case ProcessingInstructionParser::Result_Success:
+        case CDataParser::Result_Success:
         {
-            // Check token type
-            const ProcessingInstructionParser::TokenType tokenType =
-                    m_processingInstructionParser.tokenType();
-
-            switch (tokenType)
+            // Save CDATA text
+            if (m_textCoalescing)
             {
-                case ProcessingInstructionParser::TokenType_ProcessingInstruction:
-                {
-                    // Processing instruction read
-                    m_processingInstruction = m_processingInstructionParser.processingInstruction();
-
-                    // Check document state
-                    if (m_documentState == DocumentState_PrologWaitForXmlDeclaration)
-                    {
-                        // A processing instruction was fround instead of a XML
-                        // declaration at the start of the document. Now start waiting
-                        // for document type.
-                        m_documentState = DocumentState_PrologWaitForDocumentType;
-                    }
-
-                    nextState = ParsingState_ProcessingInstructionRead;
-                    break;
-                }
-
-                case ProcessingInstructionParser::TokenType_XmlDeclaration:
-                {
-                    // Check document state
-                    if (m_documentState == DocumentState_PrologWaitForXmlDeclaration)
-                    {
-                        // XML declaration read
-                        m_xmlDeclaration = m_processingInstructionParser.xmlDeclaration();
-
-                        // A XML declaration is at the start of the document. Now start
-                        // waiting for document typel.
-                        m_documentState = DocumentState_PrologWaitForDocumentType;
-                        nextState = ParsingState_XmlDeclarationRead;
-                    }
-                    else
-                    {
-                        // Error, XML declaration was read at the unexpected time
-                    }
-                    break;
-                }
-
-                default:
-                {
-                    // Error
-                    break;
-                }
+                m_text.append(m_cDataParser.text());
+            }
+            else
+            {
+                m_text = m_cDataParser.text();
             }
+
+            m_cDataParser.deinitialize();
+            nextState = ParsingState_CDataRead;
             break;
         }
 
@@ -1056,42 +2494,66 @@ XmlReader::ParsingState XmlReader::executeParsingStateReadingProcessingInstructi
 }
 
 /**
- * Execute parsing state: Reading comment
+ * Execute parsing state: Reading end of element
  *
- * \retval ParsingState_ReadingComment  Wait for more data
- * \retval ParsingState_CommentRead     Processing instruction was read
- * \retval ParsingState_Error           Error
+ * \retval ParsingState_ReadingEndOfElement Wait for more data
+ * \retval ParsingState_EndOfElementRead    End of element was read
+ * \retval ParsingState_Error               Error
  */
-XmlReader::ParsingState XmlReader::executeParsingStateReadingComment()
+XmlReader::ParsingState XmlReader::executeParsingStateReadingEndOfElement()
 {
     ParsingState nextState = ParsingState_Error;
 
     // Parse
-    const CommentParser::Result result = m_commentParser.parse();
+    const EndOfElementParser::Result result = m_endOfElementParser.parse();
 
     switch (result)
     {
-        case CommentParser::Result_NeedMoreData:
+        case EndOfElementParser::Result_NeedMoreData:
         {
             // More data is needed
-            nextState = ParsingState_ReadingComment;
+            nextState = ParsingState_ReadingEndOfElement;
             break;
         }
 
-        case CommentParser::Result_Success:
+        case EndOfElementParser::Result_Success:
         {
-            // Save comment text
-            m_text = m_commentParser.text();
-
-            // Check document state
-            if (m_documentState == DocumentState_PrologWaitForXmlDeclaration)
+            // End of element read
+            if (m_endOfElementParser.isExpectedName())
             {
-                // A comment was fround instead of a XML declaration at the start of the
-                // document. Now start waiting for document type.
-                m_documentState = DocumentState_PrologWaitForDocumentType;
+                // Element name was already matched against the currently open element, take over
+                // its name instead of copying it (while peeking the element stays open for the
+                // current event, so its name is copied)
+                if (m_peeking)
+                {
+                    m_name = m_openElementList.back();
+                }
+                else
+                {
+                    m_name.swap(m_openElementList.back());
+                }
+
+                closeOpenElement();
+                leaveElementPath();
+                nextState = ParsingState_EndOfElementRead;
             }
+            else
+            {
+                m_name = m_endOfElementParser.name();
 
-            nextState = ParsingState_CommentRead;
+                // Check if end of element matches currently open element
+                if (m_name == m_openElementList.back())
+                {
+                    // Element name matches
+                    closeOpenElement();
+                    leaveElementPath();
+                    nextState = ParsingState_EndOfElementRead;
+                }
+                else
+                {
+                    // Error
+                }
+            }
             break;
         }
 
@@ -1106,297 +2568,607 @@ XmlReader::ParsingState XmlReader::executeParsingStateReadingComment()
 }
 
 /**
- * Execute parsing state: Reading document type
+ * Execute parsing state: Resynchronizing
+ *
+ * \retval ParsingState_Resynchronizing Wait for more data
+ * \retval ParsingState_Idle            Start of the next document was found, a new document was
+ *                                      started
+ *
+ * Format of a plausible start of a document:
+ * \code{.unparsed}
+ * Start of document ::= '<' ('?' | '!' | NameStartChar)
+ * \endcode
+ */
+XmlReader::ParsingState XmlReader::executeParsingStateResynchronizing()
+{
+    ParsingState nextState = ParsingState_Resynchronizing;
+    bool finishParsing = false;
+
+    while (!finishParsing)
+    {
+        finishParsing = true;
+
+        // Bulk scan for the next start of markup
+        m_parsingBuffer.skipToCharacter(static_cast<uint32_t>('<'));
+        const size_t position = m_parsingBuffer.currentPosition();
+
+        if (m_parsingBuffer.isMoreDataNeeded() || ((position + 1U) >= m_parsingBuffer.size()))
+        {
+            // More data is needed
+        }
+        else
+        {
+            const uint32_t uchar = m_parsingBuffer.at(position + 1U);
+
+            if ((uchar == static_cast<uint32_t>('?')) ||
+                (uchar == static_cast<uint32_t>('!')) ||
+                XmlValidator::isNameStartChar(uchar))
+            {
+                // Plausible start of a document found, start a new document at it
+                m_discardedSize = m_parsingBuffer.byteOffset(position) - m_discardedOffset;
+                startNewDocument();
+                nextState = ParsingState_Idle;
+            }
+            else
+            {
+                // Not a start of a document, continue the search after it
+                m_parsingBuffer.incrementPosition();
+                finishParsing = false;
+            }
+        }
+
+        m_parsingBuffer.eraseToCurrentPosition();
+    }
+
+    return nextState;
+}
+
+/**
+ * Check if event is enabled in the event mask
+ *
+ * \param event Event
+ *
+ * \retval true     Event is enabled
+ * \retval false    Event is masked
+ */
+bool XmlReader::isEventEnabled(const EventMask event) const
+{
+    return ((m_eventMask & static_cast<uint32_t>(event)) != 0U);
+}
+
+/**
+ * Check if text contains only whitespace characters
+ *
+ * \retval true     Text contains only whitespace characters
+ * \retval false    Text contains at least one non-whitespace character
+ */
+bool XmlReader::isWhitespaceText() const
+{
+    bool whitespace = true;
+
+    for (size_t i = 0U; whitespace && (i < m_text.size()); i++)
+    {
+        whitespace = XmlValidator::isWhitespace(m_text.at(i));
+    }
+
+    return whitespace;
+}
+
+/**
+ * Enter the path of the element that was just read
+ *
+ * \param emptyElement  Element is an empty element (it is not added to the open elements)
+ */
+void XmlReader::enterElementPath(const bool emptyElement)
+{
+    // Append the path separator and the element name
+    m_pathHash = Common::HashIndex::appendHash(m_pathHash, static_cast<uint32_t>('/'));
+    m_pathHash = Common::HashIndex::appendHash(m_pathHash, m_name);
+    m_pathIncludesName = emptyElement;
+
+    if (!emptyElement)
+    {
+        m_openElementPathHashList.push_back(m_pathHash);
+    }
+}
+
+/**
+ * Leave the path of the element that was just closed
+ *
+ * \note Path hash of the closed element is kept until the next event, the parent's path is set
+ *       with ParsingState_EndOfElementRead.
+ */
+void XmlReader::leaveElementPath()
+{
+    m_pathHash = m_openElementPathHashList.back();
+    m_openElementPathHashList.pop_back();
+    m_pathIncludesName = true;
+}
+
+/**
+ * Close the innermost open element
+ *
+ * \note While peeking the element is moved aside instead of being removed, peek() puts it back
+ *       because it is closed only when the peeked event is consumed.
+ */
+void XmlReader::closeOpenElement()
+{
+    std::list<Common::UnicodeString>::iterator it = m_openElementList.end();
+    it--;
+
+    if (m_peeking)
+    {
+        m_peekedElementList.splice(m_peekedElementList.end(), m_openElementList, it);
+        m_peekedElementChange = PeekedElementChange_Closed;
+    }
+    else
+    {
+        m_openElementList.erase(it);
+    }
+}
+
+/**
+ * Park the data of the current event before the next event is peeked
+ *
+ * \param eventData    Event data
+ *
+ * \note The data that the next event clears or overwrites is swapped out. Only the name of an
+ *       empty element is copied because its end of element event reports it too. Path, subtree
+ *       hash and discarded data have a fixed size and are copied.
+ */
+void XmlReader::parkEventData(EventData *eventData)
+{
+    eventData->processingInstruction.swap(m_processingInstruction);
+    m_processingInstruction.clear();
+    eventData->text.swap(m_text);
+    m_text.clear();
+    eventData->name.swap(m_name);
+
+    if (m_parsingState == ParsingState_EmptyElementRead)
+    {
+        m_name = eventData->name;
+    }
+    else
+    {
+        m_name.clear();
+    }
+
+    eventData->attributeList.swap(m_attributeList);
+    m_attributeList.clear();
+    eventData->pathHash = m_pathHash;
+    eventData->pathIncludesName = m_pathIncludesName;
+    eventData->subtreeHash = m_subtreeHash;
+    eventData->discardedOffset = m_discardedOffset;
+    eventData->discardedSize = m_discardedSize;
+}
+
+/**
+ * Swap the data of the current event with the event data
+ *
+ * \param eventData    Event data
+ */
+void XmlReader::swapEventData(EventData *eventData)
+{
+    eventData->processingInstruction.swap(m_processingInstruction);
+    eventData->text.swap(m_text);
+    eventData->name.swap(m_name);
+    eventData->attributeList.swap(m_attributeList);
+    std::swap(eventData->pathHash, m_pathHash);
+    std::swap(eventData->pathIncludesName, m_pathIncludesName);
+    std::swap(eventData->subtreeHash, m_subtreeHash);
+    std::swap(eventData->discardedOffset, m_discardedOffset);
+    std::swap(eventData->discardedSize, m_discardedSize);
+}
+
+/**
+ * Swap the document data set by the peeked event with the event data
+ *
+ * \param eventData    Event data
+ * \param result       Parsing result of the peeked event
+ *
+ * \note XML declaration and document type are read only once at the start of a document, they are
+ *       empty until then. So they are swapped only for their own events.
+ */
+void XmlReader::swapDocumentData(EventData *eventData, const ParsingResult result)
+{
+    if (result == ParsingResult_XmlDeclaration)
+    {
+        std::swap(eventData->xmlDeclaration, m_xmlDeclaration);
+    }
+    else if (result == ParsingResult_DocumentType)
+    {
+        std::swap(eventData->documentType, m_documentType);
+    }
+    else
+    {
+        // No document data was set
+    }
+}
+
+/**
+ * Check if coalesced text is waiting to be reported
+ *
+ * \retval true     Coalesced text is pending
+ * \retval false    Text coalescing is disabled or no text was read
+ */
+bool XmlReader::isCoalescedTextPending() const
+{
+    return (m_textCoalescing && (!m_text.empty()));
+}
+
+/**
+ * Finish the coalesced text before the markup that ended it is read
+ *
+ * \param markupState   Parsing state of the markup that ended the coalesced text
+ * \param result        Output for the parsing result
+ *
+ * \return Parsing state
+ * \retval ParsingState_CoalescedTextRead   Coalesced text is reported, the markup is read after it
+ * \retval markupState                      Coalesced text is masked, continue with the markup
+ */
+XmlReader::ParsingState XmlReader::finishCoalescedText(const ParsingState markupState,
+                                                       ParsingResult *result)
+{
+    ParsingState nextState = markupState;
+
+    if ((!isEventEnabled(EventMask_WhitespaceTextNode)) && isWhitespaceText())
+    {
+        // Whitespace text node is masked
+        m_text.clear();
+    }
+    else
+    {
+        // Report the text, the markup is read on the next call
+        m_coalescedTextNextState = markupState;
+        nextState = ParsingState_CoalescedTextRead;
+        *result = ParsingResult_TextNode;
+    }
+
+    return nextState;
+}
+
+/**
+ * Start reading a text node
  *
- * \retval ParsingState_ReadingDocumentType Wait for more data
- * \retval ParsingState_DocumentTypeRead    Document type was read
- * \retval ParsingState_Error               Error
+ * \retval ParsingState_ReadingWhitespace   Whitespace text nodes are masked, skip leading whitespace
+ * \retval ParsingState_ReadingTextNode     Text node parser initialized
+ * \retval ParsingState_Error               Error, failed to initialize parser
+ *
+ * \note When whitespace text nodes are masked the whitespace between markup is skipped with a bulk
+ *       scan, the text node parser is only started if other text follows the whitespace. The bulk
+ *       scan is not used with text coalescing, because the whitespace can be a part of the
+ *       coalesced text.
  */
-XmlReader::ParsingState XmlReader::executeParsingStateReadingDocumentType()
+XmlReader::ParsingState XmlReader::startReadingTextNode()
 {
     ParsingState nextState = ParsingState_Error;
 
-    // Parse
-    const DocumentTypeParser::Result result = m_documentTypeParser.parse();
+    if ((!isEventEnabled(EventMask_WhitespaceTextNode)) && (!m_textCoalescing))
+    {
+        m_parsingBuffer.eraseToCurrentPosition();
+        nextState = ParsingState_ReadingWhitespace;
+    }
+    else if (m_textNodeParser.initialize(&m_parsingBuffer))
+    {
+        nextState = ParsingState_ReadingTextNode;
+    }
+    else
+    {
+        // Error, failed to initialize parser
+    }
 
-    switch (result)
+    return nextState;
+}
+
+/**
+ * Select validation for the next token and the text node that follows it
+ */
+void XmlReader::selectTokenValidation()
+{
+    bool trusted = false;
+
+    switch (m_validationMode)
     {
-        case DocumentTypeParser::Result_NeedMoreData:
+        case ValidationMode_Trusted:
         {
-            // More data is needed
-            nextState = ParsingState_ReadingDocumentType;
+            trusted = true;
             break;
         }
 
-        case DocumentTypeParser::Result_Success:
+        case ValidationMode_Sampled:
         {
-            // Document type read
-            m_documentType = m_documentTypeParser.documentType();
+            // Only every n-th token is validated
+            trusted = (m_validationSampleCounter != 0U);
+            m_validationSampleCounter++;
 
-            // Check document state
-            if (m_documentState == DocumentState_PrologWaitForDocumentType)
+            if (m_validationSampleCounter >= m_validationSampleInterval)
             {
-                // A document type was fround. Now start waiting for Misc
-                m_documentState = DocumentState_PrologWaitForMisc;
-                nextState = ParsingState_DocumentTypeRead;
-            }
-            else
-            {
-                // Error, invalid document state
+                m_validationSampleCounter = 0U;
             }
             break;
         }
 
         default:
         {
-            // Error
+            // Full validation
             break;
         }
     }
 
-    return nextState;
+    m_cDataParser.setTrusted(trusted);
+    m_commentParser.setTrusted(trusted);
+    m_documentTypeParser.setTrusted(trusted);
+    m_endOfElementParser.setTrusted(trusted);
+    m_processingInstructionParser.setTrusted(trusted);
+    m_startOfElementParser.setTrusted(trusted);
+    m_textNodeParser.setTrusted(trusted);
 }
 
 /**
- * Execute parsing state: Reading start of element
+ * Validate the event against the element type declarations of the document type
  *
- * \retval ParsingState_ReadingStartOfElement   Wait for more data
- * \retval ParsingState_StartOfElementRead      Start of element was read
- * \retval ParsingState_EmptyElementRead        Empty element was read
- * \retval ParsingState_Error                   Error
+ * \param result    Parsing result of the event
+ *
+ * \return Parsing result
+ * \retval ParsingResult_Error  Document is not valid
  */
-XmlReader::ParsingState XmlReader::executeParsingStateReadingStartOfElement()
+XmlReader::ParsingResult XmlReader::validateEvent(const ParsingResult result)
 {
-    ParsingState nextState = ParsingState_Error;
-
-    // Parse
-    const StartOfElementParser::Result result = m_startOfElementParser.parse();
+    bool valid = true;
 
     switch (result)
     {
-        case StartOfElementParser::Result_NeedMoreData:
+        case ParsingResult_DocumentType:
         {
-            // More data is needed
-            nextState = ParsingState_ReadingStartOfElement;
+            valid = declareDocumentTypeElements();
             break;
         }
 
-        case StartOfElementParser::Result_Success:
+        case ParsingResult_StartOfElement:
         {
-            // Check document state
-            switch (m_documentState)
-            {
-                case DocumentState_PrologWaitForXmlDeclaration:
-                case DocumentState_PrologWaitForDocumentType:
-                case DocumentState_PrologWaitForMisc:
-                case DocumentState_Element:
-                {
-                    // Start of element read
-                    m_name = m_startOfElementParser.name();
-                    m_attributeList = m_startOfElementParser.attributeList();
-
-                    if (m_documentState != DocumentState_Element)
-                    {
-                        m_documentState = DocumentState_Element;
-                    }
+            valid = m_schemaValidator.validateStartOfElement(m_name);
+            break;
+        }
 
-                    const StartOfElementParser::TokenType tokenType =
-                            m_startOfElementParser.tokenType();
+        case ParsingResult_TextNode:
+        {
+            valid = m_schemaValidator.validateText(m_text, false);
+            break;
+        }
 
-                    switch (tokenType)
-                    {
-                        case StartOfElementParser::TokenType_StartOfElement:
-                        {
-                            // Check for start of root element
-                            bool success = true;
+        case ParsingResult_CData:
+        {
+            valid = m_schemaValidator.validateText(m_text, true);
+            break;
+        }
 
-                            if (m_openElementList.empty())
-                            {
-                                const Common::UnicodeString rootName = m_documentType.name();
+        case ParsingResult_EndOfElement:
+        {
+            valid = m_schemaValidator.validateEndOfElement();
+            break;
+        }
 
-                                if (!rootName.empty())
-                                {
-                                    // Root element name was set in the document type, make sure
-                                    // that the root element name matches
-                                    if (m_name != rootName)
-                                    {
-                                        // Error, root element name does not match the root
-                                        // element name from the document type
-                                        success = false;
-                                    }
-                                }
-                            }
+        default:
+        {
+            // Other events are not validated
+            break;
+        }
+    }
 
-                            m_openElementList.push_back(m_name);
-                            nextState = ParsingState_StartOfElementRead;
-                            break;
-                        }
+    ParsingResult validatedResult = result;
 
-                        case StartOfElementParser::TokenType_EmptyElement:
-                        {
-                            nextState = ParsingState_EmptyElementRead;
-                            break;
-                        }
+    if (!valid)
+    {
+        // Error, document is not valid
+        m_parsingState = ParsingState_Error;
+        m_documentState = DocumentState_Error;
+        validatedResult = ParsingResult_Error;
+    }
 
-                        default:
-                        {
-                            // Error
-                            break;
-                        }
-                    }
-                    break;
-                }
+    return validatedResult;
+}
 
-                default:
-                {
-                    // Error, invalid state
-                    break;
-                }
-            }
-            break;
-        }
+/**
+ * Declare the elements of the document type in the schema validator
+ *
+ * \retval true     Success
+ * \retval false    Invalid or duplicate element type declaration (validation error is
+ *                  SchemaValidator::Error_InvalidDeclaration)
+ *
+ * \note Declarations from the internal subset are read before the declarations from the external
+ *       DTD. The name of the document type is the required root element.
+ */
+bool XmlReader::declareDocumentTypeElements()
+{
+    m_schemaValidator.clear();
+    bool success = m_schemaValidator.declareElements(m_documentType);
+    const Common::UnicodeString systemId = m_documentType.systemId();
 
-        default:
+    if (!systemId.empty())
+    {
+        for (size_t i = 0U; success && (i < m_externalDtdList.size()); i++)
         {
-            // Error
-            break;
+            if (m_externalDtdList.at(i).systemId() == systemId)
+            {
+                success = m_schemaValidator.declareElements(m_externalDtdList.at(i));
+            }
         }
     }
 
-    return nextState;
+    return success;
 }
 
 /**
- * Execute parsing state: Reading text node
+ * Add the event to the hashes of the open selected subtrees
  *
- * \retval ParsingState_ReadingTextNode Wait for more data
- * \retval ParsingState_TextNodeRead    Text node was read
- * \retval ParsingState_Error           Error
+ * \param result    Parsing result of the event
  */
-XmlReader::ParsingState XmlReader::executeParsingStateReadingTextNode()
+void XmlReader::hashEvent(const ParsingResult result)
 {
-    ParsingState nextState = ParsingState_Error;
+    // Hash of the previous subtree is available only until the next event
+    m_subtreeHash.start(false);
 
-    // Parse
-    const TextNodeParser::Result result = m_textNodeParser.parse();
+    // Depth of the current element in the start and end of element events
+    const size_t depth = m_openElementPathHashList.size() + (m_pathIncludesName ? 1U : 0U);
 
     switch (result)
     {
-        case TextNodeParser::Result_NeedMoreData:
+        case ParsingResult_StartOfElement:
         {
-            // More data is needed
-            nextState = ParsingState_ReadingTextNode;
+            hashStartOfElement(depth);
             break;
         }
 
-        case TextNodeParser::Result_Success:
+        case ParsingResult_EndOfElement:
         {
-            // Save text node
-            m_text = m_textNodeParser.text();
-            nextState = ParsingState_TextNodeRead;
+            hashEndOfElement(depth);
+            break;
+        }
+
+        case ParsingResult_TextNode:
+        case ParsingResult_CData:
+        {
+            if (!m_openSubtreeHashList.empty())
+            {
+                hashText();
+            }
+            break;
+        }
+
+        case ParsingResult_Error:
+        {
+            // Subtrees can not be finished after an error
+            m_openSubtreeHashList.clear();
+            m_openSubtreeDepthList.clear();
             break;
         }
 
         default:
         {
-            // Error
+            // Other events are not part of the canonical event stream
             break;
         }
     }
-
-    return nextState;
 }
 
 /**
- * Execute parsing state: Reading CDATA
+ * Add start of element to the hashes of the open selected subtrees
  *
- * \retval ParsingState_ReadingCData    Wait for more data
- * \retval ParsingState_CDataRead       CDATA was read
- * \retval ParsingState_Error           Error
+ * \param depth Depth of the element
  */
-XmlReader::ParsingState XmlReader::executeParsingStateReadingCData()
+void XmlReader::hashStartOfElement(const size_t depth)
 {
-    ParsingState nextState = ParsingState_Error;
+    m_subtreeTextStarted = false;
+    m_subtreeWhitespace.clear();
 
-    // Parse
-    const CDataParser::Result result = m_cDataParser.parse();
+    // Check if a selected subtree starts with the element
+    bool finished = false;
 
-    switch (result)
+    for (size_t i = 0U; (!finished) && (i < m_hashedSubtreePathList.size()); i++)
     {
-        case CDataParser::Result_NeedMoreData:
+        if ((m_hashedSubtreePathHashList.at(i) == m_pathHash) &&
+            isCurrentPath(m_hashedSubtreePathList.at(i)))
         {
-            // More data is needed
-            nextState = ParsingState_ReadingCData;
-            break;
+            SubtreeHash subtreeHash;
+            subtreeHash.start(m_subtreeSha256);
+            m_openSubtreeHashList.push_back(subtreeHash);
+            m_openSubtreeDepthList.push_back(depth);
+            finished = true;
         }
+    }
 
-        case CDataParser::Result_Success:
+    if (!m_openSubtreeHashList.empty())
+    {
+        // Sort the attributes by name (insertion sort, elements have only a few attributes)
+        std::vector<Common::Attribute> attributeList;
+
+        for (Common::AttributeList::ConstIterator it = m_attributeList.begin();
+             it != m_attributeList.end();
+             it++)
         {
-            // Save CDATA text
-            m_text = m_cDataParser.text();
-            m_cDataParser.deinitialize();
-            nextState = ParsingState_CDataRead;
-            break;
+            size_t position = attributeList.size();
+
+            while ((position > 0U) && (it->name() < attributeList.at(position - 1U).name()))
+            {
+                position--;
+            }
+
+            attributeList.insert(attributeList.begin() + position, *it);
         }
 
-        default:
+        for (size_t i = 0U; i < m_openSubtreeHashList.size(); i++)
         {
-            // Error
-            break;
+            SubtreeHash &subtreeHash = m_openSubtreeHashList.at(i);
+            subtreeHash.appendMarker(static_cast<uint8_t>('S'));
+            subtreeHash.appendString(m_name);
+
+            for (size_t j = 0U; j < attributeList.size(); j++)
+            {
+                subtreeHash.appendMarker(static_cast<uint8_t>('A'));
+                subtreeHash.appendString(attributeList.at(j).name());
+                subtreeHash.appendMarker(static_cast<uint8_t>('='));
+                subtreeHash.appendString(attributeList.at(j).value());
+            }
+
+            subtreeHash.appendMarker(static_cast<uint8_t>('>'));
         }
     }
-
-    return nextState;
 }
 
 /**
- * Execute parsing state: Reading end of element
+ * Add end of element to the hashes of the open selected subtrees
  *
- * \retval ParsingState_ReadingEndOfElement Wait for more data
- * \retval ParsingState_EndOfElementRead    End of element was read
- * \retval ParsingState_Error               Error
+ * \param depth Depth of the element
+ *
+ * \note If the element is the root of the innermost open selected subtree, its hash is finished.
  */
-XmlReader::ParsingState XmlReader::executeParsingStateReadingEndOfElement()
+void XmlReader::hashEndOfElement(const size_t depth)
 {
-    ParsingState nextState = ParsingState_Error;
+    m_subtreeTextStarted = false;
+    m_subtreeWhitespace.clear();
 
-    // Parse
-    const EndOfElementParser::Result result = m_endOfElementParser.parse();
+    for (size_t i = 0U; i < m_openSubtreeHashList.size(); i++)
+    {
+        m_openSubtreeHashList.at(i).appendMarker(static_cast<uint8_t>('E'));
+    }
 
-    switch (result)
+    if ((!m_openSubtreeDepthList.empty()) && (m_openSubtreeDepthList.back() == depth))
     {
-        case EndOfElementParser::Result_NeedMoreData:
-        {
-            // More data is needed
-            nextState = ParsingState_ReadingEndOfElement;
-            break;
-        }
+        m_subtreeHash = m_openSubtreeHashList.back();
+        m_subtreeHash.finish();
+        m_openSubtreeHashList.pop_back();
+        m_openSubtreeDepthList.pop_back();
+    }
+}
 
-        case EndOfElementParser::Result_Success:
+/**
+ * Add character data to the hashes of the open selected subtrees
+ *
+ * \note Whitespace at the start of a run of character data is kept until a non-whitespace
+ *       character is read, a whitespace-only run is not hashed.
+ */
+void XmlReader::hashText()
+{
+    if ((!m_subtreeTextStarted) && isWhitespaceText())
+    {
+        m_subtreeWhitespace.append(m_text);
+    }
+    else
+    {
+        for (size_t i = 0U; i < m_openSubtreeHashList.size(); i++)
         {
-            // End of element read
-            m_name = m_endOfElementParser.name();
+            SubtreeHash &subtreeHash = m_openSubtreeHashList.at(i);
 
-            // Check if end of element matches currently open element
-            if (m_name == m_openElementList.back())
-            {
-                // Element name matches
-                m_openElementList.pop_back();
-                nextState = ParsingState_EndOfElementRead;
-            }
-            else
+            if (!m_subtreeTextStarted)
             {
-                // Error
+                subtreeHash.appendMarker(static_cast<uint8_t>('T'));
+                subtreeHash.appendString(m_subtreeWhitespace);
             }
-            break;
-        }
 
-        default:
-        {
-            // Error
-            break;
+            subtreeHash.appendString(m_text);
         }
-    }
 
-    return nextState;
+        m_subtreeTextStarted = true;
+        m_subtreeWhitespace.clear();
+    }
 }
@@ -70,6 +70,9 @@ bool XmlValidator::validateCDataSection(const Common::UnicodeString &cdata)
                         validationFinished = true;
                     }
                 }
+
+                // Valid character
+                position++;
             }
             else if (isChar(uchar))
             {
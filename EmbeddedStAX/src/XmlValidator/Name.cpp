@@ -187,6 +187,51 @@ bool XmlValidator::isNameChar(const uint32_t character)
     return valid;
 }
 
+/**
+ * Check if character is a name delimiter
+ *
+ * \param character Unicode character
+ *
+ * \retval true     Character can not be a part of a name
+ * \retval false    Character can be a part of a name
+ *
+ * \note Name delimiters are all the characters that can follow a name in a well-formed document.
+ *       It can be used to find the end of a name without validating the name characters.
+ */
+bool XmlValidator::isNameDelimiter(const uint32_t character)
+{
+    bool delimiter = false;
+
+    switch (character)
+    {
+        case 0x09U:
+        case 0x0AU:
+        case 0x0DU:
+        case 0x20U:
+        case static_cast<uint32_t>('"'):
+        case static_cast<uint32_t>('&'):
+        case static_cast<uint32_t>('\''):
+        case static_cast<uint32_t>('/'):
+        case static_cast<uint32_t>(';'):
+        case static_cast<uint32_t>('<'):
+        case static_cast<uint32_t>('='):
+        case static_cast<uint32_t>('>'):
+        case static_cast<uint32_t>('?'):
+        case static_cast<uint32_t>('['):
+        {
+            delimiter = true;
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+    return delimiter;
+}
+
 /**
  * Validate a Name
  *
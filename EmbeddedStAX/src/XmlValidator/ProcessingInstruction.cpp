@@ -106,7 +106,7 @@ bool XmlValidator::validatePiData(const Common::UnicodeString &piData)
 {
     bool valid = true;
 
-    for (size_t i = 0U; i < piData.size(); i++)
+    for (size_t i = 0U; valid && (i < piData.size()); i++)
     {
         valid = isChar(piData.at(i));
 
@@ -97,6 +97,9 @@ bool XmlValidator::validateTextNode(const Common::UnicodeString &text)
                             validationFinished = true;
                         }
                     }
+
+                    // Valid character
+                    position++;
                     break;
                 }
 
@@ -0,0 +1,1375 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include <EmbeddedStAX/XmlWriter/JsonConverter.h>
+#include <EmbeddedStAX/Common/HashIndex.h>
+#include <EmbeddedStAX/XmlValidator/Common.h>
+#include <EmbeddedStAX/XmlValidator/Name.h>
+
+using namespace EmbeddedStAX;
+
+/**
+ * Constructor
+ */
+XmlWriter::JsonConverter::JsonConverter()
+    : m_rootName(Common::Utf8::toUnicodeString("json")),
+      m_arrayItemName(Common::Utf8::toUnicodeString("item")),
+      m_attributePrefix(static_cast<uint32_t>('@')),
+      m_textKey(Common::Utf8::toUnicodeString("#text")),
+      m_nameCache(64U),
+      m_nameValidationCount(0U),
+      m_inputData(),
+      m_inputOffset(0U),
+      m_inputFinished(false),
+      m_readingString(false),
+      m_utf8(),
+      m_token(),
+      m_state(State_Value),
+      m_containerList(),
+      m_target(Target_Element),
+      m_name(),
+      m_xmlWriter(),
+      m_output()
+{
+    // Names are validated by the converter
+    m_xmlWriter.setNameValidationEnabled(false);
+    clearNameCache();
+    startNewStream();
+}
+
+/**
+ * Destructor
+ */
+XmlWriter::JsonConverter::~JsonConverter()
+{
+}
+
+/**
+ * Get root element name
+ *
+ * \return Name of the root element
+ */
+Common::UnicodeString XmlWriter::JsonConverter::rootName() const
+{
+    return m_rootName;
+}
+
+/**
+ * Set root element name
+ *
+ * \param rootName  Name of the root element
+ *
+ * \retval true     Success
+ * \retval false    Error, invalid name
+ */
+bool XmlWriter::JsonConverter::setRootName(const Common::UnicodeString &rootName)
+{
+    bool success = false;
+
+    if (XmlValidator::validateName(rootName))
+    {
+        m_rootName = rootName;
+        success = true;
+    }
+
+    return success;
+}
+
+/**
+ * Get array item element name
+ *
+ * \return Name of the elements of the array items (for arrays that are not object member values)
+ */
+Common::UnicodeString XmlWriter::JsonConverter::arrayItemName() const
+{
+    return m_arrayItemName;
+}
+
+/**
+ * Set array item element name
+ *
+ * \param arrayItemName Name of the elements of the array items (for arrays that are not object
+ *                      member values)
+ *
+ * \retval true     Success
+ * \retval false    Error, invalid name
+ */
+bool XmlWriter::JsonConverter::setArrayItemName(const Common::UnicodeString &arrayItemName)
+{
+    bool success = false;
+
+    if (XmlValidator::validateName(arrayItemName))
+    {
+        m_arrayItemName = arrayItemName;
+        success = true;
+    }
+
+    return success;
+}
+
+/**
+ * Get attribute prefix
+ *
+ * \return Prefix of the keys of the members that are written as attributes (0 if disabled)
+ */
+uint32_t XmlWriter::JsonConverter::attributePrefix() const
+{
+    return m_attributePrefix;
+}
+
+/**
+ * Set attribute prefix
+ *
+ * \param attributePrefix   Prefix of the keys of the members that are written as attributes (0 to
+ *                          write all members as elements)
+ */
+void XmlWriter::JsonConverter::setAttributePrefix(const uint32_t attributePrefix)
+{
+    m_attributePrefix = attributePrefix;
+    clearNameCache();
+}
+
+/**
+ * Get text key
+ *
+ * \return Key of the members that are written as text nodes (empty if disabled)
+ */
+Common::UnicodeString XmlWriter::JsonConverter::textKey() const
+{
+    return m_textKey;
+}
+
+/**
+ * Set text key
+ *
+ * \param textKey   Key of the members that are written as text nodes (empty string to write all
+ *                  members as elements or attributes)
+ */
+void XmlWriter::JsonConverter::setTextKey(const Common::UnicodeString &textKey)
+{
+    m_textKey = textKey;
+    clearNameCache();
+}
+
+/**
+ * Set capacity of the name cache
+ *
+ * \param capacity  Maximum number of keys with cached validation results (rounded up to a power of
+ *                  two, 0 to validate the name of each member)
+ */
+void XmlWriter::JsonConverter::setNameCacheCapacity(const size_t capacity)
+{
+    size_t tableSize = 0U;
+
+    if (capacity > 0U)
+    {
+        tableSize = 1U;
+
+        while (tableSize < capacity)
+        {
+            tableSize *= 2U;
+        }
+    }
+
+    m_nameCache.clear();
+    m_nameCache.resize(tableSize);
+    clearNameCache();
+}
+
+/**
+ * Start converting a new JSON document
+ *
+ * \note Configuration and the name cache are kept.
+ */
+void XmlWriter::JsonConverter::startNewStream()
+{
+    m_inputData.clear();
+    m_inputOffset = 0U;
+    m_inputFinished = false;
+    m_readingString = false;
+    m_utf8.clear();
+    m_token.clear();
+
+    m_state = State_Value;
+    m_containerList.clear();
+    m_target = Target_Element;
+    m_name.clear();
+    m_xmlWriter.clearDocument();
+    m_output.clear();
+}
+
+/**
+ * Write JSON data (UTF-8 encoded) to the converter
+ *
+ * \param data  Data
+ *
+ * \return Number of bytes written (0 if the end of the document was already signaled)
+ */
+size_t XmlWriter::JsonConverter::writeData(const std::string &data)
+{
+    return writeData(data.data(), data.size());
+}
+
+/**
+ * Write JSON data (UTF-8 encoded) to the converter
+ *
+ * \param data  Data
+ * \param size  Size of the data
+ *
+ * \return Number of bytes written (0 if the end of the document was already signaled)
+ */
+size_t XmlWriter::JsonConverter::writeData(const char *data, const size_t size)
+{
+    size_t writtenSize = 0U;
+
+    if (!m_inputFinished)
+    {
+        m_inputData.append(data, size);
+        writtenSize = size;
+    }
+
+    return writtenSize;
+}
+
+/**
+ * Signal the end of the JSON document (no more data will be written)
+ */
+void XmlWriter::JsonConverter::finish()
+{
+    m_inputFinished = true;
+}
+
+/**
+ * Convert the JSON data that was written to the converter
+ *
+ * \retval Result_NeedMoreData  All data was converted, more data is needed
+ * \retval Result_Finished      Document was converted
+ * \retval Result_Error         Error, invalid or incomplete JSON document or a key that can not be
+ *                              converted to a XML name
+ *
+ * \note The converted data is appended to the output.
+ */
+XmlWriter::JsonConverter::Result XmlWriter::JsonConverter::process()
+{
+    Result result = Result_NeedMoreData;
+    bool finished = false;
+
+    while (!finished)
+    {
+        if (m_state == State_Error)
+        {
+            result = Result_Error;
+            finished = true;
+        }
+        else
+        {
+            const TokenType tokenType = readToken();
+
+            switch (tokenType)
+            {
+                case TokenType_None:
+                {
+                    // No complete token in the input data
+                    if (!m_inputFinished)
+                    {
+                        result = Result_NeedMoreData;
+                        finished = true;
+                    }
+                    else if ((m_state == State_EndOfDocument) &&
+                             (m_inputOffset == m_inputData.size()))
+                    {
+                        result = Result_Finished;
+                        finished = true;
+                    }
+                    else
+                    {
+                        // Error, incomplete document
+                        m_state = State_Error;
+                    }
+                    break;
+                }
+
+                case TokenType_Error:
+                {
+                    // Error, invalid token
+                    m_state = State_Error;
+                    break;
+                }
+
+                default:
+                {
+                    if (!processToken(tokenType))
+                    {
+                        // Error, unexpected token or the token can not be converted
+                        m_state = State_Error;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    // Remove the data that was already read
+    m_inputData.erase(0U, m_inputOffset);
+    m_inputOffset = 0U;
+    moveOutput();
+
+    return result;
+}
+
+/**
+ * Get converted XML data (UTF-8 encoded)
+ *
+ * \return Output
+ */
+const std::string &XmlWriter::JsonConverter::output() const
+{
+    return m_output;
+}
+
+/**
+ * Clear the output (for example after it was sent further)
+ */
+void XmlWriter::JsonConverter::clearOutput()
+{
+    m_output.clear();
+}
+
+/**
+ * Get number of name validations
+ *
+ * \return Number of names that were validated (names found in the name cache are not counted)
+ */
+size_t XmlWriter::JsonConverter::nameValidationCount() const
+{
+    return m_nameValidationCount;
+}
+
+/**
+ * Read the next token from the input data
+ *
+ * \retval TokenType_None   Token is not complete (more data is needed)
+ * \retval TokenType_Error  Invalid token
+ * \return Type of the token that was read
+ */
+XmlWriter::JsonConverter::TokenType XmlWriter::JsonConverter::readToken()
+{
+    TokenType tokenType = TokenType_None;
+
+    if (m_readingString)
+    {
+        tokenType = readString();
+    }
+    else
+    {
+        // Skip whitespace
+        while ((m_inputOffset < m_inputData.size()) &&
+               ((m_inputData[m_inputOffset] == ' ') ||
+                (m_inputData[m_inputOffset] == '\t') ||
+                (m_inputData[m_inputOffset] == '\n') ||
+                (m_inputData[m_inputOffset] == '\r')))
+        {
+            m_inputOffset++;
+        }
+
+        if (m_inputOffset < m_inputData.size())
+        {
+            const char data = m_inputData[m_inputOffset];
+
+            switch (data)
+            {
+                case '{':
+                {
+                    tokenType = TokenType_BeginObject;
+                    m_inputOffset++;
+                    break;
+                }
+
+                case '}':
+                {
+                    tokenType = TokenType_EndObject;
+                    m_inputOffset++;
+                    break;
+                }
+
+                case '[':
+                {
+                    tokenType = TokenType_BeginArray;
+                    m_inputOffset++;
+                    break;
+                }
+
+                case ']':
+                {
+                    tokenType = TokenType_EndArray;
+                    m_inputOffset++;
+                    break;
+                }
+
+                case ':':
+                {
+                    tokenType = TokenType_Colon;
+                    m_inputOffset++;
+                    break;
+                }
+
+                case ',':
+                {
+                    tokenType = TokenType_Comma;
+                    m_inputOffset++;
+                    break;
+                }
+
+                case '"':
+                {
+                    m_inputOffset++;
+                    m_readingString = true;
+                    m_utf8.clear();
+                    m_token.clear();
+                    tokenType = readString();
+                    break;
+                }
+
+                case 't':
+                {
+                    tokenType = readLiteral("true", TokenType_Boolean);
+                    break;
+                }
+
+                case 'f':
+                {
+                    tokenType = readLiteral("false", TokenType_Boolean);
+                    break;
+                }
+
+                case 'n':
+                {
+                    tokenType = readLiteral("null", TokenType_Null);
+                    break;
+                }
+
+                default:
+                {
+                    if ((data == '-') || ((data >= '0') && (data <= '9')))
+                    {
+                        tokenType = readNumber();
+                    }
+                    else
+                    {
+                        // Error, invalid character
+                        tokenType = TokenType_Error;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    return tokenType;
+}
+
+/**
+ * Read string
+ *
+ * \retval TokenType_None   String is not complete (more data is needed)
+ * \retval TokenType_Error  Invalid string
+ * \retval TokenType_String String was read
+ *
+ * \note Characters that are not allowed in XML (for example "\u0001") are not accepted.
+ * \note The characters are removed from the input data as they are read, so the reading of a large
+ *       string can continue when more data is written.
+ */
+XmlWriter::JsonConverter::TokenType XmlWriter::JsonConverter::readString()
+{
+    TokenType tokenType = TokenType_None;
+    bool finished = false;
+
+    while ((!finished) && (m_inputOffset < m_inputData.size()))
+    {
+        const uint8_t data = static_cast<uint8_t>(m_inputData[m_inputOffset]);
+
+        if (data >= 0x80U)
+        {
+            // Non-ASCII character
+            const Common::Utf8::Result result = m_utf8.write(static_cast<char>(data));
+
+            if ((result == Common::Utf8::Result_Success) && XmlValidator::isChar(m_utf8.getChar()))
+            {
+                m_token.push_back(m_utf8.getChar());
+                m_inputOffset++;
+            }
+            else if (result == Common::Utf8::Result_Incomplete)
+            {
+                m_inputOffset++;
+            }
+            else
+            {
+                // Error, invalid UTF-8 encoding or a character that is not allowed in XML
+                tokenType = TokenType_Error;
+                finished = true;
+            }
+        }
+        else if ((m_utf8.incompleteSize() > 0U) || (data < 0x20U))
+        {
+            // Error, incomplete UTF-8 character or unescaped control character
+            tokenType = TokenType_Error;
+            finished = true;
+        }
+        else if (data == static_cast<uint8_t>('"'))
+        {
+            // End of string
+            m_inputOffset++;
+            m_readingString = false;
+            tokenType = TokenType_String;
+            finished = true;
+        }
+        else if (data != static_cast<uint8_t>('\\'))
+        {
+            m_token.push_back(static_cast<uint32_t>(data));
+            m_inputOffset++;
+        }
+        else if ((m_inputOffset + 1U) >= m_inputData.size())
+        {
+            // Escape sequence is not complete
+            finished = true;
+        }
+        else
+        {
+            // Escape sequence
+            const char escapedChar = m_inputData[m_inputOffset + 1U];
+            uint32_t uchar = 0U;
+            size_t escapeSize = 2U;
+
+            switch (escapedChar)
+            {
+                case '"':
+                case '\\':
+                case '/':
+                {
+                    uchar = static_cast<uint32_t>(escapedChar);
+                    break;
+                }
+
+                case 'b':
+                {
+                    uchar = 0x08U;
+                    break;
+                }
+
+                case 'f':
+                {
+                    uchar = 0x0CU;
+                    break;
+                }
+
+                case 'n':
+                {
+                    uchar = 0x0AU;
+                    break;
+                }
+
+                case 'r':
+                {
+                    uchar = 0x0DU;
+                    break;
+                }
+
+                case 't':
+                {
+                    uchar = 0x09U;
+                    break;
+                }
+
+                case 'u':
+                {
+                    escapeSize = 6U;
+
+                    if (!readHexValue(m_inputOffset + 2U, &uchar))
+                    {
+                        escapeSize = 0U;
+                    }
+                    else if ((uchar >= 0xD800U) && (uchar <= 0xDBFFU))
+                    {
+                        // High surrogate, it has to be followed by a low surrogate
+                        uint32_t lowSurrogate = 0U;
+                        escapeSize = 12U;
+
+                        if (!readHexValue(m_inputOffset + 8U, &lowSurrogate))
+                        {
+                            escapeSize = 0U;
+                        }
+                        else if ((m_inputData[m_inputOffset + 6U] == '\\') &&
+                                 (m_inputData[m_inputOffset + 7U] == 'u') &&
+                                 (lowSurrogate >= 0xDC00U) &&
+                                 (lowSurrogate <= 0xDFFFU))
+                        {
+                            uchar = 0x10000U +
+                                    ((uchar - 0xD800U) << 10) +
+                                    (lowSurrogate - 0xDC00U);
+                        }
+                        else
+                        {
+                            // Error, invalid surrogate pair
+                            tokenType = TokenType_Error;
+                        }
+                    }
+                    else if ((uchar >= 0xDC00U) && (uchar <= 0xDFFFU))
+                    {
+                        // Error, low surrogate without a high surrogate
+                        tokenType = TokenType_Error;
+                    }
+                    else
+                    {
+                    }
+                    break;
+                }
+
+                default:
+                {
+                    // Error, invalid escape sequence
+                    tokenType = TokenType_Error;
+                    break;
+                }
+            }
+
+            if ((tokenType == TokenType_Error) ||
+                ((escapeSize != 0U) && (!XmlValidator::isChar(uchar))))
+            {
+                // Error, invalid escape sequence or a character that is not allowed in XML
+                tokenType = TokenType_Error;
+                finished = true;
+            }
+            else if (escapeSize == 0U)
+            {
+                // Error, invalid hex value or the escape sequence is not complete
+                if ((m_inputOffset + 12U) <= m_inputData.size())
+                {
+                    tokenType = TokenType_Error;
+                }
+
+                finished = true;
+            }
+            else
+            {
+                m_token.push_back(uchar);
+                m_inputOffset += escapeSize;
+            }
+        }
+    }
+
+    return tokenType;
+}
+
+/**
+ * Read number
+ *
+ * \retval TokenType_None   Number is not complete (more data is needed)
+ * \retval TokenType_Error  Invalid number
+ * \retval TokenType_Number Number was read
+ */
+XmlWriter::JsonConverter::TokenType XmlWriter::JsonConverter::readNumber()
+{
+    enum NumberState
+    {
+        NumberState_Sign,
+        NumberState_Zero,
+        NumberState_Integer,
+        NumberState_Point,
+        NumberState_Fraction,
+        NumberState_Exponent,
+        NumberState_ExponentSign,
+        NumberState_ExponentDigits,
+        NumberState_Error
+    };
+
+    TokenType tokenType = TokenType_None;
+    NumberState state = NumberState_Sign;
+    size_t position = m_inputOffset;
+    bool finished = false;
+
+    if (m_inputData[position] == '-')
+    {
+        position++;
+    }
+
+    while ((!finished) && (position < m_inputData.size()))
+    {
+        const char data = m_inputData[position];
+        const bool digit = ((data >= '0') && (data <= '9'));
+        NumberState nextState = NumberState_Error;
+
+        switch (state)
+        {
+            case NumberState_Sign:
+            {
+                if (data == '0')
+                {
+                    nextState = NumberState_Zero;
+                }
+                else if (digit)
+                {
+                    nextState = NumberState_Integer;
+                }
+                break;
+            }
+
+            case NumberState_Zero:
+            case NumberState_Integer:
+            {
+                if (digit && (state == NumberState_Integer))
+                {
+                    nextState = NumberState_Integer;
+                }
+                else if (data == '.')
+                {
+                    nextState = NumberState_Point;
+                }
+                else if ((data == 'e') || (data == 'E'))
+                {
+                    nextState = NumberState_Exponent;
+                }
+                break;
+            }
+
+            case NumberState_Point:
+            case NumberState_Fraction:
+            {
+                if (digit)
+                {
+                    nextState = NumberState_Fraction;
+                }
+                else if ((state == NumberState_Fraction) && ((data == 'e') || (data == 'E')))
+                {
+                    nextState = NumberState_Exponent;
+                }
+                break;
+            }
+
+            case NumberState_Exponent:
+            {
+                if ((data == '+') || (data == '-'))
+                {
+                    nextState = NumberState_ExponentSign;
+                }
+                else if (digit)
+                {
+                    nextState = NumberState_ExponentDigits;
+                }
+                break;
+            }
+
+            case NumberState_ExponentSign:
+            case NumberState_ExponentDigits:
+            {
+                if (digit)
+                {
+                    nextState = NumberState_ExponentDigits;
+                }
+                break;
+            }
+
+            default:
+            {
+                // Error, invalid state
+                break;
+            }
+        }
+
+        if (nextState == NumberState_Error)
+        {
+            // End of number
+            finished = true;
+        }
+        else
+        {
+            state = nextState;
+            position++;
+        }
+    }
+
+    if (finished || m_inputFinished)
+    {
+        if ((state == NumberState_Zero) ||
+            (state == NumberState_Integer) ||
+            (state == NumberState_Fraction) ||
+            (state == NumberState_ExponentDigits))
+        {
+            m_token = Common::Utf8::toUnicodeString(m_inputData.substr(m_inputOffset,
+                                                                       position - m_inputOffset));
+            m_inputOffset = position;
+            tokenType = TokenType_Number;
+        }
+        else
+        {
+            // Error, invalid number
+            tokenType = TokenType_Error;
+        }
+    }
+
+    return tokenType;
+}
+
+/**
+ * Read literal
+ *
+ * \param literal   Literal ("true", "false" or "null")
+ * \param tokenType Type of the token
+ *
+ * \retval TokenType_None   Literal is not complete (more data is needed)
+ * \retval TokenType_Error  Invalid literal
+ * \return Type of the token if the literal was read
+ */
+XmlWriter::JsonConverter::TokenType XmlWriter::JsonConverter::readLiteral(
+        const char *literal,
+        const TokenType tokenType)
+{
+    TokenType result = tokenType;
+    size_t i = 0U;
+
+    while ((result == tokenType) && (literal[i] != '\0'))
+    {
+        if ((m_inputOffset + i) >= m_inputData.size())
+        {
+            // Literal is not complete
+            result = TokenType_None;
+        }
+        else if (m_inputData[m_inputOffset + i] != literal[i])
+        {
+            // Error, invalid literal
+            result = TokenType_Error;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    if (result == tokenType)
+    {
+        m_token = Common::Utf8::toUnicodeString(literal);
+        m_inputOffset += i;
+    }
+    else if ((result == TokenType_None) && m_inputFinished)
+    {
+        // Error, incomplete literal at the end of the document
+        result = TokenType_Error;
+    }
+    else
+    {
+    }
+
+    return result;
+}
+
+/**
+ * Read the 4 hex digits of an unicode escape sequence
+ *
+ * \param position  Position of the first hex digit in the input data
+ * \param value     Output for the value
+ *
+ * \retval true     Success
+ * \retval false    Error, hex digits are not available or invalid
+ */
+bool XmlWriter::JsonConverter::readHexValue(const size_t position, uint32_t *value) const
+{
+    bool success = ((position + 4U) <= m_inputData.size());
+    *value = 0U;
+
+    for (size_t i = position; success && (i < (position + 4U)); i++)
+    {
+        const char data = m_inputData[i];
+        uint32_t digit = 0U;
+
+        if ((data >= '0') && (data <= '9'))
+        {
+            digit = static_cast<uint32_t>(data - '0');
+        }
+        else if ((data >= 'a') && (data <= 'f'))
+        {
+            digit = static_cast<uint32_t>(data - 'a') + 10U;
+        }
+        else if ((data >= 'A') && (data <= 'F'))
+        {
+            digit = static_cast<uint32_t>(data - 'A') + 10U;
+        }
+        else
+        {
+            // Error, invalid hex digit
+            success = false;
+        }
+
+        *value = (*value << 4) | digit;
+    }
+
+    return success;
+}
+
+/**
+ * Process the token in the current state
+ *
+ * \param tokenType Type of the token
+ *
+ * \retval true     Success
+ * \retval false    Error, unexpected token or the token can not be converted
+ */
+bool XmlWriter::JsonConverter::processToken(const TokenType tokenType)
+{
+    bool success = false;
+
+    switch (m_state)
+    {
+        case State_Value:
+        case State_ValueOrEndOfArray:
+        {
+            if ((tokenType == TokenType_EndArray) && (m_state == State_ValueOrEndOfArray))
+            {
+                // Empty array
+                success = processEndOfContainer(tokenType);
+            }
+            else
+            {
+                success = processValue(tokenType);
+            }
+            break;
+        }
+
+        case State_KeyOrEndOfObject:
+        case State_Key:
+        {
+            if (tokenType == TokenType_String)
+            {
+                success = processKey();
+            }
+            else if ((tokenType == TokenType_EndObject) && (m_state == State_KeyOrEndOfObject))
+            {
+                // Empty object
+                success = processEndOfContainer(tokenType);
+            }
+            else
+            {
+                // Error, unexpected token
+            }
+            break;
+        }
+
+        case State_Colon:
+        {
+            if (tokenType == TokenType_Colon)
+            {
+                m_state = State_Value;
+                success = true;
+            }
+            break;
+        }
+
+        case State_CommaOrEnd:
+        {
+            if (tokenType == TokenType_Comma)
+            {
+                if (m_containerList.back().object)
+                {
+                    m_state = State_Key;
+                }
+                else
+                {
+                    m_state = State_Value;
+                }
+
+                success = true;
+            }
+            else if ((tokenType == TokenType_EndObject) || (tokenType == TokenType_EndArray))
+            {
+                success = processEndOfContainer(tokenType);
+            }
+            else
+            {
+                // Error, unexpected token
+            }
+            break;
+        }
+
+        default:
+        {
+            // Error, no token is expected after the end of the document
+            break;
+        }
+    }
+
+    return success;
+}
+
+/**
+ * Process the key of an object member
+ *
+ * \retval true     Success
+ * \retval false    Error, the key can not be converted to a XML name
+ */
+bool XmlWriter::JsonConverter::processKey()
+{
+    bool success = true;
+
+    if ((!m_textKey.empty()) && (m_token == m_textKey))
+    {
+        m_target = Target_Text;
+        m_name.clear();
+    }
+    else if ((m_attributePrefix != 0U) &&
+             (!m_token.empty()) &&
+             (m_token.at(0U) == m_attributePrefix))
+    {
+        m_target = Target_Attribute;
+        m_name = m_token.substr(1U);
+        success = isValidName(m_token, m_name);
+    }
+    else
+    {
+        m_target = Target_Element;
+        m_name = m_token;
+        success = isValidName(m_token, m_name);
+    }
+
+    m_state = State_Colon;
+    return success;
+}
+
+/**
+ * Process a value
+ *
+ * \param tokenType Type of the token
+ *
+ * \retval true     Success
+ * \retval false    Error, the token is not a value or it can not be converted
+ */
+bool XmlWriter::JsonConverter::processValue(const TokenType tokenType)
+{
+    bool success = false;
+    const bool scalar = ((tokenType == TokenType_String) ||
+                         (tokenType == TokenType_Number) ||
+                         (tokenType == TokenType_Boolean) ||
+                         (tokenType == TokenType_Null));
+    Target target = Target_Element;
+    Common::UnicodeString name = m_rootName;
+    bool objectMember = false;
+
+    if (!m_containerList.empty())
+    {
+        if (m_containerList.back().object)
+        {
+            target = m_target;
+            name = m_name;
+            objectMember = true;
+        }
+        else
+        {
+            // Array item
+            name = m_containerList.back().name;
+        }
+    }
+
+    if (tokenType == TokenType_Null)
+    {
+        m_token.clear();
+    }
+
+    switch (target)
+    {
+        case Target_Attribute:
+        {
+            Container &container = m_containerList.back();
+
+            if (scalar &&
+                (!container.startWritten) &&
+                (container.attributeList.attribute(name) == NULL))
+            {
+                container.attributeList.add(Common::Attribute(name, m_token));
+                success = true;
+            }
+            else
+            {
+                // Error, attribute value is not a scalar, it is after the content of the element
+                // or the attribute is duplicated
+            }
+            break;
+        }
+
+        case Target_Text:
+        {
+            if (scalar)
+            {
+                success = writePendingStartOfElement();
+
+                if (success && (!m_token.empty()))
+                {
+                    success = m_xmlWriter.writeTextNode(m_token);
+                }
+            }
+            break;
+        }
+
+        default:
+        {
+            success = writePendingStartOfElement();
+
+            if (success)
+            {
+                switch (tokenType)
+                {
+                    case TokenType_BeginObject:
+                    {
+                        Container container;
+                        container.object = true;
+                        container.wrapper = false;
+                        container.name = name;
+                        container.startWritten = false;
+                        m_containerList.push_back(container);
+                        m_state = State_KeyOrEndOfObject;
+                        break;
+                    }
+
+                    case TokenType_BeginArray:
+                    {
+                        Container container;
+                        container.object = false;
+                        container.wrapper = !objectMember;
+                        container.name = name;
+                        container.startWritten = true;
+
+                        if (container.wrapper)
+                        {
+                            // Array items are written inside of an element
+                            success = m_xmlWriter.writeStartOfElement(name);
+                            container.name = m_arrayItemName;
+                        }
+
+                        m_containerList.push_back(container);
+                        m_state = State_ValueOrEndOfArray;
+                        break;
+                    }
+
+                    case TokenType_Null:
+                    {
+                        success = m_xmlWriter.writeEmptyElement(name);
+                        break;
+                    }
+
+                    case TokenType_String:
+                    case TokenType_Number:
+                    case TokenType_Boolean:
+                    {
+                        success = m_xmlWriter.writeStartOfElement(name);
+
+                        if (success && (!m_token.empty()))
+                        {
+                            success = m_xmlWriter.writeTextNode(m_token);
+                        }
+
+                        if (success)
+                        {
+                            success = m_xmlWriter.writeEndOfElement();
+                        }
+                        break;
+                    }
+
+                    default:
+                    {
+                        // Error, token is not a value
+                        success = false;
+                        break;
+                    }
+                }
+            }
+            break;
+        }
+    }
+
+    if (success && scalar)
+    {
+        finishValue();
+    }
+
+    return success;
+}
+
+/**
+ * Process the end of an object or an array
+ *
+ * \param tokenType Type of the token
+ *
+ * \retval true     Success
+ * \retval false    Error, the token does not match the container or the element can not be written
+ */
+bool XmlWriter::JsonConverter::processEndOfContainer(const TokenType tokenType)
+{
+    bool success = false;
+    const Container &container = m_containerList.back();
+
+    if (container.object && (tokenType == TokenType_EndObject))
+    {
+        if (container.startWritten)
+        {
+            success = m_xmlWriter.writeEndOfElement();
+        }
+        else
+        {
+            // Object without elements and text nodes
+            success = m_xmlWriter.writeEmptyElement(container.name, container.attributeList);
+        }
+    }
+    else if ((!container.object) && (tokenType == TokenType_EndArray))
+    {
+        success = true;
+
+        if (container.wrapper)
+        {
+            success = m_xmlWriter.writeEndOfElement();
+        }
+    }
+    else
+    {
+        // Error, the token does not match the container
+    }
+
+    if (success)
+    {
+        m_containerList.pop_back();
+        finishValue();
+    }
+
+    return success;
+}
+
+/**
+ * Write the start of element of the current object if it was not written yet
+ *
+ * \retval true     Success
+ * \retval false    Error
+ */
+bool XmlWriter::JsonConverter::writePendingStartOfElement()
+{
+    bool success = true;
+
+    if (!m_containerList.empty())
+    {
+        Container &container = m_containerList.back();
+
+        if (!container.startWritten)
+        {
+            success = m_xmlWriter.writeStartOfElement(container.name, container.attributeList);
+            container.startWritten = true;
+            container.attributeList.clear();
+        }
+    }
+
+    return success;
+}
+
+/**
+ * Select the next state after a value
+ */
+void XmlWriter::JsonConverter::finishValue()
+{
+    if (m_containerList.empty())
+    {
+        m_state = State_EndOfDocument;
+    }
+    else
+    {
+        m_state = State_CommaOrEnd;
+    }
+}
+
+/**
+ * Check if the name generated from the key is a valid XML name
+ *
+ * \param key   Key of the object member
+ * \param name  Name generated from the key
+ *
+ * \retval true     Valid name
+ * \retval false    Invalid name
+ *
+ * \note The result is stored in the name cache (indexed with the hash of the key), so the name is
+ *       validated again only if the key was evicted from the cache.
+ */
+bool XmlWriter::JsonConverter::isValidName(const Common::UnicodeString &key,
+                                           const Common::UnicodeString &name)
+{
+    bool valid = false;
+
+    if (m_nameCache.empty())
+    {
+        m_nameValidationCount++;
+        valid = XmlValidator::validateName(name);
+    }
+    else
+    {
+        const uint32_t hash = Common::HashIndex::calculateHash(key);
+        NameCacheEntry &entry = m_nameCache[hash & (m_nameCache.size() - 1U)];
+
+        if (entry.used && (entry.key == key))
+        {
+            valid = entry.valid;
+        }
+        else
+        {
+            m_nameValidationCount++;
+            valid = XmlValidator::validateName(name);
+
+            entry.used = true;
+            entry.valid = valid;
+            entry.key = key;
+        }
+    }
+
+    return valid;
+}
+
+/**
+ * Clear the name cache
+ */
+void XmlWriter::JsonConverter::clearNameCache()
+{
+    for (size_t i = 0U; i < m_nameCache.size(); i++)
+    {
+        m_nameCache[i].used = false;
+        m_nameCache[i].valid = false;
+        m_nameCache[i].key.clear();
+    }
+}
+
+/**
+ * Move the XML data from the XML writer to the output
+ */
+void XmlWriter::JsonConverter::moveOutput()
+{
+    const Common::UnicodeString xmlString = m_xmlWriter.xmlString();
+
+    if (!xmlString.empty())
+    {
+        m_output.append(Common::Utf8::toUtf8(xmlString));
+        m_xmlWriter.clearXmlString();
+    }
+}
@@ -0,0 +1,525 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include <EmbeddedStAX/XmlWriter/XmlTemplate.h>
+#include <EmbeddedStAX/XmlWriter/XmlWriter.h>
+#include <EmbeddedStAX/XmlReader/XmlReader.h>
+#include <EmbeddedStAX/XmlValidator/Common.h>
+#include <EmbeddedStAX/XmlValidator/Name.h>
+
+using namespace EmbeddedStAX;
+
+/**
+ * Constructor
+ */
+XmlWriter::XmlTemplate::XmlTemplate()
+    : m_compiled(false),
+      m_staticData(),
+      m_segmentStart(0U),
+      m_segmentList(),
+      m_holeNameList(),
+      m_holeTypeList()
+{
+}
+
+/**
+ * Destructor
+ */
+XmlWriter::XmlTemplate::~XmlTemplate()
+{
+}
+
+/**
+ * Clear the template
+ */
+void XmlWriter::XmlTemplate::clear()
+{
+    m_compiled = false;
+    m_staticData.clear();
+    m_segmentStart = 0U;
+    m_segmentList.clear();
+    m_holeNameList.clear();
+    m_holeTypeList.clear();
+}
+
+/**
+ * Compile the template from the skeleton
+ *
+ * \param skeleton  Skeleton of the template (UTF-8 encoded XML document with holes)
+ *
+ * \retval true     Success
+ * \retval false    Error, the skeleton is not a complete and well-formed XML document, a hole is
+ *                  not terminated, a hole name is not a valid name or the same hole is used in a
+ *                  text node and in an attribute value
+ *
+ * \note The markup of the skeleton is copied as it is, only the holes and the escaped "$${" are
+ *       replaced. Holes in CDATA sections, comments and processing instructions are not supported
+ *       (they are copied as they are).
+ */
+bool XmlWriter::XmlTemplate::compile(const std::string &skeleton)
+{
+    clear();
+
+    XmlReader::XmlReader xmlReader;
+    bool success = (xmlReader.writeData(skeleton) == skeleton.size());
+    bool finished = !success;
+    bool rootElementRead = false;
+    size_t depth = 0U;
+    size_t copiedOffset = 0U;
+    size_t eventStart = 0U;
+
+    while (!finished)
+    {
+        const XmlReader::XmlReader::ParsingResult result = xmlReader.parse();
+        const size_t eventEnd = xmlReader.byteOffset();
+
+        switch (result)
+        {
+            case XmlReader::XmlReader::ParsingResult_NeedMoreData:
+            {
+                // End of the skeleton, the root element has to be closed
+                success = (rootElementRead && (depth == 0U));
+                finished = true;
+                break;
+            }
+
+            case XmlReader::XmlReader::ParsingResult_StartOfElement:
+            {
+                // Token starts at the last '<' character (there is no '<' inside of a tag)
+                const size_t tokenStart = skeleton.rfind('<', eventEnd - 1U);
+                const std::string token = skeleton.substr(tokenStart, eventEnd - tokenStart);
+                rootElementRead = true;
+                depth++;
+
+                if (containsHole(token))
+                {
+                    m_staticData.append(skeleton, copiedOffset, tokenStart - copiedOffset);
+                    success = compileMarkup(token, HoleType_AttributeValue);
+                    copiedOffset = eventEnd;
+                }
+                break;
+            }
+
+            case XmlReader::XmlReader::ParsingResult_EndOfElement:
+            {
+                depth--;
+                break;
+            }
+
+            case XmlReader::XmlReader::ParsingResult_TextNode:
+            {
+                const std::string text = skeleton.substr(eventStart, eventEnd - eventStart);
+
+                if (containsHole(text))
+                {
+                    m_staticData.append(skeleton, copiedOffset, eventStart - copiedOffset);
+                    success = compileMarkup(text, HoleType_Text);
+                    copiedOffset = eventEnd;
+                }
+                break;
+            }
+
+            case XmlReader::XmlReader::ParsingResult_Error:
+            {
+                // Error, invalid skeleton
+                success = false;
+                break;
+            }
+
+            default:
+            {
+                // Other events are copied from the skeleton
+                break;
+            }
+        }
+
+        if (!success)
+        {
+            finished = true;
+        }
+
+        eventStart = eventEnd;
+    }
+
+    if (success)
+    {
+        // Copy the rest of the skeleton and finish the last segment
+        m_staticData.append(skeleton, copiedOffset, std::string::npos);
+
+        Segment segment;
+        segment.size = m_staticData.size() - m_segmentStart;
+        segment.holeIndex = Common::UnicodeString::npos;
+        segment.quotationMark = Common::QuotationMark_None;
+        m_segmentList.push_back(segment);
+
+        m_segmentStart = m_staticData.size();
+        m_compiled = true;
+    }
+    else
+    {
+        clear();
+    }
+
+    return success;
+}
+
+/**
+ * Check if the template is compiled
+ *
+ * \retval true     Template is compiled
+ * \retval false    Template is not compiled
+ */
+bool XmlWriter::XmlTemplate::isCompiled() const
+{
+    return m_compiled;
+}
+
+/**
+ * Get number of holes
+ *
+ * \return Number of holes (a hole that is used more than once is counted only once)
+ */
+size_t XmlWriter::XmlTemplate::holeCount() const
+{
+    return m_holeNameList.size();
+}
+
+/**
+ * Find hole
+ *
+ * \param name  Name of the hole
+ *
+ * \return Index of the hole or Common::UnicodeString::npos if the hole does not exist
+ */
+size_t XmlWriter::XmlTemplate::findHole(const Common::UnicodeString &name) const
+{
+    size_t index = Common::UnicodeString::npos;
+
+    for (size_t i = 0U; (index == Common::UnicodeString::npos) && (i < m_holeNameList.size()); i++)
+    {
+        if (m_holeNameList.at(i) == name)
+        {
+            index = i;
+        }
+    }
+
+    return index;
+}
+
+/**
+ * Get name of the hole
+ *
+ * \param index Index of the hole
+ *
+ * \return Name of the hole or an empty string if the index is not valid
+ */
+Common::UnicodeString XmlWriter::XmlTemplate::holeName(const size_t index) const
+{
+    Common::UnicodeString name;
+
+    if (index < m_holeNameList.size())
+    {
+        name = m_holeNameList.at(index);
+    }
+
+    return name;
+}
+
+/**
+ * Get type of the hole
+ *
+ * \param index Index of the hole
+ *
+ * \return Type of the hole (HoleType_Text if the index is not valid)
+ */
+XmlWriter::XmlTemplate::HoleType XmlWriter::XmlTemplate::holeType(const size_t index) const
+{
+    HoleType type = HoleType_Text;
+
+    if (index < m_holeTypeList.size())
+    {
+        type = m_holeTypeList.at(index);
+    }
+
+    return type;
+}
+
+/**
+ * Get size of the static data
+ *
+ * \return Number of bytes of the static data that are copied to the output for each document
+ */
+size_t XmlWriter::XmlTemplate::staticSize() const
+{
+    return m_staticData.size();
+}
+
+/**
+ * Render a document
+ *
+ * \param valueList Values of the holes (indexed with the hole index)
+ * \param output    Output for the document (UTF-8 encoded, it is appended)
+ *
+ * \retval true     Success
+ * \retval false    Error, template is not compiled, number of values does not match the number of
+ *                  holes or a value contains a character that is not allowed in XML
+ *
+ * \note On error the output is left unchanged.
+ */
+bool XmlWriter::XmlTemplate::render(const std::vector<Common::UnicodeString> &valueList,
+                                    std::string *output) const
+{
+    bool success = (m_compiled && (output != NULL) && (valueList.size() == m_holeNameList.size()));
+
+    if (success)
+    {
+        const size_t outputSize = output->size();
+        size_t offset = 0U;
+        output->reserve(outputSize + m_staticData.size());
+
+        for (size_t i = 0U; success && (i < m_segmentList.size()); i++)
+        {
+            // Copy the static data and write the value of the hole after it
+            const Segment &segment = m_segmentList[i];
+            output->append(m_staticData, offset, segment.size);
+            offset += segment.size;
+
+            if (segment.holeIndex != Common::UnicodeString::npos)
+            {
+                success = appendValue(valueList[segment.holeIndex], segment.quotationMark, output);
+            }
+        }
+
+        if (!success)
+        {
+            output->resize(outputSize);
+        }
+    }
+
+    return success;
+}
+
+/**
+ * Compile markup with holes
+ *
+ * \param markup    Markup from the skeleton (a text node or a start of element token)
+ * \param holeType  Type of the holes in the markup
+ *
+ * \retval true     Success
+ * \retval false    Error, invalid hole
+ *
+ * \note In a start of element token the holes can only be in the attribute values (a '$' character
+ *       is not allowed in a name), the quotation mark of the attribute value is tracked so the
+ *       values of the holes are escaped for it.
+ */
+bool XmlWriter::XmlTemplate::compileMarkup(const std::string &markup, const HoleType holeType)
+{
+    bool success = true;
+    Common::QuotationMark quotationMark = Common::QuotationMark_None;
+    size_t position = 0U;
+
+    while (success && (position < markup.size()))
+    {
+        const char character = markup.at(position);
+
+        if ((holeType == HoleType_AttributeValue) && ((character == '"') || (character == '\'')))
+        {
+            // Start or end of an attribute value
+            if (quotationMark == Common::QuotationMark_None)
+            {
+                quotationMark = (character == '"') ? Common::QuotationMark_Quote :
+                                                     Common::QuotationMark_Apostrophe;
+            }
+            else if (((quotationMark == Common::QuotationMark_Quote) && (character == '"')) ||
+                     ((quotationMark == Common::QuotationMark_Apostrophe) && (character == '\'')))
+            {
+                quotationMark = Common::QuotationMark_None;
+            }
+            else
+            {
+                // Other quotation mark inside of the attribute value
+            }
+
+            m_staticData.push_back(character);
+            position++;
+        }
+        else if (markup.compare(position, 3U, "$${") == 0)
+        {
+            // Escaped "${"
+            m_staticData.append("${");
+            position += 3U;
+        }
+        else if (markup.compare(position, 2U, "${") == 0)
+        {
+            // Hole found
+            const size_t endPosition = markup.find('}', position + 2U);
+
+            if (endPosition == std::string::npos)
+            {
+                // Error, hole is not terminated
+                success = false;
+            }
+            else
+            {
+                const std::string name = markup.substr(position + 2U, endPosition - position - 2U);
+                success = addHole(Common::Utf8::toUnicodeString(name), holeType, quotationMark);
+                position = endPosition + 1U;
+
+                if (holeType == HoleType_Text)
+                {
+                    // Value of the hole can end with "]]", so a '>' right after it is escaped
+                    if (markup.compare(position, 1U, ">") == 0)
+                    {
+                        m_staticData.append("&gt;");
+                        position++;
+                    }
+                    else if (markup.compare(position, 2U, "]>") == 0)
+                    {
+                        m_staticData.append("]&gt;");
+                        position += 2U;
+                    }
+                    else
+                    {
+                        // No '>' after the hole
+                    }
+                }
+            }
+        }
+        else
+        {
+            m_staticData.push_back(character);
+            position++;
+        }
+    }
+
+    return success;
+}
+
+/**
+ * Add a hole after the static data
+ *
+ * \param name          Name of the hole
+ * \param holeType      Type of the hole
+ * \param quotationMark Quotation mark of the attribute value (QuotationMark_None for a text node)
+ *
+ * \retval true     Success
+ * \retval false    Error, invalid name or the hole is already used with a different type
+ */
+bool XmlWriter::XmlTemplate::addHole(const Common::UnicodeString &name,
+                                     const HoleType holeType,
+                                     const Common::QuotationMark quotationMark)
+{
+    bool success = false;
+
+    if (XmlValidator::validateName(name))
+    {
+        size_t holeIndex = findHole(name);
+
+        if (holeIndex == Common::UnicodeString::npos)
+        {
+            holeIndex = m_holeNameList.size();
+            m_holeNameList.push_back(name);
+            m_holeTypeList.push_back(holeType);
+            success = true;
+        }
+        else if (m_holeTypeList.at(holeIndex) == holeType)
+        {
+            // Hole is used again
+            success = true;
+        }
+        else
+        {
+            // Error, hole is already used with a different type
+        }
+
+        if (success)
+        {
+            // Finish the segment with the hole
+            Segment segment;
+            segment.size = m_staticData.size() - m_segmentStart;
+            segment.holeIndex = holeIndex;
+            segment.quotationMark = quotationMark;
+            m_segmentList.push_back(segment);
+
+            m_segmentStart = m_staticData.size();
+        }
+    }
+
+    return success;
+}
+
+/**
+ * Check if markup contains a hole
+ *
+ * \param markup    Markup
+ *
+ * \retval true     Markup contains "${"
+ * \retval false    Markup does not contain a hole
+ */
+bool XmlWriter::XmlTemplate::containsHole(const std::string &markup)
+{
+    return (markup.find("${") != std::string::npos);
+}
+
+/**
+ * Escape the value and append it to the output (UTF-8 encoded)
+ *
+ * \param value         Value
+ * \param quotationMark Quotation mark of the attribute value (QuotationMark_None for a text node)
+ * \param output        Output
+ *
+ * \retval true     Success
+ * \retval false    Error, value contains a character that is not allowed in XML
+ *
+ * \note The value is escaped with the same rules as the values written by XmlWriter.
+ */
+bool XmlWriter::XmlTemplate::appendValue(const Common::UnicodeString &value,
+                                         const Common::QuotationMark quotationMark,
+                                         std::string *output)
+{
+    bool success = true;
+
+    for (size_t i = 0U; success && (i < value.size()); i++)
+    {
+        success = XmlValidator::isChar(value[i]);
+    }
+
+    if (success)
+    {
+        if (quotationMark == Common::QuotationMark_None)
+        {
+            output->append(Common::Utf8::toUtf8(XmlWriter::escapeTextNode(value)));
+        }
+        else
+        {
+            output->append(Common::Utf8::toUtf8(XmlWriter::escapeAttributeValue(value,
+                                                                               quotationMark)));
+        }
+    }
+
+    return success;
+}
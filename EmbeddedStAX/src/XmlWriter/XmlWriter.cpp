@@ -40,6 +40,7 @@ using namespace EmbeddedStAX;
  * Constructor
  */
 XmlWriter::XmlWriter::XmlWriter()
+    : m_nameValidation(true)
 {
     clearDocument();
 }
@@ -50,7 +51,9 @@ XmlWriter::XmlWriter::XmlWriter()
 void XmlWriter::XmlWriter::clearDocument()
 {
     m_state = State_Empty;
-    m_documentType;
+    m_fragment = false;
+    m_fragmentDepth = 0U;
+    m_documentType.clear();
     m_openedElementList.clear();
     m_xmlString.clear();
 }
@@ -66,6 +69,119 @@ Common::UnicodeString XmlWriter::XmlWriter::xmlString() const
     return m_xmlString;
 }
 
+/**
+ * Clear the XML string that was already written
+ *
+ * The state of the document is kept, so a large document can be written in parts: the written XML
+ * string is taken from the writer (for example with xmlString()) and cleared before the next part
+ * is written.
+ */
+void XmlWriter::XmlWriter::clearXmlString()
+{
+    m_xmlString.clear();
+}
+
+/**
+ * Check if validation of element and attribute names is enabled
+ *
+ * \retval true     Names are validated
+ * \retval false    Names are not validated
+ */
+bool XmlWriter::XmlWriter::isNameValidationEnabled() const
+{
+    return m_nameValidation;
+}
+
+/**
+ * Enable or disable validation of element and attribute names
+ *
+ * \param enabled   Validate names
+ *
+ * \note Validation should only be disabled if the names are already validated by the caller (for
+ *       example names that are validated once and then written many times).
+ */
+void XmlWriter::XmlWriter::setNameValidationEnabled(const bool enabled)
+{
+    m_nameValidation = enabled;
+}
+
+/**
+ * Start writing a fragment
+ *
+ * \param depth    Depth of the parent element of the fragment in the document (number of elements
+ *                  that are open in the parent document when the fragment is spliced into it)
+ *
+ * \retval true     Success
+ * \retval false    Error, invalid depth (a fragment can only be written inside of an element)
+ *
+ * \note The previous document or fragment is cleared. The fragment can contain any number of
+ *       elements, text nodes, CDATA sections, comments and processing instructions, but not the
+ *       XML declaration or the document type.
+ */
+bool XmlWriter::XmlWriter::startFragment(const size_t depth)
+{
+    bool success = false;
+    clearDocument();
+
+    if (depth > 0U)
+    {
+        m_state = State_Fragment;
+        m_fragment = true;
+        m_fragmentDepth = depth;
+        success = true;
+    }
+    else
+    {
+        // Error, invalid depth
+        m_state = State_Error;
+    }
+
+    return success;
+}
+
+/**
+ * Check if a fragment is written
+ *
+ * \retval true     Fragment is written
+ * \retval false    Document is written
+ */
+bool XmlWriter::XmlWriter::isFragment() const
+{
+    return m_fragment;
+}
+
+/**
+ * Check if the fragment is complete (it can be spliced into the parent document)
+ *
+ * \retval true     Fragment is complete
+ * \retval false    Fragment is not complete (an element is still open, an error occurred or a
+ *                  document is written)
+ */
+bool XmlWriter::XmlWriter::isFragmentComplete() const
+{
+    return (m_fragment && (m_state == State_Fragment));
+}
+
+/**
+ * Get depth of the parent element of the fragment
+ *
+ * \return Depth of the parent element of the fragment (0 if a document is written)
+ */
+size_t XmlWriter::XmlWriter::fragmentDepth() const
+{
+    return m_fragmentDepth;
+}
+
+/**
+ * Get current depth
+ *
+ * \return Number of open elements in the document (including the parent elements of a fragment)
+ */
+size_t XmlWriter::XmlWriter::depth() const
+{
+    return (m_fragmentDepth + m_openedElementList.size());
+}
+
 /**
  * Write XML Declaration in the XML document
  *
@@ -167,6 +283,7 @@ bool XmlWriter::XmlWriter::writeComment(const Common::UnicodeString &commentText
             case State_DocumentStarted:
             case State_Element:
             case State_DocumentEnded:
+            case State_Fragment:
             {
                 success = true;
                 break;
@@ -225,6 +342,7 @@ bool XmlWriter::XmlWriter::writeProcessingInstruction(const Common::ProcessingIn
             case State_DocumentStarted:
             case State_Element:
             case State_DocumentEnded:
+            case State_Fragment:
             {
                 success = true;
                 break;
@@ -281,7 +399,7 @@ bool XmlWriter::XmlWriter::writeEmptyElement(const Common::UnicodeString &elemen
     bool success = false;
     State nextState = State_Error;
 
-    if (XmlValidator::validateName(elementName))
+    if (validateName(elementName))
     {
         switch (m_state)
         {
@@ -317,10 +435,11 @@ bool XmlWriter::XmlWriter::writeEmptyElement(const Common::UnicodeString &elemen
             }
 
             case State_Element:
+            case State_Fragment:
             {
                 // Child element
                 success = true;
-                nextState = State_Element;
+                nextState = m_state;
                 break;
             }
 
@@ -374,7 +493,7 @@ bool XmlWriter::XmlWriter::writeStartOfElement(const Common::UnicodeString &elem
 {
     bool success = false;
 
-    if (XmlValidator::validateName(elementName))
+    if (validateName(elementName))
     {
         switch (m_state)
         {
@@ -408,6 +527,7 @@ bool XmlWriter::XmlWriter::writeStartOfElement(const Common::UnicodeString &elem
             }
 
             case State_Element:
+            case State_Fragment:
             {
                 // Child element
                 success = true;
@@ -462,7 +582,7 @@ bool XmlWriter::XmlWriter::writeTextNode(const Common::UnicodeString &text)
 {
     bool success = false;
 
-    if (m_state == State_Element)
+    if ((m_state == State_Element) || (m_state == State_Fragment))
     {
         const Common::UnicodeString escapedText = escapeTextNode(text);
 
@@ -502,7 +622,7 @@ bool XmlWriter::XmlWriter::writeCDataSection(const Common::UnicodeString &cdata)
 {
     bool success = false;
 
-    if (m_state == State_Element)
+    if ((m_state == State_Element) || (m_state == State_Fragment))
     {
         if (XmlValidator::validateCDataSection(cdata))
         {
@@ -550,10 +670,17 @@ bool XmlWriter::XmlWriter::writeEndOfElement()
             m_openedElementList.pop_back();
             m_xmlString.push_back(static_cast<uint32_t>('>'));
 
-            // Check for end of root element
+            // Check for end of root element (or end of the top level element of a fragment)
             if (m_openedElementList.empty())
             {
-                m_state = State_DocumentEnded;
+                if (m_fragment)
+                {
+                    m_state = State_Fragment;
+                }
+                else
+                {
+                    m_state = State_DocumentEnded;
+                }
             }
 
             success = true;
@@ -569,6 +696,47 @@ bool XmlWriter::XmlWriter::writeEndOfElement()
     return success;
 }
 
+/**
+ * Splice a fragment into the XML document
+ *
+ * \param fragment  Complete fragment
+ *
+ * \retval true     Success
+ * \retval false    Error, fragment is not complete or it was written for a different depth
+ *
+ * \note The fragment was already validated when it was written, so it is copied without validation.
+ *       Fragments have to be spliced in the document order.
+ */
+bool XmlWriter::XmlWriter::writeFragment(const XmlWriter &fragment)
+{
+    bool success = false;
+
+    if ((m_state == State_Element) || (m_state == State_Fragment))
+    {
+        if (fragment.isFragmentComplete() && (fragment.fragmentDepth() == depth()))
+        {
+            m_xmlString.append(fragment.m_xmlString);
+            success = true;
+        }
+        else
+        {
+            // Error, invalid fragment
+        }
+    }
+    else
+    {
+        // Error, invalid state
+    }
+
+    if (!success)
+    {
+        // Error
+        m_state = State_Error;
+    }
+
+    return success;
+}
+
 /**
  * Write Attribute List in the XML document
  *
@@ -594,7 +762,7 @@ bool XmlWriter::XmlWriter::writeAttributeList(const Common::AttributeList &attri
             const Common::UnicodeString escapedValue = escapeAttributeValue(attribute.value(),
                                                                             quotationMark);
 
-            if (XmlValidator::validateName(name) &&
+            if (validateName(name) &&
                 XmlValidator::validateAttributeValue(escapedValue, quotationMark) &&
                 ((quotationMark == Common::QuotationMark_Quote) ||
                  (quotationMark == Common::QuotationMark_Apostrophe)))
@@ -627,18 +795,20 @@ bool XmlWriter::XmlWriter::writeAttributeList(const Common::AttributeList &attri
  * \param quotationMark     Attribute value's quotation mark
  *
  * \return Escaped string
+ *
+ * \note The whitespace characters are written as character references, so they are not
+ *       normalized to spaces when the attribute value is read.
  */
 Common::UnicodeString XmlWriter::XmlWriter::escapeAttributeValue(
         const Common::UnicodeString &attributeValue,
-        const Common::QuotationMark quotationMark) const
+        const Common::QuotationMark quotationMark)
 {
     Common::UnicodeString escapedValue;
     escapedValue.reserve(attributeValue.size());
 
-    bool finished = false;
     size_t position = 0U;
 
-    while ((position < attributeValue.size()) && !finished)
+    while (position < attributeValue.size())
     {
         // Check if valid attribute value character
         const uint32_t uchar = attributeValue.at(position);
@@ -659,7 +829,6 @@ Common::UnicodeString XmlWriter::XmlWriter::escapeAttributeValue(
                 {
                     // Escape the '"' character
                     escapedValue.append(Common::Utf8::toUnicodeString("&quot;"));
-                    finished = true;
                 }
                 else
                 {
@@ -677,7 +846,6 @@ Common::UnicodeString XmlWriter::XmlWriter::escapeAttributeValue(
                 {
                     // Escape the '\'' character
                     escapedValue.append(Common::Utf8::toUnicodeString("&apos;"));
-                    finished = true;
                 }
                 else
                 {
@@ -697,6 +865,30 @@ Common::UnicodeString XmlWriter::XmlWriter::escapeAttributeValue(
                 break;
             }
 
+            case 0x09U:
+            {
+                // Escape tab character
+                escapedValue.append(Common::Utf8::toUnicodeString("&#9;"));
+                position++;
+                break;
+            }
+
+            case 0x0AU:
+            {
+                // Escape line feed character
+                escapedValue.append(Common::Utf8::toUnicodeString("&#10;"));
+                position++;
+                break;
+            }
+
+            case 0x0DU:
+            {
+                // Escape carriage return character
+                escapedValue.append(Common::Utf8::toUnicodeString("&#13;"));
+                position++;
+                break;
+            }
+
             default:
             {
                 // Valid character
@@ -716,8 +908,13 @@ Common::UnicodeString XmlWriter::XmlWriter::escapeAttributeValue(
  * \param text  Text to escape
  *
  * \return Escaped string
+ *
+ * \note A '>' character at the start of the text (also after a single ']' character) is escaped,
+ *       because the text written before it can end with "]]". The carriage return character is
+ *       written as a character reference, so it is not normalized to a line feed when the text is
+ *       read.
  */
-Common::UnicodeString XmlWriter::XmlWriter::escapeTextNode(const Common::UnicodeString &text) const
+Common::UnicodeString XmlWriter::XmlWriter::escapeTextNode(const Common::UnicodeString &text)
 {
     Common::UnicodeString escapedValue;
     escapedValue.reserve(text.size());
@@ -751,15 +948,21 @@ Common::UnicodeString XmlWriter::XmlWriter::escapeTextNode(const Common::Unicode
             case static_cast<uint32_t>('>'):
             {
                 // Check if '>' character needs to be escaped (only if part of ']]>' sequence)
-                bool escapeChar = false;
+                bool escapeChar = true;
 
                 if (position >= 2U)
                 {
                     // Check for ']]>' sequence
-                    if (Common::compareUnicodeString(position - 2U, text, "]]"))
-                    {
-                        escapeChar = true;
-                    }
+                    escapeChar = Common::compareUnicodeString(position - 2U, text, "]]");
+                }
+                else if (position == 1U)
+                {
+                    // Check for ']>' sequence after a text that ends with ']'
+                    escapeChar = (text.at(0U) == static_cast<uint32_t>(']'));
+                }
+                else
+                {
+                    // Start of the text, the text before it can end with "]]"
                 }
 
                 if (escapeChar)
@@ -776,6 +979,14 @@ Common::UnicodeString XmlWriter::XmlWriter::escapeTextNode(const Common::Unicode
                 break;
             }
 
+            case 0x0DU:
+            {
+                // Escape carriage return character
+                escapedValue.append(Common::Utf8::toUnicodeString("&#13;"));
+                position++;
+                break;
+            }
+
             default:
             {
                 // Valid character
@@ -788,3 +999,23 @@ Common::UnicodeString XmlWriter::XmlWriter::escapeTextNode(const Common::Unicode
 
     return escapedValue;
 }
+
+/**
+ * Validate element or attribute name
+ *
+ * \param name  Name
+ *
+ * \retval true     Valid name (or name validation is disabled)
+ * \retval false    Invalid name
+ */
+bool XmlWriter::XmlWriter::validateName(const Common::UnicodeString &name) const
+{
+    bool valid = true;
+
+    if (m_nameValidation)
+    {
+        valid = XmlValidator::validateName(name);
+    }
+
+    return valid;
+}
@@ -0,0 +1,162 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include "FuzzBudget.h"
+#include <cstdio>
+#include <cstdlib>
+#include <time.h>
+
+using namespace Fuzz;
+
+/**
+ * Read a budget value from an environment variable
+ *
+ * \param name          Name of the environment variable
+ * \param defaultValue  Value that is used if the variable is not set
+ *
+ * \return Budget value
+ */
+static uint64_t budgetFromEnvironment(const char *name, const uint64_t defaultValue)
+{
+    uint64_t value = defaultValue;
+    const char *text = std::getenv(name);
+
+    if (text != NULL)
+    {
+        value = static_cast<uint64_t>(std::strtoull(text, NULL, 10));
+    }
+
+    return value;
+}
+
+/**
+ * Constructor
+ *
+ * \param inputSize Size of the input (in bytes)
+ */
+TimeBudget::TimeBudget(const size_t inputSize)
+    : m_startTime(monotonicTimeUs()),
+      m_budget(0U)
+{
+    static const uint64_t baseBudget =
+            budgetFromEnvironment("EMBEDDEDSTAX_FUZZ_BASE_BUDGET_US", 20000U);
+    static const uint64_t byteBudget =
+            budgetFromEnvironment("EMBEDDEDSTAX_FUZZ_BYTE_BUDGET_US", 5U);
+
+    m_budget = baseBudget + (byteBudget * static_cast<uint64_t>(inputSize));
+}
+
+/**
+ * Check if the time budget was exceeded
+ *
+ * \param stage Name of the stage that is being checked (used in the report)
+ *
+ * \note Process is aborted if the budget was exceeded
+ */
+void TimeBudget::check(const char *stage) const
+{
+    const uint64_t elapsedTime = monotonicTimeUs() - m_startTime;
+
+    if (elapsedTime > m_budget)
+    {
+        std::fprintf(stderr,
+                     "==%s== Time budget exceeded: %llu us (budget: %llu us)\n",
+                     stage,
+                     static_cast<unsigned long long>(elapsedTime),
+                     static_cast<unsigned long long>(m_budget));
+        std::abort();
+    }
+}
+
+/**
+ * Constructor
+ *
+ * \param data  Input data
+ * \param size  Size of the input data
+ */
+ChunkSchedule::ChunkSchedule(const uint8_t *data, const size_t size)
+    : m_state(2166136261U)
+{
+    // FNV-1a hash of the input is used as the seed
+    for (size_t i = 0U; i < size; i++)
+    {
+        m_state = (m_state ^ static_cast<uint32_t>(data[i])) * 16777619U;
+    }
+
+    if (m_state == 0U)
+    {
+        // Xorshift state must not be zero
+        m_state = 1U;
+    }
+}
+
+/**
+ * Get size of the next chunk
+ *
+ * \param remainingSize Number of bytes that were not written yet
+ *
+ * \return Size of the next chunk (1 to remainingSize bytes, or 0 if remainingSize is 0)
+ *
+ * \note Most chunks are small (1 to 16 bytes) to stress the "need more data" paths of the token
+ *       parsers, but sometimes the whole remaining input is written at once to stress the paths
+ *       that work with large buffers.
+ */
+size_t ChunkSchedule::nextChunkSize(const size_t remainingSize)
+{
+    size_t chunkSize = remainingSize;
+
+    // Xorshift
+    m_state ^= m_state << 13;
+    m_state ^= m_state >> 17;
+    m_state ^= m_state << 5;
+
+    if ((m_state % 8U) != 0U)
+    {
+        chunkSize = 1U + static_cast<size_t>((m_state >> 8) % 16U);
+
+        if (chunkSize > remainingSize)
+        {
+            chunkSize = remainingSize;
+        }
+    }
+
+    return chunkSize;
+}
+
+/**
+ * Get monotonic time
+ *
+ * \return Monotonic time in microseconds
+ */
+uint64_t Fuzz::monotonicTimeUs()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (static_cast<uint64_t>(time.tv_sec) * 1000000U) +
+           (static_cast<uint64_t>(time.tv_nsec) / 1000U);
+}
@@ -0,0 +1,82 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#ifndef EMBEDDEDSTAX_FUZZ_FUZZBUDGET_H
+#define EMBEDDEDSTAX_FUZZ_FUZZBUDGET_H
+
+#include <cstddef>
+#include <stdint.h>
+
+namespace Fuzz
+{
+/**
+ * Time budget for a single fuzzer input
+ *
+ * The budget grows linearly with the size of the input, so an input that makes the parser (or the
+ * writer) do superlinear work exceeds it and is reported as a failure (the process is aborted so
+ * that the fuzzer saves the input as a crash).
+ *
+ * Default budget is 20 ms + 5 us per byte. It can be changed with the environment variables
+ * EMBEDDEDSTAX_FUZZ_BASE_BUDGET_US and EMBEDDEDSTAX_FUZZ_BYTE_BUDGET_US.
+ */
+class TimeBudget
+{
+public:
+    // Public API
+    explicit TimeBudget(const size_t inputSize);
+
+    void check(const char *stage) const;
+
+private:
+    // Private data
+    uint64_t m_startTime;
+    uint64_t m_budget;
+};
+
+/**
+ * Pseudo random chunk split schedule for the input data
+ *
+ * The schedule is seeded from the input data itself so that the same input is always split in the
+ * same way (which is needed to reproduce failures), while mutated inputs get different splits.
+ */
+class ChunkSchedule
+{
+public:
+    // Public API
+    ChunkSchedule(const uint8_t *data, const size_t size);
+
+    size_t nextChunkSize(const size_t remainingSize);
+
+private:
+    // Private data
+    uint32_t m_state;
+};
+
+uint64_t monotonicTimeUs();
+}
+
+#endif // EMBEDDEDSTAX_FUZZ_FUZZBUDGET_H
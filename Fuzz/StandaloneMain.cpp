@@ -0,0 +1,343 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+/*
+ * Standalone driver for the fuzz targets, used when the compiler does not support libFuzzer.
+ *
+ * It runs the fuzz target on all the given files (directories are read recursively) and then
+ * optionally on randomly mutated corpus inputs. The options use the same syntax as libFuzzer:
+ *
+ *   -runs=<N>          Number of mutated inputs (default: 0)
+ *   -max_len=<N>       Maximum size of a mutated input (default: 4096)
+ *   -seed=<N>          Seed of the mutations (default: current time)
+ *   -timeout=<N>       Hard timeout for a single input in seconds (default: 10)
+ *   -rss_limit_mb=<N>  Address space limit in MB (default: 2048, 0 disables the limit)
+ *
+ * When an input fails it is written to the file "crash-standalone" in the working directory.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdint.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+typedef std::vector<uint8_t> Input;
+
+static const Input *s_currentInput = NULL;
+
+/**
+ * Write the current input to a file when the fuzz target fails
+ */
+static void handleFailure(int signalNumber)
+{
+    static const char message[] = "==Standalone== Input failed, written to crash-standalone\n";
+    const int fd = open("crash-standalone", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if ((fd >= 0) && (s_currentInput != NULL) && !s_currentInput->empty())
+    {
+        const ssize_t written = write(fd, &(s_currentInput->at(0)), s_currentInput->size());
+        (void)written;
+    }
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+
+    const ssize_t written = write(STDERR_FILENO, message, sizeof(message) - 1U);
+    (void)written;
+
+    signal(signalNumber, SIG_DFL);
+    raise(signalNumber);
+}
+
+/**
+ * Run the fuzz target on a single input with a hard timeout
+ */
+static void runInput(const Input &input, const unsigned int timeout)
+{
+    s_currentInput = &input;
+    alarm(timeout);
+
+    if (input.empty())
+    {
+        LLVMFuzzerTestOneInput(NULL, 0U);
+    }
+    else
+    {
+        LLVMFuzzerTestOneInput(&(input.at(0)), input.size());
+    }
+
+    alarm(0U);
+    s_currentInput = NULL;
+}
+
+static bool readFile(const std::string &path, Input *input)
+{
+    bool success = false;
+    FILE *file = std::fopen(path.c_str(), "rb");
+
+    if (file != NULL)
+    {
+        uint8_t buffer[4096];
+        size_t size = std::fread(buffer, 1U, sizeof(buffer), file);
+
+        while (size > 0U)
+        {
+            input->insert(input->end(), buffer, buffer + size);
+            size = std::fread(buffer, 1U, sizeof(buffer), file);
+        }
+
+        success = (std::ferror(file) == 0);
+        std::fclose(file);
+    }
+
+    return success;
+}
+
+static void collectCorpus(const std::string &path, std::vector<Input> *corpus)
+{
+    struct stat pathStat;
+
+    if (stat(path.c_str(), &pathStat) != 0)
+    {
+        std::fprintf(stderr, "==Standalone== Path not found: %s\n", path.c_str());
+    }
+    else if (S_ISDIR(pathStat.st_mode))
+    {
+        DIR *directory = opendir(path.c_str());
+
+        if (directory != NULL)
+        {
+            struct dirent *entry = readdir(directory);
+
+            while (entry != NULL)
+            {
+                if ((std::strcmp(entry->d_name, ".") != 0) &&
+                    (std::strcmp(entry->d_name, "..") != 0))
+                {
+                    collectCorpus(path + "/" + entry->d_name, corpus);
+                }
+
+                entry = readdir(directory);
+            }
+
+            closedir(directory);
+        }
+    }
+    else
+    {
+        Input input;
+
+        if (readFile(path, &input))
+        {
+            corpus->push_back(input);
+        }
+    }
+}
+
+/**
+ * Xorshift random number generator
+ */
+static uint32_t nextRandom(uint32_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+/**
+ * Mutate the input
+ *
+ * Besides the usual byte level mutations, tokens that are known to stress the parser are inserted
+ * repeatedly (long runs of "]]", deep nesting, many references, ...).
+ */
+static void mutateInput(Input *input, const size_t maxLength, uint32_t *state)
+{
+    static const char *const tokenList[] =
+    {
+        "]]", "]]>", "<a>", "</a>", "<![CDATA[", "<!--", "--", "-->", "<?pi ", "?>", "&amp;",
+        "&#65;", "&#x42;", " a='v'", " b=\"w\"", "<!DOCTYPE a>", "<?xml version='1.0'?>", "\xC3\xA9"
+    };
+    static const size_t tokenCount = sizeof(tokenList) / sizeof(tokenList[0]);
+
+    const uint32_t mutationCount = 1U + (nextRandom(state) % 4U);
+
+    for (uint32_t i = 0U; i < mutationCount; i++)
+    {
+        const size_t position = input->empty() ? 0U : (nextRandom(state) % input->size());
+
+        switch (nextRandom(state) % 5U)
+        {
+            case 0U:
+            {
+                // Change a byte
+                if (!input->empty())
+                {
+                    input->at(position) = static_cast<uint8_t>(nextRandom(state));
+                }
+                break;
+            }
+
+            case 1U:
+            {
+                // Insert a byte
+                input->insert(input->begin() + position, static_cast<uint8_t>(nextRandom(state)));
+                break;
+            }
+
+            case 2U:
+            {
+                // Erase a range
+                const size_t size = nextRandom(state) % 16U;
+                const size_t end = ((position + size) < input->size()) ? (position + size) :
+                                                                         input->size();
+                input->erase(input->begin() + position, input->begin() + end);
+                break;
+            }
+
+            default:
+            {
+                // Insert a repeated token
+                const char *token = tokenList[nextRandom(state) % tokenCount];
+                const size_t repeatCount = 1U + (nextRandom(state) % 256U);
+                Input data;
+
+                for (size_t j = 0U; j < repeatCount; j++)
+                {
+                    data.insert(data.end(), token, token + std::strlen(token));
+                }
+
+                input->insert(input->begin() + position, data.begin(), data.end());
+                break;
+            }
+        }
+    }
+
+    if (input->size() > maxLength)
+    {
+        input->resize(maxLength);
+    }
+}
+
+static bool parseOption(const char *argument, const char *name, unsigned long *value)
+{
+    bool success = false;
+    const size_t nameLength = std::strlen(name);
+
+    if (std::strncmp(argument, name, nameLength) == 0)
+    {
+        *value = std::strtoul(argument + nameLength, NULL, 10);
+        success = true;
+    }
+
+    return success;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long runs = 0U;
+    unsigned long maxLength = 4096U;
+    unsigned long seed = static_cast<unsigned long>(std::time(NULL));
+    unsigned long timeout = 10U;
+    unsigned long rssLimit = 2048U;
+    std::vector<Input> corpus;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (parseOption(argv[i], "-runs=", &runs) ||
+            parseOption(argv[i], "-max_len=", &maxLength) ||
+            parseOption(argv[i], "-seed=", &seed) ||
+            parseOption(argv[i], "-timeout=", &timeout) ||
+            parseOption(argv[i], "-rss_limit_mb=", &rssLimit))
+        {
+            // Option parsed
+        }
+        else if (argv[i][0] == '-')
+        {
+            std::fprintf(stderr, "==Standalone== Ignoring unsupported option: %s\n", argv[i]);
+        }
+        else
+        {
+            collectCorpus(argv[i], &corpus);
+        }
+    }
+
+    if (rssLimit > 0U)
+    {
+        struct rlimit limit;
+        limit.rlim_cur = static_cast<rlim_t>(rssLimit) * 1024U * 1024U;
+        limit.rlim_max = limit.rlim_cur;
+        setrlimit(RLIMIT_AS, &limit);
+    }
+
+    signal(SIGABRT, &handleFailure);
+    signal(SIGSEGV, &handleFailure);
+    signal(SIGALRM, &handleFailure);
+
+    // Run the corpus
+    for (size_t i = 0U; i < corpus.size(); i++)
+    {
+        runInput(corpus.at(i), static_cast<unsigned int>(timeout));
+    }
+
+    std::printf("==Standalone== Corpus inputs: %u\n", static_cast<unsigned int>(corpus.size()));
+
+    // Run the mutated inputs
+    if (runs > 0U)
+    {
+        uint32_t state = static_cast<uint32_t>(seed) | 1U;
+
+        if (corpus.empty())
+        {
+            corpus.push_back(Input());
+        }
+
+        for (unsigned long i = 0U; i < runs; i++)
+        {
+            Input input = corpus.at(nextRandom(&state) % corpus.size());
+            mutateInput(&input, static_cast<size_t>(maxLength), &state);
+            runInput(input, static_cast<unsigned int>(timeout));
+        }
+
+        std::printf("==Standalone== Mutated inputs: %lu (seed: %lu)\n", runs, seed);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,402 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include "FuzzBudget.h"
+#include <EmbeddedStAX/XmlReader/XmlReader.h>
+#include <EmbeddedStAX/XmlValidator/Common.h>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace EmbeddedStAX;
+
+/**
+ * Event read by the XML reader, reduced to its type and a hash of its data
+ */
+struct Event
+{
+    XmlReader::XmlReader::ParsingResult result;
+    uint32_t hash;
+    bool maskable;
+};
+
+/**
+ * Add a unicode string to the FNV-1a hash
+ */
+static uint32_t hashUnicodeString(uint32_t hash, const Common::UnicodeString &value)
+{
+    for (size_t i = 0U; i < value.size(); i++)
+    {
+        hash = (hash ^ value.at(i)) * 16777619U;
+    }
+
+    return hash;
+}
+
+/**
+ * Calculate the hash of the data and the element path of the last event
+ */
+static uint32_t hashEventData(const XmlReader::XmlReader &xmlReader,
+                              const XmlReader::XmlReader::ParsingResult result)
+{
+    uint32_t hash = (2166136261U ^ xmlReader.pathHash()) * 16777619U;
+
+    switch (result)
+    {
+        case XmlReader::XmlReader::ParsingResult_ProcessingInstruction:
+        {
+            const Common::ProcessingInstruction pi = xmlReader.processingInstruction();
+            hash = hashUnicodeString(hash, pi.piTarget());
+            hash = hashUnicodeString(hash, pi.piData());
+            break;
+        }
+
+        case XmlReader::XmlReader::ParsingResult_Comment:
+        case XmlReader::XmlReader::ParsingResult_TextNode:
+        case XmlReader::XmlReader::ParsingResult_CData:
+        {
+            hash = hashUnicodeString(hash, xmlReader.text());
+            break;
+        }
+
+        case XmlReader::XmlReader::ParsingResult_StartOfElement:
+        {
+            const Common::AttributeList &attributeList = xmlReader.attributeList();
+            hash = hashUnicodeString(hash, xmlReader.name());
+
+            for (Common::AttributeList::ConstIterator it = attributeList.begin();
+                 it != attributeList.end();
+                 it++)
+            {
+                hash = hashUnicodeString(hash, it->name());
+                hash = hashUnicodeString(hash, it->value());
+            }
+            break;
+        }
+
+        case XmlReader::XmlReader::ParsingResult_EndOfElement:
+        {
+            hash = hashUnicodeString(hash, xmlReader.name());
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+    return hash;
+}
+
+/**
+ * Check if the last event can be suppressed with the event mask
+ */
+static bool isEventMaskable(const XmlReader::XmlReader &xmlReader,
+                            const XmlReader::XmlReader::ParsingResult result)
+{
+    bool maskable = false;
+
+    switch (result)
+    {
+        case XmlReader::XmlReader::ParsingResult_XmlDeclaration:
+        case XmlReader::XmlReader::ParsingResult_ProcessingInstruction:
+        case XmlReader::XmlReader::ParsingResult_Comment:
+        {
+            maskable = true;
+            break;
+        }
+
+        case XmlReader::XmlReader::ParsingResult_TextNode:
+        {
+            const Common::UnicodeString text = xmlReader.text();
+            maskable = true;
+
+            for (size_t i = 0U; maskable && (i < text.size()); i++)
+            {
+                maskable = XmlValidator::isWhitespace(text.at(i));
+            }
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+    return maskable;
+}
+
+/**
+ * Parse the input with the selected chunk split schedule
+ *
+ * \param data          Input data
+ * \param size          Size of the input data
+ * \param schedule      Chunk split schedule (NULL to write all data at once)
+ * \param eventMask     Event mask of the reader
+ * \param cacheCapacity Capacity of the reader's attribute value cache (0 to disable the cache)
+ * \param shapeCapacity Capacity of the reader's shape predictor (0 to disable shape prediction)
+ * \param parseBudget   Work budget of each parse() call (0 for no budget)
+ * \param coalescing    Enable text coalescing in the reader
+ * \param recovery      Enable error recovery in the reader (parsing continues after errors)
+ * \param budget        Time budget of the input
+ * \param eventList     Output for the events read from the input
+ */
+static void parseInput(const uint8_t *data,
+                       const size_t size,
+                       Fuzz::ChunkSchedule *schedule,
+                       const uint32_t eventMask,
+                       const size_t cacheCapacity,
+                       const size_t shapeCapacity,
+                       const size_t parseBudget,
+                       const bool coalescing,
+                       const bool recovery,
+                       const Fuzz::TimeBudget &budget,
+                       std::vector<Event> *eventList)
+{
+    XmlReader::XmlReader xmlReader;
+    xmlReader.setEventMask(eventMask);
+    xmlReader.setAttributeValueCache(cacheCapacity);
+    xmlReader.setShapePrediction(shapeCapacity);
+    xmlReader.setTextCoalescingEnabled(coalescing);
+    xmlReader.setErrorRecoveryEnabled(recovery);
+    const char *chunk = reinterpret_cast<const char *>(data);
+    size_t remainingSize = size;
+    bool finished = false;
+
+    while (!finished)
+    {
+        XmlReader::XmlReader::ParsingResult result = XmlReader::XmlReader::ParsingResult_None;
+
+        if (parseBudget == 0U)
+        {
+            result = xmlReader.parse();
+        }
+        else
+        {
+            result = xmlReader.parse(parseBudget);
+        }
+
+        if (result == XmlReader::XmlReader::ParsingResult_Yield)
+        {
+            // Budget was used up, continue parsing
+        }
+        else if (result == XmlReader::XmlReader::ParsingResult_NeedMoreData)
+        {
+            size_t chunkSize = remainingSize;
+
+            if (schedule != NULL)
+            {
+                chunkSize = schedule->nextChunkSize(remainingSize);
+            }
+
+            if (chunkSize == 0U)
+            {
+                // End of input
+                finished = true;
+            }
+            else if (xmlReader.writeData(chunk, chunkSize) != chunkSize)
+            {
+                // Invalid encoding, parse only the data that was already written
+                remainingSize = 0U;
+            }
+            else
+            {
+                chunk += chunkSize;
+                remainingSize -= chunkSize;
+            }
+        }
+        else
+        {
+            Event event;
+            event.result = result;
+            event.hash = hashEventData(xmlReader, result);
+            event.maskable = isEventMaskable(xmlReader, result);
+            eventList->push_back(event);
+
+            if ((result == XmlReader::XmlReader::ParsingResult_Error) && (!recovery))
+            {
+                finished = true;
+            }
+        }
+
+        budget.check("XmlReader");
+    }
+}
+
+/**
+ * Compare the events of two parsing runs and abort if they differ
+ *
+ * \param eventList         Reference events
+ * \param otherEventList    Events of the other run
+ * \param runName           Name of the other run
+ */
+static void compareEvents(const std::vector<Event> &eventList,
+                          const std::vector<Event> &otherEventList,
+                          const char *runName)
+{
+    bool match = (eventList.size() == otherEventList.size());
+
+    for (size_t i = 0U; match && (i < eventList.size()); i++)
+    {
+        if ((eventList.at(i).result != otherEventList.at(i).result) ||
+            (eventList.at(i).hash != otherEventList.at(i).hash))
+        {
+            std::fprintf(stderr,
+                         "==XmlReader== Event %u differs in the %s run\n",
+                         static_cast<unsigned int>(i),
+                         runName);
+            match = false;
+        }
+    }
+
+    if (!match)
+    {
+        std::fprintf(stderr,
+                     "==XmlReader== Events: %u (all at once), %u (%s)\n",
+                     static_cast<unsigned int>(eventList.size()),
+                     static_cast<unsigned int>(otherEventList.size()),
+                     runName);
+        std::abort();
+    }
+}
+
+/**
+ * Copy all events except the text node and CDATA events
+ *
+ * \param eventList         Events
+ * \param markupEventList   Output for the events without the character data
+ */
+static void removeCharacterDataEvents(const std::vector<Event> &eventList,
+                                      std::vector<Event> *markupEventList)
+{
+    for (size_t i = 0U; i < eventList.size(); i++)
+    {
+        if ((eventList.at(i).result != XmlReader::XmlReader::ParsingResult_TextNode) &&
+            (eventList.at(i).result != XmlReader::XmlReader::ParsingResult_CData))
+        {
+            markupEventList->push_back(eventList.at(i));
+        }
+    }
+}
+
+/**
+ * Fuzzer entry point
+ *
+ * The input is parsed four times: once written to the reader all at once, once split into chunks
+ * (with a small attribute value cache, a small shape predictor, a small parse budget and error
+ * recovery), once split into chunks with all maskable events masked and once split into chunks
+ * with text coalescing.
+ * The chunked run has to produce the same events (up to the first error, after it the recovered
+ * events follow), the masked run has to produce the same events without the maskable ones, the
+ * coalesced run has to produce the same markup events and all runs have to finish within the time
+ * budget.
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    const Fuzz::TimeBudget budget(size);
+    Fuzz::ChunkSchedule schedule(data, size);
+    Fuzz::ChunkSchedule maskedSchedule(data, size);
+    std::vector<Event> eventList;
+    std::vector<Event> chunkedEventList;
+    std::vector<Event> maskedEventList;
+    std::vector<Event> unmaskedEventList;
+    Fuzz::ChunkSchedule coalescedSchedule(data, size);
+    std::vector<Event> coalescedEventList;
+    std::vector<Event> markupEventList;
+    std::vector<Event> coalescedMarkupEventList;
+
+    parseInput(data,
+               size,
+               NULL,
+               XmlReader::XmlReader::EventMask_All,
+               0U,
+               0U,
+               0U,
+               false,
+               false,
+               budget,
+               &eventList);
+    parseInput(data,
+               size,
+               &schedule,
+               XmlReader::XmlReader::EventMask_All,
+               4U,
+               4U,
+               5U,
+               false,
+               true,
+               budget,
+               &chunkedEventList);
+    parseInput(data,
+               size,
+               &maskedSchedule,
+               XmlReader::XmlReader::EventMask_None,
+               0U,
+               0U,
+               0U,
+               false,
+               false,
+               budget,
+               &maskedEventList);
+    parseInput(data,
+               size,
+               &coalescedSchedule,
+               XmlReader::XmlReader::EventMask_All,
+               0U,
+               0U,
+               0U,
+               true,
+               false,
+               budget,
+               &coalescedEventList);
+
+    if (chunkedEventList.size() > eventList.size())
+    {
+        // Remove the events that were read after the error was recovered
+        chunkedEventList.resize(eventList.size());
+    }
+
+    compareEvents(eventList, chunkedEventList, "chunked");
+
+    for (size_t i = 0U; i < eventList.size(); i++)
+    {
+        if (!eventList.at(i).maskable)
+        {
+            unmaskedEventList.push_back(eventList.at(i));
+        }
+    }
+
+    compareEvents(unmaskedEventList, maskedEventList, "masked");
+
+    removeCharacterDataEvents(eventList, &markupEventList);
+    removeCharacterDataEvents(coalescedEventList, &coalescedMarkupEventList);
+    compareEvents(markupEventList, coalescedMarkupEventList, "coalesced");
+
+    return 0;
+}
@@ -0,0 +1,348 @@
+/*
+ * This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org>
+ */
+
+#include "FuzzBudget.h"
+#include <EmbeddedStAX/XmlReader/XmlReader.h>
+#include <EmbeddedStAX/XmlWriter/XmlWriter.h>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace EmbeddedStAX;
+
+/**
+ * Decoder of writer operations from the fuzzer input
+ */
+class OperationDecoder
+{
+public:
+    // Public types
+    enum Operation
+    {
+        Operation_XmlDeclaration,
+        Operation_DocumentType,
+        Operation_Comment,
+        Operation_ProcessingInstruction,
+        Operation_EmptyElement,
+        Operation_StartOfElement,
+        Operation_TextNode,
+        Operation_CDataSection,
+        Operation_EndOfElement,
+        Operation_Count
+    };
+
+public:
+    // Public API
+    OperationDecoder(const uint8_t *data, const size_t size)
+        : m_data(data),
+          m_size(size),
+          m_position(0U)
+    {
+    }
+
+    bool atEnd() const
+    {
+        return (m_position >= m_size);
+    }
+
+    uint8_t readByte()
+    {
+        uint8_t value = 0U;
+
+        if (m_position < m_size)
+        {
+            value = m_data[m_position];
+            m_position++;
+        }
+
+        return value;
+    }
+
+    Operation readOperation()
+    {
+        return static_cast<Operation>(readByte() % static_cast<uint8_t>(Operation_Count));
+    }
+
+    /**
+     * Read a string: one length byte followed by one byte per character
+     *
+     * Bytes up to 0xEF are used as characters directly and the rest are mapped to characters
+     * outside of the Basic Multilingual Plane.
+     */
+    Common::UnicodeString readString()
+    {
+        Common::UnicodeString value;
+        const size_t length = readByte() % 32U;
+
+        for (size_t i = 0U; (i < length) && !atEnd(); i++)
+        {
+            const uint32_t byte = readByte();
+
+            if (byte < 0xF0U)
+            {
+                value.push_back(byte);
+            }
+            else
+            {
+                value.push_back(0x10000U + byte);
+            }
+        }
+
+        return value;
+    }
+
+    Common::AttributeList readAttributeList()
+    {
+        Common::AttributeList attributeList;
+        const size_t count = readByte() % 4U;
+
+        for (size_t i = 0U; (i < count) && !atEnd(); i++)
+        {
+            const Common::UnicodeString name = readString();
+            const Common::UnicodeString value = readString();
+            const Common::QuotationMark quotationMark = ((readByte() % 2U) == 0U) ?
+                                                            Common::QuotationMark_Quote :
+                                                            Common::QuotationMark_Apostrophe;
+            attributeList.add(Common::Attribute(name, value, quotationMark));
+        }
+
+        return attributeList;
+    }
+
+private:
+    // Private data
+    const uint8_t *m_data;
+    size_t m_size;
+    size_t m_position;
+};
+
+/**
+ * Execute the next writer operation
+ *
+ * \param decoder   Operation decoder
+ * \param xmlWriter XML writer
+ * \param depth     Depth of the opened elements (updated on success)
+ * \param rootCount Number of written root elements (updated on success)
+ *
+ * \retval true     Success
+ * \retval false    Operation was rejected by the writer
+ */
+static bool executeOperation(OperationDecoder *decoder,
+                             XmlWriter::XmlWriter *xmlWriter,
+                             size_t *depth,
+                             size_t *rootCount)
+{
+    bool success = false;
+
+    switch (decoder->readOperation())
+    {
+        case OperationDecoder::Operation_XmlDeclaration:
+        {
+            success = xmlWriter->writeXmlDeclaration();
+            break;
+        }
+
+        case OperationDecoder::Operation_DocumentType:
+        {
+            success = xmlWriter->writeDocumentType(decoder->readString());
+            break;
+        }
+
+        case OperationDecoder::Operation_Comment:
+        {
+            success = xmlWriter->writeComment(decoder->readString());
+            break;
+        }
+
+        case OperationDecoder::Operation_ProcessingInstruction:
+        {
+            const Common::UnicodeString piTarget = decoder->readString();
+            const Common::UnicodeString piData = decoder->readString();
+            success = xmlWriter->writeProcessingInstruction(
+                          Common::ProcessingInstruction(piTarget, piData));
+            break;
+        }
+
+        case OperationDecoder::Operation_EmptyElement:
+        {
+            const Common::UnicodeString name = decoder->readString();
+            success = xmlWriter->writeEmptyElement(name, decoder->readAttributeList());
+
+            if (success && (*depth == 0U))
+            {
+                (*rootCount)++;
+            }
+            break;
+        }
+
+        case OperationDecoder::Operation_StartOfElement:
+        {
+            const Common::UnicodeString name = decoder->readString();
+            success = xmlWriter->writeStartOfElement(name, decoder->readAttributeList());
+
+            if (success)
+            {
+                if (*depth == 0U)
+                {
+                    (*rootCount)++;
+                }
+
+                (*depth)++;
+            }
+            break;
+        }
+
+        case OperationDecoder::Operation_TextNode:
+        {
+            success = xmlWriter->writeTextNode(decoder->readString());
+            break;
+        }
+
+        case OperationDecoder::Operation_CDataSection:
+        {
+            success = xmlWriter->writeCDataSection(decoder->readString());
+            break;
+        }
+
+        case OperationDecoder::Operation_EndOfElement:
+        {
+            success = xmlWriter->writeEndOfElement();
+
+            if (success)
+            {
+                (*depth)--;
+            }
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+    return success;
+}
+
+/**
+ * Parse the written document and check that it is a complete and well-formed document
+ *
+ * \param xmlString Written document
+ * \param budget    Time budget of the input
+ *
+ * \retval true     Document is well-formed
+ * \retval false    Error
+ */
+static bool readDocument(const Common::UnicodeString &xmlString, const Fuzz::TimeBudget &budget)
+{
+    XmlReader::XmlReader xmlReader;
+    bool success = false;
+    bool finished = false;
+    size_t depth = 0U;
+
+    xmlReader.writeData(Common::Utf8::toUtf8(xmlString));
+
+    while (!finished)
+    {
+        switch (xmlReader.parse())
+        {
+            case XmlReader::XmlReader::ParsingResult_NeedMoreData:
+            {
+                finished = true;
+                break;
+            }
+
+            case XmlReader::XmlReader::ParsingResult_StartOfElement:
+            {
+                depth++;
+                break;
+            }
+
+            case XmlReader::XmlReader::ParsingResult_EndOfElement:
+            {
+                depth--;
+
+                if (depth == 0U)
+                {
+                    success = true;
+                }
+                break;
+            }
+
+            case XmlReader::XmlReader::ParsingResult_Error:
+            {
+                // Error
+                success = false;
+                finished = true;
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
+        }
+
+        budget.check("XmlWriter");
+    }
+
+    return success;
+}
+
+/**
+ * Fuzzer entry point
+ *
+ * The input is decoded into a sequence of writer operations. If the writer accepts all of them
+ * and the root element gets closed then the written document has to be readable by the XML reader.
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    const Fuzz::TimeBudget budget(size);
+    OperationDecoder decoder(data, size);
+    XmlWriter::XmlWriter xmlWriter;
+    bool success = true;
+    size_t depth = 0U;
+    size_t rootCount = 0U;
+
+    while (success && !decoder.atEnd())
+    {
+        success = executeOperation(&decoder, &xmlWriter, &depth, &rootCount);
+        budget.check("XmlWriter");
+    }
+
+    if (success && (rootCount == 1U) && (depth == 0U))
+    {
+        if (!readDocument(xmlWriter.xmlString(), budget))
+        {
+            std::fprintf(stderr,
+                         "==XmlWriter== Written document is not well-formed:\n%s\n",
+                         Common::Utf8::toUtf8(xmlWriter.xmlString()).c_str());
+            std::abort();
+        }
+    }
+
+    return 0;
+}
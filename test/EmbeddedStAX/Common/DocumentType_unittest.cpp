@@ -91,3 +91,46 @@ TEST(EmbeddedStAX_Common_DocumentType, ValidationTest)
 
     EXPECT_FALSE(documentType.isValid());
 }
+
+TEST(EmbeddedStAX_Common_DocumentType, ExternalIdTest)
+{
+    DocumentType documentType(Utf8::toUnicodeString("name"));
+
+    EXPECT_EQ(UnicodeString(), documentType.publicId());
+    EXPECT_EQ(UnicodeString(), documentType.systemId());
+
+    documentType.setExternalId(Utf8::toUnicodeString("public"), Utf8::toUnicodeString("system"));
+    const DocumentType copy(documentType);
+
+    EXPECT_EQ(Utf8::toUnicodeString("public"), copy.publicId());
+    EXPECT_EQ(Utf8::toUnicodeString("system"), copy.systemId());
+
+    documentType.clear();
+
+    EXPECT_EQ(UnicodeString(), documentType.publicId());
+    EXPECT_EQ(UnicodeString(), documentType.systemId());
+}
+
+TEST(EmbeddedStAX_Common_DocumentType, ElementDeclarationTest)
+{
+    DocumentType documentType(Utf8::toUnicodeString("name"));
+
+    EXPECT_EQ(0U, documentType.elementDeclarationCount());
+
+    documentType.addElementDeclaration(Utf8::toUnicodeString("a"), Utf8::toUnicodeString("ANY"));
+    documentType.addElementDeclaration(Utf8::toUnicodeString("b"), Utf8::toUnicodeString("(a)"));
+    DocumentType copy;
+    copy = documentType;
+
+    ASSERT_EQ(2U, copy.elementDeclarationCount());
+    EXPECT_EQ(Utf8::toUnicodeString("a"), copy.elementName(0U));
+    EXPECT_EQ(Utf8::toUnicodeString("ANY"), copy.elementContentSpec(0U));
+    EXPECT_EQ(Utf8::toUnicodeString("b"), copy.elementName(1U));
+    EXPECT_EQ(Utf8::toUnicodeString("(a)"), copy.elementContentSpec(1U));
+    EXPECT_EQ(UnicodeString(), copy.elementName(2U));
+    EXPECT_EQ(UnicodeString(), copy.elementContentSpec(2U));
+
+    documentType.clear();
+
+    EXPECT_EQ(0U, documentType.elementDeclarationCount());
+}
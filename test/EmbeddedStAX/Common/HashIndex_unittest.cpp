@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <EmbeddedStAX/Common/HashIndex.h>
+
+using namespace EmbeddedStAX::Common;
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::Common::HashIndex
+//--------------------------------------------------------------------------------------------------
+TEST(EmbeddedStAX_Common_HashIndex, CalculateHashTest)
+{
+    // FNV-1a test vectors
+    EXPECT_EQ(2166136261U, HashIndex::initialHash());
+    EXPECT_EQ(HashIndex::initialHash(), HashIndex::calculateHash(UnicodeString()));
+    EXPECT_EQ(0xE40C292CU, HashIndex::calculateHash(Utf8::toUnicodeString("a")));
+    EXPECT_EQ(0xBF9CF968U, HashIndex::calculateHash(Utf8::toUnicodeString("foobar")));
+
+    // Appending a string is the same as appending its characters
+    const UnicodeString value = Utf8::toUnicodeString("name");
+    uint32_t hash = HashIndex::initialHash();
+
+    for (size_t i = 0U; i < value.size(); i++)
+    {
+        hash = HashIndex::appendHash(hash, value.at(i));
+    }
+
+    EXPECT_EQ(hash, HashIndex::calculateHash(value));
+
+    // A different seed gives a different hash
+    EXPECT_NE(HashIndex::calculateHash(value), HashIndex::appendHash(12345U, value));
+}
+
+TEST(EmbeddedStAX_Common_HashIndex, AddFindTest)
+{
+    HashIndex hashIndex;
+    EXPECT_EQ(0U, hashIndex.size());
+
+    // Items 0 and 2 have the same hash
+    hashIndex.add(100U);
+    hashIndex.add(200U);
+    hashIndex.add(100U);
+    EXPECT_EQ(3U, hashIndex.size());
+
+    // All items with the same hash are found
+    size_t slot = hashIndex.firstSlot(100U);
+    size_t index = 0U;
+    ASSERT_TRUE(hashIndex.find(100U, &slot, &index));
+    EXPECT_EQ(0U, index);
+    ASSERT_TRUE(hashIndex.find(100U, &slot, &index));
+    EXPECT_EQ(2U, index);
+    EXPECT_FALSE(hashIndex.find(100U, &slot, &index));
+
+    slot = hashIndex.firstSlot(200U);
+    ASSERT_TRUE(hashIndex.find(200U, &slot, &index));
+    EXPECT_EQ(1U, index);
+    EXPECT_FALSE(hashIndex.find(200U, &slot, &index));
+
+    slot = hashIndex.firstSlot(300U);
+    EXPECT_FALSE(hashIndex.find(300U, &slot, &index));
+
+    // Clear
+    hashIndex.clear();
+    EXPECT_EQ(0U, hashIndex.size());
+
+    slot = hashIndex.firstSlot(100U);
+    EXPECT_FALSE(hashIndex.find(100U, &slot, &index));
+}
+
+TEST(EmbeddedStAX_Common_HashIndex, GrowTest)
+{
+    HashIndex hashIndex;
+
+    // Hashes that differ only in their high bits
+    for (uint32_t i = 0U; i < 1000U; i++)
+    {
+        hashIndex.add(i << 16);
+    }
+
+    EXPECT_EQ(1000U, hashIndex.size());
+
+    for (uint32_t i = 0U; i < 1000U; i++)
+    {
+        const uint32_t hash = i << 16;
+        size_t slot = hashIndex.firstSlot(hash);
+        size_t index = 0U;
+
+        ASSERT_TRUE(hashIndex.find(hash, &slot, &index));
+        EXPECT_EQ(static_cast<size_t>(i), index);
+        EXPECT_FALSE(hashIndex.find(hash, &slot, &index));
+    }
+}
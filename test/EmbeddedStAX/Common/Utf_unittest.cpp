@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <EmbeddedStAX/Common/Utf.h>
+
+using namespace EmbeddedStAX::Common;
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::Common::Utf8
+//--------------------------------------------------------------------------------------------------
+TEST(EmbeddedStAX_Common_Utf8, EncodeCharacterTest)
+{
+    // One byte
+    EXPECT_EQ(std::string("\x00", 1U), Utf8::toUtf8(0x00U));
+    EXPECT_EQ(std::string("A"), Utf8::toUtf8(0x41U));
+    EXPECT_EQ(std::string("\x7F"), Utf8::toUtf8(0x7FU));
+
+    // Two bytes
+    EXPECT_EQ(std::string("\xC2\x80"), Utf8::toUtf8(0x80U));
+    EXPECT_EQ(std::string("\xC3\xA9"), Utf8::toUtf8(0xE9U));
+    EXPECT_EQ(std::string("\xDF\xBF"), Utf8::toUtf8(0x7FFU));
+
+    // Three bytes
+    EXPECT_EQ(std::string("\xE0\xA0\x80"), Utf8::toUtf8(0x800U));
+    EXPECT_EQ(std::string("\xE2\x82\xAC"), Utf8::toUtf8(0x20ACU));
+    EXPECT_EQ(std::string("\xEF\xBF\xBD"), Utf8::toUtf8(0xFFFDU));
+
+    // Four bytes
+    EXPECT_EQ(std::string("\xF0\x90\x80\x80"), Utf8::toUtf8(0x10000U));
+    EXPECT_EQ(std::string("\xF0\x9F\x98\x80"), Utf8::toUtf8(0x1F600U));
+    EXPECT_EQ(std::string("\xF4\x8F\xBF\xBF"), Utf8::toUtf8(0x10FFFFU));
+
+    // Not a unicode character
+    EXPECT_EQ(std::string(), Utf8::toUtf8(0x110000U));
+}
+
+TEST(EmbeddedStAX_Common_Utf8, EncodeDecodeRoundTripTest)
+{
+    UnicodeString unicodeString;
+    unicodeString.push_back(0x24U);
+    unicodeString.push_back(0xA2U);
+    unicodeString.push_back(0x939U);
+    unicodeString.push_back(0x20ACU);
+    unicodeString.push_back(0xD55CU);
+    unicodeString.push_back(0x10348U);
+
+    const std::string utf8 = Utf8::toUtf8(unicodeString);
+
+    EXPECT_EQ(std::string("\x24\xC2\xA2\xE0\xA4\xB9\xE2\x82\xAC\xED\x95\x9C\xF0\x90\x8D\x88"),
+              utf8);
+    EXPECT_EQ(unicodeString, Utf8::toUnicodeString(utf8));
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <EmbeddedStAX/XmlReader/AttributeValueCache.h>
+#include <EmbeddedStAX/XmlReader/XmlReader.h>
+#include <vector>
+
+using namespace EmbeddedStAX::XmlReader;
+using EmbeddedStAX::Common::UnicodeString;
+using EmbeddedStAX::Common::Utf8;
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::XmlReader::AttributeValueCache
+//--------------------------------------------------------------------------------------------------
+TEST(EmbeddedStAX_XmlReader_AttributeValueCache, DisabledCacheTest)
+{
+    AttributeValueCache cache;
+    const UnicodeString value = Utf8::toUnicodeString("USD");
+
+    EXPECT_EQ(0U, cache.capacity());
+    EXPECT_EQ(&value, &cache.intern(value));
+    EXPECT_EQ(0U, cache.lookupCount());
+    EXPECT_EQ(0U, cache.hitCount());
+}
+
+TEST(EmbeddedStAX_XmlReader_AttributeValueCache, InternTest)
+{
+    AttributeValueCache cache;
+    cache.setCapacity(10U, 8U);
+    EXPECT_EQ(16U, cache.capacity());
+    EXPECT_EQ(8U, cache.maxValueSize());
+
+    const UnicodeString usd = Utf8::toUnicodeString("USD");
+    const UnicodeString longValue = Utf8::toUnicodeString("longer than eight");
+
+    // First occurrence is stored, the following ones are found in the cache
+    const UnicodeString *internedUsd = &cache.intern(usd);
+    EXPECT_NE(&usd, internedUsd);
+    EXPECT_EQ(usd, *internedUsd);
+    EXPECT_EQ(internedUsd, &cache.intern(Utf8::toUnicodeString("USD")));
+    EXPECT_EQ(internedUsd, &cache.intern(usd));
+
+    // Long values are not cached
+    EXPECT_EQ(&longValue, &cache.intern(longValue));
+
+    EXPECT_EQ(3U, cache.lookupCount());
+    EXPECT_EQ(2U, cache.hitCount());
+
+    // Statistics are kept when cached values are removed
+    cache.clear();
+    EXPECT_EQ(usd, cache.intern(usd));
+    EXPECT_EQ(4U, cache.lookupCount());
+    EXPECT_EQ(2U, cache.hitCount());
+
+    cache.resetStatistics();
+    EXPECT_EQ(0U, cache.lookupCount());
+    EXPECT_EQ(0U, cache.hitCount());
+    EXPECT_EQ(0U, cache.replacementCount());
+}
+
+TEST(EmbeddedStAX_XmlReader_AttributeValueCache, ReplacementTest)
+{
+    // A cache with a single entry holds only the last value
+    AttributeValueCache cache;
+    cache.setCapacity(1U);
+
+    EXPECT_EQ(Utf8::toUnicodeString("a"), cache.intern(Utf8::toUnicodeString("a")));
+    EXPECT_EQ(Utf8::toUnicodeString("b"), cache.intern(Utf8::toUnicodeString("b")));
+    EXPECT_EQ(Utf8::toUnicodeString("b"), cache.intern(Utf8::toUnicodeString("b")));
+    EXPECT_EQ(Utf8::toUnicodeString("a"), cache.intern(Utf8::toUnicodeString("a")));
+
+    EXPECT_EQ(4U, cache.lookupCount());
+    EXPECT_EQ(1U, cache.hitCount());
+    EXPECT_EQ(2U, cache.replacementCount());
+}
+
+TEST(EmbeddedStAX_XmlReader_AttributeValueCache, XmlReaderTest)
+{
+    XmlReader xmlReader;
+    xmlReader.setAttributeValueCache(64U);
+    xmlReader.writeData("<r><a c='USD' t=\"int\"/><a c='USD' t='int'/><a c='EUR' t=\"int\"/></r>");
+
+    std::vector<UnicodeString> valueList;
+    bool finished = false;
+
+    while (!finished)
+    {
+        switch (xmlReader.parse())
+        {
+            case XmlReader::ParsingResult_StartOfElement:
+            {
+                const EmbeddedStAX::Common::AttributeList attributeList = xmlReader.attributeList();
+
+                for (EmbeddedStAX::Common::AttributeList::ConstIterator it = attributeList.begin();
+                     it != attributeList.end();
+                     it++)
+                {
+                    valueList.push_back(it->value());
+                }
+                break;
+            }
+
+            case XmlReader::ParsingResult_EndOfElement:
+            {
+                break;
+            }
+
+            default:
+            {
+                finished = true;
+                break;
+            }
+        }
+    }
+
+    ASSERT_EQ(6U, valueList.size());
+    EXPECT_EQ(Utf8::toUnicodeString("USD"), valueList.at(0));
+    EXPECT_EQ(Utf8::toUnicodeString("int"), valueList.at(1));
+    EXPECT_EQ(Utf8::toUnicodeString("USD"), valueList.at(2));
+    EXPECT_EQ(Utf8::toUnicodeString("int"), valueList.at(3));
+    EXPECT_EQ(Utf8::toUnicodeString("EUR"), valueList.at(4));
+    EXPECT_EQ(Utf8::toUnicodeString("int"), valueList.at(5));
+
+    EXPECT_EQ(6U, xmlReader.attributeValueCache().lookupCount());
+    EXPECT_EQ(3U, xmlReader.attributeValueCache().hitCount());
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <EmbeddedStAX/XmlReader/XmlReader.h>
+#include <EmbeddedStAX/Common/Utf.h>
+#include "XmlReaderTestHelper.h"
+
+using namespace EmbeddedStAX::Common;
+using namespace EmbeddedStAX::XmlReader;
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::XmlReader::AttributeValueParser
+//--------------------------------------------------------------------------------------------------
+TEST(EmbeddedStAX_XmlReader_AttributeValueParser, QuotationMarkSplitTest)
+{
+    // Data runs out right before each opening quotation mark
+    const std::string document = "<root a=\"1\" b='2'/>";
+    XmlReader xmlReader;
+    size_t position = 0U;
+
+    ASSERT_EQ(XmlReader::ParsingResult_StartOfElement,
+              parseNextEvent(&xmlReader, document, 1U, &position));
+
+    const AttributeList attributeList = xmlReader.attributeList();
+    ASSERT_EQ(2U, attributeList.size());
+    AttributeList::ConstIterator it = attributeList.begin();
+
+    EXPECT_EQ(Utf8::toUnicodeString("a"), it->name());
+    EXPECT_EQ(Utf8::toUnicodeString("1"), it->value());
+    ++it;
+
+    EXPECT_EQ(Utf8::toUnicodeString("b"), it->name());
+    EXPECT_EQ(Utf8::toUnicodeString("2"), it->value());
+
+    EXPECT_EQ(XmlReader::ParsingResult_EndOfElement,
+              parseNextEvent(&xmlReader, document, 1U, &position));
+}
+
+TEST(EmbeddedStAX_XmlReader_AttributeValueParser, LeadingWhitespaceTest)
+{
+    // Whitespace between '=' and the opening quotation mark is skipped one character at a time
+    const std::string document = "<root a= \t\"1\" b=\n'2'/>";
+    XmlReader xmlReader;
+    size_t position = 0U;
+
+    ASSERT_EQ(XmlReader::ParsingResult_StartOfElement,
+              parseNextEvent(&xmlReader, document, 1U, &position));
+
+    const AttributeList attributeList = xmlReader.attributeList();
+    ASSERT_EQ(2U, attributeList.size());
+    AttributeList::ConstIterator it = attributeList.begin();
+
+    EXPECT_EQ(Utf8::toUnicodeString("1"), it->value());
+    ++it;
+    EXPECT_EQ(Utf8::toUnicodeString("2"), it->value());
+
+    EXPECT_EQ(XmlReader::ParsingResult_EndOfElement,
+              parseNextEvent(&xmlReader, document, 1U, &position));
+}
@@ -0,0 +1,240 @@
+#include <gtest/gtest.h>
+#include <EmbeddedStAX/XmlReader/ColumnarExtractor.h>
+#include <clocale>
+
+using namespace EmbeddedStAX::XmlReader;
+using EmbeddedStAX::Common::UnicodeString;
+using EmbeddedStAX::Common::Utf8;
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::XmlReader::ColumnarExtractor
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the document and pass all events to the extractor
+ */
+static void extractDocument(ColumnarExtractor *columnarExtractor, const std::string &document)
+{
+    XmlReader xmlReader;
+    ASSERT_EQ(document.size(), xmlReader.writeData(document));
+    columnarExtractor->startNewDocument();
+    bool finished = false;
+
+    while (!finished)
+    {
+        const XmlReader::ParsingResult result = xmlReader.parse();
+        columnarExtractor->processEvent(xmlReader, result);
+
+        if ((result == XmlReader::ParsingResult_NeedMoreData) ||
+            (result == XmlReader::ParsingResult_Error))
+        {
+            finished = true;
+        }
+    }
+}
+
+/**
+ * Get string value from a string column
+ */
+static std::string stringValue(const ColumnarExtractor::Column &column, const size_t row)
+{
+    const size_t offset = column.stringOffsets.at(row);
+    return column.stringData.substr(offset, column.stringOffsets.at(row + 1U) - offset);
+}
+
+TEST(EmbeddedStAX_XmlReader_ColumnarExtractor, ExtractTest)
+{
+    ColumnarExtractor columnarExtractor;
+    ASSERT_TRUE(columnarExtractor.setRecordPath(Utf8::toUnicodeString("/export/row")));
+
+    const size_t idColumn = columnarExtractor.addField(Utf8::toUnicodeString("@id"),
+                                                       ColumnarExtractor::ColumnType_Int64);
+    const size_t nameColumn = columnarExtractor.addField(Utf8::toUnicodeString("name"),
+                                                         ColumnarExtractor::ColumnType_String);
+    const size_t priceColumn = columnarExtractor.addField(Utf8::toUnicodeString("price/amount"),
+                                                          ColumnarExtractor::ColumnType_Double);
+    const size_t skuColumn = columnarExtractor.addField(Utf8::toUnicodeString("item/@sku"),
+                                                        ColumnarExtractor::ColumnType_String);
+    const size_t textColumn = columnarExtractor.addField(UnicodeString(),
+                                                         ColumnarExtractor::ColumnType_String);
+    ASSERT_EQ(0U, idColumn);
+    ASSERT_EQ(4U, textColumn);
+    ASSERT_EQ(5U, columnarExtractor.columnCount());
+
+    extractDocument(&columnarExtractor,
+                    "<export>"
+                    "<row id=\"1\"><name>a&amp;b</name><price><amount> 1.5 </amount></price>"
+                    "<item sku=\"x\"/><item sku=\"y\"/>t</row>"
+                    "<other><row id=\"9\"/></other>"
+                    "<row id=\"x\"><name><![CDATA[c]]>\xC3\xA9<b>ignored</b></name></row>"
+                    "<row id=\"-9223372036854775808\"><price><amount>abc</amount></price></row>"
+                    "</export>");
+
+    ASSERT_EQ(3U, columnarExtractor.rowCount());
+    EXPECT_EQ(2U, columnarExtractor.conversionErrorCount());
+
+    // Int64 column
+    const ColumnarExtractor::Column &idValues = columnarExtractor.column(idColumn);
+    EXPECT_EQ(ColumnarExtractor::ColumnType_Int64, idValues.type);
+    ASSERT_EQ(3U, idValues.int64Values.size());
+    EXPECT_EQ(1, idValues.int64Values.at(0U));
+    EXPECT_TRUE(columnarExtractor.isValid(idColumn, 0U));
+    EXPECT_FALSE(columnarExtractor.isValid(idColumn, 1U));
+    EXPECT_EQ(static_cast<int64_t>(-9223372036854775807LL - 1LL), idValues.int64Values.at(2U));
+    EXPECT_TRUE(columnarExtractor.isValid(idColumn, 2U));
+    EXPECT_EQ(0x05U, idValues.validity.at(0U));
+
+    // String columns
+    const ColumnarExtractor::Column &nameValues = columnarExtractor.column(nameColumn);
+    ASSERT_EQ(4U, nameValues.stringOffsets.size());
+    EXPECT_EQ(std::string("a&b"), stringValue(nameValues, 0U));
+    EXPECT_EQ(std::string("c\xC3\xA9"), stringValue(nameValues, 1U));
+    EXPECT_EQ(std::string(), stringValue(nameValues, 2U));
+    EXPECT_FALSE(columnarExtractor.isValid(nameColumn, 2U));
+
+    const ColumnarExtractor::Column &skuValues = columnarExtractor.column(skuColumn);
+    EXPECT_EQ(std::string("x"), stringValue(skuValues, 0U));
+    EXPECT_EQ(std::string("x"), skuValues.stringData);
+
+    const ColumnarExtractor::Column &textValues = columnarExtractor.column(textColumn);
+    EXPECT_EQ(std::string("t"), stringValue(textValues, 0U));
+    EXPECT_TRUE(columnarExtractor.isValid(textColumn, 1U));
+    EXPECT_EQ(std::string(), stringValue(textValues, 1U));
+
+    // Double column
+    const ColumnarExtractor::Column &priceValues = columnarExtractor.column(priceColumn);
+    ASSERT_EQ(3U, priceValues.doubleValues.size());
+    EXPECT_DOUBLE_EQ(1.5, priceValues.doubleValues.at(0U));
+    EXPECT_TRUE(columnarExtractor.isValid(priceColumn, 0U));
+    EXPECT_FALSE(columnarExtractor.isValid(priceColumn, 1U));
+    EXPECT_FALSE(columnarExtractor.isValid(priceColumn, 2U));
+}
+
+TEST(EmbeddedStAX_XmlReader_ColumnarExtractor, LocaleTest)
+{
+    ColumnarExtractor columnarExtractor;
+    ASSERT_TRUE(columnarExtractor.setRecordPath(Utf8::toUnicodeString("/a/r")));
+    ASSERT_EQ(0U, columnarExtractor.addField(Utf8::toUnicodeString("@v"),
+                                             ColumnarExtractor::ColumnType_Double));
+
+    // Switch to a locale with a decimal comma (if one is installed)
+    const std::string previousLocale(std::setlocale(LC_NUMERIC, NULL));
+    const char * const localeNames[] = { "de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8" };
+
+    for (size_t i = 0U; i < (sizeof(localeNames) / sizeof(localeNames[0])); i++)
+    {
+        if (std::setlocale(LC_NUMERIC, localeNames[i]) != NULL)
+        {
+            break;
+        }
+    }
+
+    extractDocument(&columnarExtractor,
+                    "<a><r v=\"1.25\"/><r v=\"-2.5e3\"/><r v=\"1,5\"/></a>");
+    std::setlocale(LC_NUMERIC, previousLocale.c_str());
+
+    const ColumnarExtractor::Column &values = columnarExtractor.column(0U);
+    ASSERT_EQ(3U, values.doubleValues.size());
+    EXPECT_DOUBLE_EQ(1.25, values.doubleValues.at(0U));
+    EXPECT_DOUBLE_EQ(-2500.0, values.doubleValues.at(1U));
+    EXPECT_TRUE(columnarExtractor.isValid(0U, 0U));
+    EXPECT_TRUE(columnarExtractor.isValid(0U, 1U));
+    EXPECT_FALSE(columnarExtractor.isValid(0U, 2U));
+    EXPECT_EQ(1U, columnarExtractor.conversionErrorCount());
+}
+
+TEST(EmbeddedStAX_XmlReader_ColumnarExtractor, BatchTest)
+{
+    ColumnarExtractor columnarExtractor;
+    ASSERT_TRUE(columnarExtractor.setRecordPath(Utf8::toUnicodeString("/a/r")));
+    ASSERT_EQ(0U, columnarExtractor.addField(Utf8::toUnicodeString("v"),
+                                             ColumnarExtractor::ColumnType_Int64));
+    columnarExtractor.setBatchSize(10U);
+    EXPECT_EQ(10U, columnarExtractor.batchSize());
+
+    std::string document("<a>");
+
+    for (size_t i = 0U; i < 25U; i++)
+    {
+        document.append("<r><v>");
+        document.push_back(static_cast<char>('0' + (i % 10U)));
+        document.append("</v></r>");
+    }
+
+    document.append("</a>");
+
+    // Take the batches as soon as they are full
+    XmlReader xmlReader;
+    ASSERT_EQ(document.size(), xmlReader.writeData(document));
+    size_t batchCount = 0U;
+    size_t rowCount = 0U;
+    bool finished = false;
+
+    while (!finished)
+    {
+        const XmlReader::ParsingResult result = xmlReader.parse();
+        columnarExtractor.processEvent(xmlReader, result);
+
+        if (columnarExtractor.isBatchFull())
+        {
+            EXPECT_EQ(10U, columnarExtractor.rowCount());
+            const uint32_t validity =
+                    static_cast<uint32_t>(columnarExtractor.column(0U).validity.at(0U)) |
+                    (static_cast<uint32_t>(columnarExtractor.column(0U).validity.at(1U)) << 8);
+            EXPECT_EQ(0x03FFU, validity);
+            EXPECT_EQ(9, columnarExtractor.column(0U).int64Values.at(9U));
+            rowCount += columnarExtractor.rowCount();
+            batchCount++;
+            columnarExtractor.clearBatch();
+        }
+
+        finished = (result == XmlReader::ParsingResult_NeedMoreData);
+    }
+
+    EXPECT_EQ(2U, batchCount);
+    EXPECT_EQ(5U, columnarExtractor.rowCount());
+    EXPECT_EQ(25U, rowCount + columnarExtractor.rowCount());
+
+    // Incomplete record is discarded
+    extractDocument(&columnarExtractor, "<a><r><v>1</v></r><r><v>2</v>");
+    EXPECT_EQ(6U, columnarExtractor.rowCount());
+    columnarExtractor.startNewDocument();
+    EXPECT_EQ(6U, columnarExtractor.column(0U).int64Values.size());
+    EXPECT_EQ(1U, columnarExtractor.column(0U).validity.size());
+}
+
+TEST(EmbeddedStAX_XmlReader_ColumnarExtractor, InvalidConfigurationTest)
+{
+    ColumnarExtractor columnarExtractor;
+    const ColumnarExtractor::ColumnType type = ColumnarExtractor::ColumnType_String;
+
+    // Record path is not set
+    EXPECT_EQ(UnicodeString::npos,
+              columnarExtractor.addField(Utf8::toUnicodeString("a"), type));
+
+    // Invalid paths
+    EXPECT_FALSE(columnarExtractor.setRecordPath(UnicodeString()));
+    EXPECT_FALSE(columnarExtractor.setRecordPath(Utf8::toUnicodeString("/a/1b")));
+    ASSERT_TRUE(columnarExtractor.setRecordPath(Utf8::toUnicodeString("/a/b")));
+    EXPECT_EQ(UnicodeString::npos,
+              columnarExtractor.addField(Utf8::toUnicodeString("c/"), type));
+    EXPECT_EQ(UnicodeString::npos,
+              columnarExtractor.addField(Utf8::toUnicodeString("c@d"), type));
+    EXPECT_EQ(UnicodeString::npos,
+              columnarExtractor.addField(Utf8::toUnicodeString("@1"), type));
+    EXPECT_EQ(UnicodeString::npos,
+              columnarExtractor.addField(Utf8::toUnicodeString("@d/e"), type));
+    EXPECT_EQ(0U, columnarExtractor.columnCount());
+
+    // Fields can not be added to a batch with rows
+    ASSERT_EQ(0U, columnarExtractor.addField(Utf8::toUnicodeString("@d"), type));
+    extractDocument(&columnarExtractor, "<a><b d=\"x\"/></a>");
+    EXPECT_EQ(1U, columnarExtractor.rowCount());
+    EXPECT_EQ(UnicodeString::npos,
+              columnarExtractor.addField(Utf8::toUnicodeString("c"), type));
+    columnarExtractor.clearBatch();
+    EXPECT_EQ(1U, columnarExtractor.addField(Utf8::toUnicodeString("c"), type));
+
+    // Record path clears the fields
+    ASSERT_TRUE(columnarExtractor.setRecordPath(Utf8::toUnicodeString("/a")));
+    EXPECT_EQ(0U, columnarExtractor.columnCount());
+}
@@ -0,0 +1,433 @@
+#include <gtest/gtest.h>
+#include <EmbeddedStAX/XmlReader/RewriteEngine.h>
+#include <cmath>
+#include <ctime>
+#include <sstream>
+
+using namespace EmbeddedStAX::XmlReader;
+
+//--------------------------------------------------------------------------------------------------
+// Test case: Asymptotic complexity of EmbeddedStAX::XmlReader::XmlReader::parse() and
+//            EmbeddedStAX::XmlReader::RewriteEngine::process()
+//
+// Each test generates documents of size N, 2N, 4N and 8N for a single construct, measures the
+// parsing time and fits the scaling exponent (slope of the log-log least squares line). Parsing
+// time has to scale linearly with the size of the document, the exponent has to stay below the
+// tolerance (quadratic parsing has an exponent of about 2).
+//--------------------------------------------------------------------------------------------------
+typedef std::string (*DocumentGenerator)(const size_t size);
+typedef double (*DocumentParser)(const std::string &document, bool *success);
+
+static const size_t BaseSize = 4000U;
+static const size_t RunCount = 3U;
+static const double MaxExponent = 1.5;
+
+/**
+ * Parse the document (written to the reader all at once) and return the parsing time (CPU time in
+ * seconds)
+ */
+static double parseDocument(const std::string &document, bool *success)
+{
+    XmlReader xmlReader;
+    bool finished = false;
+    size_t depth = 0U;
+    *success = false;
+
+    const std::clock_t startTime = std::clock();
+    xmlReader.writeData(document);
+
+    while (!finished)
+    {
+        switch (xmlReader.parse())
+        {
+            case XmlReader::ParsingResult_StartOfElement:
+            {
+                depth++;
+                break;
+            }
+
+            case XmlReader::ParsingResult_EndOfElement:
+            {
+                depth--;
+
+                if (depth == 0U)
+                {
+                    *success = true;
+                }
+                break;
+            }
+
+            case XmlReader::ParsingResult_NeedMoreData:
+            case XmlReader::ParsingResult_Error:
+            {
+                finished = true;
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
+        }
+    }
+
+    const std::clock_t endTime = std::clock();
+    return static_cast<double>(endTime - startTime) / static_cast<double>(CLOCKS_PER_SEC);
+}
+
+/**
+ * Parse a stream of documents (written to the reader with error recovery all at once) and return
+ * the parsing time (CPU time in seconds)
+ */
+static double parseDocumentStream(const std::string &document, bool *success)
+{
+    XmlReader xmlReader;
+    xmlReader.setErrorRecoveryEnabled(true);
+    bool finished = false;
+    size_t depth = 0U;
+    size_t documentCount = 0U;
+    *success = true;
+
+    const std::clock_t startTime = std::clock();
+    xmlReader.writeData(document);
+
+    while (!finished)
+    {
+        switch (xmlReader.parse())
+        {
+            case XmlReader::ParsingResult_StartOfElement:
+            {
+                depth++;
+                break;
+            }
+
+            case XmlReader::ParsingResult_EndOfElement:
+            {
+                depth--;
+
+                if (depth == 0U)
+                {
+                    // Documents follow each other in the stream
+                    documentCount++;
+                    xmlReader.startNewDocument();
+                }
+                break;
+            }
+
+            case XmlReader::ParsingResult_NeedMoreData:
+            {
+                finished = true;
+                break;
+            }
+
+            case XmlReader::ParsingResult_DataDiscarded:
+            case XmlReader::ParsingResult_Error:
+            {
+                *success = false;
+                finished = true;
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
+        }
+    }
+
+    const std::clock_t endTime = std::clock();
+
+    if (documentCount == 0U)
+    {
+        *success = false;
+    }
+
+    return static_cast<double>(endTime - startTime) / static_cast<double>(CLOCKS_PER_SEC);
+}
+
+/**
+ * Rewrite the document (written to the rewrite engine all at once, without rules so that all of
+ * the events are copied as raw byte ranges) and return the rewriting time (CPU time in seconds)
+ */
+static double rewriteDocument(const std::string &document, bool *success)
+{
+    RewriteEngine rewriteEngine;
+    bool finished = false;
+    *success = false;
+
+    const std::clock_t startTime = std::clock();
+    rewriteEngine.startNewStream();
+    rewriteEngine.writeData(document);
+
+    while (!finished)
+    {
+        switch (rewriteEngine.process())
+        {
+            case XmlReader::ParsingResult_NeedMoreData:
+            {
+                rewriteEngine.finish();
+                *success = (rewriteEngine.output() == document);
+                finished = true;
+                break;
+            }
+
+            case XmlReader::ParsingResult_Error:
+            {
+                finished = true;
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
+        }
+    }
+
+    const std::clock_t endTime = std::clock();
+    return static_cast<double>(endTime - startTime) / static_cast<double>(CLOCKS_PER_SEC);
+}
+
+/**
+ * Measure the scaling exponent of the parsing time for the generated documents
+ *
+ * \note The best of several runs is used for each size to reduce the noise.
+ */
+static double measureScalingExponent(DocumentGenerator generator,
+                                     DocumentParser parser = &parseDocument)
+{
+    double sumX = 0.0;
+    double sumY = 0.0;
+    double sumXX = 0.0;
+    double sumXY = 0.0;
+    size_t pointCount = 0U;
+
+    for (size_t size = BaseSize; size <= (8U * BaseSize); size *= 2U)
+    {
+        const std::string document = generator(size);
+        double bestTime = 0.0;
+
+        for (size_t run = 0U; run < RunCount; run++)
+        {
+            bool success = false;
+            const double time = parser(document, &success);
+            EXPECT_TRUE(success);
+
+            if ((run == 0U) || (time < bestTime))
+            {
+                bestTime = time;
+            }
+        }
+
+        // Guard against timer resolution
+        if (bestTime < 1.0e-6)
+        {
+            bestTime = 1.0e-6;
+        }
+
+        const double x = std::log(static_cast<double>(size));
+        const double y = std::log(bestTime);
+        sumX += x;
+        sumY += y;
+        sumXX += x * x;
+        sumXY += x * y;
+        pointCount++;
+    }
+
+    const double n = static_cast<double>(pointCount);
+    return ((n * sumXY) - (sumX * sumY)) / ((n * sumXX) - (sumX * sumX));
+}
+
+// Document generators *****************************************************************************
+static std::string generateLongText(const size_t size)
+{
+    std::string document("<root>");
+
+    for (size_t i = 0U; i < size; i++)
+    {
+        document.append("text> ");
+    }
+
+    document.append("</root>");
+    return document;
+}
+
+static std::string generateLongCData(const size_t size)
+{
+    std::string document("<root><![CDATA[");
+
+    for (size_t i = 0U; i < size; i++)
+    {
+        document.append("]>]<x ");
+    }
+
+    document.append("]]></root>");
+    return document;
+}
+
+static std::string generateLongComment(const size_t size)
+{
+    std::string document("<root><!--");
+
+    for (size_t i = 0U; i < size; i++)
+    {
+        document.append("-text ");
+    }
+
+    document.append("--></root>");
+    return document;
+}
+
+static std::string generateManyAttributes(const size_t size)
+{
+    std::ostringstream document;
+    document << "<root";
+
+    for (size_t i = 0U; i < size; i++)
+    {
+        document << " a" << i << "='v'";
+    }
+
+    document << "/>";
+    return document.str();
+}
+
+static std::string generateCollidingAttributeNames(const size_t size)
+{
+    // Characters U+00061, U+10061, ..., U+E0061 differ only above the low 16 bits, so the low 16
+    // bits of the FNV-1a hashes of all names with the same length are equal
+    std::ostringstream document;
+    document << "<root";
+
+    for (size_t i = 0U; i < size; i++)
+    {
+        size_t value = i;
+        document << ' ';
+
+        for (size_t position = 0U; position < 4U; position++)
+        {
+            const uint32_t plane = static_cast<uint32_t>(value % 15U);
+
+            if (plane == 0U)
+            {
+                document << 'a';
+            }
+            else
+            {
+                // UTF-8 encoding of the character (plane << 16) + 0x61
+                document << static_cast<char>(0xF0U | (plane >> 2))
+                         << static_cast<char>(0x80U | ((plane & 0x03U) << 4))
+                         << static_cast<char>(0x81U)
+                         << static_cast<char>(0xA1U);
+            }
+
+            value /= 15U;
+        }
+
+        document << "='v'";
+    }
+
+    document << "/>";
+    return document.str();
+}
+
+static std::string generateDeepNesting(const size_t size)
+{
+    std::string document;
+
+    for (size_t i = 0U; i < size; i++)
+    {
+        document.append("<e>");
+    }
+
+    for (size_t i = 0U; i < size; i++)
+    {
+        document.append("</e>");
+    }
+
+    return document;
+}
+
+static std::string generateManyReferences(const size_t size)
+{
+    std::string document("<root>");
+
+    for (size_t i = 0U; i < size; i++)
+    {
+        document.append("&amp;&#65;&#x42;");
+    }
+
+    document.append("</root>");
+    return document;
+}
+
+static std::string generateManyDocuments(const size_t size)
+{
+    std::string document;
+
+    for (size_t i = 0U; i < size; i++)
+    {
+        document.append("<m a='1'>hello</m>");
+    }
+
+    return document;
+}
+
+static std::string generateManyRecords(const size_t size)
+{
+    std::string document("<root>");
+
+    for (size_t i = 0U; i < size; i++)
+    {
+        document.append("<r a='1'>hello</r>");
+    }
+
+    document.append("</root>");
+    return document;
+}
+
+// Tests *******************************************************************************************
+TEST(EmbeddedStAX_XmlReader_Complexity, LongTextTest)
+{
+    EXPECT_LT(measureScalingExponent(&generateLongText), MaxExponent);
+}
+
+TEST(EmbeddedStAX_XmlReader_Complexity, LongCDataTest)
+{
+    EXPECT_LT(measureScalingExponent(&generateLongCData), MaxExponent);
+}
+
+TEST(EmbeddedStAX_XmlReader_Complexity, LongCommentTest)
+{
+    EXPECT_LT(measureScalingExponent(&generateLongComment), MaxExponent);
+}
+
+TEST(EmbeddedStAX_XmlReader_Complexity, ManyAttributesTest)
+{
+    EXPECT_LT(measureScalingExponent(&generateManyAttributes), MaxExponent);
+}
+
+TEST(EmbeddedStAX_XmlReader_Complexity, CollidingAttributeNamesTest)
+{
+    EXPECT_LT(measureScalingExponent(&generateCollidingAttributeNames), MaxExponent);
+}
+
+TEST(EmbeddedStAX_XmlReader_Complexity, DeepNestingTest)
+{
+    EXPECT_LT(measureScalingExponent(&generateDeepNesting), MaxExponent);
+}
+
+TEST(EmbeddedStAX_XmlReader_Complexity, ManyReferencesTest)
+{
+    EXPECT_LT(measureScalingExponent(&generateManyReferences), MaxExponent);
+}
+
+TEST(EmbeddedStAX_XmlReader_Complexity, ManyDocumentsTest)
+{
+    EXPECT_LT(measureScalingExponent(&generateManyDocuments, &parseDocumentStream), MaxExponent);
+}
+
+TEST(EmbeddedStAX_XmlReader_Complexity, RewriteManyRecordsTest)
+{
+    EXPECT_LT(measureScalingExponent(&generateManyRecords, &rewriteDocument), MaxExponent);
+}
@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+#include <EmbeddedStAX/XmlReader/ContentModel.h>
+#include <sstream>
+
+using namespace EmbeddedStAX::XmlReader;
+using EmbeddedStAX::Common::UnicodeString;
+using EmbeddedStAX::Common::Utf8;
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::XmlReader::NameTable
+//--------------------------------------------------------------------------------------------------
+TEST(EmbeddedStAX_XmlReader_NameTable, AddFindTest)
+{
+    NameTable nameTable;
+    EXPECT_EQ(0U, nameTable.size());
+    EXPECT_EQ(UnicodeString::npos, nameTable.find(Utf8::toUnicodeString("a")));
+
+    EXPECT_EQ(0U, nameTable.add(Utf8::toUnicodeString("a")));
+    EXPECT_EQ(1U, nameTable.add(Utf8::toUnicodeString("b")));
+    EXPECT_EQ(0U, nameTable.add(Utf8::toUnicodeString("a")));
+    EXPECT_EQ(2U, nameTable.size());
+
+    // Many names (the hash table has to grow)
+    for (char c = 'a'; c <= 'z'; c++)
+    {
+        nameTable.add(Utf8::toUnicodeString(std::string("x") + c));
+    }
+
+    EXPECT_EQ(28U, nameTable.size());
+    EXPECT_EQ(1U, nameTable.find(Utf8::toUnicodeString("b")));
+    EXPECT_EQ(Utf8::toUnicodeString("xq"),
+              nameTable.name(nameTable.find(Utf8::toUnicodeString("xq"))));
+    EXPECT_EQ(UnicodeString::npos, nameTable.find(Utf8::toUnicodeString("c")));
+
+    nameTable.clear();
+    EXPECT_EQ(0U, nameTable.size());
+    EXPECT_EQ(UnicodeString::npos, nameTable.find(Utf8::toUnicodeString("a")));
+}
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::XmlReader::ContentModel
+//--------------------------------------------------------------------------------------------------
+
+/**
+ * Run the automaton of the content model over a sequence of element names
+ *
+ * \param contentModel  Content model
+ * \param nameTable     Name table
+ * \param names         Element names separated with spaces
+ *
+ * \retval true     Sequence is accepted
+ * \retval false    Sequence is not accepted
+ */
+static bool acceptsSequence(const ContentModel &contentModel,
+                            const NameTable &nameTable,
+                            const std::string &names)
+{
+    size_t state = 0U;
+    size_t position = 0U;
+
+    while ((state != UnicodeString::npos) && (position < names.size()))
+    {
+        size_t end = names.find(' ', position);
+
+        if (end == std::string::npos)
+        {
+            end = names.size();
+        }
+
+        const size_t nameId =
+                nameTable.find(Utf8::toUnicodeString(names.substr(position, end - position)));
+        state = contentModel.nextState(state, nameId);
+        position = end + 1U;
+    }
+
+    return contentModel.isAcceptingState(state);
+}
+
+TEST(EmbeddedStAX_XmlReader_ContentModel, CompileTest)
+{
+    NameTable nameTable;
+    ContentModel contentModel;
+
+    EXPECT_TRUE(contentModel.compile(Utf8::toUnicodeString("EMPTY"), &nameTable));
+    EXPECT_EQ(ContentModel::Type_Empty, contentModel.type());
+    EXPECT_FALSE(contentModel.isTextAllowed());
+
+    EXPECT_TRUE(contentModel.compile(Utf8::toUnicodeString(" ANY "), &nameTable));
+    EXPECT_EQ(ContentModel::Type_Any, contentModel.type());
+    EXPECT_TRUE(contentModel.isTextAllowed());
+
+    EXPECT_TRUE(contentModel.compile(Utf8::toUnicodeString("(#PCDATA)"), &nameTable));
+    EXPECT_EQ(ContentModel::Type_Mixed, contentModel.type());
+    EXPECT_EQ(0U, contentModel.symbolCount());
+
+    EXPECT_TRUE(contentModel.compile(Utf8::toUnicodeString("( #PCDATA | b | i )*"), &nameTable));
+    EXPECT_EQ(ContentModel::Type_Mixed, contentModel.type());
+    EXPECT_EQ(2U, contentModel.symbolCount());
+
+    EXPECT_TRUE(contentModel.compile(Utf8::toUnicodeString("(a, (b | c)*, d?)+"), &nameTable));
+    EXPECT_EQ(ContentModel::Type_Children, contentModel.type());
+    EXPECT_FALSE(contentModel.isTextAllowed());
+
+    // Invalid content specifications
+    EXPECT_FALSE(contentModel.compile(UnicodeString(), &nameTable));
+    EXPECT_FALSE(contentModel.compile(Utf8::toUnicodeString("EMPTY x"), &nameTable));
+    EXPECT_FALSE(contentModel.compile(Utf8::toUnicodeString("(#PCDATA | b)"), &nameTable));
+    EXPECT_FALSE(contentModel.compile(Utf8::toUnicodeString("(#PCDATA | b | b)*"), &nameTable));
+    EXPECT_FALSE(contentModel.compile(Utf8::toUnicodeString("(a | b, c)"), &nameTable));
+    EXPECT_FALSE(contentModel.compile(Utf8::toUnicodeString("(a, b"), &nameTable));
+    EXPECT_FALSE(contentModel.compile(Utf8::toUnicodeString("()"), &nameTable));
+    EXPECT_FALSE(contentModel.compile(Utf8::toUnicodeString("(a,)"), &nameTable));
+    EXPECT_FALSE(contentModel.compile(Utf8::toUnicodeString("a"), &nameTable));
+    EXPECT_FALSE(contentModel.compile(Utf8::toUnicodeString("(1a)"), &nameTable));
+    EXPECT_FALSE(contentModel.compile(Utf8::toUnicodeString("(a)"), NULL));
+}
+
+TEST(EmbeddedStAX_XmlReader_ContentModel, AutomatonTest)
+{
+    NameTable nameTable;
+    ContentModel contentModel;
+    ASSERT_TRUE(contentModel.compile(Utf8::toUnicodeString("(head, (p | list)*, foot?)"),
+                                     &nameTable));
+
+    EXPECT_TRUE(acceptsSequence(contentModel, nameTable, "head"));
+    EXPECT_TRUE(acceptsSequence(contentModel, nameTable, "head p list p"));
+    EXPECT_TRUE(acceptsSequence(contentModel, nameTable, "head foot"));
+    EXPECT_TRUE(acceptsSequence(contentModel, nameTable, "head list foot"));
+    EXPECT_FALSE(acceptsSequence(contentModel, nameTable, ""));
+    EXPECT_FALSE(acceptsSequence(contentModel, nameTable, "p"));
+    EXPECT_FALSE(acceptsSequence(contentModel, nameTable, "head foot p"));
+    EXPECT_FALSE(acceptsSequence(contentModel, nameTable, "head head"));
+    EXPECT_FALSE(acceptsSequence(contentModel, nameTable, "head other"));
+
+    // Non-deterministic content model is also compiled
+    ASSERT_TRUE(contentModel.compile(Utf8::toUnicodeString("((a, b) | (a, c))+"), &nameTable));
+    EXPECT_TRUE(acceptsSequence(contentModel, nameTable, "a b"));
+    EXPECT_TRUE(acceptsSequence(contentModel, nameTable, "a c a b"));
+    EXPECT_FALSE(acceptsSequence(contentModel, nameTable, "a"));
+    EXPECT_FALSE(acceptsSequence(contentModel, nameTable, "a b c"));
+
+    // Mixed content
+    ASSERT_TRUE(contentModel.compile(Utf8::toUnicodeString("(#PCDATA | b | i)*"), &nameTable));
+    EXPECT_TRUE(acceptsSequence(contentModel, nameTable, ""));
+    EXPECT_TRUE(acceptsSequence(contentModel, nameTable, "b i b"));
+    EXPECT_FALSE(acceptsSequence(contentModel, nameTable, "b p"));
+
+    // Any content
+    ASSERT_TRUE(contentModel.compile(Utf8::toUnicodeString("ANY"), &nameTable));
+    EXPECT_TRUE(acceptsSequence(contentModel, nameTable, "a p foot"));
+
+    // Empty content
+    ASSERT_TRUE(contentModel.compile(Utf8::toUnicodeString("EMPTY"), &nameTable));
+    EXPECT_TRUE(acceptsSequence(contentModel, nameTable, ""));
+    EXPECT_FALSE(acceptsSequence(contentModel, nameTable, "a"));
+}
+
+TEST(EmbeddedStAX_XmlReader_ContentModel, StateLimitTest)
+{
+    NameTable nameTable;
+    ContentModel contentModel;
+
+    // Deterministic sequence with more than 256 names
+    std::string contentSpec("(");
+    std::string names;
+
+    for (size_t i = 0U; i < 300U; i++)
+    {
+        std::ostringstream name;
+        name << "e" << i;
+
+        if (i > 0U)
+        {
+            contentSpec.append(",");
+            names.append(" ");
+        }
+
+        contentSpec.append(name.str());
+        names.append(name.str());
+    }
+
+    contentSpec.append(")");
+
+    ASSERT_TRUE(contentModel.compile(Utf8::toUnicodeString(contentSpec), &nameTable));
+    EXPECT_EQ(301U, contentModel.stateCount());
+    EXPECT_TRUE(acceptsSequence(contentModel, nameTable, names));
+    EXPECT_FALSE(acceptsSequence(contentModel, nameTable, names.substr(0U, names.rfind(' '))));
+
+    // Number of states of a non-deterministic content model is limited: "(a | b)*, a, (a | b)" with
+    // n - 1 repetitions of "(a | b)" needs 2^n states and the start state
+    ASSERT_TRUE(contentModel.compile(Utf8::toUnicodeString("((a | b)*, a, (a | b), (a | b))"),
+                                     &nameTable));
+    EXPECT_EQ(9U, contentModel.stateCount());
+    EXPECT_TRUE(acceptsSequence(contentModel, nameTable, "b a b b"));
+    EXPECT_FALSE(acceptsSequence(contentModel, nameTable, "a b b b"));
+
+    std::string blowUpSpec("((a | b)*, a");
+
+    for (size_t i = 0U; i < 8U; i++)
+    {
+        blowUpSpec.append(", (a | b)");
+    }
+
+    blowUpSpec.append(")");
+    EXPECT_FALSE(contentModel.compile(Utf8::toUnicodeString(blowUpSpec), &nameTable));
+}
+
+TEST(EmbeddedStAX_XmlReader_ContentModel, TransitionLimitTest)
+{
+    NameTable nameTable;
+    ContentModel contentModel;
+
+    // Long sequence only stores one transition per state
+    std::string sequenceSpec("(");
+    std::string choiceSpec("(");
+    std::string names;
+
+    for (size_t i = 0U; i < 4000U; i++)
+    {
+        std::ostringstream name;
+        name << "e" << i;
+
+        if (i > 0U)
+        {
+            sequenceSpec.append(",");
+            choiceSpec.append("|");
+            names.append(" ");
+        }
+
+        sequenceSpec.append(name.str());
+        choiceSpec.append(name.str());
+        names.append(name.str());
+    }
+
+    sequenceSpec.append(")");
+    choiceSpec.append(")*");
+
+    ASSERT_TRUE(contentModel.compile(Utf8::toUnicodeString(sequenceSpec), &nameTable));
+    EXPECT_EQ(4001U, contentModel.stateCount());
+    EXPECT_EQ(4000U, contentModel.symbolCount());
+    EXPECT_TRUE(acceptsSequence(contentModel, nameTable, names));
+    EXPECT_FALSE(acceptsSequence(contentModel, nameTable, "e0 e2"));
+
+    // Repeated choice of all names needs a transition from every state to every state
+    EXPECT_FALSE(contentModel.compile(Utf8::toUnicodeString(choiceSpec), &nameTable));
+
+    ASSERT_TRUE(contentModel.compile(Utf8::toUnicodeString("(e0 | e1 | e2)*"), &nameTable));
+    EXPECT_EQ(4U, contentModel.stateCount());
+    EXPECT_TRUE(acceptsSequence(contentModel, nameTable, "e2 e0 e1 e1"));
+}
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include <EmbeddedStAX/XmlReader/PathRouter.h>
+#include <vector>
+#include "XmlReaderTestHelper.h"
+
+using namespace EmbeddedStAX::XmlReader;
+using EmbeddedStAX::Common::UnicodeString;
+using EmbeddedStAX::Common::Utf8;
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::XmlReader::PathRouter
+//--------------------------------------------------------------------------------------------------
+typedef std::vector<XmlReader::ParsingResult> ParsingResultList;
+
+/**
+ * Path handler that records the events passed to it
+ */
+class RecordingPathHandler: public AbstractPathHandler
+{
+public:
+    void handleEvent(const XmlReader &, const XmlReader::ParsingResult parsingResult)
+    {
+        resultList.push_back(parsingResult);
+    }
+
+    ParsingResultList resultList;
+};
+
+static const std::string PathDocument(
+        "<r><a>text<b/><b x='1'></b></a><!--comment--><a><c/></a></r>");
+
+TEST(EmbeddedStAX_XmlReader_PathRouter, PathHashTest)
+{
+    std::vector<std::string> expectedPathList;
+    expectedPathList.push_back("/r");           // Start r
+    expectedPathList.push_back("/r/a");         // Start a
+    expectedPathList.push_back("/r/a");         // Text
+    expectedPathList.push_back("/r/a/b");       // Start b
+    expectedPathList.push_back("/r/a/b");       // End b
+    expectedPathList.push_back("/r/a/b");       // Start b
+    expectedPathList.push_back("/r/a/b");       // End b
+    expectedPathList.push_back("/r/a");         // End a
+    expectedPathList.push_back("/r");           // Comment
+    expectedPathList.push_back("/r/a");         // Start a
+    expectedPathList.push_back("/r/a/c");       // Start c
+    expectedPathList.push_back("/r/a/c");       // End c
+    expectedPathList.push_back("/r/a");         // End a
+    expectedPathList.push_back("/r");           // End r
+
+    for (size_t chunkSize = 1U; chunkSize <= 4U; chunkSize++)
+    {
+        XmlReader xmlReader;
+        EXPECT_EQ(XmlReader::calculatePathHash(UnicodeString()), xmlReader.pathHash());
+        EXPECT_TRUE(xmlReader.isCurrentPath(UnicodeString()));
+
+        size_t position = 0U;
+        size_t eventIndex = 0U;
+        bool finished = false;
+
+        while (!finished)
+        {
+            const XmlReader::ParsingResult result =
+                    parseNextEvent(&xmlReader, PathDocument, chunkSize, &position);
+
+            if (result == XmlReader::ParsingResult_NeedMoreData)
+            {
+                // All of the document was written
+                finished = true;
+            }
+            else if ((result == XmlReader::ParsingResult_Error) ||
+                     (eventIndex >= expectedPathList.size()))
+            {
+                ADD_FAILURE() << "Unexpected event: " << result;
+                finished = true;
+            }
+            else
+            {
+                const UnicodeString path =
+                        Utf8::toUnicodeString(expectedPathList.at(eventIndex));
+                EXPECT_EQ(XmlReader::calculatePathHash(path), xmlReader.pathHash())
+                        << "Event: " << eventIndex;
+                EXPECT_TRUE(xmlReader.isCurrentPath(path)) << "Event: " << eventIndex;
+                EXPECT_FALSE(xmlReader.isCurrentPath(Utf8::toUnicodeString("/r/x")));
+                EXPECT_FALSE(xmlReader.isCurrentPath(path + Utf8::toUnicodeString("/b")));
+                eventIndex++;
+            }
+        }
+
+        EXPECT_EQ(expectedPathList.size(), eventIndex);
+        EXPECT_EQ(XmlReader::calculatePathHash(UnicodeString()), xmlReader.pathHash());
+    }
+}
+
+TEST(EmbeddedStAX_XmlReader_PathRouter, AddRouteTest)
+{
+    PathRouter router;
+    RecordingPathHandler handler;
+
+    EXPECT_TRUE(router.addRoute(Utf8::toUnicodeString("/r"), &handler));
+    EXPECT_TRUE(router.addRoute(Utf8::toUnicodeString("/r/a"), &handler));
+    EXPECT_TRUE(router.addRoute(Utf8::toUnicodeString("/r/a/b"), &handler));
+
+    // Duplicate route
+    EXPECT_FALSE(router.addRoute(Utf8::toUnicodeString("/r/a"), &handler));
+
+    // Invalid routes
+    EXPECT_FALSE(router.addRoute(Utf8::toUnicodeString("/r/c"), NULL));
+    EXPECT_FALSE(router.addRoute(UnicodeString(), &handler));
+    EXPECT_FALSE(router.addRoute(Utf8::toUnicodeString("r"), &handler));
+    EXPECT_FALSE(router.addRoute(Utf8::toUnicodeString("/"), &handler));
+    EXPECT_FALSE(router.addRoute(Utf8::toUnicodeString("/r/"), &handler));
+    EXPECT_FALSE(router.addRoute(Utf8::toUnicodeString("/r//a"), &handler));
+    EXPECT_FALSE(router.addRoute(Utf8::toUnicodeString("/r/1a"), &handler));
+
+    EXPECT_EQ(3U, router.size());
+
+    // Many routes (the hash table has to grow)
+    for (char c = 'a'; c <= 'z'; c++)
+    {
+        EXPECT_TRUE(router.addRoute(Utf8::toUnicodeString(std::string("/x/") + c), &handler));
+    }
+
+    EXPECT_EQ(29U, router.size());
+
+    router.clear();
+    EXPECT_EQ(0U, router.size());
+}
+
+TEST(EmbeddedStAX_XmlReader_PathRouter, RouteTest)
+{
+    PathRouter router;
+    RecordingPathHandler aHandler;
+    RecordingPathHandler bHandler;
+    RecordingPathHandler cHandler;
+    ASSERT_TRUE(router.addRoute(Utf8::toUnicodeString("/r/a"), &aHandler));
+    ASSERT_TRUE(router.addRoute(Utf8::toUnicodeString("/r/a/b"), &bHandler));
+    ASSERT_TRUE(router.addRoute(Utf8::toUnicodeString("/a/c"), &cHandler));
+
+    for (char c = 'a'; c <= 'z'; c++)
+    {
+        ASSERT_TRUE(router.addRoute(Utf8::toUnicodeString(std::string("/x/") + c), &cHandler));
+    }
+
+    ParsingResultList expectedA;
+    expectedA.push_back(XmlReader::ParsingResult_StartOfElement);
+    expectedA.push_back(XmlReader::ParsingResult_TextNode);
+    expectedA.push_back(XmlReader::ParsingResult_EndOfElement);
+    expectedA.push_back(XmlReader::ParsingResult_StartOfElement);
+    expectedA.push_back(XmlReader::ParsingResult_EndOfElement);
+
+    ParsingResultList expectedB;
+    expectedB.push_back(XmlReader::ParsingResult_StartOfElement);
+    expectedB.push_back(XmlReader::ParsingResult_EndOfElement);
+    expectedB.push_back(XmlReader::ParsingResult_StartOfElement);
+    expectedB.push_back(XmlReader::ParsingResult_EndOfElement);
+
+    XmlReader xmlReader;
+    xmlReader.writeData(PathDocument);
+    size_t unroutedCount = 0U;
+    bool finished = false;
+
+    while (!finished)
+    {
+        const XmlReader::ParsingResult result = xmlReader.parse();
+
+        if ((result == XmlReader::ParsingResult_NeedMoreData) ||
+            (result == XmlReader::ParsingResult_Error))
+        {
+            finished = true;
+        }
+        else if (!router.route(xmlReader, result))
+        {
+            unroutedCount++;
+        }
+    }
+
+    EXPECT_EQ(expectedA, aHandler.resultList);
+    EXPECT_EQ(expectedB, bHandler.resultList);
+    EXPECT_TRUE(cHandler.resultList.empty());
+    EXPECT_EQ(5U, unroutedCount);
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <EmbeddedStAX/XmlReader/XmlReader.h>
+#include <EmbeddedStAX/Common/Utf.h>
+#include "XmlReaderTestHelper.h"
+
+using namespace EmbeddedStAX::Common;
+using namespace EmbeddedStAX::XmlReader;
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::XmlReader::ReferenceParser
+//--------------------------------------------------------------------------------------------------
+TEST(EmbeddedStAX_XmlReader_ReferenceParser, EntityReferenceSplitTest)
+{
+    // Data runs out right after '&'
+    const std::string document = "<root>&amp;&lt;&gt;</root>";
+    XmlReader xmlReader;
+    size_t position = 0U;
+
+    ASSERT_EQ(XmlReader::ParsingResult_StartOfElement,
+              parseNextEvent(&xmlReader, document, 1U, &position));
+    ASSERT_EQ(XmlReader::ParsingResult_TextNode,
+              parseNextEvent(&xmlReader, document, 1U, &position));
+    EXPECT_EQ(Utf8::toUnicodeString("&<>"), xmlReader.text());
+    EXPECT_EQ(XmlReader::ParsingResult_EndOfElement,
+              parseNextEvent(&xmlReader, document, 1U, &position));
+}
+
+TEST(EmbeddedStAX_XmlReader_ReferenceParser, CharacterReferenceSplitTest)
+{
+    // Data runs out right after '&' and right after '&#'
+    const std::string document = "<root a=\"&#65;&#x42;\">&#67;&#x44;</root>";
+    XmlReader xmlReader;
+    size_t position = 0U;
+
+    ASSERT_EQ(XmlReader::ParsingResult_StartOfElement,
+              parseNextEvent(&xmlReader, document, 1U, &position));
+    const AttributeList attributeList = xmlReader.attributeList();
+    ASSERT_EQ(1U, attributeList.size());
+    EXPECT_EQ(Utf8::toUnicodeString("AB"), attributeList.begin()->value());
+
+    ASSERT_EQ(XmlReader::ParsingResult_TextNode,
+              parseNextEvent(&xmlReader, document, 1U, &position));
+    EXPECT_EQ(Utf8::toUnicodeString("CD"), xmlReader.text());
+    EXPECT_EQ(XmlReader::ParsingResult_EndOfElement,
+              parseNextEvent(&xmlReader, document, 1U, &position));
+}
+
+TEST(EmbeddedStAX_XmlReader_ReferenceParser, CharacterReferenceValueTest)
+{
+    // The referenced character is built from the digit values and the ';' is not stored
+    const std::string document = "<root>&#48;&#x3A;&#x3b;&#8364;&#x1F600;</root>";
+    XmlReader xmlReader;
+    size_t position = 0U;
+
+    UnicodeString expectedText;
+    expectedText.push_back(0x30U);
+    expectedText.push_back(0x3AU);
+    expectedText.push_back(0x3BU);
+    expectedText.push_back(0x20ACU);
+    expectedText.push_back(0x1F600U);
+
+    ASSERT_EQ(XmlReader::ParsingResult_StartOfElement,
+              parseNextEvent(&xmlReader, document, 1U, &position));
+    ASSERT_EQ(XmlReader::ParsingResult_TextNode,
+              parseNextEvent(&xmlReader, document, 1U, &position));
+    EXPECT_EQ(expectedText, xmlReader.text());
+    EXPECT_EQ(XmlReader::ParsingResult_EndOfElement,
+              parseNextEvent(&xmlReader, document, 1U, &position));
+}
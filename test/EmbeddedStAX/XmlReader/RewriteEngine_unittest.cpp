@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+#include <EmbeddedStAX/XmlReader/RewriteEngine.h>
+
+using namespace EmbeddedStAX::XmlReader;
+using EmbeddedStAX::Common::Attribute;
+using EmbeddedStAX::Common::QuotationMark_Apostrophe;
+using EmbeddedStAX::Common::UnicodeString;
+using EmbeddedStAX::Common::Utf8;
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::XmlReader::RewriteEngine
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rewrite the document by writing it to the rewrite engine in chunks
+ */
+static std::string rewriteDocument(RewriteEngine *rewriteEngine,
+                                   const std::string &document,
+                                   const size_t chunkSize)
+{
+    rewriteEngine->startNewStream();
+    size_t position = 0U;
+    bool finished = false;
+
+    while (!finished)
+    {
+        const XmlReader::ParsingResult result = rewriteEngine->process();
+
+        if (result == XmlReader::ParsingResult_NeedMoreData)
+        {
+            if (position < document.size())
+            {
+                const std::string chunk = document.substr(position, chunkSize);
+                EXPECT_EQ(chunk.size(), rewriteEngine->writeData(chunk));
+                position += chunk.size();
+            }
+            else
+            {
+                rewriteEngine->finish();
+                finished = true;
+            }
+        }
+        else if (result == XmlReader::ParsingResult_Error)
+        {
+            ADD_FAILURE() << "Parsing error";
+            finished = true;
+        }
+        else
+        {
+            // Continue processing
+        }
+    }
+
+    return rewriteEngine->output();
+}
+
+static const std::string RewriteDocument(
+        "<?xml version=\"1.0\"?>\n"
+        "<!-- order -->\n"
+        "<order id=\"1\">\n"
+        "  <card type='visa'><number>4111 &amp; 1111</number><cvc>123</cvc></card>\n"
+        "  <item><name>A &lt; B</name><note><![CDATA[x]]>y</note></item>\n"
+        "  <empty/>\n"
+        "</order>\n");
+
+TEST(EmbeddedStAX_XmlReader_RewriteEngine, IdentityTest)
+{
+    RewriteEngine rewriteEngine;
+    EXPECT_TRUE(rewriteEngine.addRenameRule(Utf8::toUnicodeString("/other"),
+                                            Utf8::toUnicodeString("x")));
+
+    for (size_t chunkSize = 1U; chunkSize <= 4U; chunkSize++)
+    {
+        EXPECT_EQ(RewriteDocument, rewriteDocument(&rewriteEngine, RewriteDocument, chunkSize));
+        EXPECT_EQ(RewriteDocument.size(), rewriteEngine.copiedSize());
+        EXPECT_EQ(0U, rewriteEngine.rewrittenEventCount());
+    }
+}
+
+TEST(EmbeddedStAX_XmlReader_RewriteEngine, RenameTest)
+{
+    RewriteEngine rewriteEngine;
+    EXPECT_TRUE(rewriteEngine.addRenameRule(Utf8::toUnicodeString("/order"),
+                                            Utf8::toUnicodeString("purchase")));
+    EXPECT_TRUE(rewriteEngine.addRenameRule(Utf8::toUnicodeString("/order/empty"),
+                                            Utf8::toUnicodeString("none")));
+    EXPECT_FALSE(rewriteEngine.addRenameRule(Utf8::toUnicodeString("/order"),
+                                             Utf8::toUnicodeString("other")));
+    EXPECT_EQ(2U, rewriteEngine.ruleCount());
+
+    const std::string expected(
+            "<?xml version=\"1.0\"?>\n"
+            "<!-- order -->\n"
+            "<purchase id=\"1\">\n"
+            "  <card type='visa'><number>4111 &amp; 1111</number><cvc>123</cvc></card>\n"
+            "  <item><name>A &lt; B</name><note><![CDATA[x]]>y</note></item>\n"
+            "  <none/>\n"
+            "</purchase>\n");
+
+    for (size_t chunkSize = 1U; chunkSize <= 4U; chunkSize++)
+    {
+        EXPECT_EQ(expected, rewriteDocument(&rewriteEngine, RewriteDocument, chunkSize));
+        EXPECT_EQ(3U, rewriteEngine.rewrittenEventCount());
+    }
+}
+
+TEST(EmbeddedStAX_XmlReader_RewriteEngine, DropTest)
+{
+    RewriteEngine rewriteEngine;
+    EXPECT_TRUE(rewriteEngine.addDropRule(Utf8::toUnicodeString("/order/card")));
+    EXPECT_TRUE(rewriteEngine.addDropRule(Utf8::toUnicodeString("/order/empty")));
+    EXPECT_TRUE(rewriteEngine.addRenameRule(Utf8::toUnicodeString("/order/card/cvc"),
+                                            Utf8::toUnicodeString("code")));
+    EXPECT_FALSE(rewriteEngine.addDropRule(Utf8::toUnicodeString("/order/card")));
+
+    const std::string expected(
+            "<?xml version=\"1.0\"?>\n"
+            "<!-- order -->\n"
+            "<order id=\"1\">\n"
+            "  \n"
+            "  <item><name>A &lt; B</name><note><![CDATA[x]]>y</note></item>\n"
+            "  \n"
+            "</order>\n");
+
+    for (size_t chunkSize = 1U; chunkSize <= 4U; chunkSize++)
+    {
+        EXPECT_EQ(expected, rewriteDocument(&rewriteEngine, RewriteDocument, chunkSize));
+        EXPECT_EQ(0U, rewriteEngine.rewrittenEventCount());
+    }
+}
+
+TEST(EmbeddedStAX_XmlReader_RewriteEngine, AttributeTest)
+{
+    RewriteEngine rewriteEngine;
+    EXPECT_TRUE(rewriteEngine.addAttributeRule(
+                    Utf8::toUnicodeString("/order/card"),
+                    Attribute(Utf8::toUnicodeString("type"),
+                              Utf8::toUnicodeString("hidden 'x'"),
+                              QuotationMark_Apostrophe)));
+    EXPECT_TRUE(rewriteEngine.addAttributeRule(
+                    Utf8::toUnicodeString("/order/card"),
+                    Attribute(Utf8::toUnicodeString("masked"), Utf8::toUnicodeString("a<b"))));
+    EXPECT_TRUE(rewriteEngine.addAttributeRule(
+                    Utf8::toUnicodeString("/order/empty"),
+                    Attribute(Utf8::toUnicodeString("n"), Utf8::toUnicodeString("1"))));
+    EXPECT_FALSE(rewriteEngine.addAttributeRule(
+                     Utf8::toUnicodeString("/order/card"),
+                     Attribute(Utf8::toUnicodeString("type"), Utf8::toUnicodeString("y"))));
+
+    const std::string expected(
+            "<?xml version=\"1.0\"?>\n"
+            "<!-- order -->\n"
+            "<order id=\"1\">\n"
+            "  <card type='hidden &apos;x&apos;' masked=\"a&lt;b\"><number>4111 &amp; 1111"
+            "</number><cvc>123</cvc></card>\n"
+            "  <item><name>A &lt; B</name><note><![CDATA[x]]>y</note></item>\n"
+            "  <empty n=\"1\"/>\n"
+            "</order>\n");
+
+    for (size_t chunkSize = 1U; chunkSize <= 4U; chunkSize++)
+    {
+        EXPECT_EQ(expected, rewriteDocument(&rewriteEngine, RewriteDocument, chunkSize));
+    }
+}
+
+TEST(EmbeddedStAX_XmlReader_RewriteEngine, TextMaskTest)
+{
+    RewriteEngine rewriteEngine;
+    EXPECT_TRUE(rewriteEngine.addTextMaskRule(Utf8::toUnicodeString("/order/card/number"),
+                                              Utf8::toUnicodeString("****")));
+    EXPECT_TRUE(rewriteEngine.addTextMaskRule(Utf8::toUnicodeString("/order/item/note"),
+                                              Utf8::toUnicodeString("<hidden>")));
+
+    const std::string expected(
+            "<?xml version=\"1.0\"?>\n"
+            "<!-- order -->\n"
+            "<order id=\"1\">\n"
+            "  <card type='visa'><number>****</number><cvc>123</cvc></card>\n"
+            "  <item><name>A &lt; B</name><note>&lt;hidden></note></item>\n"
+            "  <empty/>\n"
+            "</order>\n");
+
+    for (size_t chunkSize = 1U; chunkSize <= 4U; chunkSize++)
+    {
+        EXPECT_EQ(expected, rewriteDocument(&rewriteEngine, RewriteDocument, chunkSize));
+        EXPECT_EQ(2U, rewriteEngine.rewrittenEventCount());
+    }
+}
+
+TEST(EmbeddedStAX_XmlReader_RewriteEngine, InvalidRuleTest)
+{
+    RewriteEngine rewriteEngine;
+    EXPECT_FALSE(rewriteEngine.addDropRule(Utf8::toUnicodeString("order")));
+    EXPECT_FALSE(rewriteEngine.addDropRule(Utf8::toUnicodeString("/order/")));
+    EXPECT_FALSE(rewriteEngine.addRenameRule(Utf8::toUnicodeString("/order"),
+                                             Utf8::toUnicodeString("1x")));
+    EXPECT_FALSE(rewriteEngine.addAttributeRule(Utf8::toUnicodeString("/order"), Attribute()));
+    EXPECT_EQ(0U, rewriteEngine.ruleCount());
+
+    // Many paths (hash table is resized)
+    for (size_t i = 0U; i < 40U; i++)
+    {
+        std::string path("/order/e");
+        path.push_back(static_cast<char>('a' + (i % 26U)));
+        path.push_back(static_cast<char>('a' + (i / 26U)));
+        EXPECT_TRUE(rewriteEngine.addDropRule(Utf8::toUnicodeString(path)));
+    }
+
+    EXPECT_EQ(40U, rewriteEngine.ruleCount());
+    EXPECT_FALSE(rewriteEngine.addDropRule(Utf8::toUnicodeString("/order/eaa")));
+
+    rewriteEngine.clear();
+    EXPECT_EQ(0U, rewriteEngine.ruleCount());
+}
@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+#include <EmbeddedStAX/XmlReader/SchemaValidator.h>
+#include <EmbeddedStAX/XmlReader/XmlReader.h>
+
+using namespace EmbeddedStAX::XmlReader;
+using EmbeddedStAX::Common::UnicodeString;
+using EmbeddedStAX::Common::Utf8;
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::XmlReader::SimpleType
+//--------------------------------------------------------------------------------------------------
+TEST(EmbeddedStAX_XmlReader_SimpleType, StringTest)
+{
+    SimpleType simpleType;
+    EXPECT_EQ(SimpleType::BaseType_String, simpleType.baseType());
+    EXPECT_TRUE(simpleType.validate(UnicodeString()));
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString(" any text ")));
+
+    simpleType.setLengthRange(2U, 4U);
+    EXPECT_FALSE(simpleType.validate(Utf8::toUnicodeString("a")));
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString("ab")));
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString("abcd")));
+    EXPECT_FALSE(simpleType.validate(Utf8::toUnicodeString("abcde")));
+
+    simpleType.addEnumeration(Utf8::toUnicodeString("red"));
+    simpleType.addEnumeration(Utf8::toUnicodeString("blue"));
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString("red")));
+    EXPECT_FALSE(simpleType.validate(Utf8::toUnicodeString("green")));
+    EXPECT_FALSE(simpleType.validate(Utf8::toUnicodeString(" red")));
+
+    simpleType.clearEnumeration();
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString("abc")));
+}
+
+TEST(EmbeddedStAX_XmlReader_SimpleType, BooleanTest)
+{
+    SimpleType simpleType(SimpleType::BaseType_Boolean);
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString("true")));
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString(" false\n")));
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString("1")));
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString("0")));
+    EXPECT_FALSE(simpleType.validate(Utf8::toUnicodeString("True")));
+    EXPECT_FALSE(simpleType.validate(Utf8::toUnicodeString("")));
+    EXPECT_FALSE(simpleType.validate(Utf8::toUnicodeString("t rue")));
+}
+
+TEST(EmbeddedStAX_XmlReader_SimpleType, IntegerTest)
+{
+    SimpleType simpleType(SimpleType::BaseType_Integer);
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString("0")));
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString(" -123 ")));
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString("+42")));
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString("2147483647")));
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString("-2147483648")));
+    EXPECT_FALSE(simpleType.validate(Utf8::toUnicodeString("2147483648")));
+    EXPECT_FALSE(simpleType.validate(Utf8::toUnicodeString("99999999999")));
+    EXPECT_FALSE(simpleType.validate(Utf8::toUnicodeString("")));
+    EXPECT_FALSE(simpleType.validate(Utf8::toUnicodeString("-")));
+    EXPECT_FALSE(simpleType.validate(Utf8::toUnicodeString("1.0")));
+    EXPECT_FALSE(simpleType.validate(Utf8::toUnicodeString("1 2")));
+
+    simpleType.setValueRange(-10, 10);
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString("-10")));
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString("10")));
+    EXPECT_FALSE(simpleType.validate(Utf8::toUnicodeString("11")));
+    EXPECT_FALSE(simpleType.validate(Utf8::toUnicodeString("-11")));
+
+    simpleType.setLengthRange(0U, 2U);
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString(" 10 ")));
+    EXPECT_FALSE(simpleType.validate(Utf8::toUnicodeString("-10")));
+}
+
+TEST(EmbeddedStAX_XmlReader_SimpleType, DecimalTest)
+{
+    SimpleType simpleType(SimpleType::BaseType_Decimal);
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString("1")));
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString("-1.5")));
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString(".5")));
+    EXPECT_TRUE(simpleType.validate(Utf8::toUnicodeString("5.")));
+    EXPECT_FALSE(simpleType.validate(Utf8::toUnicodeString(".")));
+    EXPECT_FALSE(simpleType.validate(Utf8::toUnicodeString("1.2.3")));
+    EXPECT_FALSE(simpleType.validate(Utf8::toUnicodeString("1e3")));
+}
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::XmlReader::SchemaValidator
+//--------------------------------------------------------------------------------------------------
+
+/**
+ * Parse the document and validate its events
+ *
+ * \param validator Schema validator
+ * \param document  Document
+ *
+ * \return Validation error
+ */
+static SchemaValidator::Error validateDocument(SchemaValidator *validator,
+                                               const std::string &document)
+{
+    XmlReader xmlReader;
+    xmlReader.writeData(document);
+    validator->startNewDocument();
+    bool finished = false;
+
+    while (!finished)
+    {
+        const XmlReader::ParsingResult result = xmlReader.parse();
+
+        if ((result == XmlReader::ParsingResult_NeedMoreData) ||
+            (result == XmlReader::ParsingResult_Error))
+        {
+            EXPECT_EQ(XmlReader::ParsingResult_NeedMoreData, result);
+            finished = true;
+        }
+        else if (result == XmlReader::ParsingResult_StartOfElement)
+        {
+            finished = !validator->validateStartOfElement(xmlReader.name());
+        }
+        else if ((result == XmlReader::ParsingResult_TextNode) ||
+                 (result == XmlReader::ParsingResult_CData))
+        {
+            finished = !validator->validateText(xmlReader.text(),
+                                                result == XmlReader::ParsingResult_CData);
+        }
+        else if (result == XmlReader::ParsingResult_EndOfElement)
+        {
+            finished = !validator->validateEndOfElement();
+        }
+        else
+        {
+            // Other events are not validated
+        }
+    }
+
+    return validator->error();
+}
+
+TEST(EmbeddedStAX_XmlReader_SchemaValidator, DeclarationTest)
+{
+    SchemaValidator validator;
+    EXPECT_TRUE(validator.declareElement(Utf8::toUnicodeString("list"),
+                                         Utf8::toUnicodeString("(item+)")));
+    EXPECT_TRUE(validator.declareElement(Utf8::toUnicodeString("item"),
+                                         Utf8::toUnicodeString("(#PCDATA)")));
+    EXPECT_EQ(2U, validator.elementCount());
+    EXPECT_TRUE(validator.isElementDeclared(Utf8::toUnicodeString("item")));
+    EXPECT_FALSE(validator.isElementDeclared(Utf8::toUnicodeString("other")));
+
+    // Invalid declarations
+    EXPECT_FALSE(validator.declareElement(Utf8::toUnicodeString("list"),
+                                          Utf8::toUnicodeString("ANY")));
+    EXPECT_FALSE(validator.declareElement(Utf8::toUnicodeString("1a"),
+                                          Utf8::toUnicodeString("ANY")));
+    EXPECT_FALSE(validator.declareElement(Utf8::toUnicodeString("other"),
+                                          Utf8::toUnicodeString("(a")));
+    EXPECT_EQ(2U, validator.elementCount());
+
+    // Simple type can only be set for text content
+    EXPECT_TRUE(validator.setElementType(Utf8::toUnicodeString("item"),
+                                         SimpleType(SimpleType::BaseType_Integer)));
+    EXPECT_FALSE(validator.setElementType(Utf8::toUnicodeString("list"),
+                                          SimpleType(SimpleType::BaseType_Integer)));
+    EXPECT_FALSE(validator.setElementType(Utf8::toUnicodeString("other"), SimpleType()));
+
+    EXPECT_TRUE(validator.setRootElement(Utf8::toUnicodeString("list")));
+    EXPECT_FALSE(validator.setRootElement(Utf8::toUnicodeString("other")));
+
+    validator.clear();
+    EXPECT_EQ(0U, validator.elementCount());
+    EXPECT_FALSE(validator.isElementDeclared(Utf8::toUnicodeString("list")));
+}
+
+TEST(EmbeddedStAX_XmlReader_SchemaValidator, ValidateTest)
+{
+    SchemaValidator validator;
+    ASSERT_TRUE(validator.declareElement(Utf8::toUnicodeString("order"),
+                                         Utf8::toUnicodeString("(id, item+, note?)")));
+    ASSERT_TRUE(validator.declareElement(Utf8::toUnicodeString("id"),
+                                         Utf8::toUnicodeString("(#PCDATA)")));
+    ASSERT_TRUE(validator.declareElement(Utf8::toUnicodeString("item"),
+                                         Utf8::toUnicodeString("EMPTY")));
+    ASSERT_TRUE(validator.declareElement(Utf8::toUnicodeString("note"),
+                                         Utf8::toUnicodeString("(#PCDATA | b)*")));
+    ASSERT_TRUE(validator.declareElement(Utf8::toUnicodeString("b"),
+                                         Utf8::toUnicodeString("(#PCDATA)")));
+    SimpleType idType(SimpleType::BaseType_Integer);
+    idType.setValueRange(1, 1000);
+    ASSERT_TRUE(validator.setElementType(Utf8::toUnicodeString("id"), idType));
+    ASSERT_TRUE(validator.setRootElement(Utf8::toUnicodeString("order")));
+
+    EXPECT_EQ(SchemaValidator::Error_None,
+              validateDocument(&validator, "<order><id>7</id><item/></order>"));
+    EXPECT_EQ(SchemaValidator::Error_None,
+              validateDocument(&validator,
+                               "<?xml version=\"1.0\"?>\n"
+                               "<!-- comment -->\n"
+                               "<order>\n"
+                               "  <id> 1000 </id>\n"
+                               "  <item/><item></item>\n"
+                               "  <note>Text <b>bold</b> text<![CDATA[<x>]]></note>\n"
+                               "</order>"));
+
+    // Invalid documents
+    EXPECT_EQ(SchemaValidator::Error_InvalidRootElement,
+              validateDocument(&validator, "<id>7</id>"));
+    EXPECT_EQ(SchemaValidator::Error_UndeclaredElement,
+              validateDocument(&validator, "<order><id>7</id><other/></order>"));
+    EXPECT_EQ(SchemaValidator::Error_UnexpectedElement,
+              validateDocument(&validator, "<order><item/></order>"));
+    EXPECT_EQ(SchemaValidator::Error_UnexpectedElement,
+              validateDocument(&validator, "<order><id>7</id><item/><note/><item/></order>"));
+    EXPECT_EQ(SchemaValidator::Error_UnexpectedText,
+              validateDocument(&validator, "<order>text<id>7</id><item/></order>"));
+    EXPECT_EQ(SchemaValidator::Error_UnexpectedText,
+              validateDocument(&validator, "<order><id>7</id><item> </item></order>"));
+    EXPECT_EQ(SchemaValidator::Error_UnexpectedText,
+              validateDocument(&validator, "<order><![CDATA[ ]]><id>7</id><item/></order>"));
+    EXPECT_EQ(SchemaValidator::Error_IncompleteContent,
+              validateDocument(&validator, "<order><id>7</id></order>"));
+    EXPECT_EQ(SchemaValidator::Error_InvalidValue,
+              validateDocument(&validator, "<order><id>1001</id><item/></order>"));
+    EXPECT_EQ(SchemaValidator::Error_InvalidValue,
+              validateDocument(&validator, "<order><id>x</id><item/></order>"));
+
+    // Validator is reusable after an error
+    EXPECT_EQ(SchemaValidator::Error_None,
+              validateDocument(&validator, "<order><id>7</id><item/></order>"));
+}
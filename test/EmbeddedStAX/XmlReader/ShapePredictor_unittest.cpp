@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <EmbeddedStAX/XmlReader/ShapePredictor.h>
+#include <EmbeddedStAX/XmlReader/XmlReader.h>
+#include <vector>
+#include "XmlReaderTestHelper.h"
+
+using namespace EmbeddedStAX::XmlReader;
+using EmbeddedStAX::Common::UnicodeString;
+using EmbeddedStAX::Common::Utf8;
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::XmlReader::ShapePredictor
+//--------------------------------------------------------------------------------------------------
+TEST(EmbeddedStAX_XmlReader_ShapePredictor, DisabledPredictorTest)
+{
+    ShapePredictor shapePredictor;
+    uint32_t hash = 0U;
+
+    EXPECT_EQ(0U, shapePredictor.capacity());
+    EXPECT_EQ(NULL, shapePredictor.predictName(ShapePredictor::NameType_Element, false, &hash));
+    shapePredictor.addName(Utf8::toUnicodeString("a"), 1U, true, false);
+    EXPECT_EQ(0U, shapePredictor.lookupCount());
+}
+
+TEST(EmbeddedStAX_XmlReader_ShapePredictor, PredictTest)
+{
+    ShapePredictor shapePredictor;
+    shapePredictor.setCapacity(100U);
+    EXPECT_EQ(128U, shapePredictor.capacity());
+
+    const UnicodeString a = Utf8::toUnicodeString("a");
+    const UnicodeString b = Utf8::toUnicodeString("b");
+    uint32_t hash = 0U;
+
+    // Learn the sequence: a, b (attribute), a
+    EXPECT_EQ(NULL, shapePredictor.predictName(ShapePredictor::NameType_Element, true, &hash));
+    shapePredictor.addName(a, 1U, true, false);
+    EXPECT_EQ(NULL, shapePredictor.predictName(ShapePredictor::NameType_Attribute, true, &hash));
+    shapePredictor.addName(b, 2U, false, false);
+    EXPECT_EQ(NULL, shapePredictor.predictName(ShapePredictor::NameType_Element, true, &hash));
+    shapePredictor.addName(a, 1U, true, false);
+
+    // Attribute after "a" is predicted, but only if validation is not needed
+    EXPECT_EQ(NULL, shapePredictor.predictName(ShapePredictor::NameType_Attribute, true, &hash));
+    const UnicodeString *name =
+            shapePredictor.predictName(ShapePredictor::NameType_Attribute, false, &hash);
+    ASSERT_TRUE(name != NULL);
+    EXPECT_EQ(b, *name);
+    EXPECT_EQ(2U, hash);
+    shapePredictor.addName(b, 2U, false, true);
+
+    // Element after "b"
+    name = shapePredictor.predictName(ShapePredictor::NameType_Element, true, &hash);
+    ASSERT_TRUE(name != NULL);
+    EXPECT_EQ(a, *name);
+    shapePredictor.addName(a, 1U, true, true);
+
+    // Element after "a" is not known
+    EXPECT_EQ(NULL, shapePredictor.predictName(ShapePredictor::NameType_Element, false, &hash));
+
+    EXPECT_EQ(7U, shapePredictor.lookupCount());
+    EXPECT_EQ(2U, shapePredictor.predictionCount());
+    EXPECT_EQ(2U, shapePredictor.hitCount());
+    EXPECT_EQ(2U, shapePredictor.skippedCharacterCount());
+
+    // Statistics are kept when learned names are removed
+    shapePredictor.clear();
+    EXPECT_EQ(NULL, shapePredictor.predictName(ShapePredictor::NameType_Element, true, &hash));
+    EXPECT_EQ(8U, shapePredictor.lookupCount());
+
+    shapePredictor.resetStatistics();
+    EXPECT_EQ(0U, shapePredictor.lookupCount());
+    EXPECT_EQ(0U, shapePredictor.predictionCount());
+    EXPECT_EQ(0U, shapePredictor.hitCount());
+    EXPECT_EQ(0U, shapePredictor.skippedCharacterCount());
+}
+
+/**
+ * Parse the document and collect the names of the elements and the attributes
+ */
+static std::vector<UnicodeString> readNames(XmlReader *xmlReader,
+                                            const std::string &document,
+                                            const size_t chunkSize)
+{
+    std::vector<UnicodeString> nameList;
+    size_t position = 0U;
+    bool finished = false;
+
+    while (!finished)
+    {
+        const XmlReader::ParsingResult result =
+                parseNextEvent(xmlReader, document, chunkSize, &position);
+
+        if (result == XmlReader::ParsingResult_NeedMoreData)
+        {
+            // All of the document was written
+            finished = true;
+        }
+        else if (result == XmlReader::ParsingResult_StartOfElement)
+        {
+            const EmbeddedStAX::Common::AttributeList attributeList = xmlReader->attributeList();
+            nameList.push_back(xmlReader->name());
+
+            for (EmbeddedStAX::Common::AttributeList::ConstIterator it = attributeList.begin();
+                 it != attributeList.end();
+                 it++)
+            {
+                nameList.push_back(it->name());
+            }
+        }
+        else if (result == XmlReader::ParsingResult_Error)
+        {
+            nameList.push_back(UnicodeString());
+            finished = true;
+        }
+        else
+        {
+            // Other events
+        }
+    }
+
+    return nameList;
+}
+
+static const std::string RecordDocument(
+        "<r><rec id='1' v='a'><n>x</n></rec>"
+        "<rec id='2' v='b'><n>y</n></rec>"
+        "<rec ids='3' v='c'><n>z</n></rec>"
+        "<record id='4' v='d'><n>z</n></record></r>");
+
+TEST(EmbeddedStAX_XmlReader_ShapePredictor, XmlReaderTest)
+{
+    XmlReader referenceReader;
+    XmlReader xmlReader;
+    xmlReader.setShapePrediction(1024U);
+    const std::vector<UnicodeString> expectedNameList =
+            readNames(&referenceReader, RecordDocument, RecordDocument.size());
+    ASSERT_EQ(17U, expectedNameList.size());
+
+    // Names are the same with prediction (hits and misses)
+    EXPECT_EQ(expectedNameList, readNames(&xmlReader, RecordDocument, RecordDocument.size()));
+    EXPECT_EQ(17U, xmlReader.shapePredictor().lookupCount());
+    EXPECT_EQ(9U, xmlReader.shapePredictor().predictionCount());
+    EXPECT_EQ(7U, xmlReader.shapePredictor().hitCount());
+    EXPECT_EQ(10U, xmlReader.shapePredictor().skippedCharacterCount());
+
+    // Learned names are kept for the next document
+    xmlReader.clear();
+    EXPECT_EQ(expectedNameList, readNames(&xmlReader, RecordDocument, RecordDocument.size()));
+    EXPECT_LT(7U, xmlReader.shapePredictor().hitCount());
+
+    for (size_t chunkSize = 1U; chunkSize <= 4U; chunkSize++)
+    {
+        xmlReader.clear();
+        EXPECT_EQ(expectedNameList, readNames(&xmlReader, RecordDocument, chunkSize));
+    }
+
+    // Names learned in the trusted mode are not predicted in the full validation mode
+    xmlReader.setShapePrediction(1024U);
+    xmlReader.setValidationMode(XmlReader::ValidationMode_Trusted);
+    xmlReader.clear();
+    EXPECT_EQ(expectedNameList, readNames(&xmlReader, RecordDocument, RecordDocument.size()));
+    EXPECT_EQ(7U, xmlReader.shapePredictor().hitCount());
+
+    // Names are learned again (validated) before they are predicted
+    xmlReader.setValidationMode(XmlReader::ValidationMode_Full);
+    xmlReader.clear();
+    EXPECT_EQ(expectedNameList, readNames(&xmlReader, RecordDocument, RecordDocument.size()));
+    EXPECT_EQ(14U, xmlReader.shapePredictor().hitCount());
+
+    // Invalid name is not accepted because it matches the prediction
+    xmlReader.clear();
+    const std::vector<UnicodeString> nameList =
+            readNames(&xmlReader, "<r><rec id='1' v='a'><n>x</n></rec><rec id\x01='2'/></r>", 64U);
+    ASSERT_FALSE(nameList.empty());
+    EXPECT_TRUE(nameList.back().empty());
+}
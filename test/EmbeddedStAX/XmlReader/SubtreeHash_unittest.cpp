@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <EmbeddedStAX/XmlReader/SubtreeHash.h>
+#include <cstdio>
+
+using namespace EmbeddedStAX::XmlReader;
+using EmbeddedStAX::Common::UnicodeString;
+using EmbeddedStAX::Common::Utf8;
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::XmlReader::SubtreeHash
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert the digest to a hexadecimal string
+ */
+static std::string toHex(const std::vector<uint8_t> &digest)
+{
+    std::string hex;
+
+    for (size_t i = 0U; i < digest.size(); i++)
+    {
+        char buffer[3];
+        std::sprintf(buffer, "%02x", static_cast<unsigned int>(digest.at(i)));
+        hex.append(buffer);
+    }
+
+    return hex;
+}
+
+TEST(EmbeddedStAX_XmlReader_SubtreeHash, Sha256Test)
+{
+    EXPECT_EQ("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+              toHex(SubtreeHash::calculateSha256("")));
+    EXPECT_EQ("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+              toHex(SubtreeHash::calculateSha256("abc")));
+    EXPECT_EQ("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+              toHex(SubtreeHash::calculateSha256(
+                        "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")));
+    EXPECT_EQ("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0",
+              toHex(SubtreeHash::calculateSha256(std::string(1000000U, 'a'))));
+}
+
+TEST(EmbeddedStAX_XmlReader_SubtreeHash, FastHashTest)
+{
+    SubtreeHash subtreeHash;
+    EXPECT_FALSE(subtreeHash.isFinished());
+    EXPECT_EQ(0xCBF29CE484222325ULL, subtreeHash.fastHash());
+
+    subtreeHash.appendString(Utf8::toUnicodeString("a"));
+    subtreeHash.finish();
+    EXPECT_TRUE(subtreeHash.isFinished());
+    EXPECT_EQ(0xAF63DC4C8601EC8CULL, subtreeHash.fastHash());
+    EXPECT_TRUE(subtreeHash.sha256().empty());
+
+    // Nothing is appended to a finished hash
+    subtreeHash.appendString(Utf8::toUnicodeString("b"));
+    EXPECT_EQ(0xAF63DC4C8601EC8CULL, subtreeHash.fastHash());
+
+    // Strings are hashed UTF-8 encoded
+    subtreeHash.start(true);
+    subtreeHash.appendString(Utf8::toUnicodeString("\xC3\xA9"));
+    subtreeHash.finish();
+    EXPECT_EQ(SubtreeHash::calculateSha256("\xC3\xA9"), subtreeHash.sha256());
+
+    // Markers separate the strings
+    SubtreeHash other;
+    subtreeHash.start(false);
+    subtreeHash.appendString(Utf8::toUnicodeString("ab"));
+    other.appendString(Utf8::toUnicodeString("a"));
+    other.appendMarker(static_cast<uint8_t>('T'));
+    other.appendString(Utf8::toUnicodeString("b"));
+    EXPECT_NE(subtreeHash.fastHash(), other.fastHash());
+}
@@ -0,0 +1,40 @@
+#ifndef TESTEMBEDDEDSTAX_XMLREADER_XMLREADERTESTHELPER_H
+#define TESTEMBEDDEDSTAX_XMLREADER_XMLREADERTESTHELPER_H
+
+#include <EmbeddedStAX/XmlReader/XmlReader.h>
+#include <string>
+
+//--------------------------------------------------------------------------------------------------
+// Helper functions
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse the next event, the document is written to the reader in chunks of the selected size when
+ * more data is needed
+ *
+ * \param xmlReader     XML reader
+ * \param document      Document
+ * \param chunkSize     Size of the chunks
+ * \param position      Position of the next chunk in the document (updated)
+ *
+ * \return Parsing result, ParsingResult_NeedMoreData only after all of the document was written
+ */
+inline EmbeddedStAX::XmlReader::XmlReader::ParsingResult parseNextEvent(
+        EmbeddedStAX::XmlReader::XmlReader *xmlReader,
+        const std::string &document,
+        const size_t chunkSize,
+        size_t *position)
+{
+    EmbeddedStAX::XmlReader::XmlReader::ParsingResult result = xmlReader->parse();
+
+    while ((result == EmbeddedStAX::XmlReader::XmlReader::ParsingResult_NeedMoreData) &&
+           (*position < document.size()))
+    {
+        xmlReader->writeData(document.substr(*position, chunkSize));
+        (*position) += chunkSize;
+        result = xmlReader->parse();
+    }
+
+    return result;
+}
+
+#endif // TESTEMBEDDEDSTAX_XMLREADER_XMLREADERTESTHELPER_H
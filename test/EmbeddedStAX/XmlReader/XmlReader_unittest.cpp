@@ -0,0 +1,1126 @@
+#include <gtest/gtest.h>
+#include <EmbeddedStAX/XmlReader/XmlReader.h>
+#include <sstream>
+#include <vector>
+#include "XmlReaderTestHelper.h"
+
+using namespace EmbeddedStAX::XmlReader;
+using EmbeddedStAX::Common::UnicodeString;
+using EmbeddedStAX::Common::Utf8;
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::XmlReader::XmlReader
+//--------------------------------------------------------------------------------------------------
+typedef std::vector<XmlReader::ParsingResult> ParsingResultList;
+typedef std::vector<EmbeddedStAX::Common::UnicodeString> NameList;
+
+/**
+ * Parse the document (written to the reader in chunks of the selected size) and return the list of
+ * all parsing results until the end of the data or an error. Optionally the element names of all
+ * start and end of element results are collected.
+ */
+static ParsingResultList parseDocument(XmlReader *xmlReader,
+                                       const std::string &document,
+                                       const size_t chunkSize,
+                                       NameList *nameList = NULL)
+{
+    ParsingResultList resultList;
+    size_t position = 0U;
+    bool finished = false;
+
+    while (!finished)
+    {
+        const XmlReader::ParsingResult result =
+                parseNextEvent(xmlReader, document, chunkSize, &position);
+
+        if (result == XmlReader::ParsingResult_NeedMoreData)
+        {
+            // All of the document was written
+            finished = true;
+        }
+        else
+        {
+            resultList.push_back(result);
+
+            if ((nameList != NULL) &&
+                ((result == XmlReader::ParsingResult_StartOfElement) ||
+                 (result == XmlReader::ParsingResult_EndOfElement)))
+            {
+                nameList->push_back(xmlReader->name());
+            }
+
+            if (result == XmlReader::ParsingResult_Error)
+            {
+                finished = true;
+            }
+        }
+    }
+
+    return resultList;
+}
+
+static const std::string EventMaskDocument(
+        "<?xml version=\"1.0\"?>\n"
+        "<?pi-before data?>\n"
+        "<!-- comment before -->\n"
+        "<root>\n"
+        "    <!-- comment - inside ->-->\n"
+        "    <?pi data ? > data?>\n"
+        "    <a>text</a>\n"
+        "    <b> &#32; </b>\n"
+        "</root>\n"
+        "<!-- comment after -->\n");
+
+TEST(EmbeddedStAX_XmlReader_XmlReader, DefaultEventMaskTest)
+{
+    XmlReader xmlReader;
+    EXPECT_EQ(static_cast<uint32_t>(XmlReader::EventMask_All), xmlReader.eventMask());
+
+    ParsingResultList expected;
+    expected.push_back(XmlReader::ParsingResult_XmlDeclaration);
+    expected.push_back(XmlReader::ParsingResult_ProcessingInstruction);
+    expected.push_back(XmlReader::ParsingResult_Comment);
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_TextNode);
+    expected.push_back(XmlReader::ParsingResult_Comment);
+    expected.push_back(XmlReader::ParsingResult_TextNode);
+    expected.push_back(XmlReader::ParsingResult_ProcessingInstruction);
+    expected.push_back(XmlReader::ParsingResult_TextNode);
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_TextNode);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+    expected.push_back(XmlReader::ParsingResult_TextNode);
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_TextNode);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+    expected.push_back(XmlReader::ParsingResult_TextNode);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+    expected.push_back(XmlReader::ParsingResult_Comment);
+
+    EXPECT_EQ(expected, parseDocument(&xmlReader, EventMaskDocument, EventMaskDocument.size()));
+}
+
+TEST(EmbeddedStAX_XmlReader_XmlReader, EventMaskTest)
+{
+    ParsingResultList expected;
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_TextNode);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+
+    for (size_t chunkSize = 1U; chunkSize <= EventMaskDocument.size(); chunkSize++)
+    {
+        XmlReader xmlReader;
+        xmlReader.setEventMask(XmlReader::EventMask_None);
+        EXPECT_EQ(static_cast<uint32_t>(XmlReader::EventMask_None), xmlReader.eventMask());
+
+        EXPECT_EQ(expected, parseDocument(&xmlReader, EventMaskDocument, chunkSize));
+    }
+}
+
+TEST(EmbeddedStAX_XmlReader_XmlReader, SingleEventMaskTest)
+{
+    XmlReader xmlReader;
+    xmlReader.setEventMask(XmlReader::EventMask_Comment);
+
+    ParsingResultList expected;
+    expected.push_back(XmlReader::ParsingResult_Comment);
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_Comment);
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_TextNode);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+    expected.push_back(XmlReader::ParsingResult_Comment);
+
+    EXPECT_EQ(expected, parseDocument(&xmlReader, EventMaskDocument, 7U));
+
+    // Event mask is kept for the next document
+    xmlReader.clear();
+    EXPECT_EQ(static_cast<uint32_t>(XmlReader::EventMask_Comment), xmlReader.eventMask());
+
+    expected.clear();
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_Comment);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+
+    EXPECT_EQ(expected, parseDocument(&xmlReader, "<root><!--a--></root>", 3U));
+}
+
+TEST(EmbeddedStAX_XmlReader_XmlReader, MaskedXmlDeclarationTest)
+{
+    XmlReader xmlReader;
+    xmlReader.setEventMask(XmlReader::EventMask_None);
+
+    // Masked XML declaration is still validated
+    ParsingResultList expected;
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+
+    EXPECT_EQ(expected, parseDocument(&xmlReader, "<?xml version=\"1.0\"?><root/>", 5U));
+
+    xmlReader.clear();
+    expected.clear();
+    expected.push_back(XmlReader::ParsingResult_Error);
+
+    EXPECT_EQ(expected, parseDocument(&xmlReader, "<?xml version=\"x\"?><root/>", 5U));
+
+    // Masked processing instruction must not use a reserved target
+    xmlReader.clear();
+    expected.clear();
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_Error);
+
+    EXPECT_EQ(expected, parseDocument(&xmlReader, "<root><?XmL data?></root>", 5U));
+}
+
+TEST(EmbeddedStAX_XmlReader_XmlReader, MaskedWhitespaceTextNodeTest)
+{
+    const std::string document("<root>\n  <a> \t</a>\n  <b>  text </b>\n  <c> &#32; </c>\r\n</root>");
+    std::vector<EmbeddedStAX::Common::UnicodeString> textList;
+
+    for (size_t chunkSize = 1U; chunkSize <= document.size(); chunkSize++)
+    {
+        XmlReader xmlReader;
+        xmlReader.setEventMask(XmlReader::EventMask_All &
+                               (~XmlReader::EventMask_WhitespaceTextNode));
+        size_t position = 0U;
+        size_t endOfElementCount = 0U;
+        bool finished = false;
+        textList.clear();
+
+        while (!finished)
+        {
+            switch (parseNextEvent(&xmlReader, document, chunkSize, &position))
+            {
+                case XmlReader::ParsingResult_NeedMoreData:
+                {
+                    // All of the document was written
+                    finished = true;
+                    break;
+                }
+
+                case XmlReader::ParsingResult_TextNode:
+                {
+                    textList.push_back(xmlReader.text());
+                    break;
+                }
+
+                case XmlReader::ParsingResult_EndOfElement:
+                {
+                    endOfElementCount++;
+                    break;
+                }
+
+                case XmlReader::ParsingResult_Error:
+                {
+                    finished = true;
+                    break;
+                }
+
+                default:
+                {
+                    break;
+                }
+            }
+        }
+
+        EXPECT_EQ(4U, endOfElementCount);
+        ASSERT_EQ(1U, textList.size());
+        EXPECT_EQ(EmbeddedStAX::Common::Utf8::toUnicodeString("  text "), textList.at(0U));
+    }
+}
+
+TEST(EmbeddedStAX_XmlReader_XmlReader, EndOfElementTest)
+{
+    ParsingResultList expected;
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+
+    ParsingResultList expectedError;
+    expectedError.push_back(XmlReader::ParsingResult_StartOfElement);
+    expectedError.push_back(XmlReader::ParsingResult_StartOfElement);
+    expectedError.push_back(XmlReader::ParsingResult_Error);
+
+    NameList expectedNameList;
+    expectedNameList.push_back(EmbeddedStAX::Common::Utf8::toUnicodeString("a"));
+    expectedNameList.push_back(EmbeddedStAX::Common::Utf8::toUnicodeString("ab"));
+    expectedNameList.push_back(EmbeddedStAX::Common::Utf8::toUnicodeString("b"));
+    expectedNameList.push_back(EmbeddedStAX::Common::Utf8::toUnicodeString("b"));
+    expectedNameList.push_back(EmbeddedStAX::Common::Utf8::toUnicodeString("ab"));
+    expectedNameList.push_back(EmbeddedStAX::Common::Utf8::toUnicodeString("a"));
+
+    for (size_t chunkSize = 1U; chunkSize <= 8U; chunkSize++)
+    {
+        XmlReader xmlReader;
+        NameList nameList;
+        EXPECT_EQ(expected,
+                  parseDocument(&xmlReader, "<a><ab><b></b ></ab\n></a>", chunkSize, &nameList));
+        EXPECT_EQ(expectedNameList, nameList);
+
+        // End tag must match the innermost open element exactly
+        xmlReader.clear();
+        EXPECT_EQ(expectedError, parseDocument(&xmlReader, "<r><ab></a></r>", chunkSize));
+
+        xmlReader.clear();
+        EXPECT_EQ(expectedError, parseDocument(&xmlReader, "<r><a></ab></r>", chunkSize));
+
+        xmlReader.clear();
+        EXPECT_EQ(expectedError, parseDocument(&xmlReader, "<r><a></a/></r>", chunkSize));
+    }
+}
+
+TEST(EmbeddedStAX_XmlReader_XmlReader, CDataTest)
+{
+    // CDATA sections with a '>' that is not a part of "]]>"
+    const std::string document("<r><![CDATA[>x]]><![CDATA[a>b]]></r>");
+
+    ParsingResultList expected;
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_CData);
+    expected.push_back(XmlReader::ParsingResult_CData);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+
+    for (size_t chunkSize = 1U; chunkSize <= document.size(); chunkSize++)
+    {
+        XmlReader xmlReader;
+        EXPECT_EQ(expected, parseDocument(&xmlReader, document, chunkSize));
+    }
+
+    XmlReader xmlReader;
+    xmlReader.writeData(document);
+    EXPECT_EQ(XmlReader::ParsingResult_StartOfElement, xmlReader.parse());
+    EXPECT_EQ(XmlReader::ParsingResult_CData, xmlReader.parse());
+    EXPECT_EQ(Utf8::toUnicodeString(">x"), xmlReader.text());
+    EXPECT_EQ(XmlReader::ParsingResult_CData, xmlReader.parse());
+    EXPECT_EQ(Utf8::toUnicodeString("a>b"), xmlReader.text());
+}
+
+TEST(EmbeddedStAX_XmlReader_XmlReader, ValidationModeTest)
+{
+    // Name and CDATA with characters that are not allowed in them
+    const std::string document("<r><a\x01-b x\x02=\"1\"/><![CDATA[\x03]]></r>");
+
+    ParsingResultList expected;
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+    expected.push_back(XmlReader::ParsingResult_CData);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+
+    ParsingResultList expectedError;
+    expectedError.push_back(XmlReader::ParsingResult_StartOfElement);
+    expectedError.push_back(XmlReader::ParsingResult_Error);
+
+    XmlReader xmlReader;
+    EXPECT_EQ(XmlReader::ValidationMode_Full, xmlReader.validationMode());
+    EXPECT_EQ(expectedError, parseDocument(&xmlReader, document, 4U));
+
+    // Trusted input
+    xmlReader.clear();
+    xmlReader.setValidationMode(XmlReader::ValidationMode_Trusted);
+    EXPECT_EQ(XmlReader::ValidationMode_Trusted, xmlReader.validationMode());
+
+    NameList nameList;
+    EXPECT_EQ(expected, parseDocument(&xmlReader, document, 4U, &nameList));
+    ASSERT_EQ(4U, nameList.size());
+    EXPECT_EQ(EmbeddedStAX::Common::Utf8::toUnicodeString("a\x01-b"), nameList.at(1U));
+
+    // Sampled validation: every token is validated
+    xmlReader.clear();
+    xmlReader.setValidationMode(XmlReader::ValidationMode_Sampled, 0U);
+    EXPECT_EQ(1U, xmlReader.validationSampleInterval());
+    EXPECT_EQ(expectedError, parseDocument(&xmlReader, document, 4U));
+
+    // Sampled validation: only the first token of the document is validated
+    xmlReader.clear();
+    xmlReader.setValidationMode(XmlReader::ValidationMode_Sampled, 100U);
+    EXPECT_EQ(expected, parseDocument(&xmlReader, document, 4U));
+
+    // Structure is still validated in trusted mode
+    xmlReader.clear();
+    xmlReader.setValidationMode(XmlReader::ValidationMode_Trusted);
+    expectedError.insert(expectedError.begin(), XmlReader::ParsingResult_StartOfElement);
+    EXPECT_EQ(expectedError, parseDocument(&xmlReader, "<r><a></b></r>", 4U));
+}
+
+TEST(EmbeddedStAX_XmlReader_XmlReader, DuplicateAttributeTest)
+{
+    ParsingResultList expected;
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+
+    ParsingResultList expectedError;
+    expectedError.push_back(XmlReader::ParsingResult_StartOfElement);
+    expectedError.push_back(XmlReader::ParsingResult_Error);
+
+    // Element with a lot of attributes (the hash table has to grow)
+    std::ostringstream manyAttributes;
+    manyAttributes << "<e";
+
+    for (size_t i = 0U; i < 100U; i++)
+    {
+        manyAttributes << " a" << i << "='v'";
+    }
+
+    for (size_t chunkSize = 1U; chunkSize <= 8U; chunkSize++)
+    {
+        XmlReader xmlReader;
+        EXPECT_EQ(expected,
+                  parseDocument(&xmlReader,
+                                "<r a='1' b=\"2\" ab='3'><e a='1' b='2'/></r>",
+                                chunkSize));
+
+        xmlReader.clear();
+        EXPECT_EQ(expected,
+                  parseDocument(&xmlReader,
+                                "<r>" + manyAttributes.str() + " b='v'/></r>",
+                                chunkSize));
+
+        // Attribute names must be unique in an element
+        xmlReader.clear();
+        EXPECT_EQ(expectedError,
+                  parseDocument(&xmlReader, "<r><e a='1' a='2'/></r>", chunkSize));
+
+        xmlReader.clear();
+        EXPECT_EQ(expectedError,
+                  parseDocument(&xmlReader, "<r><e a='1' b='2' a = '3'></e></r>", chunkSize));
+
+        xmlReader.clear();
+        EXPECT_EQ(expectedError,
+                  parseDocument(&xmlReader,
+                                "<r>" + manyAttributes.str() + " a99='v'/></r>",
+                                chunkSize));
+    }
+}
+
+TEST(EmbeddedStAX_XmlReader_XmlReader, ParseBudgetTest)
+{
+    const std::string document("<?xml version=\"1.0\"?>\n"
+                               "<!DOCTYPE root>\n"
+                               "<root a='1' b=\"&amp;2\">\n"
+                               "  <!-- comment -->\n"
+                               "  <?pi data?>\n"
+                               "  <e>text &lt; more text</e>\n"
+                               "  <![CDATA[cdata]]>\n"
+                               "  <empty/>\n"
+                               "</root>\n");
+
+    XmlReader referenceReader;
+    NameList expectedNameList;
+    const ParsingResultList expected =
+            parseDocument(&referenceReader, document, document.size(), &expectedNameList);
+    ASSERT_EQ(XmlReader::ParsingResult_EndOfElement, expected.back());
+
+    for (size_t budget = 0U; budget <= 16U; budget++)
+    {
+        XmlReader xmlReader;
+        xmlReader.writeData(document);
+
+        ParsingResultList resultList;
+        NameList nameList;
+        size_t yieldCount = 0U;
+        bool finished = false;
+
+        while (!finished)
+        {
+            const XmlReader::ParsingResult result = xmlReader.parse(budget);
+
+            if (result == XmlReader::ParsingResult_Yield)
+            {
+                // Budget was used up, continue parsing
+                EXPECT_EQ(XmlReader::ParsingResult_Yield, xmlReader.lastParsingResult());
+                yieldCount++;
+            }
+            else if (result == XmlReader::ParsingResult_NeedMoreData)
+            {
+                finished = true;
+            }
+            else
+            {
+                resultList.push_back(result);
+
+                if ((result == XmlReader::ParsingResult_StartOfElement) ||
+                    (result == XmlReader::ParsingResult_EndOfElement))
+                {
+                    nameList.push_back(xmlReader.name());
+                }
+
+                if (result == XmlReader::ParsingResult_Error)
+                {
+                    finished = true;
+                }
+            }
+        }
+
+        EXPECT_EQ(expected, resultList) << "Budget: " << budget;
+        EXPECT_EQ(expectedNameList, nameList) << "Budget: " << budget;
+
+        // Each call reads at most the budget, so a small budget has to yield
+        if (budget <= 4U)
+        {
+            EXPECT_GE(yieldCount * ((budget == 0U) ? 1U : budget), document.size() / 2U);
+        }
+    }
+}
+
+TEST(EmbeddedStAX_XmlReader_XmlReader, TextCoalescingTest)
+{
+    const std::string document("<r> a &amp; b<![CDATA[<c>]]>d<e/> <![CDATA[ ]]> <!--x-->f</r>");
+    NameList expectedTextList;
+    expectedTextList.push_back(EmbeddedStAX::Common::Utf8::toUnicodeString(" a & b<c>d"));
+    expectedTextList.push_back(EmbeddedStAX::Common::Utf8::toUnicodeString("   "));
+    expectedTextList.push_back(EmbeddedStAX::Common::Utf8::toUnicodeString("f"));
+
+    NameList expectedMaskedTextList;
+    expectedMaskedTextList.push_back(expectedTextList.at(0U));
+    expectedMaskedTextList.push_back(expectedTextList.at(2U));
+
+    for (size_t chunkSize = 1U; chunkSize <= document.size(); chunkSize++)
+    {
+        for (size_t masked = 0U; masked < 2U; masked++)
+        {
+            XmlReader xmlReader;
+            xmlReader.setTextCoalescingEnabled(true);
+            EXPECT_TRUE(xmlReader.isTextCoalescingEnabled());
+
+            if (masked != 0U)
+            {
+                xmlReader.setEventMask(XmlReader::EventMask_All &
+                                       (~XmlReader::EventMask_WhitespaceTextNode));
+            }
+
+            NameList textList;
+            size_t position = 0U;
+            size_t endOfElementCount = 0U;
+            size_t cDataCount = 0U;
+            bool finished = false;
+
+            while (!finished)
+            {
+                switch (parseNextEvent(&xmlReader, document, chunkSize, &position))
+                {
+                    case XmlReader::ParsingResult_NeedMoreData:
+                    {
+                        // All of the document was written
+                        finished = true;
+                        break;
+                    }
+
+                    case XmlReader::ParsingResult_TextNode:
+                    {
+                        textList.push_back(xmlReader.text());
+                        break;
+                    }
+
+                    case XmlReader::ParsingResult_CData:
+                    {
+                        cDataCount++;
+                        break;
+                    }
+
+                    case XmlReader::ParsingResult_EndOfElement:
+                    {
+                        endOfElementCount++;
+                        break;
+                    }
+
+                    case XmlReader::ParsingResult_Error:
+                    {
+                        finished = true;
+                        break;
+                    }
+
+                    default:
+                    {
+                        break;
+                    }
+                }
+            }
+
+            EXPECT_EQ(2U, endOfElementCount);
+            EXPECT_EQ(0U, cDataCount);
+
+            if (masked != 0U)
+            {
+                EXPECT_EQ(expectedMaskedTextList, textList);
+            }
+            else
+            {
+                EXPECT_EQ(expectedTextList, textList);
+            }
+        }
+    }
+}
+
+TEST(EmbeddedStAX_XmlReader_XmlReader, PeekTest)
+{
+    const std::string document("<?xml version=\"1.0\"?><r a=\"1\"><e/><b>t<![CDATA[c]]></b><!--x--></r>");
+
+    for (size_t chunkSize = 1U; chunkSize <= document.size(); chunkSize++)
+    {
+        XmlReader reference;
+        NameList expectedNameList;
+        const ParsingResultList expected =
+                parseDocument(&reference, document, chunkSize, &expectedNameList);
+
+        XmlReader xmlReader;
+        ParsingResultList resultList;
+        NameList nameList;
+        size_t position = 0U;
+        bool finished = false;
+
+        while (!finished)
+        {
+            const XmlReader::ParsingResult lastResult = xmlReader.lastParsingResult();
+            const XmlReader::ParsingResult peekedResult = xmlReader.peek();
+            EXPECT_EQ(peekedResult, xmlReader.peek());
+            EXPECT_EQ(lastResult, xmlReader.lastParsingResult());
+
+            if (peekedResult == XmlReader::ParsingResult_NeedMoreData)
+            {
+                if (position < document.size())
+                {
+                    xmlReader.writeData(document.substr(position, chunkSize));
+                    position += chunkSize;
+                }
+                else
+                {
+                    finished = true;
+                }
+            }
+            else
+            {
+                if ((peekedResult == XmlReader::ParsingResult_StartOfElement) ||
+                    (peekedResult == XmlReader::ParsingResult_EndOfElement))
+                {
+                    // Name is available before the event is consumed
+                    nameList.push_back(xmlReader.peekedName());
+                }
+
+                EXPECT_EQ(peekedResult, xmlReader.parse());
+                EXPECT_EQ(peekedResult, xmlReader.lastParsingResult());
+                resultList.push_back(peekedResult);
+
+                if (peekedResult == XmlReader::ParsingResult_Error)
+                {
+                    finished = true;
+                }
+            }
+        }
+
+        EXPECT_EQ(expected, resultList);
+        EXPECT_EQ(expectedNameList, nameList);
+    }
+}
+
+TEST(EmbeddedStAX_XmlReader_XmlReader, PeekKeepsCurrentEventTest)
+{
+    const std::string document("<r a=\"1\"><rec><x>1</x></rec><b c=\"2\" d=\"3\"/></r>");
+
+    for (size_t chunkSize = 1U; chunkSize <= document.size(); chunkSize++)
+    {
+        XmlReader xmlReader;
+        EXPECT_TRUE(xmlReader.addHashedSubtree(Utf8::toUnicodeString("/r/rec")));
+        size_t position = 0U;
+        bool finished = false;
+
+        while (!finished)
+        {
+            const XmlReader::ParsingResult result =
+                    parseNextEvent(&xmlReader, document, chunkSize, &position);
+
+            if (result == XmlReader::ParsingResult_NeedMoreData)
+            {
+                // All of the document was written
+                finished = true;
+            }
+            else if (result == XmlReader::ParsingResult_Error)
+            {
+                ADD_FAILURE();
+                finished = true;
+            }
+            else
+            {
+                // Data of the current event
+                const UnicodeString name = xmlReader.name();
+                const EmbeddedStAX::Common::AttributeList attributeList = xmlReader.attributeList();
+                const uint32_t pathHash = xmlReader.pathHash();
+                const bool subtreeHashAvailable = xmlReader.isSubtreeHashAvailable();
+                const uint64_t subtreeHash = xmlReader.subtreeHash();
+                const UnicodeString recPath = Utf8::toUnicodeString("/r/rec");
+                const bool currentPathRec = xmlReader.isCurrentPath(recPath);
+
+                // Peek at the next event, feeding data until it is complete
+                XmlReader::ParsingResult peekedResult = xmlReader.peek();
+
+                while ((peekedResult == XmlReader::ParsingResult_NeedMoreData) &&
+                       (position < document.size()))
+                {
+                    xmlReader.writeData(document.substr(position, chunkSize));
+                    position += chunkSize;
+                    peekedResult = xmlReader.peek();
+                }
+
+                // Current event is not changed by the peek
+                EXPECT_EQ(result, xmlReader.lastParsingResult());
+                EXPECT_EQ(name, xmlReader.name());
+                EXPECT_EQ(pathHash, xmlReader.pathHash());
+                EXPECT_EQ(subtreeHashAvailable, xmlReader.isSubtreeHashAvailable());
+                EXPECT_EQ(subtreeHash, xmlReader.subtreeHash());
+
+                const EmbeddedStAX::Common::AttributeList currentAttributeList =
+                        xmlReader.attributeList();
+                ASSERT_EQ(attributeList.size(), currentAttributeList.size());
+
+                for (EmbeddedStAX::Common::AttributeList::ConstIterator it1 = attributeList.begin(),
+                     it2 = currentAttributeList.begin();
+                     it1 != attributeList.end();
+                     it1++, it2++)
+                {
+                    EXPECT_EQ(it1->name(), it2->name());
+                    EXPECT_EQ(it1->value(), it2->value());
+                }
+
+                EXPECT_EQ(currentPathRec, xmlReader.isCurrentPath(recPath));
+            }
+        }
+    }
+
+    // Data of the peeked event is reported after it is consumed
+    XmlReader xmlReader;
+    xmlReader.writeData("<r a=\"1\"><b c=\"2\" d=\"3\"/></r>");
+    EXPECT_EQ(XmlReader::ParsingResult_StartOfElement, xmlReader.parse());
+    EXPECT_EQ(XmlReader::ParsingResult_StartOfElement, xmlReader.peek());
+    EXPECT_EQ(Utf8::toUnicodeString("b"), xmlReader.peekedName());
+    EXPECT_EQ(Utf8::toUnicodeString("r"), xmlReader.name());
+    EXPECT_EQ(1U, xmlReader.attributeList().size());
+
+    EXPECT_EQ(XmlReader::ParsingResult_StartOfElement, xmlReader.parse());
+    EXPECT_TRUE(xmlReader.peekedName().empty());
+    EXPECT_EQ(Utf8::toUnicodeString("b"), xmlReader.name());
+    EXPECT_EQ(2U, xmlReader.attributeList().size());
+    EXPECT_TRUE(xmlReader.isCurrentPath(Utf8::toUnicodeString("/r/b")));
+}
+
+TEST(EmbeddedStAX_XmlReader_XmlReader, ErrorLocationTest)
+{
+    const std::string document("<r>\n  <a>x</a>\n  <b>\xC3\xA9\xE2\x82\xAC</c>\n</r>");
+
+    for (size_t chunkSize = 1U; chunkSize <= document.size(); chunkSize++)
+    {
+        XmlReader xmlReader;
+        xmlReader.setLineTrackingEnabled(true);
+        EXPECT_TRUE(xmlReader.isLineTrackingEnabled());
+
+        const ParsingResultList resultList = parseDocument(&xmlReader, document, chunkSize);
+        ASSERT_FALSE(resultList.empty());
+        EXPECT_EQ(XmlReader::ParsingResult_Error, resultList.back());
+
+        // Error is detected at the end of the "</c>" end tag
+        size_t line = 0U;
+        size_t column = 0U;
+        EXPECT_TRUE(xmlReader.location(&line, &column));
+        EXPECT_EQ(3U, line);
+        EXPECT_EQ(12U, column);
+        EXPECT_EQ(26U, xmlReader.characterOffset());
+        EXPECT_EQ(29U, xmlReader.byteOffset());
+    }
+
+    // Without line tracking the location is known while the data is in the parsing buffer
+    XmlReader xmlReader;
+    EXPECT_FALSE(xmlReader.isLineTrackingEnabled());
+    parseDocument(&xmlReader, document, document.size());
+
+    size_t line = 0U;
+    size_t column = 0U;
+    EXPECT_TRUE(xmlReader.location(&line, &column));
+    EXPECT_EQ(3U, line);
+    EXPECT_EQ(12U, column);
+    EXPECT_EQ(29U, xmlReader.byteOffset());
+
+    xmlReader.clear();
+    parseDocument(&xmlReader, document, 1U);
+    EXPECT_FALSE(xmlReader.location(&line, &column));
+    EXPECT_EQ(26U, xmlReader.characterOffset());
+    EXPECT_EQ(29U, xmlReader.byteOffset());
+}
+
+TEST(EmbeddedStAX_XmlReader_XmlReader, ErrorRecoveryTest)
+{
+    const std::string document("<a>1</a><b>x&bad</b>\xC3\xA9 < </b><?xml version=\"1.0\"?><c>3</c>");
+
+    ParsingResultList expected;
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_TextNode);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_Error);
+    expected.push_back(XmlReader::ParsingResult_DataDiscarded);
+    expected.push_back(XmlReader::ParsingResult_XmlDeclaration);
+    expected.push_back(XmlReader::ParsingResult_StartOfElement);
+    expected.push_back(XmlReader::ParsingResult_TextNode);
+    expected.push_back(XmlReader::ParsingResult_EndOfElement);
+
+    for (size_t chunkSize = 1U; chunkSize <= document.size(); chunkSize++)
+    {
+        XmlReader xmlReader;
+        xmlReader.setErrorRecoveryEnabled(true);
+        EXPECT_TRUE(xmlReader.isErrorRecoveryEnabled());
+
+        ParsingResultList resultList;
+        size_t position = 0U;
+        size_t depth = 0U;
+        bool finished = false;
+
+        while (!finished)
+        {
+            const XmlReader::ParsingResult result =
+                    parseNextEvent(&xmlReader, document, chunkSize, &position);
+
+            if (result == XmlReader::ParsingResult_NeedMoreData)
+            {
+                // All of the document was written
+                finished = true;
+            }
+            else
+            {
+                resultList.push_back(result);
+
+                if (result == XmlReader::ParsingResult_StartOfElement)
+                {
+                    depth++;
+                }
+                else if (result == XmlReader::ParsingResult_EndOfElement)
+                {
+                    depth--;
+
+                    if (depth == 0U)
+                    {
+                        // Documents follow each other in the stream
+                        xmlReader.startNewDocument();
+                    }
+                }
+                else if (result == XmlReader::ParsingResult_DataDiscarded)
+                {
+                    // Discarded from the start of the "<b>" document to the XML declaration
+                    EXPECT_EQ(8U, xmlReader.discardedOffset());
+                    EXPECT_EQ(21U, xmlReader.discardedSize());
+                    depth = 0U;
+                }
+                else
+                {
+                    // Nothing to do
+                }
+            }
+        }
+
+        EXPECT_EQ(expected, resultList);
+    }
+
+    // Discarded range includes the data of the broken document that was read before the error
+    XmlReader recoveringReader;
+    recoveringReader.setErrorRecoveryEnabled(true);
+    recoveringReader.writeData("<a x='1' x='2'/><b/>");
+    EXPECT_EQ(XmlReader::ParsingResult_Error, recoveringReader.parse());
+    EXPECT_EQ(XmlReader::ParsingResult_DataDiscarded, recoveringReader.parse());
+    EXPECT_EQ(0U, recoveringReader.discardedOffset());
+    EXPECT_EQ(16U, recoveringReader.discardedSize());
+    EXPECT_EQ(XmlReader::ParsingResult_StartOfElement, recoveringReader.parse());
+    EXPECT_EQ(Utf8::toUnicodeString("b"), recoveringReader.name());
+
+    // Without error recovery the reader stays in the error state
+    ParsingResultList expectedError;
+    expectedError.push_back(XmlReader::ParsingResult_StartOfElement);
+    expectedError.push_back(XmlReader::ParsingResult_TextNode);
+    expectedError.push_back(XmlReader::ParsingResult_EndOfElement);
+    expectedError.push_back(XmlReader::ParsingResult_Error);
+
+    XmlReader xmlReader;
+    EXPECT_FALSE(xmlReader.isErrorRecoveryEnabled());
+    EXPECT_EQ(expectedError, parseDocument(&xmlReader, document, document.size()));
+    EXPECT_EQ(XmlReader::ParsingResult_Error, xmlReader.parse());
+    EXPECT_EQ(XmlReader::ParsingResult_Error, xmlReader.parse());
+}
+
+static const std::string InternalSubsetDocument(
+        "<!DOCTYPE note SYSTEM 'note.dtd' [\n"
+        "  <!ELEMENT note (to, body)>\n"
+        "  <!ATTLIST note id CDATA \"a>b\">\n"
+        "  <!-- comment with <!ELEMENT x ANY> and ] -->\n"
+        "  <?pi ]> ?>\n"
+        "  <!ENTITY e '>'>\n"
+        "  %pe;\n"
+        "  <!ELEMENT to (#PCDATA)>\n"
+        "]>\n"
+        "<note><to>a</to><body/></note>");
+
+TEST(EmbeddedStAX_XmlReader_XmlReader, DocumentTypeTest)
+{
+    for (size_t chunkSize = 1U; chunkSize <= 3U; chunkSize++)
+    {
+        XmlReader xmlReader;
+        size_t position = 0U;
+        ASSERT_EQ(XmlReader::ParsingResult_DocumentType,
+                  parseNextEvent(&xmlReader, InternalSubsetDocument, chunkSize, &position));
+
+        const EmbeddedStAX::Common::DocumentType documentType = xmlReader.documentType();
+        EXPECT_EQ(Utf8::toUnicodeString("note"), documentType.name());
+        EXPECT_EQ(UnicodeString(), documentType.publicId());
+        EXPECT_EQ(Utf8::toUnicodeString("note.dtd"), documentType.systemId());
+        ASSERT_EQ(2U, documentType.elementDeclarationCount());
+        EXPECT_EQ(Utf8::toUnicodeString("note"), documentType.elementName(0U));
+        EXPECT_EQ(Utf8::toUnicodeString("(to, body)"), documentType.elementContentSpec(0U));
+        EXPECT_EQ(Utf8::toUnicodeString("to"), documentType.elementName(1U));
+        EXPECT_EQ(Utf8::toUnicodeString("(#PCDATA)"), documentType.elementContentSpec(1U));
+    }
+
+    // Public ID
+    XmlReader xmlReader;
+    xmlReader.writeData("<!DOCTYPE html PUBLIC \"-//W3C//DTD XHTML 1.0//EN\" \"x.dtd\"><html/>");
+    ASSERT_EQ(XmlReader::ParsingResult_DocumentType, xmlReader.parse());
+    EXPECT_EQ(Utf8::toUnicodeString("-//W3C//DTD XHTML 1.0//EN"),
+              xmlReader.documentType().publicId());
+    EXPECT_EQ(Utf8::toUnicodeString("x.dtd"), xmlReader.documentType().systemId());
+
+    // Invalid document types
+    std::vector<std::string> invalidDocumentList;
+    invalidDocumentList.push_back("<!DOCTYPE r SYSTEM><r/>");
+    invalidDocumentList.push_back("<!DOCTYPE r SYSTEM'x'><r/>");
+    invalidDocumentList.push_back("<!DOCTYPE r PUBLIC 'x'><r/>");
+    invalidDocumentList.push_back("<!DOCTYPE r OTHER 'x'><r/>");
+    invalidDocumentList.push_back("<!DOCTYPE r [ x ]><r/>");
+    invalidDocumentList.push_back("<!DOCTYPE r [ <!ELEMENT r> ]><r/>");
+    invalidDocumentList.push_back("<!DOCTYPE r [ <!ELEMENT 1r ANY> ]><r/>");
+    invalidDocumentList.push_back("<!DOCTYPE r [ <!OTHER r ANY> ]><r/>");
+    invalidDocumentList.push_back("<!DOCTYPE r [ ] x><r/>");
+
+    for (size_t i = 0U; i < invalidDocumentList.size(); i++)
+    {
+        xmlReader.clear();
+        xmlReader.writeData(invalidDocumentList.at(i));
+        EXPECT_EQ(XmlReader::ParsingResult_Error, xmlReader.parse())
+                << invalidDocumentList.at(i);
+    }
+}
+
+TEST(EmbeddedStAX_XmlReader_XmlReader, DtdValidationTest)
+{
+    XmlReader xmlReader;
+    xmlReader.setDtdValidationEnabled(true);
+    EXPECT_TRUE(xmlReader.isDtdValidationEnabled());
+
+    // Element "body" is declared in the external DTD
+    EXPECT_TRUE(xmlReader.addExternalDtd(Utf8::toUnicodeString("note.dtd"),
+                                         "<!-- note -->\n<!ELEMENT body EMPTY>\n"));
+    EXPECT_FALSE(xmlReader.addExternalDtd(UnicodeString(), "<!ELEMENT body EMPTY>"));
+    EXPECT_FALSE(xmlReader.addExternalDtd(Utf8::toUnicodeString("x.dtd"), "<!ELEMENT x>"));
+
+    ParsingResultList expectedResultList;
+    expectedResultList.push_back(XmlReader::ParsingResult_DocumentType);
+    expectedResultList.push_back(XmlReader::ParsingResult_StartOfElement);
+    expectedResultList.push_back(XmlReader::ParsingResult_StartOfElement);
+    expectedResultList.push_back(XmlReader::ParsingResult_TextNode);
+    expectedResultList.push_back(XmlReader::ParsingResult_EndOfElement);
+    expectedResultList.push_back(XmlReader::ParsingResult_StartOfElement);
+    expectedResultList.push_back(XmlReader::ParsingResult_EndOfElement);
+    expectedResultList.push_back(XmlReader::ParsingResult_EndOfElement);
+
+    for (size_t chunkSize = 1U; chunkSize <= 4U; chunkSize++)
+    {
+        xmlReader.clear();
+        EXPECT_EQ(expectedResultList, parseDocument(&xmlReader, InternalSubsetDocument, chunkSize));
+        EXPECT_EQ(SchemaValidator::Error_None, xmlReader.validationError());
+    }
+
+    // Invalid documents
+    const std::string prolog("<!DOCTYPE note SYSTEM 'note.dtd' ["
+                             "<!ELEMENT note (to, body)><!ELEMENT to (#PCDATA)>]>");
+    ParsingResultList resultList;
+
+    xmlReader.clear();
+    resultList = parseDocument(&xmlReader, prolog + "<note><body/></note>", 4U);
+    EXPECT_EQ(XmlReader::ParsingResult_Error, resultList.back());
+    EXPECT_EQ(SchemaValidator::Error_UnexpectedElement, xmlReader.validationError());
+
+    xmlReader.clear();
+    resultList = parseDocument(&xmlReader, prolog + "<note><to>a</to></note>", 4U);
+    EXPECT_EQ(XmlReader::ParsingResult_Error, resultList.back());
+    EXPECT_EQ(SchemaValidator::Error_IncompleteContent, xmlReader.validationError());
+
+    xmlReader.clear();
+    resultList = parseDocument(&xmlReader, prolog + "<to>a</to>", 4U);
+    EXPECT_EQ(XmlReader::ParsingResult_Error, resultList.back());
+    EXPECT_EQ(SchemaValidator::Error_InvalidRootElement, xmlReader.validationError());
+
+    xmlReader.clear();
+    resultList = parseDocument(&xmlReader, prolog + "<note><to>a</to><body>x</body></note>", 4U);
+    EXPECT_EQ(XmlReader::ParsingResult_Error, resultList.back());
+    EXPECT_EQ(SchemaValidator::Error_UnexpectedText, xmlReader.validationError());
+
+    // Duplicate declaration in the internal subset and in the external DTD
+    xmlReader.clear();
+    resultList = parseDocument(&xmlReader,
+                               "<!DOCTYPE body SYSTEM 'note.dtd' [<!ELEMENT body ANY>]><body/>",
+                               4U);
+    ASSERT_EQ(1U, resultList.size());
+    EXPECT_EQ(XmlReader::ParsingResult_Error, resultList.back());
+    EXPECT_EQ(SchemaValidator::Error_InvalidDeclaration, xmlReader.validationError());
+
+    // Parameter entity references in the declarations are not supported
+    xmlReader.clear();
+    resultList = parseDocument(&xmlReader,
+                               "<!DOCTYPE a [<!ENTITY % c '(b)'><!ELEMENT a %c;>]><a/>",
+                               4U);
+    ASSERT_EQ(1U, resultList.size());
+    EXPECT_EQ(XmlReader::ParsingResult_Error, resultList.back());
+    EXPECT_EQ(SchemaValidator::Error_InvalidDeclaration, xmlReader.validationError());
+
+    // Declaration error is cleared with the next document
+    xmlReader.clear();
+    resultList = parseDocument(&xmlReader, "<!DOCTYPE a [<!ELEMENT a EMPTY>]><a/>", 4U);
+    EXPECT_EQ(XmlReader::ParsingResult_EndOfElement, resultList.back());
+    EXPECT_EQ(SchemaValidator::Error_None, xmlReader.validationError());
+
+    // Sequence with more than 256 element names
+    std::string largePrologue("<!DOCTYPE r [<!ELEMENT e EMPTY><!ELEMENT r (e");
+    std::string largeBody("<r><e/>");
+
+    for (size_t i = 1U; i < 300U; i++)
+    {
+        largePrologue.append(",e");
+        largeBody.append("<e/>");
+    }
+
+    xmlReader.clear();
+    resultList = parseDocument(&xmlReader, largePrologue + ")>]>" + largeBody + "</r>", 64U);
+    EXPECT_EQ(XmlReader::ParsingResult_EndOfElement, resultList.back());
+    EXPECT_EQ(SchemaValidator::Error_None, xmlReader.validationError());
+
+    // Document without document type is not valid
+    xmlReader.clear();
+    resultList = parseDocument(&xmlReader, "<note/>", 4U);
+    EXPECT_EQ(XmlReader::ParsingResult_Error, resultList.back());
+    EXPECT_EQ(SchemaValidator::Error_UndeclaredElement, xmlReader.validationError());
+
+    // External DTD is not used when it is removed
+    xmlReader.clearExternalDtds();
+    xmlReader.clear();
+    resultList = parseDocument(&xmlReader, InternalSubsetDocument, 4U);
+    EXPECT_EQ(XmlReader::ParsingResult_Error, resultList.back());
+    EXPECT_EQ(SchemaValidator::Error_UndeclaredElement, xmlReader.validationError());
+}
+
+/**
+ * Parse the document and collect the subtree hashes and SHA-256 digests reported with the end of
+ * element events
+ */
+static void collectSubtreeHashes(XmlReader *xmlReader,
+                                 const std::string &document,
+                                 const size_t chunkSize,
+                                 std::vector<uint64_t> *hashList,
+                                 std::vector<std::vector<uint8_t> > *digestList)
+{
+    size_t position = 0U;
+    bool finished = false;
+
+    while (!finished)
+    {
+        const XmlReader::ParsingResult result =
+                parseNextEvent(xmlReader, document, chunkSize, &position);
+
+        if (result == XmlReader::ParsingResult_NeedMoreData)
+        {
+            // All of the document was written
+            finished = true;
+        }
+        else if (result == XmlReader::ParsingResult_Error)
+        {
+            ADD_FAILURE() << "Parsing error";
+            finished = true;
+        }
+        else if (xmlReader->isSubtreeHashAvailable())
+        {
+            EXPECT_EQ(XmlReader::ParsingResult_EndOfElement, result);
+            hashList->push_back(xmlReader->subtreeHash());
+            digestList->push_back(xmlReader->subtreeSha256());
+        }
+        else
+        {
+            // Continue parsing
+        }
+    }
+}
+
+TEST(EmbeddedStAX_XmlReader_XmlReader, SubtreeHashTest)
+{
+    const std::string document(
+            "<r>\n"
+            "  <rec id='1' b=\"2\">a &amp; b</rec>\n"
+            "  <rec b='2' id=\"1\"><![CDATA[a & b]]></rec>\n"
+            "  <rec id='1' b='2'>a &amp; c</rec>\n"
+            "  <rec id='1' b='2'>\n    <x/><!-- comment -->\n  </rec>\n"
+            "  <rec id='1' b='2'><x></x></rec>\n"
+            "  <other><rec id='1' b='2'>a &amp; b</rec></other>\n"
+            "</r>\n");
+
+    XmlReader xmlReader;
+    EXPECT_FALSE(xmlReader.addHashedSubtree(Utf8::toUnicodeString("r/rec")));
+    EXPECT_TRUE(xmlReader.addHashedSubtree(Utf8::toUnicodeString("/r/rec")));
+    EXPECT_FALSE(xmlReader.addHashedSubtree(Utf8::toUnicodeString("/r/rec")));
+    EXPECT_FALSE(xmlReader.isSubtreeSha256Enabled());
+
+    for (size_t chunkSize = 1U; chunkSize <= 4U; chunkSize++)
+    {
+        std::vector<uint64_t> hashList;
+        std::vector<std::vector<uint8_t> > digestList;
+        xmlReader.clear();
+        collectSubtreeHashes(&xmlReader, document, chunkSize, &hashList, &digestList);
+
+        ASSERT_EQ(5U, hashList.size());
+        EXPECT_EQ(hashList.at(0), hashList.at(1));
+        EXPECT_NE(hashList.at(0), hashList.at(2));
+        EXPECT_EQ(hashList.at(3), hashList.at(4));
+        EXPECT_NE(hashList.at(0), hashList.at(3));
+        EXPECT_TRUE(digestList.at(0).empty());
+    }
+
+    // Nested subtrees and SHA-256 digest
+    xmlReader.setSubtreeSha256Enabled(true);
+    EXPECT_TRUE(xmlReader.isSubtreeSha256Enabled());
+    EXPECT_TRUE(xmlReader.addHashedSubtree(Utf8::toUnicodeString("/r/rec/x")));
+    EXPECT_TRUE(xmlReader.addHashedSubtree(Utf8::toUnicodeString("/r/other")));
+
+    std::vector<uint64_t> hashList;
+    std::vector<std::vector<uint8_t> > digestList;
+    xmlReader.clear();
+    collectSubtreeHashes(&xmlReader, document, 3U, &hashList, &digestList);
+
+    ASSERT_EQ(8U, hashList.size());
+    EXPECT_EQ(hashList.at(0), hashList.at(1));  // rec
+    EXPECT_EQ(hashList.at(3), hashList.at(5));  // x
+    EXPECT_EQ(hashList.at(4), hashList.at(6));  // rec
+    EXPECT_NE(hashList.at(0), hashList.at(7));  // other
+    EXPECT_EQ(32U, digestList.at(0).size());
+    EXPECT_EQ(digestList.at(0), digestList.at(1));
+    EXPECT_NE(digestList.at(0), digestList.at(2));
+
+    // Hashing is disabled without selected subtrees
+    xmlReader.clearHashedSubtrees();
+    hashList.clear();
+    digestList.clear();
+    xmlReader.clear();
+    collectSubtreeHashes(&xmlReader, document, 4U, &hashList, &digestList);
+    EXPECT_TRUE(hashList.empty());
+}
@@ -0,0 +1,27 @@
+#include <gtest/gtest.h>
+#include <EmbeddedStAX/XmlValidator/CDataSection.h>
+
+using namespace EmbeddedStAX::XmlValidator;
+using EmbeddedStAX::Common::UnicodeString;
+using EmbeddedStAX::Common::Utf8;
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::XmlValidator::validateCDataSection()
+//--------------------------------------------------------------------------------------------------
+TEST(EmbeddedStAX_XmlValidator_CDataSection, ValidationTest)
+{
+    EXPECT_TRUE(validateCDataSection(UnicodeString()));
+    EXPECT_TRUE(validateCDataSection(Utf8::toUnicodeString("<a>&amp;</a>")));
+
+    // '>' that is not a part of "]]>"
+    EXPECT_TRUE(validateCDataSection(Utf8::toUnicodeString(">")));
+    EXPECT_TRUE(validateCDataSection(Utf8::toUnicodeString("a>b")));
+    EXPECT_TRUE(validateCDataSection(Utf8::toUnicodeString("]>]>")));
+
+    // End of the CDATA section
+    EXPECT_FALSE(validateCDataSection(Utf8::toUnicodeString("]]>")));
+    EXPECT_FALSE(validateCDataSection(Utf8::toUnicodeString("a>b]]>c")));
+
+    // Invalid character
+    EXPECT_FALSE(validateCDataSection(Utf8::toUnicodeString("a\x01>b")));
+}
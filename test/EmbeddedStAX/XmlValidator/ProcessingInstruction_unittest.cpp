@@ -0,0 +1,23 @@
+#include <gtest/gtest.h>
+#include <EmbeddedStAX/XmlValidator/ProcessingInstruction.h>
+
+using namespace EmbeddedStAX::XmlValidator;
+using EmbeddedStAX::Common::UnicodeString;
+using EmbeddedStAX::Common::Utf8;
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::XmlValidator::validatePiData()
+//--------------------------------------------------------------------------------------------------
+TEST(EmbeddedStAX_XmlValidator_ProcessingInstruction, PiDataValidationTest)
+{
+    EXPECT_TRUE(validatePiData(UnicodeString()));
+    EXPECT_TRUE(validatePiData(Utf8::toUnicodeString("data ? > data")));
+
+    // End of the processing instruction
+    EXPECT_FALSE(validatePiData(Utf8::toUnicodeString("?>")));
+    EXPECT_FALSE(validatePiData(Utf8::toUnicodeString("a?>b")));
+
+    // Invalid character before a valid last character
+    EXPECT_FALSE(validatePiData(Utf8::toUnicodeString("\x01" "a")));
+    EXPECT_FALSE(validatePiData(Utf8::toUnicodeString("da\x01ta")));
+}
@@ -0,0 +1,28 @@
+#include <gtest/gtest.h>
+#include <EmbeddedStAX/XmlValidator/TextNode.h>
+
+using namespace EmbeddedStAX::XmlValidator;
+using EmbeddedStAX::Common::UnicodeString;
+using EmbeddedStAX::Common::Utf8;
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::XmlValidator::validateTextNode()
+//--------------------------------------------------------------------------------------------------
+TEST(EmbeddedStAX_XmlValidator_TextNode, ValidationTest)
+{
+    EXPECT_TRUE(validateTextNode(UnicodeString()));
+    EXPECT_TRUE(validateTextNode(Utf8::toUnicodeString("text &amp; &#32; text")));
+
+    // '>' that is not a part of "]]>"
+    EXPECT_TRUE(validateTextNode(Utf8::toUnicodeString(">")));
+    EXPECT_TRUE(validateTextNode(Utf8::toUnicodeString("a>b")));
+    EXPECT_TRUE(validateTextNode(Utf8::toUnicodeString("]>]>")));
+
+    // "]]>" must not be used in a text node
+    EXPECT_FALSE(validateTextNode(Utf8::toUnicodeString("]]>")));
+    EXPECT_FALSE(validateTextNode(Utf8::toUnicodeString("a>b]]>c")));
+
+    // Markup and invalid references
+    EXPECT_FALSE(validateTextNode(Utf8::toUnicodeString("a<b")));
+    EXPECT_FALSE(validateTextNode(Utf8::toUnicodeString("a&b")));
+}
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include <EmbeddedStAX/XmlWriter/JsonConverter.h>
+
+using namespace EmbeddedStAX::XmlWriter;
+using EmbeddedStAX::Common::UnicodeString;
+using EmbeddedStAX::Common::Utf8;
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::XmlWriter::JsonConverter
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert the document by writing it to the converter in chunks
+ */
+static JsonConverter::Result convertDocument(JsonConverter *jsonConverter,
+                                             const std::string &document,
+                                             const size_t chunkSize,
+                                             std::string *output)
+{
+    JsonConverter::Result result = JsonConverter::Result_NeedMoreData;
+    size_t position = 0U;
+    jsonConverter->startNewStream();
+
+    while (result == JsonConverter::Result_NeedMoreData)
+    {
+        if (position < document.size())
+        {
+            const std::string chunk = document.substr(position, chunkSize);
+            EXPECT_EQ(chunk.size(), jsonConverter->writeData(chunk));
+            position += chunk.size();
+        }
+        else
+        {
+            jsonConverter->finish();
+        }
+
+        result = jsonConverter->process();
+
+        // Take the output after each chunk
+        output->append(jsonConverter->output());
+        jsonConverter->clearOutput();
+    }
+
+    return result;
+}
+
+TEST(EmbeddedStAX_XmlWriter_JsonConverter, ConvertTest)
+{
+    JsonConverter jsonConverter;
+    const std::string document("{\n"
+                               "    \"@id\": 42,\n"
+                               "    \"@type\": \"a\\\"b\",\n"
+                               "    \"name\": \"x < y & \\u00e9\\u4e2d\\ud83d\\ude00\",\n"
+                               "    \"tags\": [\"t1\", \"t2\", {\"@n\": 3}, [true, null]],\n"
+                               "    \"empty\": {},\n"
+                               "    \"none\": null,\n"
+                               "    \"nested\": {\"#text\": \"value\", \"child\": -1.5e+3},\n"
+                               "    \"list\": []\n"
+                               "}\n");
+    const std::string expectedOutput("<json id=\"42\" type=\"a&quot;b\">"
+                                     "<name>x &lt; y &amp; "
+                                     "\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80</name>"
+                                     "<tags>t1</tags><tags>t2</tags><tags n=\"3\"/>"
+                                     "<tags><item>true</item><item/></tags>"
+                                     "<empty/>"
+                                     "<none/>"
+                                     "<nested>value<child>-1.5e+3</child></nested>"
+                                     "</json>");
+
+    // Convert the document with different chunk sizes
+    for (size_t chunkSize = 1U; chunkSize <= document.size(); chunkSize += 7U)
+    {
+        std::string output;
+        EXPECT_EQ(JsonConverter::Result_Finished,
+                  convertDocument(&jsonConverter, document, chunkSize, &output));
+        EXPECT_EQ(expectedOutput, output);
+    }
+}
+
+TEST(EmbeddedStAX_XmlWriter_JsonConverter, TopLevelValueTest)
+{
+    JsonConverter jsonConverter;
+    std::string output;
+
+    EXPECT_EQ(JsonConverter::Result_Finished,
+              convertDocument(&jsonConverter, "123", 1U, &output));
+    EXPECT_EQ(std::string("<json>123</json>"), output);
+
+    output.clear();
+    EXPECT_EQ(JsonConverter::Result_Finished,
+              convertDocument(&jsonConverter, " [1, [\"a\"], {}] ", 3U, &output));
+    EXPECT_EQ(std::string("<json><item>1</item><item><item>a</item></item><item/></json>"),
+              output);
+
+    // Configurable names
+    EXPECT_TRUE(jsonConverter.setRootName(Utf8::toUnicodeString("root")));
+    EXPECT_TRUE(jsonConverter.setArrayItemName(Utf8::toUnicodeString("row")));
+    EXPECT_FALSE(jsonConverter.setRootName(Utf8::toUnicodeString("1root")));
+    EXPECT_EQ(Utf8::toUnicodeString("root"), jsonConverter.rootName());
+    jsonConverter.setAttributePrefix(0U);
+    jsonConverter.setTextKey(UnicodeString());
+
+    output.clear();
+    EXPECT_EQ(JsonConverter::Result_Finished,
+              convertDocument(&jsonConverter, "[{\"a\": \"\"}]", 100U, &output));
+    EXPECT_EQ(std::string("<root><row><a></a></row></root>"), output);
+
+    output.clear();
+    EXPECT_EQ(JsonConverter::Result_Error,
+              convertDocument(&jsonConverter, "{\"@a\": 1}", 100U, &output));
+}
+
+TEST(EmbeddedStAX_XmlWriter_JsonConverter, NameCacheTest)
+{
+    JsonConverter jsonConverter;
+    std::string document("[");
+
+    for (size_t i = 0U; i < 100U; i++)
+    {
+        if (i > 0U)
+        {
+            document.append(",");
+        }
+
+        document.append("{\"@id\": 1, \"name\": \"n\", \"value\": 2}");
+    }
+
+    document.append("]");
+
+    // Names are validated once per distinct key
+    std::string output;
+    EXPECT_EQ(JsonConverter::Result_Finished,
+              convertDocument(&jsonConverter, document, 10U, &output));
+    EXPECT_EQ(3U, jsonConverter.nameValidationCount());
+
+    // Without the cache each name is validated
+    jsonConverter.setNameCacheCapacity(0U);
+    output.clear();
+    EXPECT_EQ(JsonConverter::Result_Finished,
+              convertDocument(&jsonConverter, document, 10U, &output));
+    EXPECT_EQ(303U, jsonConverter.nameValidationCount());
+}
+
+TEST(EmbeddedStAX_XmlWriter_JsonConverter, InvalidDocumentTest)
+{
+    static const char *s_documentList[] =
+    {
+        "",
+        "{",
+        "{\"a\": 1",
+        "{\"a\" 1}",
+        "{\"a\": 1,}",
+        "[1,]",
+        "[1}",
+        "{\"a\": 1]",
+        "01",
+        "-",
+        "1.",
+        "1e",
+        "tru",
+        "nul1",
+        "\"abc",
+        "\"a\\x\"",
+        "\"\\ud800\"",
+        "\"\\udc00\"",
+        "\"a\nb\"",
+        "\"\xC3\"",
+        "1 2",
+        "{\"1a\": 1}",
+        "{\"a b\": 1}",
+        "{\"a\": 1, \"@b\": 2}",
+        "{\"@a\": 1, \"@a\": 2}",
+        "{\"@a\": {}}",
+        "{\"#text\": []}",
+        "\"\\u0001\""
+    };
+
+    JsonConverter jsonConverter;
+
+    for (size_t i = 0U; i < (sizeof(s_documentList) / sizeof(s_documentList[0])); i++)
+    {
+        std::string output;
+        EXPECT_EQ(JsonConverter::Result_Error,
+                  convertDocument(&jsonConverter, s_documentList[i], 1U, &output))
+                << "Document: " << s_documentList[i];
+    }
+}
@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <EmbeddedStAX/XmlReader/XmlReader.h>
+#include <EmbeddedStAX/XmlWriter/XmlTemplate.h>
+
+using namespace EmbeddedStAX::XmlWriter;
+using EmbeddedStAX::Common::UnicodeString;
+using EmbeddedStAX::Common::Utf8;
+using EmbeddedStAX::XmlReader::XmlReader;
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::XmlWriter::XmlTemplate
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that the document is well-formed
+ */
+static bool isWellFormed(const std::string &document)
+{
+    XmlReader xmlReader;
+    bool success = (xmlReader.writeData(document) == document.size());
+    bool finished = !success;
+
+    while (!finished)
+    {
+        const XmlReader::ParsingResult result = xmlReader.parse();
+
+        if (result == XmlReader::ParsingResult_Error)
+        {
+            success = false;
+            finished = true;
+        }
+        else if (result == XmlReader::ParsingResult_NeedMoreData)
+        {
+            finished = true;
+        }
+        else
+        {
+        }
+    }
+
+    return success;
+}
+
+TEST(EmbeddedStAX_XmlWriter_XmlTemplate, CompileTest)
+{
+    XmlTemplate xmlTemplate;
+    const std::string skeleton("<?xml version=\"1.0\"?>\n"
+                               "<!-- response -->\n"
+                               "<response id='${id}' status=\"ok\">\n"
+                               "    <name>${name}</name>\n"
+                               "    <copy of=\"${id}\">${name} &amp; ${name}</copy>\n"
+                               "    <empty x=\"${x}\"/>\n"
+                               "    <![CDATA[${not a hole}]]>\n"
+                               "</response>\n");
+
+    EXPECT_FALSE(xmlTemplate.isCompiled());
+    EXPECT_TRUE(xmlTemplate.compile(skeleton));
+    EXPECT_TRUE(xmlTemplate.isCompiled());
+
+    // Holes (a hole that is used more than once is counted only once)
+    ASSERT_EQ(3U, xmlTemplate.holeCount());
+    EXPECT_EQ(Utf8::toUnicodeString("id"), xmlTemplate.holeName(0U));
+    EXPECT_EQ(XmlTemplate::HoleType_AttributeValue, xmlTemplate.holeType(0U));
+    EXPECT_EQ(Utf8::toUnicodeString("name"), xmlTemplate.holeName(1U));
+    EXPECT_EQ(XmlTemplate::HoleType_Text, xmlTemplate.holeType(1U));
+    EXPECT_EQ(Utf8::toUnicodeString("x"), xmlTemplate.holeName(2U));
+    EXPECT_EQ(XmlTemplate::HoleType_AttributeValue, xmlTemplate.holeType(2U));
+    EXPECT_EQ(1U, xmlTemplate.findHole(Utf8::toUnicodeString("name")));
+    EXPECT_EQ(UnicodeString::npos, xmlTemplate.findHole(Utf8::toUnicodeString("missing")));
+    EXPECT_TRUE(xmlTemplate.holeName(3U).empty());
+
+    // Render
+    std::vector<UnicodeString> valueList;
+    valueList.push_back(Utf8::toUnicodeString("42"));
+    valueList.push_back(Utf8::toUnicodeString("abc"));
+    valueList.push_back(Utf8::toUnicodeString("1"));
+
+    std::string output;
+    ASSERT_TRUE(xmlTemplate.render(valueList, &output));
+    EXPECT_EQ(std::string("<?xml version=\"1.0\"?>\n"
+                          "<!-- response -->\n"
+                          "<response id='42' status=\"ok\">\n"
+                          "    <name>abc</name>\n"
+                          "    <copy of=\"42\">abc &amp; abc</copy>\n"
+                          "    <empty x=\"1\"/>\n"
+                          "    <![CDATA[${not a hole}]]>\n"
+                          "</response>\n"),
+              output);
+    EXPECT_EQ(output.size() - 14U, xmlTemplate.staticSize());
+
+    // Output is appended
+    ASSERT_TRUE(xmlTemplate.render(valueList, &output));
+    EXPECT_EQ(2U * (xmlTemplate.staticSize() + 14U), output.size());
+
+    // Clear
+    xmlTemplate.clear();
+    EXPECT_FALSE(xmlTemplate.isCompiled());
+    EXPECT_EQ(0U, xmlTemplate.holeCount());
+    EXPECT_EQ(0U, xmlTemplate.staticSize());
+    EXPECT_FALSE(xmlTemplate.render(std::vector<UnicodeString>(), &output));
+}
+
+TEST(EmbeddedStAX_XmlWriter_XmlTemplate, EscapingTest)
+{
+    XmlTemplate xmlTemplate;
+    ASSERT_TRUE(xmlTemplate.compile("<a q=\"${v}\" s='${v}' t=\"&lt;${v}\">"
+                                    "$${literal} &lt;${t}&gt;<b/>${t}</a>"));
+    ASSERT_EQ(2U, xmlTemplate.holeCount());
+
+    std::vector<UnicodeString> valueList;
+    valueList.push_back(Utf8::toUnicodeString("<\"'&>\t\n"));
+    valueList.push_back(Utf8::toUnicodeString("]]>\"'\r\n\xC3\xA9"));
+
+    std::string output;
+    ASSERT_TRUE(xmlTemplate.render(valueList, &output));
+    EXPECT_EQ(std::string("<a q=\"&lt;&quot;'&amp;>&#9;&#10;\""
+                          " s='&lt;\"&apos;&amp;>&#9;&#10;'"
+                          " t=\"&lt;&lt;&quot;'&amp;>&#9;&#10;\">"
+                          "${literal} &lt;]]&gt;\"'&#13;\n\xC3\xA9&gt;<b/>]]&gt;\"'&#13;\n\xC3\xA9"
+                          "</a>"),
+              output);
+    EXPECT_TRUE(isWellFormed(output));
+
+    // Values are read back unchanged
+    XmlReader xmlReader;
+    ASSERT_EQ(output.size(), xmlReader.writeData(output));
+    ASSERT_EQ(XmlReader::ParsingResult_StartOfElement, xmlReader.parse());
+    ASSERT_EQ(3U, xmlReader.attributeList().size());
+    EXPECT_EQ(valueList.at(0U), xmlReader.attributeList().begin()->value());
+}
+
+TEST(EmbeddedStAX_XmlWriter_XmlTemplate, ReferenceTest)
+{
+    // A '$' written as a reference is not a part of a hole
+    XmlTemplate xmlTemplate;
+    ASSERT_TRUE(xmlTemplate.compile("<r a=\"&#36;{a}\">&#36;{b}${c}&#x24;{d}</r>"));
+    ASSERT_EQ(1U, xmlTemplate.holeCount());
+    EXPECT_EQ(Utf8::toUnicodeString("c"), xmlTemplate.holeName(0U));
+
+    std::vector<UnicodeString> valueList;
+    valueList.push_back(Utf8::toUnicodeString("x"));
+
+    std::string output;
+    ASSERT_TRUE(xmlTemplate.render(valueList, &output));
+    EXPECT_EQ(std::string("<r a=\"&#36;{a}\">&#36;{b}x&#x24;{d}</r>"), output);
+
+    // Value next to "]]" or "]>" in the skeleton can not form "]]>"
+    ASSERT_TRUE(xmlTemplate.compile("<r>]]${v}|${v}]>|${v}></r>"));
+    valueList.at(0U) = Utf8::toUnicodeString("]>]]");
+
+    output.clear();
+    ASSERT_TRUE(xmlTemplate.render(valueList, &output));
+    EXPECT_EQ(std::string("<r>]]]&gt;]]|]&gt;]]]&gt;|]&gt;]]&gt;</r>"), output);
+    EXPECT_TRUE(isWellFormed(output));
+}
+
+TEST(EmbeddedStAX_XmlWriter_XmlTemplate, InvalidSkeletonTest)
+{
+    XmlTemplate xmlTemplate;
+
+    // Malformed document
+    EXPECT_FALSE(xmlTemplate.compile("<a>${x}</b>"));
+    EXPECT_FALSE(xmlTemplate.isCompiled());
+
+    // Incomplete document
+    EXPECT_FALSE(xmlTemplate.compile("<a>${x}"));
+    EXPECT_FALSE(xmlTemplate.compile(""));
+
+    // Unterminated hole
+    EXPECT_FALSE(xmlTemplate.compile("<a>${x</a>"));
+    EXPECT_FALSE(xmlTemplate.compile("<a b=\"${x\"/>"));
+
+    // Invalid hole name
+    EXPECT_FALSE(xmlTemplate.compile("<a>${1x}</a>"));
+    EXPECT_FALSE(xmlTemplate.compile("<a>${}</a>"));
+
+    // Same hole in a text node and in an attribute value
+    EXPECT_FALSE(xmlTemplate.compile("<a b=\"${x}\">${x}</a>"));
+    EXPECT_EQ(0U, xmlTemplate.holeCount());
+
+    // Valid skeleton after an invalid one
+    EXPECT_TRUE(xmlTemplate.compile("<a b=\"${x}\">${y}</a>"));
+    EXPECT_EQ(2U, xmlTemplate.holeCount());
+}
+
+TEST(EmbeddedStAX_XmlWriter_XmlTemplate, InvalidValueTest)
+{
+    XmlTemplate xmlTemplate;
+    ASSERT_TRUE(xmlTemplate.compile("<a b=\"${x}\">${y}</a>"));
+
+    std::string output("prefix");
+    std::vector<UnicodeString> valueList;
+    valueList.push_back(Utf8::toUnicodeString("x"));
+
+    // Number of values does not match
+    EXPECT_FALSE(xmlTemplate.render(valueList, &output));
+    EXPECT_FALSE(xmlTemplate.render(valueList, NULL));
+
+    // Invalid character (output is left unchanged)
+    UnicodeString value = Utf8::toUnicodeString("y");
+    value.push_back(0x01U);
+    valueList.push_back(value);
+    EXPECT_FALSE(xmlTemplate.render(valueList, &output));
+    EXPECT_EQ(std::string("prefix"), output);
+
+    valueList.at(1U) = Utf8::toUnicodeString("y");
+    EXPECT_TRUE(xmlTemplate.render(valueList, &output));
+    EXPECT_EQ(std::string("prefix<a b=\"x\">y</a>"), output);
+}
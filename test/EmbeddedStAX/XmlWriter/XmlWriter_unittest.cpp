@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <EmbeddedStAX/XmlWriter/XmlWriter.h>
+
+using namespace EmbeddedStAX::XmlWriter;
+using EmbeddedStAX::Common::Attribute;
+using EmbeddedStAX::Common::AttributeList;
+using EmbeddedStAX::Common::UnicodeString;
+using EmbeddedStAX::Common::Utf8;
+
+//--------------------------------------------------------------------------------------------------
+// Test case: EmbeddedStAX::XmlWriter::XmlWriter
+//--------------------------------------------------------------------------------------------------
+TEST(EmbeddedStAX_XmlWriter_XmlWriter, FragmentTest)
+{
+    // Write fragments (they could be written in parallel, each one with its own writer)
+    XmlWriter fragmentList[3];
+
+    for (size_t i = 0U; i < 3U; i++)
+    {
+        AttributeList attributeList;
+        attributeList.add(Attribute(Utf8::toUnicodeString("id"),
+                                    UnicodeString(1U, static_cast<uint32_t>('0' + i))));
+
+        XmlWriter &fragment = fragmentList[i];
+        EXPECT_FALSE(fragment.isFragment());
+        ASSERT_TRUE(fragment.startFragment(2U));
+        EXPECT_TRUE(fragment.isFragment());
+        EXPECT_TRUE(fragment.isFragmentComplete());
+        EXPECT_EQ(2U, fragment.fragmentDepth());
+
+        ASSERT_TRUE(fragment.writeStartOfElement(Utf8::toUnicodeString("record"), attributeList));
+        EXPECT_FALSE(fragment.isFragmentComplete());
+        EXPECT_EQ(3U, fragment.depth());
+        ASSERT_TRUE(fragment.writeTextNode(Utf8::toUnicodeString("a<b")));
+        ASSERT_TRUE(fragment.writeEndOfElement());
+        EXPECT_TRUE(fragment.isFragmentComplete());
+        ASSERT_TRUE(fragment.writeEmptyElement(Utf8::toUnicodeString("separator")));
+        ASSERT_TRUE(fragment.writeComment(Utf8::toUnicodeString(" end ")));
+        EXPECT_TRUE(fragment.isFragmentComplete());
+    }
+
+    // Splice the fragments in order
+    XmlWriter xmlWriter;
+    ASSERT_TRUE(xmlWriter.writeStartOfElement(Utf8::toUnicodeString("export")));
+    ASSERT_TRUE(xmlWriter.writeStartOfElement(Utf8::toUnicodeString("records")));
+    EXPECT_EQ(2U, xmlWriter.depth());
+
+    for (size_t i = 0U; i < 3U; i++)
+    {
+        ASSERT_TRUE(xmlWriter.writeFragment(fragmentList[i]));
+    }
+
+    ASSERT_TRUE(xmlWriter.writeEndOfElement());
+    ASSERT_TRUE(xmlWriter.writeEndOfElement());
+
+    EXPECT_EQ(Utf8::toUnicodeString("<export><records>"
+                                    "<record id=\"0\">a&lt;b</record><separator/><!-- end -->"
+                                    "<record id=\"1\">a&lt;b</record><separator/><!-- end -->"
+                                    "<record id=\"2\">a&lt;b</record><separator/><!-- end -->"
+                                    "</records></export>"),
+              xmlWriter.xmlString());
+}
+
+TEST(EmbeddedStAX_XmlWriter_XmlWriter, InvalidFragmentTest)
+{
+    XmlWriter fragment;
+
+    // Fragment has to be written inside of an element
+    EXPECT_FALSE(fragment.startFragment(0U));
+
+    // XML declaration and document type are not allowed in a fragment
+    ASSERT_TRUE(fragment.startFragment(1U));
+    EXPECT_FALSE(fragment.writeXmlDeclaration());
+    EXPECT_FALSE(fragment.isFragmentComplete());
+    ASSERT_TRUE(fragment.startFragment(1U));
+    EXPECT_FALSE(fragment.writeDocumentType(Utf8::toUnicodeString("root")));
+
+    // End of element without an open element in the fragment
+    ASSERT_TRUE(fragment.startFragment(1U));
+    EXPECT_FALSE(fragment.writeEndOfElement());
+
+    // Incomplete fragment can not be spliced
+    XmlWriter xmlWriter;
+    ASSERT_TRUE(fragment.startFragment(1U));
+    ASSERT_TRUE(fragment.writeStartOfElement(Utf8::toUnicodeString("a")));
+    ASSERT_TRUE(xmlWriter.writeStartOfElement(Utf8::toUnicodeString("root")));
+    EXPECT_FALSE(xmlWriter.writeFragment(fragment));
+
+    // Fragment written for a different depth can not be spliced
+    ASSERT_TRUE(fragment.writeEndOfElement());
+    xmlWriter.clearDocument();
+    ASSERT_TRUE(xmlWriter.writeStartOfElement(Utf8::toUnicodeString("root")));
+    ASSERT_TRUE(xmlWriter.writeStartOfElement(Utf8::toUnicodeString("child")));
+    EXPECT_FALSE(xmlWriter.writeFragment(fragment));
+
+    // Fragment can not be spliced outside of an element
+    xmlWriter.clearDocument();
+    EXPECT_FALSE(xmlWriter.writeFragment(fragment));
+
+    // Document is not a fragment
+    XmlWriter document;
+    ASSERT_TRUE(document.writeEmptyElement(Utf8::toUnicodeString("a")));
+    EXPECT_FALSE(document.isFragmentComplete());
+    xmlWriter.clearDocument();
+    ASSERT_TRUE(xmlWriter.writeStartOfElement(Utf8::toUnicodeString("root")));
+    EXPECT_FALSE(xmlWriter.writeFragment(document));
+}
+
+TEST(EmbeddedStAX_XmlWriter_XmlWriter, NestedFragmentTest)
+{
+    // Fragment spliced into a fragment
+    XmlWriter innerFragment;
+    ASSERT_TRUE(innerFragment.startFragment(2U));
+    ASSERT_TRUE(innerFragment.writeTextNode(Utf8::toUnicodeString("text")));
+    ASSERT_TRUE(innerFragment.writeCDataSection(Utf8::toUnicodeString("<cdata>")));
+
+    XmlWriter outerFragment;
+    ASSERT_TRUE(outerFragment.startFragment(1U));
+    ASSERT_TRUE(outerFragment.writeStartOfElement(Utf8::toUnicodeString("b")));
+    ASSERT_TRUE(outerFragment.writeFragment(innerFragment));
+    ASSERT_TRUE(outerFragment.writeEndOfElement());
+
+    XmlWriter xmlWriter;
+    ASSERT_TRUE(xmlWriter.writeXmlDeclaration());
+    ASSERT_TRUE(xmlWriter.writeStartOfElement(Utf8::toUnicodeString("a")));
+    ASSERT_TRUE(xmlWriter.writeFragment(outerFragment));
+    ASSERT_TRUE(xmlWriter.writeEndOfElement());
+
+    EXPECT_EQ(Utf8::toUnicodeString("<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                                    "<a><b>text<![CDATA[<cdata>]]></b></a>"),
+              xmlWriter.xmlString());
+}
+
+TEST(EmbeddedStAX_XmlWriter_XmlWriter, EscapeTest)
+{
+    // Whitespace in attribute values is written as character references
+    EXPECT_EQ(Utf8::toUnicodeString("a&#9;b&#10;c&#13;d'&quot;&lt;&amp;>"),
+              XmlWriter::escapeAttributeValue(Utf8::toUnicodeString("a\tb\nc\rd'\"<&>"),
+                                              EmbeddedStAX::Common::QuotationMark_Quote));
+    EXPECT_EQ(Utf8::toUnicodeString("&apos;\""),
+              XmlWriter::escapeAttributeValue(Utf8::toUnicodeString("'\""),
+                                              EmbeddedStAX::Common::QuotationMark_Apostrophe));
+
+    // Text written after a text that ends with "]]" can not form "]]>"
+    EXPECT_EQ(Utf8::toUnicodeString("a>b]]&gt;\n&#13;"),
+              XmlWriter::escapeTextNode(Utf8::toUnicodeString("a>b]]>\n\r")));
+    EXPECT_EQ(Utf8::toUnicodeString("&gt;"), XmlWriter::escapeTextNode(Utf8::toUnicodeString(">")));
+    EXPECT_EQ(Utf8::toUnicodeString("]&gt;"),
+              XmlWriter::escapeTextNode(Utf8::toUnicodeString("]>")));
+
+    XmlWriter xmlWriter;
+    ASSERT_TRUE(xmlWriter.writeStartOfElement(Utf8::toUnicodeString("a")));
+    ASSERT_TRUE(xmlWriter.writeTextNode(Utf8::toUnicodeString("]]")));
+    ASSERT_TRUE(xmlWriter.writeTextNode(Utf8::toUnicodeString(">")));
+    ASSERT_TRUE(xmlWriter.writeEndOfElement());
+    EXPECT_EQ(Utf8::toUnicodeString("<a>]]&gt;</a>"), xmlWriter.xmlString());
+}